@@ -28,6 +28,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationDoubleVectorKey.h"
 #include "vtkInformationInformationVectorKey.h"
+#include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
@@ -41,6 +42,7 @@
 #include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkSignedCharArray.h"
+#include "vtkSmartPointer.h"
 #include "vtkTypeTraits.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
@@ -48,6 +50,7 @@
 #include "vtkUnsignedShortArray.h"
 
 #include <algorithm> // for min(), max()
+#include <utility>
 #include <vector>
 
 namespace
@@ -442,6 +445,7 @@ vtkInformationKeyRestrictedMacro(vtkDataArray, COMPONENT_RANGE, DoubleVector, 2)
 vtkInformationKeyRestrictedMacro(vtkDataArray, L2_NORM_RANGE, DoubleVector, 2);
 vtkInformationKeyRestrictedMacro(vtkDataArray, L2_NORM_FINITE_RANGE, DoubleVector, 2);
 vtkInformationKeyMacro(vtkDataArray, UNITS_LABEL, String);
+vtkInformationKeyRestrictedMacro(vtkDataArray, MODIFIED_RANGES, ObjectBase, "vtkIdTypeArray");
 
 //------------------------------------------------------------------------------
 // Construct object with default tuple dimension (number of components) of 1.
@@ -1583,6 +1587,8 @@ int vtkDataArray::CopyInformation(vtkInformation* infoFrom, int deep)
   {
     myInfo->Remove(L2_NORM_RANGE());
   }
+  // Modified ranges describe the modifications of the source array only.
+  myInfo->Remove(MODIFIED_RANGES());
 
   return 1;
 }
@@ -1761,9 +1767,87 @@ void vtkDataArray::Modified()
     vtkInformation* info = this->GetInformation();
     info->Remove(L2_NORM_RANGE());
     info->Remove(L2_NORM_FINITE_RANGE());
+    info->Remove(MODIFIED_RANGES());
   }
   this->Superclass::Modified();
 }
+
+//------------------------------------------------------------------------------
+void vtkDataArray::ModifiedRange(vtkIdType begin, vtkIdType end)
+{
+  // Beyond this number of ranges, the oldest ones are forgotten.
+  static constexpr vtkIdType maximumNumberOfRanges = 256;
+
+  vtkInformation* info = this->GetInformation();
+  vtkSmartPointer<vtkIdTypeArray> ranges =
+    vtkIdTypeArray::SafeDownCast(info->Get(MODIFIED_RANGES()));
+  if (!ranges)
+  {
+    // The modifications until now are not described by ranges.
+    ranges = vtkSmartPointer<vtkIdTypeArray>::New();
+    ranges->SetNumberOfComponents(3);
+    const vtkIdType first[3] = { static_cast<vtkIdType>(this->GetMTime()), 0, 0 };
+    ranges->InsertNextTypedTuple(first);
+  }
+
+  // Modified() forgets the ranges, so keep them out of the way.
+  info->Remove(MODIFIED_RANGES());
+  this->Modified();
+
+  const vtkIdType range[3] = { static_cast<vtkIdType>(this->GetMTime()), begin, end };
+  ranges->InsertNextTypedTuple(range);
+  if (ranges->GetNumberOfTuples() > maximumNumberOfRanges + 1)
+  {
+    ranges->SetTypedComponent(0, 0, ranges->GetTypedComponent(1, 0));
+    ranges->RemoveTuple(1);
+  }
+  info->Set(MODIFIED_RANGES(), ranges);
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArray::GetModifiedRanges(vtkMTimeType since, vtkIdTypeArray* ranges)
+{
+  ranges->Initialize();
+  ranges->SetNumberOfComponents(2);
+  if (this->GetMTime() <= since)
+  {
+    return true;
+  }
+
+  vtkIdTypeArray* modified = this->HasInformation()
+    ? vtkIdTypeArray::SafeDownCast(this->GetInformation()->Get(MODIFIED_RANGES()))
+    : nullptr;
+  if (!modified || static_cast<vtkMTimeType>(modified->GetTypedComponent(0, 0)) > since)
+  {
+    return false;
+  }
+
+  std::vector<std::pair<vtkIdType, vtkIdType>> collected;
+  for (vtkIdType i = 1; i < modified->GetNumberOfTuples(); ++i)
+  {
+    if (static_cast<vtkMTimeType>(modified->GetTypedComponent(i, 0)) > since)
+    {
+      collected.emplace_back(modified->GetTypedComponent(i, 1), modified->GetTypedComponent(i, 2));
+    }
+  }
+  std::sort(collected.begin(), collected.end());
+
+  for (const auto& range : collected)
+  {
+    const vtkIdType last = ranges->GetNumberOfTuples() - 1;
+    if (last >= 0 && range.first <= ranges->GetTypedComponent(last, 1))
+    {
+      ranges->SetTypedComponent(
+        last, 1, std::max(range.second, ranges->GetTypedComponent(last, 1)));
+    }
+    else if (range.first < range.second)
+    {
+      const vtkIdType tuple[2] = { range.first, range.second };
+      ranges->InsertNextTypedTuple(tuple);
+    }
+  }
+  return true;
+}
 VTK_ABI_NAMESPACE_END
 
 namespace
@@ -42,8 +42,10 @@
 VTK_ABI_NAMESPACE_BEGIN
 class vtkDoubleArray;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkInformationStringKey;
 class vtkInformationDoubleVectorKey;
+class vtkInformationObjectBaseKey;
 class vtkLookupTable;
 class vtkPoints;
 
@@ -524,10 +526,35 @@ public:
   static vtkInformationDoubleVectorKey* L2_NORM_FINITE_RANGE();
 
   /**
-   * Removes out-of-date L2_NORM_RANGE() and L2_NORM_FINITE_RANGE() values.
+   * Removes out-of-date L2_NORM_RANGE() and L2_NORM_FINITE_RANGE() values,
+   * and the modified ranges.
    */
   void Modified() override;
 
+  /**
+   * Call Modified() and record that only the tuples in [begin, end) were
+   * modified, so that the filters computing their outputs tuple by tuple can
+   * update the tuples computed from these ones instead of re-executing
+   * entirely. Use it after modifying a small part of a large array, for
+   * instance interactively. Calling Modified() forgets the modified ranges.
+   */
+  void ModifiedRange(vtkIdType begin, vtkIdType end);
+
+  /**
+   * Fill ranges with the [begin, end) ranges of the tuples modified after the
+   * given modification time, sorted and merged, as a 2 components array.
+   * Returns false if the array was modified after this time without
+   * ModifiedRange(), in which case all the tuples must be considered modified.
+   */
+  bool GetModifiedRanges(vtkMTimeType since, vtkIdTypeArray* ranges);
+
+  /**
+   * This key holds the ranges recorded by ModifiedRange(), as a vtkIdTypeArray
+   * of (modification time, begin, end) tuples. Its first tuple holds the time
+   * after which all the modifications are described by ranges.
+   */
+  static vtkInformationObjectBaseKey* MODIFIED_RANGES();
+
   /**
    * A human-readable string indicating the units for the array data.
    */
@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConcurrentMergePoints.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkConcurrentMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr int Dim = 20;
+constexpr int NumberOfCopies = 8;
+
+// Lattice point of index i, scaled so that coordinates are not exactly
+// representable as float.
+void LatticePoint(vtkIdType i, double x[3])
+{
+  x[0] = 0.1 * (i % Dim);
+  x[1] = 0.1 * ((i / Dim) % Dim);
+  x[2] = 0.1 * (i / (Dim * Dim));
+}
+
+bool TestConcurrentInsertion(int dataType)
+{
+  const vtkIdType numUnique = Dim * Dim * Dim;
+  const vtkIdType numInsertions = NumberOfCopies * numUnique;
+  const double bounds[6] = { 0.0, 0.1 * (Dim - 1), 0.0, 0.1 * (Dim - 1), 0.0, 0.1 * (Dim - 1) };
+
+  vtkNew<vtkPoints> points;
+  points->SetDataType(dataType);
+  vtkNew<vtkConcurrentMergePoints> locator;
+  locator->SetDivisions(8, 8, 8);
+  locator->InitPointInsertion(points, bounds);
+
+  // Every point is inserted several times, from different threads.
+  std::vector<vtkIdType> ids(numInsertions);
+  std::vector<char> inserted(numInsertions);
+  vtkSMPTools::For(0, numInsertions, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      LatticePoint((i * 7919) % numUnique, x);
+      inserted[i] = static_cast<char>(locator->InsertUniquePoint(x, ids[i]));
+    }
+  });
+
+  if (locator->GetNumberOfInsertedPoints() != numUnique)
+  {
+    std::cerr << "Expected " << numUnique << " unique points, got "
+              << locator->GetNumberOfInsertedPoints() << std::endl;
+    return false;
+  }
+
+  // All the insertions of a point must agree on its id, and only one of
+  // them may have inserted it.
+  std::vector<vtkIdType> uniqueIds(numUnique, -1);
+  std::vector<int> numInserted(numUnique, 0);
+  for (vtkIdType i = 0; i < numInsertions; ++i)
+  {
+    const vtkIdType p = (i * 7919) % numUnique;
+    if (uniqueIds[p] == -1)
+    {
+      uniqueIds[p] = ids[i];
+    }
+    numInserted[p] += inserted[i];
+    if (ids[i] != uniqueIds[p] || ids[i] < 0 || ids[i] >= numUnique)
+    {
+      std::cerr << "Inconsistent id for point " << p << std::endl;
+      return false;
+    }
+  }
+
+  locator->FinishPointInsertion();
+  if (points->GetNumberOfPoints() != numUnique)
+  {
+    std::cerr << "Wrong number of output points" << std::endl;
+    return false;
+  }
+
+  double x[3], y[3];
+  for (vtkIdType p = 0; p < numUnique; ++p)
+  {
+    LatticePoint(p, x);
+    points->GetPoint(uniqueIds[p], y);
+    if (numInserted[p] != 1 || static_cast<float>(x[0]) != static_cast<float>(y[0]) ||
+      static_cast<float>(x[1]) != static_cast<float>(y[1]) ||
+      static_cast<float>(x[2]) != static_cast<float>(y[2]))
+    {
+      std::cerr << "Point " << p << " was not inserted correctly" << std::endl;
+      return false;
+    }
+    if (locator->IsInsertedPoint(x) != uniqueIds[p] ||
+      locator->FindClosestInsertedPoint(x) != uniqueIds[p])
+    {
+      std::cerr << "Point " << p << " cannot be located" << std::endl;
+      return false;
+    }
+  }
+
+  // Serial insertion keeps working after the concurrent one.
+  x[0] = x[1] = x[2] = 0.05;
+  vtkIdType ptId;
+  if (!locator->InsertUniquePoint(x, ptId) || ptId != numUnique ||
+    points->GetNumberOfPoints() != numUnique + 1)
+  {
+    std::cerr << "Serial insertion failed" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestConcurrentMergePoints(int, char*[])
+{
+  bool success = TestConcurrentInsertion(VTK_FLOAT);
+  success &= TestConcurrentInsertion(VTK_DOUBLE);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
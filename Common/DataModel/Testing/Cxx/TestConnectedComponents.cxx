@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectedComponents.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkConnectedComponents.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+int TestConnectedComponents(int, char*[])
+{
+  // A random graph, with some excluded elements.
+  const vtkIdType numElements = 20000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  std::vector<bool> excluded(numElements);
+  for (vtkIdType i = 0; i < numElements; ++i)
+  {
+    excluded[i] = random->GetNextRangeValue(0, 1) < 0.1;
+  }
+  std::vector<std::pair<vtkIdType, vtkIdType>> edges;
+  std::vector<std::vector<vtkIdType>> neighbors(numElements);
+  for (vtkIdType i = 0; i < 9000; ++i)
+  {
+    const vtkIdType id0 = static_cast<vtkIdType>(random->GetNextRangeValue(0, numElements));
+    const vtkIdType id1 = static_cast<vtkIdType>(random->GetNextRangeValue(0, numElements));
+    if (!excluded[id0] && !excluded[id1])
+    {
+      edges.emplace_back(id0, id1);
+      neighbors[id0].push_back(id1);
+      neighbors[id1].push_back(id0);
+    }
+  }
+
+  // The expected labels, from a traversal seeded by increasing ids.
+  std::vector<vtkIdType> expected(numElements, -1);
+  vtkIdType numExpected = 0;
+  for (vtkIdType i = 0; i < numElements; ++i)
+  {
+    if (excluded[i] || expected[i] >= 0)
+    {
+      continue;
+    }
+    std::vector<vtkIdType> wave(1, i);
+    expected[i] = numExpected;
+    while (!wave.empty())
+    {
+      const vtkIdType id = wave.back();
+      wave.pop_back();
+      for (vtkIdType neighbor : neighbors[id])
+      {
+        if (expected[neighbor] < 0)
+        {
+          expected[neighbor] = numExpected;
+          wave.push_back(neighbor);
+        }
+      }
+    }
+    ++numExpected;
+  }
+
+  vtkConnectedComponents components;
+  components.Initialize(numElements);
+  for (vtkIdType i = 0; i < numElements; ++i)
+  {
+    if (excluded[i])
+    {
+      components.Exclude(i);
+    }
+  }
+  vtkSMPTools::For(0, static_cast<vtkIdType>(edges.size()), [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      components.Union(edges[i].first, edges[i].second);
+    }
+  });
+  std::vector<vtkIdType> labels(numElements);
+  const vtkIdType numComponents = components.Label(labels.data());
+  std::cout << numComponents << " components" << std::endl;
+  if (numComponents != numExpected || labels != expected)
+  {
+    std::cerr << "Wrong labels: " << numComponents << " components instead of " << numExpected
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Two triangles sharing an edge, a line, and a triangle sharing a point
+  // with the line, with an unused point.
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(9);
+  for (vtkIdType i = 0; i < 9; ++i)
+  {
+    points->SetPoint(i, i, i % 2, 0.0);
+  }
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell({ 4, 5 });
+  vtkNew<vtkCellArray> polys;
+  polys->InsertNextCell({ 0, 1, 2 });
+  polys->InsertNextCell({ 6, 7, 5 });
+  polys->InsertNextCell({ 2, 1, 3 });
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->SetLines(lines);
+  polyData->SetPolys(polys);
+  vtkIdType cellLabels[4];
+  vtkIdType pointLabels[9];
+  const vtkIdType expectedCellLabels[4] = { 0, 1, 0, 1 };
+  const vtkIdType expectedPointLabels[9] = { 1, 1, 1, 1, 0, 0, 0, 0, -1 };
+  if (vtkConnectedComponents::LabelCells(polyData, cellLabels, pointLabels) != 2 ||
+    !std::equal(cellLabels, cellLabels + 4, expectedCellLabels) ||
+    !std::equal(pointLabels, pointLabels + 9, expectedPointLabels))
+  {
+    std::cerr << "Wrong cell labels" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
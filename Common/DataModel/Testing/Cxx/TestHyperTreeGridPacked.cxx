@@ -0,0 +1,232 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHyperTreeGridPacked.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the "Packed" squeeze mode of vtkHyperTreeGrid preserves the
+// structure of the trees.
+
+#include "vtkBitArray.h"
+#include "vtkHyperTree.h"
+#include "vtkHyperTreeGridNonOrientedCursor.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkTypeInt64Array.h"
+#include "vtkUniformHyperTreeGrid.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int MaxDepth = 5;
+
+bool IsRefined(vtkIdType index, unsigned int depth)
+{
+  return depth < MaxDepth && (index * 7 + depth) % 3 != 1;
+}
+
+// Subdivide the leaves at the given depth, which numbers the vertices in
+// breadth-first order when called depth after depth.
+void SubdivideDepth(vtkHyperTreeGridNonOrientedCursor* cursor, unsigned int depth)
+{
+  if (cursor->GetLevel() == depth)
+  {
+    if (IsRefined(cursor->GetVertexId(), depth))
+    {
+      cursor->SubdivideLeaf();
+    }
+    return;
+  }
+  if (cursor->IsLeaf())
+  {
+    return;
+  }
+  for (unsigned char ichild = 0; ichild < cursor->GetNumberOfChildren(); ++ichild)
+  {
+    cursor->ToChild(ichild);
+    SubdivideDepth(cursor, depth);
+    cursor->ToParent();
+  }
+}
+
+// Subdivide the tree depth first, which does not number its vertices in
+// breadth-first order.
+void SubdivideDepthFirst(vtkHyperTreeGridNonOrientedCursor* cursor)
+{
+  if (!IsRefined(cursor->GetVertexId(), cursor->GetLevel()))
+  {
+    return;
+  }
+  cursor->SubdivideLeaf();
+  for (unsigned char ichild = 0; ichild < cursor->GetNumberOfChildren(); ++ichild)
+  {
+    cursor->ToChild(ichild);
+    SubdivideDepthFirst(cursor);
+    cursor->ToParent();
+  }
+}
+
+// Depth-first description of a tree: global index and refinement of each
+// vertex.
+void Describe(vtkHyperTreeGridNonOrientedCursor* cursor, std::vector<vtkIdType>& description)
+{
+  description.emplace_back(cursor->GetGlobalNodeIndex());
+  description.emplace_back(cursor->IsLeaf());
+  if (cursor->IsLeaf())
+  {
+    return;
+  }
+  for (unsigned char ichild = 0; ichild < cursor->GetNumberOfChildren(); ++ichild)
+  {
+    cursor->ToChild(ichild);
+    Describe(cursor, description);
+    cursor->ToParent();
+  }
+}
+
+// Description of all trees, including the elder child indices and the
+// breadth-first descriptors used by the writers.
+std::vector<vtkIdType> Describe(vtkHyperTreeGrid* htg)
+{
+  std::vector<vtkIdType> description;
+  vtkNew<vtkHyperTreeGridNonOrientedCursor> cursor;
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
+  htg->InitializeTreeIterator(it);
+  vtkIdType treeId;
+  while (vtkHyperTree* tree = it.GetNextTree(treeId))
+  {
+    htg->InitializeNonOrientedCursor(cursor, treeId);
+    Describe(cursor, description);
+
+    description.emplace_back(tree->GetNumberOfVertices());
+    description.emplace_back(tree->GetNumberOfNodes());
+    description.emplace_back(tree->GetNumberOfLevels());
+    description.emplace_back(tree->GetGlobalNodeIndexMax());
+    size_t numberOfElements;
+    const unsigned int* elderChildren = tree->GetElderChildIndexArray(numberOfElements);
+    for (size_t index = 0; index < numberOfElements; ++index)
+    {
+      if (!tree->IsLeaf(index))
+      {
+        description.emplace_back(elderChildren[index]);
+        description.emplace_back(tree->GetElderChildIndex(static_cast<unsigned int>(index)));
+      }
+    }
+
+    vtkNew<vtkTypeInt64Array> numberOfVerticesPerDepth;
+    vtkNew<vtkBitArray> descriptor;
+    vtkNew<vtkIdList> breadthFirstIdMap;
+    tree->ComputeBreadthFirstOrderDescriptor(
+      htg->GetMask(), numberOfVerticesPerDepth, descriptor, breadthFirstIdMap);
+    for (vtkIdType i = 0; i < numberOfVerticesPerDepth->GetNumberOfValues(); ++i)
+    {
+      description.emplace_back(numberOfVerticesPerDepth->GetValue(i));
+    }
+    for (vtkIdType i = 0; i < descriptor->GetNumberOfValues(); ++i)
+    {
+      description.emplace_back(descriptor->GetValue(i));
+    }
+    for (vtkIdType i = 0; i < breadthFirstIdMap->GetNumberOfIds(); ++i)
+    {
+      description.emplace_back(breadthFirstIdMap->GetId(i));
+    }
+  }
+  return description;
+}
+}
+
+int TestHyperTreeGridPacked(int, char*[])
+{
+  vtkNew<vtkUniformHyperTreeGrid> htg;
+  htg->SetBranchFactor(2);
+  htg->SetGridScale(1.0);
+  htg->SetOrigin(0.0, 0.0, 0.0);
+  htg->SetDimensions(4, 3, 1);
+  vtkNew<vtkBitArray> mask;
+  htg->SetMask(mask);
+
+  // Trees 0 to 4 are built breadth first, tree 3 with an explicit global
+  // index mapping, while tree 5 is built depth first.
+  vtkNew<vtkHyperTreeGridNonOrientedCursor> cursor;
+  for (vtkIdType treeId = 0; treeId < 5; ++treeId)
+  {
+    const vtkIdType numberOfCells = htg->GetNumberOfCells();
+    htg->InitializeNonOrientedCursor(cursor, treeId, true);
+    for (unsigned int depth = 0; depth < MaxDepth; ++depth)
+    {
+      SubdivideDepth(cursor, depth);
+    }
+    vtkHyperTree* tree = cursor->GetTree();
+    if (treeId == 3)
+    {
+      for (vtkIdType index = 0; index < tree->GetNumberOfVertices(); ++index)
+      {
+        tree->SetGlobalIndexFromLocal(
+          index, numberOfCells + tree->GetNumberOfVertices() - 1 - index);
+      }
+    }
+    else
+    {
+      tree->SetGlobalIndexStart(numberOfCells);
+    }
+  }
+  const vtkIdType numberOfCells = htg->GetNumberOfCells();
+  htg->InitializeNonOrientedCursor(cursor, 5, true);
+  SubdivideDepthFirst(cursor);
+  cursor->SetGlobalIndexStart(numberOfCells);
+  for (vtkIdType index = 0; index < htg->GetNumberOfCells(); ++index)
+  {
+    mask->InsertValue(index, index % 11 == 4);
+  }
+
+  const std::vector<vtkIdType> description = Describe(htg);
+  const unsigned long memorySize = htg->GetActualMemorySizeBytes();
+
+  htg->SetModeSqueeze("Packed");
+  htg->Squeeze();
+  if (htg->GetActualMemorySizeBytes() >= memorySize)
+  {
+    std::cerr << "Packing did not reduce memory usage" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
+  htg->InitializeTreeIterator(it);
+  vtkIdType treeId;
+  while (vtkHyperTree* tree = it.GetNextTree(treeId))
+  {
+    const bool packed = strstr(tree->GetClassName(), "vtkPackedHyperTree") != nullptr;
+    if (packed != (treeId != 5))
+    {
+      std::cerr << "Tree " << treeId << " is " << tree->GetClassName() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (Describe(htg) != description)
+  {
+    std::cerr << "Packing modified the trees" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUniformHyperTreeGrid> copy;
+  copy->ShallowCopy(htg);
+  if (Describe(copy) != description)
+  {
+    std::cerr << "Copying packed trees modified them" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSpaceFillingCurve.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSpaceFillingCurve.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+int TestSpaceFillingCurve(int, char*[])
+{
+  // Morton indices interleave the bits of the coordinates.
+  if (vtkSpaceFillingCurve::MortonIndex(1, 0, 0) != 4 ||
+    vtkSpaceFillingCurve::MortonIndex(0, 1, 0) != 2 ||
+    vtkSpaceFillingCurve::MortonIndex(0, 0, 1) != 1 ||
+    vtkSpaceFillingCurve::MortonIndex(3, 3, 3) != 63)
+  {
+    std::cerr << "Wrong Morton indices" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Points of a regular 8x8x8 lattice, numbered in reverse order.
+  const int dim = 8;
+  const vtkIdType numPts = dim * dim * dim;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  vtkIdType ptId = numPts;
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        points->SetPoint(--ptId, i, j, k);
+      }
+    }
+  }
+
+  for (int curve : { vtkSpaceFillingCurve::MORTON, vtkSpaceFillingCurve::HILBERT })
+  {
+    vtkNew<vtkIdTypeArray> order;
+    if (!vtkSpaceFillingCurve::SortPoints(points, curve, order) ||
+      order->GetNumberOfTuples() != numPts)
+    {
+      std::cerr << "Failed to sort points along curve " << curve << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The ordering must be a permutation.
+    vtkNew<vtkIdList> map;
+    std::vector<bool> seen(numPts, false);
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      seen[order->GetValue(i)] = true;
+    }
+    vtkSpaceFillingCurve::InvertOrdering(order, map);
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      if (!seen[i] || map->GetId(order->GetValue(i)) != i)
+      {
+        std::cerr << "Ordering is not a permutation for curve " << curve << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // The Hilbert curve only steps between adjacent lattice points.
+    if (curve == vtkSpaceFillingCurve::HILBERT)
+    {
+      double p0[3], p1[3];
+      for (vtkIdType i = 1; i < numPts; ++i)
+      {
+        points->GetPoint(order->GetValue(i - 1), p0);
+        points->GetPoint(order->GetValue(i), p1);
+        if (vtkMath::Distance2BetweenPoints(p0, p1) != 1.0)
+        {
+          std::cerr << "Hilbert ordering jumps between points " << order->GetValue(i - 1)
+                    << " and " << order->GetValue(i) << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // The insertion order in rounds is a permutation, sorted along the curve
+  // within each of its rounds.
+  vtkNew<vtkIdTypeArray> rounds;
+  if (!vtkSpaceFillingCurve::SortPointsInRounds(points, vtkSpaceFillingCurve::HILBERT, rounds) ||
+    rounds->GetNumberOfTuples() != numPts)
+  {
+    std::cerr << "Failed to sort points in rounds" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<bool> seen(numPts, false);
+  double bounds[6];
+  points->GetBounds(bounds);
+  int numDescents = 0;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    seen[rounds->GetValue(i)] = true;
+    double p0[3], p1[3];
+    points->GetPoint(rounds->GetValue(i), p1);
+    if (i > 0)
+    {
+      points->GetPoint(rounds->GetValue(i - 1), p0);
+      if (vtkSpaceFillingCurve::ComputeIndex(vtkSpaceFillingCurve::HILBERT, p1, bounds) <
+        vtkSpaceFillingCurve::ComputeIndex(vtkSpaceFillingCurve::HILBERT, p0, bounds))
+      {
+        ++numDescents;
+      }
+    }
+  }
+  if (std::find(seen.begin(), seen.end(), false) != seen.end() || numDescents == 0 ||
+    numDescents >= 9)
+  {
+    std::cerr << "Wrong insertion order in rounds: " << numDescents << " descents" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,249 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStructuredFindCells.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the batch versions of FindCell() and
+// ComputeStructuredCoordinates() of vtkImageData and vtkRectilinearGrid agree
+// with the single point versions.
+
+#include "vtkCell.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkRectilinearGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NumberOfPoints = 500;
+
+// Random points in (slightly more than) the bounds of the dataset, along
+// with points lying exactly on its nodes.
+std::vector<double> GeneratePoints(vtkDataSet* ds)
+{
+  std::mt19937 generator(1234);
+  double bounds[6];
+  ds->GetBounds(bounds);
+  std::vector<double> x(3 * NumberOfPoints);
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const double pad = 0.1 * (bounds[2 * axis + 1] - bounds[2 * axis]);
+    std::uniform_real_distribution<double> dist(bounds[2 * axis] - pad, bounds[2 * axis + 1] + pad);
+    for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+    {
+      x[3 * i + axis] = dist(generator);
+    }
+  }
+  for (vtkIdType i = 0; i < NumberOfPoints / 10; ++i)
+  {
+    ds->GetPoint((i * 37) % ds->GetNumberOfPoints(), x.data() + 3 * i);
+  }
+  return x;
+}
+
+// Compare the batch results with FindCell() and check that the weights
+// interpolate the points of the cells. FindCell() of vtkRectilinearGrid ignores
+// the tolerance, so the batch version may find more points within it.
+template <typename DataSetT>
+bool CheckFindCells(DataSetT* ds, double tol2, const char* name)
+{
+  std::vector<double> x = GeneratePoints(ds);
+  std::vector<vtkIdType> cellIds(NumberOfPoints);
+  std::vector<double> pcoords(3 * NumberOfPoints);
+  std::vector<double> weights(8 * NumberOfPoints);
+  const vtkIdType numFound = ds->FindCells(
+    NumberOfPoints, x.data(), tol2, cellIds.data(), pcoords.data(), weights.data());
+
+  vtkIdType expectedNumFound = 0;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    double pt[3] = { x[3 * i], x[3 * i + 1], x[3 * i + 2] };
+    double dsBounds[6];
+    ds->GetBounds(dsBounds);
+    double dist2 = 0.0;
+    for (int c = 0; c < 3; ++c)
+    {
+      const double dist =
+        std::max(std::max(dsBounds[2 * c] - pt[c], pt[c] - dsBounds[2 * c + 1]), 0.0);
+      dist2 += dist * dist;
+    }
+
+    double pc[3], w[8];
+    int subId;
+    const vtkIdType cellId = ds->FindCell(pt, nullptr, -1, tol2, subId, pc, w);
+    if ((cellId >= 0 && cellId != cellIds[i]) || (cellId < 0 && cellIds[i] >= 0 && dist2 > tol2))
+    {
+      std::cerr << name << ": point " << i << " found in cell " << cellIds[i] << " instead of "
+                << cellId << std::endl;
+      return false;
+    }
+    const vtkIdType foundId = cellIds[i];
+    if (foundId < 0)
+    {
+      // Points within tolerance of the bounds are found.
+      if (tol2 > 0.0 && dist2 < 0.5 * tol2)
+      {
+        std::cerr << name << ": point " << i << " within tolerance is not found" << std::endl;
+        return false;
+      }
+      continue;
+    }
+    ++expectedNumFound;
+
+    // Points inside of cells are interpolated exactly.
+    ds->GetCellPoints(foundId, ptIds);
+    double interpolated[3] = { 0.0, 0.0, 0.0 };
+    double sum = 0.0;
+    for (vtkIdType j = 0; j < ptIds->GetNumberOfIds(); ++j)
+    {
+      double cellPt[3];
+      ds->GetPoint(ptIds->GetId(j), cellPt);
+      const double weight = weights[j * NumberOfPoints + i];
+      sum += weight;
+      for (int c = 0; c < 3; ++c)
+      {
+        interpolated[c] += weight * cellPt[c];
+      }
+    }
+    double closest[3];
+    double bounds[6];
+    ds->GetCellBounds(foundId, bounds);
+    for (int c = 0; c < 3; ++c)
+    {
+      closest[c] = std::min(std::max(pt[c], bounds[2 * c]), bounds[2 * c + 1]);
+    }
+    if (std::abs(sum - 1.0) > 1e-12 ||
+      vtkMath::Distance2BetweenPoints(interpolated, closest) > 1e-12)
+    {
+      std::cerr << name << ": wrong weights for point " << i << std::endl;
+      return false;
+    }
+  }
+
+  if (numFound != expectedNumFound)
+  {
+    std::cerr << name << ": found " << numFound << " points instead of " << expectedNumFound
+              << std::endl;
+    return false;
+  }
+
+  // Structured coordinates of the points inside of the dataset.
+  std::vector<int> ijk(3 * NumberOfPoints);
+  std::vector<unsigned char> inBounds(NumberOfPoints);
+  ds->ComputeStructuredCoordinates(
+    NumberOfPoints, x.data(), ijk.data(), pcoords.data(), inBounds.data());
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    double pt[3] = { x[3 * i], x[3 * i + 1], x[3 * i + 2] };
+    int loc[3];
+    double pc[3];
+    const int inside = ds->ComputeStructuredCoordinates(pt, loc, pc);
+    if (inside != inBounds[i])
+    {
+      std::cerr << name << ": wrong bounds check for point " << i << std::endl;
+      return false;
+    }
+    for (int c = 0; inside && c < 3; ++c)
+    {
+      if (loc[c] != ijk[c * NumberOfPoints + i] ||
+        std::abs(pc[c] - pcoords[c * NumberOfPoints + i]) > 1e-12)
+      {
+        std::cerr << name << ": wrong structured coordinates for point " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkDoubleArray> Coordinates(int num, double start)
+{
+  auto coords = vtkSmartPointer<vtkDoubleArray>::New();
+  coords->SetNumberOfTuples(num);
+  double x = start;
+  for (int i = 0; i < num; ++i)
+  {
+    coords->SetValue(i, x);
+    x += 0.5 + 0.25 * (i % 3);
+  }
+  return coords;
+}
+}
+
+int TestStructuredFindCells(int, char*[])
+{
+  bool success = true;
+
+  vtkNew<vtkImageData> image;
+  image->SetExtent(-2, 8, 0, 6, 1, 5);
+  image->SetOrigin(0.5, -1.0, 2.0);
+  image->SetSpacing(0.5, 0.25, 1.5);
+  success &= CheckFindCells<vtkImageData>(image, 0.0, "image");
+  success &= CheckFindCells<vtkImageData>(image, 0.01, "image with tolerance");
+
+  const double angle = vtkMath::RadiansFromDegrees(30.0);
+  image->SetDirectionMatrix(
+    std::cos(angle), -std::sin(angle), 0.0, std::sin(angle), std::cos(angle), 0.0, 0.0, 0.0, 1.0);
+  success &= CheckFindCells<vtkImageData>(image, 0.0, "oriented image");
+
+  vtkNew<vtkImageData> plane;
+  plane->SetExtent(0, 10, 3, 3, 0, 7);
+  plane->SetSpacing(1.0, 1.0, 0.5);
+  success &= CheckFindCells<vtkImageData>(plane, 1e-6, "XZ image");
+
+  vtkNew<vtkRectilinearGrid> grid;
+  grid->SetDimensions(9, 7, 5);
+  grid->SetXCoordinates(Coordinates(9, -1.0));
+  grid->SetYCoordinates(Coordinates(7, 0.0));
+  grid->SetZCoordinates(Coordinates(5, 2.0));
+  success &= CheckFindCells<vtkRectilinearGrid>(grid, 0.0, "rectilinear grid");
+  success &= CheckFindCells<vtkRectilinearGrid>(grid, 0.01, "rectilinear grid with tolerance");
+
+  // The single point FindCell() of rectilinear grids keeps ignoring tol2.
+  double outside[3] = { -1.05, 1.0, 3.0 };
+  double pc[3], w[8];
+  int subId;
+  vtkIdType cellId;
+  if (grid->FindCell(outside, nullptr, -1, 0.01, subId, pc, w) != -1 ||
+    grid->FindCells(1, outside, 0.01, &cellId) != 1)
+  {
+    std::cerr << "Wrong tolerance handling of rectilinear grid" << std::endl;
+    success = false;
+  }
+
+  // Coordinates modified in place are seen by the batch methods.
+  vtkDoubleArray* xCoords = vtkDoubleArray::SafeDownCast(grid->GetXCoordinates());
+  for (vtkIdType i = 0; i < xCoords->GetNumberOfTuples(); ++i)
+  {
+    xCoords->SetValue(i, 2.0 * xCoords->GetValue(i) + 0.5);
+  }
+  xCoords->Modified();
+  success &= CheckFindCells<vtkRectilinearGrid>(grid, 0.0, "modified rectilinear grid");
+
+  vtkNew<vtkRectilinearGrid> gridPlane;
+  gridPlane->SetDimensions(1, 7, 5);
+  gridPlane->SetXCoordinates(Coordinates(1, 0.0));
+  gridPlane->SetYCoordinates(Coordinates(7, 0.0));
+  gridPlane->SetZCoordinates(Coordinates(5, 2.0));
+  success &= CheckFindCells<vtkRectilinearGrid>(gridPlane, 0.0, "YZ rectilinear grid");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -955,6 +955,26 @@ public:
   vtkIdType GetNumberOfArrays() { return static_cast<vtkIdType>(this->Arrays.size()); }
 };
 
+/**
+ * Return true if ArrayList processes all the arrays of the attributes.
+ * AddArrays() skips the arrays that are not data arrays, such as string
+ * arrays, and bit arrays, which would be left unset in the output. Threaded
+ * algorithms copying attributes with ArrayList should use a serial path
+ * when this returns false.
+ */
+inline bool CanUseArrayList(vtkDataSetAttributes* attributes)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = attributes->GetAbstractArray(i);
+    if (!array || !array->IsNumeric() || array->GetDataType() == VTK_BIT)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 VTK_ABI_NAMESPACE_END
 #include "vtkArrayListTemplate.txx"
 
@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompositeDataSetLeafRange.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkCompositeDataSetLeafRange_h
+#define vtkCompositeDataSetLeafRange_h
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkCompositeDataSetRange.h"
+#include "vtkSmartPointer.h"
+
+#include <cassert>
+#include <vector>
+
+namespace vtk
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+/**
+ * Random access range over the items visited by a vtkCompositeDataIterator.
+ *
+ * The iterators of vtkCompositeDataSet, and the ranges built on top of them,
+ * are forward only which makes them unsuitable for vtkSMPTools. This range
+ * flattens a traversal into a vector of data objects along with their flat
+ * indices, so that items can be processed concurrently:
+ *
+ * ```cpp
+ * vtk::CompositeDataSetLeafRange leaves(cds);
+ * vtkSMPTools::For(0, leaves.size(), [&](vtkIdType begin, vtkIdType end) {
+ *   for (vtkIdType i = begin; i < end; ++i)
+ *   {
+ *     Process(leaves[i], leaves.GetFlatIndex(i));
+ *   }
+ * });
+ * ```
+ *
+ * The i-th item of the range is the i-th item visited by the iterator, so
+ * results can be put back in a composite dataset of the same structure by
+ * traversing the iterator again. The range holds raw pointers: the composite
+ * dataset must outlive it and must not be modified while it is in use.
+ */
+class CompositeDataSetLeafRange
+{
+public:
+  using value_type = vtkDataObject*;
+  using size_type = vtkIdType;
+  using const_iterator = std::vector<vtkDataObject*>::const_iterator;
+  using iterator = const_iterator;
+
+  CompositeDataSetLeafRange() = default;
+
+  /**
+   * Gather the leaves of the composite dataset. Null leaves are skipped
+   * unless `options` is CompositeDataSetOptions::None.
+   */
+  explicit CompositeDataSetLeafRange(vtkCompositeDataSet* cds,
+    CompositeDataSetOptions options = CompositeDataSetOptions::SkipEmptyNodes)
+  {
+    if (cds)
+    {
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(cds->NewIterator());
+      iter->SetSkipEmptyNodes((options & CompositeDataSetOptions::SkipEmptyNodes) ==
+        CompositeDataSetOptions::SkipEmptyNodes);
+      this->Gather(iter);
+    }
+  }
+
+  /**
+   * Gather the items visited by an iterator, honoring its traversal options.
+   */
+  explicit CompositeDataSetLeafRange(vtkCompositeDataIterator* iter)
+  {
+    if (iter)
+    {
+      this->Gather(iter);
+    }
+  }
+
+  size_type size() const noexcept { return static_cast<size_type>(this->Leaves.size()); }
+  bool empty() const noexcept { return this->Leaves.empty(); }
+
+  const_iterator begin() const noexcept { return this->Leaves.begin(); }
+  const_iterator end() const noexcept { return this->Leaves.end(); }
+
+  vtkDataObject* operator[](size_type i) const noexcept
+  {
+    assert(i >= 0 && i < this->size());
+    return this->Leaves[i];
+  }
+
+  /**
+   * Flat index of the i-th item in the composite dataset.
+   */
+  unsigned int GetFlatIndex(size_type i) const noexcept
+  {
+    assert(i >= 0 && i < this->size());
+    return this->FlatIndices[i];
+  }
+
+private:
+  void Gather(vtkCompositeDataIterator* iter)
+  {
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      this->Leaves.push_back(iter->GetCurrentDataObject());
+      this->FlatIndices.push_back(iter->GetCurrentFlatIndex());
+    }
+  }
+
+  std::vector<vtkDataObject*> Leaves;
+  std::vector<unsigned int> FlatIndices;
+};
+
+VTK_ABI_NAMESPACE_END
+} // end namespace vtk
+
+#endif // vtkCompositeDataSetLeafRange_h
+
+// VTK-HeaderTest-Exclude: vtkCompositeDataSetLeafRange.h
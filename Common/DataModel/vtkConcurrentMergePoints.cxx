@@ -0,0 +1,436 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConcurrentMergePoints.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkConcurrentMergePoints.h"
+
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// A point linked in a bucket. The point id is -1 until the point is
+// published, and stays -1 if the node was abandoned because a concurrent
+// insertion of the same point won.
+struct PointNode
+{
+  double X[3];
+  std::atomic<vtkIdType> PointId;
+  vtkIdType Next;
+};
+
+// Nodes are stored in chunks of geometrically increasing sizes so that they
+// never move once allocated: chunk c holds FirstChunkSize * 2^c nodes.
+constexpr vtkIdType FirstChunkSize = 1024;
+constexpr int MaxNumberOfChunks = 48;
+}
+
+//------------------------------------------------------------------------------
+struct vtkConcurrentMergePoints::vtkInternals
+{
+  std::unique_ptr<std::atomic<vtkIdType>[]> Heads; // first node of each bucket
+  std::atomic<PointNode*> Chunks[MaxNumberOfChunks];
+  std::atomic<vtkIdType> NumberOfNodes;
+  std::atomic<vtkIdType> NumberOfPoints;
+  bool RoundToFloat = false;
+
+  vtkInternals(vtkIdType numBuckets)
+    : Heads(new std::atomic<vtkIdType>[numBuckets])
+    , NumberOfNodes(0)
+    , NumberOfPoints(0)
+  {
+    for (auto& chunk : this->Chunks)
+    {
+      chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    std::atomic<vtkIdType>* heads = this->Heads.get();
+    vtkSMPTools::For(0, numBuckets, [heads](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        heads[i].store(-1, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  ~vtkInternals()
+  {
+    for (auto& chunk : this->Chunks)
+    {
+      delete[] chunk.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Return the node with the given index, allocating its chunk if needed.
+  PointNode& GetNode(vtkIdType nodeId)
+  {
+    int chunkId = 0;
+    vtkIdType chunkBegin = 0;
+    vtkIdType chunkSize = FirstChunkSize;
+    while (nodeId >= chunkBegin + chunkSize)
+    {
+      chunkBegin += chunkSize;
+      chunkSize *= 2;
+      ++chunkId;
+    }
+
+    PointNode* chunk = this->Chunks[chunkId].load(std::memory_order_acquire);
+    if (!chunk)
+    {
+      PointNode* newChunk = new PointNode[chunkSize];
+      if (this->Chunks[chunkId].compare_exchange_strong(
+            chunk, newChunk, std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        chunk = newChunk;
+      }
+      else
+      {
+        delete[] newChunk;
+      }
+    }
+    return chunk[nodeId - chunkBegin];
+  }
+
+  // Search the nodes of a bucket from first up to (but excluding) last for
+  // the given coordinates, and return the matching node or nullptr.
+  PointNode* FindNode(vtkIdType first, vtkIdType last, const double x[3])
+  {
+    for (vtkIdType nodeId = first; nodeId != last;)
+    {
+      PointNode& node = this->GetNode(nodeId);
+      if (node.X[0] == x[0] && node.X[1] == x[1] && node.X[2] == x[2])
+      {
+        return &node;
+      }
+      nodeId = node.Next;
+    }
+    return nullptr;
+  }
+
+  // Coordinates are compared as stored by the points, as vtkMergePoints does.
+  void GetKey(const double x[3], double key[3]) const
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      key[i] = this->RoundToFloat ? static_cast<double>(static_cast<float>(x[i])) : x[i];
+    }
+  }
+
+  // Return the id of a node, waiting for a concurrent insertion to publish it.
+  static vtkIdType WaitForPointId(const PointNode& node)
+  {
+    vtkIdType ptId;
+    while ((ptId = node.PointId.load(std::memory_order_acquire)) < 0)
+    {
+      std::this_thread::yield();
+    }
+    return ptId;
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkStandardNewMacro(vtkConcurrentMergePoints);
+
+//------------------------------------------------------------------------------
+vtkConcurrentMergePoints::vtkConcurrentMergePoints() = default;
+
+//------------------------------------------------------------------------------
+vtkConcurrentMergePoints::~vtkConcurrentMergePoints() = default;
+
+//------------------------------------------------------------------------------
+int vtkConcurrentMergePoints::InitPointInsertion(vtkPoints* newPts, const double bounds[6])
+{
+  return this->InitPointInsertion(newPts, bounds, 0);
+}
+
+//------------------------------------------------------------------------------
+int vtkConcurrentMergePoints::InitPointInsertion(
+  vtkPoints* newPts, const double bounds[6], vtkIdType estNumPts)
+{
+  this->FinishPointInsertion();
+  if (!this->Superclass::InitPointInsertion(newPts, bounds, estNumPts))
+  {
+    return 0;
+  }
+
+  this->Internals.reset(new vtkInternals(this->NumberOfBuckets));
+  this->Internals->RoundToFloat = (newPts->GetDataType() == VTK_FLOAT);
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+bool vtkConcurrentMergePoints::InsertNode(
+  const double x[3], bool unique, bool explicitId, vtkIdType& ptId)
+{
+  vtkInternals* internals = this->Internals.get();
+  double key[3];
+  internals->GetKey(x, key);
+
+  std::atomic<vtkIdType>& head = internals->Heads[this->GetBucketIndex(x)];
+  vtkIdType first = head.load(std::memory_order_acquire);
+  if (unique)
+  {
+    if (PointNode* found = internals->FindNode(first, -1, key))
+    {
+      ptId = vtkInternals::WaitForPointId(*found);
+      return false;
+    }
+  }
+
+  const vtkIdType nodeId = internals->NumberOfNodes.fetch_add(1, std::memory_order_relaxed);
+  PointNode& node = internals->GetNode(nodeId);
+  std::copy(key, key + 3, node.X);
+  node.PointId.store(-1, std::memory_order_relaxed);
+  node.Next = first;
+
+  // On failure, first is updated to the current head of the bucket: only the
+  // nodes pushed in the meantime need to be checked for duplicates.
+  while (!head.compare_exchange_weak(
+    first, nodeId, std::memory_order_release, std::memory_order_acquire))
+  {
+    if (unique)
+    {
+      if (PointNode* found = internals->FindNode(first, node.Next, key))
+      {
+        ptId = vtkInternals::WaitForPointId(*found);
+        return false;
+      }
+    }
+    node.Next = first;
+  }
+
+  if (explicitId)
+  {
+    vtkIdType numPts = internals->NumberOfPoints.load(std::memory_order_relaxed);
+    while (numPts <= ptId &&
+      !internals->NumberOfPoints.compare_exchange_weak(
+        numPts, ptId + 1, std::memory_order_relaxed))
+    {
+    }
+  }
+  else
+  {
+    ptId = internals->NumberOfPoints.fetch_add(1, std::memory_order_relaxed);
+  }
+  node.PointId.store(ptId, std::memory_order_release);
+
+  // Serial callers expect the points to be updated immediately.
+  if (!vtkSMPTools::IsParallelScope())
+  {
+    this->Points->InsertPoint(ptId, x);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int vtkConcurrentMergePoints::InsertUniquePoint(const double x[3], vtkIdType& ptId)
+{
+  return this->InsertNode(x, true, false, ptId) ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkConcurrentMergePoints::InsertNextPoint(const double x[3])
+{
+  vtkIdType ptId = -1;
+  this->InsertNode(x, false, false, ptId);
+  return ptId;
+}
+
+//------------------------------------------------------------------------------
+void vtkConcurrentMergePoints::InsertPoint(vtkIdType ptId, const double x[3])
+{
+  this->InsertNode(x, false, true, ptId);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkConcurrentMergePoints::IsInsertedPoint(const double x[3])
+{
+  vtkInternals* internals = this->Internals.get();
+  if (!internals)
+  {
+    return -1;
+  }
+
+  double key[3];
+  internals->GetKey(x, key);
+  const vtkIdType first =
+    internals->Heads[this->GetBucketIndex(x)].load(std::memory_order_acquire);
+  PointNode* found = internals->FindNode(first, -1, key);
+  return found ? vtkInternals::WaitForPointId(*found) : -1;
+}
+
+//------------------------------------------------------------------------------
+// Search shells of buckets of increasing Chebyshev distance around the bucket
+// containing x. Once a point is found at distance d, only the shells that
+// may contain a closer point are searched.
+vtkIdType vtkConcurrentMergePoints::FindClosestInsertedPoint(const double x[3])
+{
+  vtkInternals* internals = this->Internals.get();
+  if (!internals)
+  {
+    return -1;
+  }
+  for (int i = 0; i < 3; i++)
+  {
+    if (x[i] < this->Bounds[2 * i] || x[i] > this->Bounds[2 * i + 1])
+    {
+      return -1;
+    }
+  }
+
+  int ijk[3];
+  this->GetBucketIndices(x, ijk);
+  const double hmin = std::min(this->H[0], std::min(this->H[1], this->H[2]));
+  const int maxLevel =
+    std::max(this->Divisions[0], std::max(this->Divisions[1], this->Divisions[2]));
+
+  vtkIdType closest = -1;
+  double minDist2 = VTK_DOUBLE_MAX;
+  for (int level = 0; level < maxLevel; ++level)
+  {
+    // Buckets of this level are at least (level - 1) * hmin away from x.
+    if (closest >= 0 && level > 1 && (level - 1) * hmin > std::sqrt(minDist2))
+    {
+      break;
+    }
+
+    const int kMin = std::max(ijk[2] - level, 0);
+    const int kMax = std::min(ijk[2] + level, this->Divisions[2] - 1);
+    const int jMin = std::max(ijk[1] - level, 0);
+    const int jMax = std::min(ijk[1] + level, this->Divisions[1] - 1);
+    const int iMin = std::max(ijk[0] - level, 0);
+    const int iMax = std::min(ijk[0] + level, this->Divisions[0] - 1);
+    for (int k = kMin; k <= kMax; ++k)
+    {
+      const bool kShell = (std::abs(k - ijk[2]) == level);
+      for (int j = jMin; j <= jMax; ++j)
+      {
+        const bool jShell = kShell || (std::abs(j - ijk[1]) == level);
+        for (int i = iMin; i <= iMax; ++i)
+        {
+          if (!jShell && std::abs(i - ijk[0]) != level)
+          {
+            continue;
+          }
+          const vtkIdType cno = i + j * this->XD + k * this->SliceSize;
+          vtkIdType nodeId = internals->Heads[cno].load(std::memory_order_acquire);
+          while (nodeId >= 0)
+          {
+            const PointNode& node = internals->GetNode(nodeId);
+            const vtkIdType ptId = node.PointId.load(std::memory_order_acquire);
+            double dist2;
+            if (ptId >= 0 && (dist2 = vtkMath::Distance2BetweenPoints(x, node.X)) < minDist2)
+            {
+              closest = ptId;
+              minDist2 = dist2;
+            }
+            nodeId = node.Next;
+          }
+        }
+      }
+    }
+  }
+
+  return closest;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkConcurrentMergePoints::GetNumberOfInsertedPoints() const
+{
+  return this->Internals ? this->Internals->NumberOfPoints.load(std::memory_order_acquire) : 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkConcurrentMergePoints::FinishPointInsertion()
+{
+  vtkInternals* internals = this->Internals.get();
+  if (!internals || !this->Points || !this->HashTable)
+  {
+    return;
+  }
+
+  // Write the coordinates of the published nodes.
+  const vtkIdType numPts = internals->NumberOfPoints.load(std::memory_order_acquire);
+  const vtkIdType numNodes = internals->NumberOfNodes.load(std::memory_order_acquire);
+  vtkPoints* points = this->Points;
+  points->SetNumberOfPoints(numPts);
+  vtkSMPTools::For(0, numNodes, [internals, points](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType nodeId = begin; nodeId < end; ++nodeId)
+    {
+      const PointNode& node = internals->GetNode(nodeId);
+      const vtkIdType ptId = node.PointId.load(std::memory_order_relaxed);
+      if (ptId >= 0)
+      {
+        points->SetPoint(ptId, node.X);
+      }
+    }
+  });
+
+  // Fill the buckets of vtkPointLocator so that its queries can be used.
+  vtkIdList** hashTable = this->HashTable;
+  vtkSMPTools::For(
+    0, this->NumberOfBuckets, [internals, hashTable](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cno = begin; cno < end; ++cno)
+      {
+        vtkIdType nodeId = internals->Heads[cno].load(std::memory_order_relaxed);
+        if (nodeId < 0)
+        {
+          continue;
+        }
+        vtkIdList* bucket = hashTable[cno];
+        if (!bucket)
+        {
+          bucket = hashTable[cno] = vtkIdList::New();
+        }
+        bucket->Reset();
+        for (; nodeId >= 0; nodeId = internals->GetNode(nodeId).Next)
+        {
+          bucket->InsertNextId(internals->GetNode(nodeId).PointId.load(std::memory_order_relaxed));
+        }
+        std::sort(bucket->begin(), bucket->end());
+      }
+    });
+
+  this->InsertionPointId = numPts;
+  this->Points->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkConcurrentMergePoints::Initialize()
+{
+  this->FinishPointInsertion();
+  this->Superclass::Initialize();
+}
+
+//------------------------------------------------------------------------------
+void vtkConcurrentMergePoints::FreeSearchStructure()
+{
+  this->Superclass::FreeSearchStructure();
+  this->Internals.reset();
+}
+
+//------------------------------------------------------------------------------
+void vtkConcurrentMergePoints::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Number Of Inserted Points: " << this->GetNumberOfInsertedPoints() << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConcurrentMergePoints.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConcurrentMergePoints
+ * @brief   merge exactly coincident points from several threads
+ *
+ * vtkConcurrentMergePoints is a vtkMergePoints whose point insertion methods
+ * (InsertUniquePoint(), InsertNextPoint(), InsertPoint(), IsInsertedPoint()
+ * and FindClosestInsertedPoint()) may be called concurrently, for instance
+ * from within a vtkSMPTools::For() loop. A single locator can therefore be
+ * shared by all the threads of a threaded filter that generates coincident
+ * output points, and produces the same unique points as vtkMergePoints.
+ *
+ * Each bucket of the uniform binning is a lock-free linked list: points are
+ * pushed in a bucket with an atomic compare-and-swap, and a thread inserting
+ * a point concurrently with another one in the same bucket re-checks the
+ * newly pushed points for duplicates. Point ids are contiguous, although
+ * the id given to each unique point depends on the thread scheduling.
+ *
+ * Since vtkPoints cannot grow concurrently, points inserted from within a
+ * parallel scope (see vtkSMPTools::IsParallelScope()) are kept in the
+ * locator and only written to the vtkPoints given to InitPointInsertion()
+ * by FinishPointInsertion(), which must be called once all threads are done
+ * inserting points. Initialize() and InitPointInsertion() also do so. Points
+ * inserted outside of a parallel scope are written immediately, so this
+ * class can be used as a drop-in replacement of vtkMergePoints by serial
+ * filters.
+ *
+ * As with vtkMergePoints, the location methods inherited from
+ * vtkPointLocator (FindClosestPoint(), FindPointsWithinRadius()...) query the
+ * dataset given to SetDataSet() and are not meant to be used during
+ * incremental insertion. Use IsInsertedPoint() or FindClosestInsertedPoint()
+ * instead.
+ *
+ * @warning
+ * Like vtkMergePoints, this class merges exactly coincident points and
+ * ignores the Tolerance.
+ *
+ * @sa
+ * vtkMergePoints vtkSMPMergePoints vtkIncrementalPointLocator
+ */
+
+#ifndef vtkConcurrentMergePoints_h
+#define vtkConcurrentMergePoints_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkMergePoints.h"
+
+#include <memory> // For std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONDATAMODEL_EXPORT vtkConcurrentMergePoints : public vtkMergePoints
+{
+public:
+  static vtkConcurrentMergePoints* New();
+  vtkTypeMacro(vtkConcurrentMergePoints, vtkMergePoints);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Initialize the point insertion process. Points pending from a previous
+   * insertion are written to their vtkPoints first.
+   */
+  int InitPointInsertion(vtkPoints* newPts, const double bounds[6]) override;
+  int InitPointInsertion(vtkPoints* newPts, const double bounds[6], vtkIdType estNumPts) override;
+  ///@}
+
+  ///@{
+  /**
+   * Determine whether point given by x[3] has been inserted into points list.
+   * Return id of previously inserted point if this is true, otherwise return
+   * -1. This method is thread safe.
+   */
+  vtkIdType IsInsertedPoint(const double x[3]) override;
+  vtkIdType IsInsertedPoint(double x, double y, double z) override
+  {
+    return this->vtkPointLocator::IsInsertedPoint(x, y, z);
+  }
+  ///@}
+
+  /**
+   * Insert a point unless it has already been inserted. Return 0 if the
+   * point was already in the list, otherwise return 1. In either case, the
+   * id of the point is returned in the ptId argument. This method is thread
+   * safe: concurrent insertions of the same point all return the same id.
+   */
+  int InsertUniquePoint(const double x[3], vtkIdType& ptId) override;
+
+  /**
+   * Insert a point without checking for duplicates and return its id. This
+   * method is thread safe.
+   */
+  vtkIdType InsertNextPoint(const double x[3]) override;
+
+  /**
+   * Insert a point with the given id, without checking for duplicates. This
+   * method is thread safe as long as ids are not reused.
+   */
+  void InsertPoint(vtkIdType ptId, const double x[3]) override;
+
+  /**
+   * Return the id of the closest point already inserted, or -1 if there is
+   * none. This method is thread safe.
+   */
+  vtkIdType FindClosestInsertedPoint(const double x[3]) override;
+
+  /**
+   * Return the number of points inserted so far.
+   */
+  vtkIdType GetNumberOfInsertedPoints() const;
+
+  /**
+   * Write the inserted points to the vtkPoints given to InitPointInsertion(),
+   * which is resized to the number of inserted points, and fill the buckets
+   * of vtkPointLocator (see GetPointsInBucket()). This must be called
+   * from a single thread once concurrent insertions are done. Insertion can
+   * resume afterwards.
+   */
+  void FinishPointInsertion();
+
+  ///@{
+  /**
+   * See vtkLocator interface documentation. Initialize() writes the pending
+   * points to their vtkPoints before releasing the search structure.
+   */
+  void Initialize() override;
+  void FreeSearchStructure() override;
+  ///@}
+
+protected:
+  vtkConcurrentMergePoints();
+  ~vtkConcurrentMergePoints() override;
+
+private:
+  vtkConcurrentMergePoints(const vtkConcurrentMergePoints&) = delete;
+  void operator=(const vtkConcurrentMergePoints&) = delete;
+
+  // Link a new node for x in a bucket and assign it a point id. If unique
+  // is true and x is found in the bucket, nothing is inserted and the id of
+  // the existing point is returned in ptId. ptId may also be an explicit id.
+  bool InsertNode(const double x[3], bool unique, bool explicitId, vtkIdType& ptId);
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
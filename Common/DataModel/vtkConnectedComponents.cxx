@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectedComponents.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkConnectedComponents.h"
+
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+void vtkConnectedComponents::Initialize(vtkIdType numberOfElements)
+{
+  if (numberOfElements != this->NumberOfElements || !this->Parents)
+  {
+    this->Parents.reset(new std::atomic<vtkIdType>[numberOfElements]);
+    this->NumberOfElements = numberOfElements;
+  }
+  vtkSMPTools::For(0, numberOfElements, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
+    {
+      this->Parents[id].store(id, std::memory_order_relaxed);
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkConnectedComponents::Label(vtkIdType* labels)
+{
+  const vtkIdType numElements = this->NumberOfElements;
+  vtkSMPTools::For(0, numElements, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
+    {
+      labels[id] = this->Parents[id].load(std::memory_order_relaxed) < 0 ? -1 : this->Find(id);
+    }
+  });
+
+  // Number the roots in blocks: count them, then offset each block by the
+  // roots of the previous ones. The numbers are stored in the parents of the
+  // roots, which are not needed anymore.
+  const vtkIdType blockSize = 65536;
+  const vtkIdType numBlocks = (numElements + blockSize - 1) / blockSize;
+  std::vector<vtkIdType> blockOffsets(numBlocks + 1, 0);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+    for (; block < endBlock; ++block)
+    {
+      const vtkIdType endId = std::min(numElements, (block + 1) * blockSize);
+      for (vtkIdType id = block * blockSize; id < endId; ++id)
+      {
+        blockOffsets[block + 1] += labels[id] == id ? 1 : 0;
+      }
+    }
+  });
+  for (vtkIdType block = 0; block < numBlocks; ++block)
+  {
+    blockOffsets[block + 1] += blockOffsets[block];
+  }
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+    for (; block < endBlock; ++block)
+    {
+      vtkIdType label = blockOffsets[block];
+      const vtkIdType endId = std::min(numElements, (block + 1) * blockSize);
+      for (vtkIdType id = block * blockSize; id < endId; ++id)
+      {
+        if (labels[id] == id)
+        {
+          this->Parents[id].store(label++, std::memory_order_relaxed);
+        }
+      }
+    }
+  });
+  vtkSMPTools::For(0, numElements, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
+    {
+      if (labels[id] >= 0)
+      {
+        labels[id] = this->Parents[labels[id]].load(std::memory_order_relaxed);
+      }
+    }
+  });
+  return blockOffsets[numBlocks];
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkConnectedComponents::LabelCells(
+  vtkDataSet* input, vtkIdType* cellLabels, vtkIdType* pointLabels)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  if (numCells < 1)
+  {
+    if (pointLabels)
+    {
+      std::fill_n(pointLabels, numPts, -1);
+    }
+    return 0;
+  }
+
+  // Build the cells if needed, so that GetCellPoints() is thread-safe.
+  vtkNew<vtkIdList> cellPointIds;
+  input->GetCellPoints(0, cellPointIds);
+
+  // Each point records the first cell that reaches it, and every other cell
+  // using the point is merged with that one.
+  std::unique_ptr<std::atomic<vtkIdType>[]> pointCells(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      pointCells[ptId].store(-1, std::memory_order_relaxed);
+    }
+  });
+  vtkConnectedComponents components;
+  components.Initialize(numCells);
+  vtkSMPThreadLocalObject<vtkIdList> localPointIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* ptIdList = localPointIds.Local();
+    const vtkIdType* pts = nullptr;
+    vtkIdType npts = 0;
+    for (; cellId < endCellId; ++cellId)
+    {
+      input->GetCellPoints(cellId, npts, pts, ptIdList);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        vtkIdType otherCellId = -1;
+        if (!pointCells[pts[i]].compare_exchange_strong(
+              otherCellId, cellId, std::memory_order_relaxed))
+        {
+          components.Union(cellId, otherCellId);
+        }
+      }
+    }
+  });
+
+  const vtkIdType numComponents = components.Label(cellLabels);
+  if (pointLabels)
+  {
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType cellId = pointCells[ptId].load(std::memory_order_relaxed);
+        pointLabels[ptId] = cellId < 0 ? -1 : cellLabels[cellId];
+      }
+    });
+  }
+  return numComponents;
+}
+VTK_ABI_NAMESPACE_END
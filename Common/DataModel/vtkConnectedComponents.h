@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectedComponents.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConnectedComponents
+ * @brief   parallel union-find labelling of connected components
+ *
+ * vtkConnectedComponents partitions a set of elements 0..n-1 into connected
+ * components. Pairs of connected elements are merged with Union(), which may
+ * be called concurrently from several threads: the structure is lock-free,
+ * and uses pointer jumping (path halving) to keep the trees shallow. The root
+ * of a component is always its smallest element, so Label() numbers the
+ * components in the order of their smallest element. This is the order in
+ * which a serial traversal seeded by increasing ids discovers them, which
+ * keeps the labels deterministic whatever the number of threads.
+ *
+ * LabelCells() applies it to the cells of a dataset connected through their
+ * points, as used by the connectivity filters.
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectedComponents_h
+#define vtkConnectedComponents_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkType.h"                  // For vtkIdType
+
+#include <atomic>  // For the parents
+#include <memory>  // For the parents
+#include <utility> // For std::swap
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataSet;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkConnectedComponents
+{
+public:
+  vtkConnectedComponents() = default;
+  ~vtkConnectedComponents() = default;
+
+  /**
+   * Make each of the given number of elements a component of its own.
+   */
+  void Initialize(vtkIdType numberOfElements);
+
+  /**
+   * Return the number of elements.
+   */
+  vtkIdType GetNumberOfElements() const { return this->NumberOfElements; }
+
+  /**
+   * Exclude an element from the components, before any call to Union()
+   * involving it. Excluded elements are labelled -1.
+   */
+  void Exclude(vtkIdType id) { this->Parents[id].store(-1, std::memory_order_relaxed); }
+
+  /**
+   * Return the smallest element of the component of an element. This method
+   * is thread-safe, including with concurrent calls to Union().
+   */
+  vtkIdType Find(vtkIdType id)
+  {
+    vtkIdType parent = this->Parents[id].load(std::memory_order_relaxed);
+    while (parent != id)
+    {
+      // Path halving: point the element to its grandparent.
+      vtkIdType grandParent = this->Parents[parent].load(std::memory_order_relaxed);
+      if (grandParent != parent)
+      {
+        this->Parents[id].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+      }
+      id = grandParent;
+      parent = this->Parents[id].load(std::memory_order_relaxed);
+    }
+    return id;
+  }
+
+  /**
+   * Merge the components of two elements. This method is thread-safe.
+   */
+  void Union(vtkIdType id0, vtkIdType id1)
+  {
+    for (;;)
+    {
+      id0 = this->Find(id0);
+      id1 = this->Find(id1);
+      if (id0 == id1)
+      {
+        return;
+      }
+      // Link the larger root to the smaller one, so that roots stay minimal.
+      if (id0 < id1)
+      {
+        std::swap(id0, id1);
+      }
+      vtkIdType expected = id0;
+      if (this->Parents[id0].compare_exchange_strong(expected, id1, std::memory_order_relaxed))
+      {
+        return;
+      }
+    }
+  }
+
+  /**
+   * Number the components 0, 1, ... in the order of their smallest element,
+   * and store the component of each element in labels, which must have room
+   * for GetNumberOfElements() values. Return the number of components. This
+   * method must not be called concurrently with Union(), and it reuses the
+   * storage of the components, so Initialize() must be called again before
+   * any other use.
+   */
+  vtkIdType Label(vtkIdType* labels);
+
+  /**
+   * Label the cells of a dataset connected through shared points, in the
+   * order of their smallest cell id. cellLabels must have room for the
+   * number of cells, and pointLabels, if not nullptr, for the number of
+   * points; points used by no cell are labelled -1. Return the number of
+   * components. The cells are visited in parallel, so for vtkPolyData the
+   * cells must be built, or built by this method from a single thread.
+   */
+  static vtkIdType LabelCells(vtkDataSet* input, vtkIdType* cellLabels, vtkIdType* pointLabels);
+
+private:
+  vtkConnectedComponents(const vtkConnectedComponents&) = delete;
+  void operator=(const vtkConnectedComponents&) = delete;
+
+  vtkIdType NumberOfElements = 0;
+  std::unique_ptr<std::atomic<vtkIdType>[]> Parents;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+// VTK-HeaderTest-Exclude: vtkConnectedComponents.h
@@ -21,12 +21,15 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkTypeInt64Array.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <deque>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 //------------------------------------------------------------------------------
@@ -131,6 +134,85 @@ double vtkHyperTree::GetScale(unsigned int d) const
   return scale[d];
 }
 
+//=============================================================================
+namespace
+{
+/**
+ * Recursive implementation used by ComputeBreadthFirstOrderDescriptor to
+ * compute per depth tree descriptor (`descriptorPerDepth`), its id mapping
+ * (`breadthFirstOrderIdMapPerDepth`) with the current tree.
+ *
+ * The descriptor is a binary array associated to each depth such that leaf vertices
+ * are mapped to zero, while non leaf vertices are mapped to one.
+ */
+void ComputeBreadthFirstOrderDescriptorImpl(vtkHyperTree* tree, vtkBitArray* inputMask, int depth,
+  vtkIdType index, std::vector<std::vector<bool>>& descriptorPerDepth,
+  std::vector<std::vector<vtkIdType>>& breadthFirstOrderIdMapPerDepth)
+{
+  vtkIdType idg = tree->GetGlobalIndexFromLocal(index);
+  bool mask = inputMask ? inputMask->GetValue(idg) : false;
+  breadthFirstOrderIdMapPerDepth[depth].emplace_back(idg);
+  if (!tree->IsLeaf(index) && !mask)
+  {
+    descriptorPerDepth[depth].push_back(true);
+    for (int iChild = 0; iChild < tree->GetNumberOfChildren(); ++iChild)
+    {
+      ComputeBreadthFirstOrderDescriptorImpl(tree, inputMask, depth + 1,
+        tree->GetElderChildIndex(index) + iChild, descriptorPerDepth,
+        breadthFirstOrderIdMapPerDepth);
+    }
+  }
+  else
+  {
+    descriptorPerDepth[depth].push_back(false);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Implementation of vtkHyperTree::ComputeBreadthFirstOrderDescriptor, which
+// only relies on the public interface of the tree.
+void ComputeBreadthFirstOrderDescriptor(vtkHyperTree* tree, vtkBitArray* inputMask,
+  vtkTypeInt64Array* numberOfVerticesPerDepth, vtkBitArray* descriptor,
+  vtkIdList* breadthFirstIdMap)
+{
+  int maxDepth = tree->GetNumberOfLevels();
+  std::vector<std::vector<bool>> descriptorPerDepth(maxDepth);
+  std::vector<std::vector<vtkIdType>> breadthFirstOrderIdMapPerDepth(maxDepth);
+
+  ComputeBreadthFirstOrderDescriptorImpl(
+    tree, inputMask, 0, 0, descriptorPerDepth, breadthFirstOrderIdMapPerDepth);
+
+  // Reducing maxDepth to squeeze out depths in which all subtrees are
+  // entirely masked.
+  while (maxDepth && breadthFirstOrderIdMapPerDepth[--maxDepth].empty())
+    ;
+
+  ++maxDepth;
+
+  for (int idepth = 0; idepth < maxDepth; ++idepth)
+  {
+    numberOfVerticesPerDepth->InsertNextValue(
+      static_cast<vtkTypeInt64>(breadthFirstOrderIdMapPerDepth[idepth].size()));
+    for (auto idg : breadthFirstOrderIdMapPerDepth[idepth])
+    {
+      breadthFirstIdMap->InsertNextId(idg);
+    }
+  }
+
+  // We ignore last depth for the descriptor, as we already know that no
+  // vertices have children.
+  // However, we are careful not treating trees with only one depth. There
+  // is no need to describe such trivial trees.
+  for (int idepth = 0; idepth < maxDepth - 1; ++idepth)
+  {
+    for (auto state : descriptorPerDepth[idepth])
+    {
+      descriptor->InsertNextValue(state);
+    }
+  }
+}
+}
+
 //=============================================================================
 struct vtkCompactHyperTreeData
 {
@@ -155,41 +237,8 @@ public:
     vtkTypeInt64Array* numberOfVerticesPerDepth, vtkBitArray* descriptor,
     vtkIdList* breadthFirstIdMap) override
   {
-    int maxDepth = this->GetNumberOfLevels();
-    std::vector<std::vector<bool>> descriptorPerDepth(maxDepth);
-    std::vector<std::vector<vtkIdType>> breadthFirstOrderIdMapPerDepth(maxDepth);
-
-    this->ComputeBreadthFirstOrderDescriptorImpl(
-      inputMask, 0, 0, descriptorPerDepth, breadthFirstOrderIdMapPerDepth);
-
-    // Reducing maxDepth to squeeze out depths in which all subtrees are
-    // entirely masked.
-    while (maxDepth && breadthFirstOrderIdMapPerDepth[--maxDepth].empty())
-      ;
-
-    ++maxDepth;
-
-    for (int idepth = 0; idepth < maxDepth; ++idepth)
-    {
-      numberOfVerticesPerDepth->InsertNextValue(
-        static_cast<vtkTypeInt64>(breadthFirstOrderIdMapPerDepth[idepth].size()));
-      for (auto idg : breadthFirstOrderIdMapPerDepth[idepth])
-      {
-        breadthFirstIdMap->InsertNextId(idg);
-      }
-    }
-
-    // We ignore last depth for the descriptor, as we already know that no
-    // vertices have children.
-    // However, we are careful not treating trees with only one depth. There
-    // is no need to describe such trivial trees.
-    for (int idepth = 0; idepth < maxDepth - 1; ++idepth)
-    {
-      for (auto state : descriptorPerDepth[idepth])
-      {
-        descriptor->InsertNextValue(state);
-      }
-    }
+    ::ComputeBreadthFirstOrderDescriptor(
+      this, inputMask, numberOfVerticesPerDepth, descriptor, breadthFirstIdMap);
   }
 
   //---------------------------------------------------------------------------
@@ -320,9 +369,12 @@ public:
   }
 
   //---------------------------------------------------------------------------
-  vtkHyperTree* Freeze(const char* vtkNotUsed(mode)) override
+  vtkHyperTree* Freeze(const char* mode) override
   {
-    // Option not used
+    if (mode && !strcmp(mode, "Packed"))
+    {
+      return this->FreezePacked(nullptr);
+    }
     return this;
   }
 
@@ -553,49 +605,443 @@ protected:
     this->CompactDatas = htp->CompactDatas;
   }
 
-  /**
-   * Recursive implementation used by ComputeBreadthFirstOrderDescriptor to
-   * compute per depth tree descriptor (`descriptorPerDepth`), its id mapping
-   * (`breadthFirstOrderIdMapPerDepth`) with the current tree.
-   *
-   * The descriptor is a binary array associated to each depth such that leaf vertices
-   * are mapped to zero, while non leaf vertices are mapped to one.
-   */
-  void ComputeBreadthFirstOrderDescriptorImpl(vtkBitArray* inputMask, int depth, vtkIdType index,
-    std::vector<std::vector<bool>>& descriptorPerDepth,
-    std::vector<std::vector<vtkIdType>>& breadthFirstOrderIdMapPerDepth)
-  {
-    vtkIdType idg = this->GetGlobalIndexFromLocal(index);
-    bool mask = inputMask ? inputMask->GetValue(idg) : false;
-    breadthFirstOrderIdMapPerDepth[depth].emplace_back(idg);
-    if (!this->IsLeaf(index) && !mask)
-    {
-      descriptorPerDepth[depth].push_back(true);
-      for (int iChild = 0; iChild < this->NumberOfChildren; ++iChild)
+  //---------------------------------------------------------------------------
+  std::shared_ptr<vtkCompactHyperTreeData> CompactDatas;
+
+private:
+  vtkCompactHyperTree(const vtkCompactHyperTree&) = delete;
+  void operator=(const vtkCompactHyperTree&) = delete;
+};
+
+//------------------------------------------------------------------------------
+vtkStandardNewMacro(vtkCompactHyperTree);
+
+//=============================================================================
+namespace
+{
+inline vtkIdType PopCount(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<vtkIdType>(__builtin_popcountll(word));
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<vtkIdType>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+}
+
+//=============================================================================
+struct vtkPackedHyperTreeData
+{
+  // Storage of the refinement of the vertices of several trees, one bit per
+  // vertex set if the vertex is coarse. The vertices of each tree are stored
+  // contiguously in breadth-first order, trailing leaves being omitted.
+  std::vector<uint64_t> Bits;
+
+  // Number of set bits preceding each word of Bits
+  std::vector<vtkIdType> Ranks;
+
+  vtkIdType NumberOfBits = 0;
+  vtkIdType NumberOfSetBits = 0;
+
+  // Storage to record the explicit local to global id mappings of the trees
+  std::vector<vtkIdType> GlobalIndexTable_stl;
+
+  void AppendBit(bool bit)
+  {
+    if ((this->NumberOfBits & 63) == 0)
+    {
+      this->Bits.emplace_back(0);
+      this->Ranks.emplace_back(this->NumberOfSetBits);
+    }
+    if (bit)
+    {
+      this->Bits.back() |= uint64_t(1) << (this->NumberOfBits & 63);
+      ++this->NumberOfSetBits;
+    }
+    ++this->NumberOfBits;
+  }
+
+  bool GetBit(vtkIdType index) const { return (this->Bits[index >> 6] >> (index & 63)) & 1; }
+
+  // Number of set bits preceding the bit at index
+  vtkIdType Rank(vtkIdType index) const
+  {
+    const uint64_t word = this->Bits[index >> 6] & ((uint64_t(1) << (index & 63)) - 1);
+    return this->Ranks[index >> 6] + PopCount(word);
+  }
+};
+
+//=============================================================================
+// Frozen hypertree whose vertices are numbered in breadth-first order, so that
+// the children of the coarse vertices are allocated in the same order as
+// their parents. Its structure then reduces to the refinement bit of each
+// vertex, the elder child of the n-th coarse vertex being 1 + n * f^d.
+class vtkPackedHyperTree : public vtkHyperTree
+{
+public:
+  vtkTemplateTypeMacro(vtkPackedHyperTree, vtkHyperTree);
+
+  //---------------------------------------------------------------------------
+  static vtkPackedHyperTree* New();
+
+  //---------------------------------------------------------------------------
+  // Description:
+  // Append the structure of ht to the packed storage of sibling, or to a
+  // new storage if sibling is nullptr. Return false, leaving the storage
+  // untouched, if ht is not numbered in breadth-first order.
+  bool Pack(vtkHyperTree* ht, vtkPackedHyperTree* sibling)
+  {
+    const vtkIdType numberOfVertices = ht->GetNumberOfVertices();
+    const vtkIdType numberOfChildren = ht->GetNumberOfChildren();
+    vtkIdType numberOfBits = 0;
+    vtkIdType numberOfCoarseVertices = 0;
+    for (vtkIdType index = 0; index < numberOfVertices; ++index)
+    {
+      if (!ht->IsLeaf(index))
       {
-        this->ComputeBreadthFirstOrderDescriptorImpl(inputMask, depth + 1,
-          this->GetElderChildIndex(index) + iChild, descriptorPerDepth,
-          breadthFirstOrderIdMapPerDepth);
+        if (ht->GetElderChildIndex(static_cast<unsigned int>(index)) !=
+          1 + numberOfChildren * numberOfCoarseVertices)
+        {
+          return false;
+        }
+        ++numberOfCoarseVertices;
+        numberOfBits = index + 1;
       }
     }
-    else
+
+    const std::vector<vtkIdType>* globalIndexTable = nullptr;
+    std::vector<vtkIdType> packedGlobalIndexTable;
+    if (ht->GetGlobalIndexStart() < 0)
     {
-      descriptorPerDepth[depth].push_back(false);
+      if (vtkCompactHyperTree* compact = vtkCompactHyperTree::SafeDownCast(ht))
+      {
+        globalIndexTable = &compact->GetGlobalIndexTable();
+      }
+      else if (vtkPackedHyperTree* packed = vtkPackedHyperTree::SafeDownCast(ht))
+      {
+        for (vtkIdType index = 0; index < packed->GlobalIndexTableSize; ++index)
+        {
+          packedGlobalIndexTable.emplace_back(packed->GetGlobalIndexFromLocal(index));
+        }
+        globalIndexTable = &packedGlobalIndexTable;
+      }
+      else
+      {
+        return false;
+      }
     }
+
+    this->PackedDatas =
+      sibling ? sibling->PackedDatas : std::make_shared<vtkPackedHyperTreeData>();
+    this->BitOffset = this->PackedDatas->NumberOfBits;
+    this->RankOffset = this->PackedDatas->NumberOfSetBits;
+    this->NumberOfBits = numberOfBits;
+    for (vtkIdType index = 0; index < numberOfBits; ++index)
+    {
+      this->PackedDatas->AppendBit(!ht->IsLeaf(index));
+    }
+    this->GlobalIndexTableOffset = -1;
+    this->GlobalIndexTableSize = 0;
+    if (globalIndexTable && !globalIndexTable->empty())
+    {
+      std::vector<vtkIdType>& table = this->PackedDatas->GlobalIndexTable_stl;
+      this->GlobalIndexTableOffset = static_cast<vtkIdType>(table.size());
+      this->GlobalIndexTableSize = static_cast<vtkIdType>(globalIndexTable->size());
+      table.insert(table.end(), globalIndexTable->begin(), globalIndexTable->end());
+    }
+
+    this->BranchFactor = ht->GetBranchFactor();
+    this->Dimension = ht->GetDimension();
+    this->NumberOfChildren = ht->GetNumberOfChildren();
+    this->Datas->TreeIndex = ht->GetTreeIndex();
+    this->Datas->NumberOfLevels = ht->GetNumberOfLevels();
+    this->Datas->NumberOfVertices = numberOfVertices;
+    this->Datas->NumberOfNodes = numberOfCoarseVertices;
+    this->Datas->GlobalIndexStart = ht->GetGlobalIndexStart();
+    if (ht->HasScales())
+    {
+      this->Scales = ht->GetScales();
+    }
+    return true;
   }
 
   //---------------------------------------------------------------------------
-  std::shared_ptr<vtkCompactHyperTreeData> CompactDatas;
+  bool SharesStorage(const vtkPackedHyperTree* ht) const
+  {
+    return this->PackedDatas == ht->PackedDatas;
+  }
+
+  //---------------------------------------------------------------------------
+  void ComputeBreadthFirstOrderDescriptor(vtkBitArray* inputMask,
+    vtkTypeInt64Array* numberOfVerticesPerDepth, vtkBitArray* descriptor,
+    vtkIdList* breadthFirstIdMap) override
+  {
+    ::ComputeBreadthFirstOrderDescriptor(
+      this, inputMask, numberOfVerticesPerDepth, descriptor, breadthFirstIdMap);
+  }
+
+  //---------------------------------------------------------------------------
+  void BuildFromBreadthFirstOrderDescriptor(vtkBitArray* vtkNotUsed(descriptor),
+    vtkIdType vtkNotUsed(numberOfBits), vtkIdType vtkNotUsed(startIndex)) override
+  {
+    vtkErrorMacro("Cannot modify a packed hypertree.");
+  }
+
+  //---------------------------------------------------------------------------
+  void InitializeForReader(vtkIdType vtkNotUsed(numberOfLevels), vtkIdType vtkNotUsed(nbVertices),
+    vtkIdType vtkNotUsed(nbVerticesOfLastdepth), vtkBitArray* vtkNotUsed(isParent),
+    vtkBitArray* vtkNotUsed(isMasked), vtkBitArray* vtkNotUsed(outIsMasked)) override
+  {
+    vtkErrorMacro("Cannot modify a packed hypertree.");
+  }
+
+  //---------------------------------------------------------------------------
+  vtkHyperTree* Freeze(const char* vtkNotUsed(mode)) override { return this; }
+
+  //---------------------------------------------------------------------------
+  ~vtkPackedHyperTree() override = default;
+
+  //---------------------------------------------------------------------------
+  bool IsGlobalIndexImplicit() override { return this->Datas->GlobalIndexStart == -1; }
+
+  //---------------------------------------------------------------------------
+  void SetGlobalIndexStart(vtkIdType start) override
+  {
+    assert("pre: not_global_index_start_if_use_global_index_from_local" &&
+      this->GlobalIndexTableSize == 0);
+
+    this->Datas->GlobalIndexStart = start;
+  }
+
+  //---------------------------------------------------------------------------
+  void SetGlobalIndexFromLocal(vtkIdType index, vtkIdType global) override
+  {
+    // The packed global index table cannot grow, existing entries only can
+    // be overwritten.
+    if (index < 0 || index >= this->GlobalIndexTableSize)
+    {
+      vtkErrorMacro("Cannot extend the global index mapping of a packed hypertree.");
+      return;
+    }
+    this->PackedDatas->GlobalIndexTable_stl[this->GlobalIndexTableOffset + index] = global;
+  }
+
+  //---------------------------------------------------------------------------
+  vtkIdType GetGlobalIndexFromLocal(vtkIdType index) const override
+  {
+    if (this->GlobalIndexTableSize)
+    {
+      // Case explicit global node index
+      assert("pre: not_valid_index" && index >= 0 && index < this->GlobalIndexTableSize);
+      assert("pre: not_positive_global_index" &&
+        this->PackedDatas->GlobalIndexTable_stl[this->GlobalIndexTableOffset + index] >= 0);
+      return this->PackedDatas->GlobalIndexTable_stl[this->GlobalIndexTableOffset + index];
+    }
+    // Case implicit global node index
+    assert("pre: not_positive_start_index" && this->Datas->GlobalIndexStart >= 0);
+    assert("pre: not_valid_index" && index >= 0);
+    return this->Datas->GlobalIndexStart + index;
+  }
+
+  //---------------------------------------------------------------------------
+  vtkIdType GetGlobalNodeIndexMax() const override
+  {
+    if (this->GlobalIndexTableSize)
+    {
+      // Case explicit global node index
+      const auto it_begin =
+        this->PackedDatas->GlobalIndexTable_stl.begin() + this->GlobalIndexTableOffset;
+      return *std::max_element(it_begin, it_begin + this->GlobalIndexTableSize);
+    }
+    // Case implicit global node index
+    assert("pre: not_positive_start_index" && this->Datas->GlobalIndexStart >= 0);
+    return this->Datas->GlobalIndexStart + this->Datas->NumberOfVertices - 1;
+  }
+
+  //---------------------------------------------------------------------------
+  vtkIdType GetElderChildIndex(unsigned int index_parent) const override
+  {
+    assert("pre: valid_range" &&
+      index_parent < static_cast<unsigned int>(this->Datas->NumberOfVertices));
+    if (this->IsLeaf(index_parent))
+    {
+      return std::numeric_limits<unsigned int>::max();
+    }
+    return 1 +
+      this->NumberOfChildren *
+      (this->PackedDatas->Rank(this->BitOffset + index_parent) - this->RankOffset);
+  }
+
+  //---------------------------------------------------------------------------
+  // Description:
+  // The elder child index array is not stored by packed trees: it is only
+  // built, once, if this method gets called.
+  const unsigned int* GetElderChildIndexArray(size_t& nbElements) const override
+  {
+    if (!this->ElderChildIndexArrayBuilt.load(std::memory_order_acquire))
+    {
+      std::lock_guard<std::mutex> lock(this->ElderChildIndexArrayMutex);
+      if (!this->ElderChildIndexArrayBuilt.load(std::memory_order_relaxed))
+      {
+        this->ElderChildIndexArray.resize(this->NumberOfBits);
+        for (vtkIdType index = 0; index < this->NumberOfBits; ++index)
+        {
+          this->ElderChildIndexArray[index] =
+            static_cast<unsigned int>(this->GetElderChildIndex(static_cast<unsigned int>(index)));
+        }
+        this->ElderChildIndexArrayBuilt.store(true, std::memory_order_release);
+      }
+    }
+    nbElements = this->ElderChildIndexArray.size();
+    return this->ElderChildIndexArray.data();
+  }
+
+  //---------------------------------------------------------------------------
+  void SubdivideLeaf(vtkIdType vtkNotUsed(index), unsigned int vtkNotUsed(depth)) override
+  {
+    vtkErrorMacro("Cannot modify a packed hypertree.");
+  }
+
+  //---------------------------------------------------------------------------
+  unsigned long GetActualMemorySizeBytes() override
+  {
+    // in bytes, counting the share of this tree in the packed storage
+    return static_cast<unsigned long>((this->NumberOfBits + 7) / 8 +
+      sizeof(vtkIdType) * ((this->NumberOfBits + 63) / 64) +
+      sizeof(vtkIdType) * this->GlobalIndexTableSize +
+      sizeof(unsigned int) * this->ElderChildIndexArray.size() + 3 * sizeof(unsigned char) +
+      10 * sizeof(vtkIdType));
+  }
+
+  //---------------------------------------------------------------------------
+  bool IsTerminalNode(vtkIdType index) const override
+  {
+    assert("pre: valid_range" && index >= 0 && index < this->Datas->NumberOfVertices);
+    if (this->IsLeaf(index))
+    {
+      return false;
+    }
+
+    const vtkIdType elder = this->GetElderChildIndex(static_cast<unsigned int>(index));
+    for (unsigned int ichild = 0; ichild < this->NumberOfChildren; ++ichild)
+    {
+      if (!this->IsLeaf(elder + ichild))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //---------------------------------------------------------------------------
+  bool IsLeaf(vtkIdType index) const override
+  {
+    assert("pre: valid_range" && index >= 0 && index < this->Datas->NumberOfVertices);
+    return index >= this->NumberOfBits || !this->PackedDatas->GetBit(this->BitOffset + index);
+  }
+
+protected:
+  //---------------------------------------------------------------------------
+  vtkPackedHyperTree() { this->InitializePrivate(); }
+
+  //---------------------------------------------------------------------------
+  void InitializePrivate() override
+  {
+    // A single leaf at the root, in a storage of its own
+    this->PackedDatas = std::make_shared<vtkPackedHyperTreeData>();
+    this->BitOffset = 0;
+    this->RankOffset = 0;
+    this->NumberOfBits = 0;
+    this->GlobalIndexTableOffset = -1;
+    this->GlobalIndexTableSize = 0;
+    this->ElderChildIndexArray.clear();
+    this->ElderChildIndexArrayBuilt = false;
+  }
+
+  //---------------------------------------------------------------------------
+  void PrintSelfPrivate(ostream& os, vtkIndent indent) override
+  {
+    os << indent << "BitOffset: " << this->BitOffset << endl;
+    os << indent << "NumberOfBits: " << this->NumberOfBits << endl;
+    for (vtkIdType i = 0; i < this->NumberOfBits; ++i)
+    {
+      os << this->PackedDatas->GetBit(this->BitOffset + i);
+    }
+    os << endl;
+
+    os << indent << "GlobalIndexTable: ";
+    for (vtkIdType i = 0; i < this->GlobalIndexTableSize; ++i)
+    {
+      os << " " << this->PackedDatas->GlobalIndexTable_stl[this->GlobalIndexTableOffset + i];
+    }
+    os << endl;
+  }
+
+  //---------------------------------------------------------------------------
+  void CopyStructurePrivate(vtkHyperTree* ht) override
+  {
+    assert("pre: ht_exists" && ht != nullptr);
+    vtkPackedHyperTree* htp = vtkPackedHyperTree::SafeDownCast(ht);
+    assert("pre: same_type" && htp != nullptr);
+    this->PackedDatas = htp->PackedDatas;
+    this->BitOffset = htp->BitOffset;
+    this->RankOffset = htp->RankOffset;
+    this->NumberOfBits = htp->NumberOfBits;
+    this->GlobalIndexTableOffset = htp->GlobalIndexTableOffset;
+    this->GlobalIndexTableSize = htp->GlobalIndexTableSize;
+  }
+
+  //---------------------------------------------------------------------------
+  std::shared_ptr<vtkPackedHyperTreeData> PackedDatas;
+
+  // Position of the first vertex of this tree in the packed storage, and
+  // number of coarse vertices stored before it
+  vtkIdType BitOffset;
+  vtkIdType RankOffset;
+
+  // Number of vertices stored, up to the last coarse vertex
+  vtkIdType NumberOfBits;
+
+  // Range of the explicit global index mapping in the packed storage
+  vtkIdType GlobalIndexTableOffset;
+  vtkIdType GlobalIndexTableSize;
+
+  // Built on demand by GetElderChildIndexArray
+  mutable std::vector<unsigned int> ElderChildIndexArray;
+  mutable std::atomic<bool> ElderChildIndexArrayBuilt;
+  mutable std::mutex ElderChildIndexArrayMutex;
 
 private:
-  vtkCompactHyperTree(const vtkCompactHyperTree&) = delete;
-  void operator=(const vtkCompactHyperTree&) = delete;
+  vtkPackedHyperTree(const vtkPackedHyperTree&) = delete;
+  void operator=(const vtkPackedHyperTree&) = delete;
 };
 
 //------------------------------------------------------------------------------
-vtkStandardNewMacro(vtkCompactHyperTree);
+vtkStandardNewMacro(vtkPackedHyperTree);
 //=============================================================================
 
+vtkHyperTree* vtkHyperTree::FreezePacked(vtkHyperTree* sibling)
+{
+  vtkPackedHyperTree* packedSibling = vtkPackedHyperTree::SafeDownCast(sibling);
+  vtkPackedHyperTree* packed = vtkPackedHyperTree::SafeDownCast(this);
+  if (packed && (!packedSibling || packed->SharesStorage(packedSibling)))
+  {
+    return this;
+  }
+
+  vtkPackedHyperTree* ht = vtkPackedHyperTree::New();
+  if (!ht->Pack(this, packedSibling))
+  {
+    ht->Delete();
+    return this;
+  }
+  return ht;
+}
+
+//------------------------------------------------------------------------------
 vtkHyperTree* vtkHyperTree::CreateInstance(unsigned char factor, unsigned char dimension)
 {
   if (factor < 2 || 3 < factor)
@@ -288,11 +288,28 @@ public:
    * Return a freeze instance (a priori compact but potentially
    * unmodifiable).
    * This method is calling by the Squeeze method of hypertree grid.
-   * The mode parameter will allow to propose different instances.
-   * Today, there is none, the freeze call does not do anything.
+   * The mode parameter will allow to propose different instances:
+   * with the "Packed" mode, a packed instance is returned (see
+   * FreezePacked), otherwise the freeze call does not do anything.
    */
   virtual vtkHyperTree* Freeze(const char* mode) = 0;
 
+  /**
+   * Return a frozen, unmodifiable, instance of this tree whose refinement
+   * is stored as one bit per vertex in a packed storage. This storage is
+   * shared with the tree `sibling` if it is itself a packed tree, which
+   * allows all the trees of an hypertree grid to be stored in a single
+   * breadth-first bit array (see vtkHyperTreeGrid::Squeeze).
+   * The elder child of a vertex is then computed from the number of coarse
+   * vertices preceding it, which requires the vertices of the tree to be
+   * numbered in breadth-first order, as done by the readers and by
+   * BuildFromBreadthFirstOrderDescriptor.
+   * Return this tree if it cannot be packed or if it already is packed in
+   * the storage of `sibling`, otherwise return a new instance that must be
+   * released by the caller.
+   */
+  vtkHyperTree* FreezePacked(vtkHyperTree* sibling);
+
   ///@{
   /**
    * Set/Get tree index in hypertree grid.
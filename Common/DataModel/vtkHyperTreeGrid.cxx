@@ -49,6 +49,7 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <deque>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -210,7 +211,7 @@ void vtkHyperTreeGrid::Initialize()
   this->HyperTrees.clear();
 
   // Default state
-  this->ModeSqueeze = nullptr;
+  this->SetModeSqueeze(nullptr);
   this->FreezeState = false;
 
   // Grid topology
@@ -307,17 +308,25 @@ void vtkHyperTreeGrid::Squeeze()
 {
   if (!this->FreezeState)
   {
+    // In packed mode, all trees share the storage of the first packed one
+    const bool packed = this->ModeSqueeze && !strcmp(this->ModeSqueeze, "Packed");
+    vtkHyperTree* sibling = nullptr;
     vtkHyperTreeGridIterator itIn;
     InitializeTreeIterator(itIn);
     vtkIdType indexIn;
     while (vtkHyperTree* ht = itIn.GetNextTree(indexIn))
     {
-      vtkHyperTree* htfreeze = ht->Freeze(this->GetModeSqueeze());
+      vtkHyperTree* htfreeze =
+        packed ? ht->FreezePacked(sibling) : ht->Freeze(this->GetModeSqueeze());
       if (htfreeze != ht)
       {
         this->SetTree(indexIn, htfreeze);
         htfreeze->UnRegister(this);
       }
+      if (htfreeze != ht || !sibling)
+      {
+        sibling = htfreeze;
+      }
     }
     this->FreezeState = true;
   }
@@ -458,7 +467,7 @@ void vtkHyperTreeGrid::CopyEmptyStructure(vtkDataObject* ds)
   }
 
   // Copy grid parameters
-  this->ModeSqueeze = htg->ModeSqueeze;
+  this->SetModeSqueeze(htg->ModeSqueeze);
   this->FreezeState = htg->FreezeState;
   this->BranchFactor = htg->BranchFactor;
   this->Dimension = htg->Dimension;
@@ -500,7 +509,7 @@ void vtkHyperTreeGrid::CopyStructure(vtkDataObject* ds)
   }
 
   // Copy grid parameters
-  this->ModeSqueeze = htg->ModeSqueeze;
+  this->SetModeSqueeze(htg->ModeSqueeze);
   this->FreezeState = htg->FreezeState;
   this->BranchFactor = htg->BranchFactor;
   this->Dimension = htg->Dimension;
@@ -525,7 +534,7 @@ void vtkHyperTreeGrid::CopyStructure(vtkDataObject* ds)
 
   for (auto it = htg->HyperTrees.begin(); it != htg->HyperTrees.end(); ++it)
   {
-    vtkHyperTree* tree = vtkHyperTree::CreateInstance(this->BranchFactor, this->Dimension);
+    vtkHyperTree* tree = it->second->NewInstance();
     assert("pre: same_type" && tree != nullptr);
     tree->CopyStructure(it->second);
     this->HyperTrees[it->first] = tree;
@@ -1190,7 +1199,7 @@ void vtkHyperTreeGrid::DeepCopy(vtkDataObject* src)
   assert("pre: same_type" && htg != nullptr);
 
   // Copy grid parameters
-  this->ModeSqueeze = htg->ModeSqueeze;
+  this->SetModeSqueeze(htg->ModeSqueeze);
   this->FreezeState = htg->FreezeState;
   this->Dimension = htg->Dimension;
   this->Orientation = htg->Orientation;
@@ -1254,7 +1263,7 @@ void vtkHyperTreeGrid::DeepCopy(vtkDataObject* src)
 
   for (auto it = htg->HyperTrees.begin(); it != htg->HyperTrees.end(); ++it)
   {
-    vtkHyperTree* tree = vtkHyperTree::CreateInstance(this->BranchFactor, this->Dimension);
+    vtkHyperTree* tree = it->second->NewInstance();
     assert("pre: same_type" && tree != nullptr);
     tree->CopyStructure(it->second);
     this->HyperTrees[it->first] = tree;
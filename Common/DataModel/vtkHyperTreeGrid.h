@@ -115,13 +115,19 @@ public:
   static constexpr vtkIdType InvalidIndex = ~0;
 
   /**
-   * Set/Get mode squeeze
+   * Set/Get mode squeeze.
+   * With the "Packed" mode, Squeeze stores the refinement of all the trees
+   * in a single packed bit array, one bit per vertex, instead of one array
+   * of elder child indices per tree. Packed trees are then unmodifiable.
+   * Trees whose vertices are not numbered in breadth-first order are not
+   * packed.
    */
   vtkSetStringMacro(ModeSqueeze); // By copy
   vtkGetStringMacro(ModeSqueeze);
 
   /**
    * Squeeze this representation.
+   * See SetModeSqueeze.
    */
   virtual void Squeeze();
 
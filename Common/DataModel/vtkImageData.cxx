@@ -34,6 +34,8 @@
 #include "vtkVertex.h"
 #include "vtkVoxel.h"
 
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageData);
 vtkStandardExtendedNewMacro(vtkImageData);
@@ -1227,6 +1229,149 @@ int vtkImageData::ComputeStructuredCoordinates(const double x[3], int ijk[3], do
   return isInBounds;
 }
 
+//------------------------------------------------------------------------------
+// Same as the single point version, one axis at a time so that the inner
+// loops only involve arithmetic on contiguous arrays.
+vtkIdType vtkImageData::ComputeStructuredCoordinates(
+  vtkIdType numPts, const double* x, int* ijk, double* pcoords, unsigned char* inBounds)
+{
+  // tolerance is needed for floating points error margin
+  // (this is squared tolerance)
+  const double tol2 = 1e-12;
+
+  const double* matrix = this->PhysicalToIndexMatrix->GetData();
+  const int* extent = this->Extent;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const double* row = matrix + 4 * axis;
+    const int minExt = extent[axis * 2];
+    const int maxExt = extent[axis * 2 + 1];
+    int* axisIjk = ijk + axis * numPts;
+    double* axisPCoords = pcoords + axis * numPts;
+
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      const double* pt = x + 3 * i;
+      const double loc = row[0] * pt[0] + row[1] * pt[1] + row[2] * pt[2] + row[3];
+      int idx = vtkMath::Floor(loc);
+      double pcoord = loc - idx;
+
+      unsigned char tmpInBounds = 1;
+      if (minExt == maxExt || idx < minExt)
+      {
+        const double dist = loc - minExt;
+        tmpInBounds = (dist * dist <= tol2);
+        if (tmpInBounds)
+        {
+          pcoord = 0.0;
+          idx = minExt;
+        }
+      }
+      else if (idx >= maxExt)
+      {
+        const double dist = loc - maxExt;
+        tmpInBounds = (dist * dist <= tol2);
+        if (tmpInBounds)
+        {
+          pcoord = 1.0;
+          idx = maxExt - 1;
+        }
+      }
+
+      axisIjk[i] = idx;
+      axisPCoords[i] = pcoord;
+      inBounds[i] = (axis == 0 ? tmpInBounds : (inBounds[i] & tmpInBounds));
+    }
+  }
+
+  vtkIdType numInBounds = 0;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    numInBounds += inBounds[i];
+  }
+  return numInBounds;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkImageData::FindCells(vtkIdType numPts, const double* x, double tol2,
+  vtkIdType* cellIds, double* pcoords, double* weights)
+{
+  std::vector<int> ijk(3 * numPts);
+  std::vector<double> localPCoords;
+  if (!pcoords)
+  {
+    localPCoords.resize(3 * numPts);
+    pcoords = localPCoords.data();
+  }
+  std::vector<unsigned char> inBounds(numPts);
+  this->ComputeStructuredCoordinates(numPts, x, ijk.data(), pcoords, inBounds.data());
+
+  int* iIdx = ijk.data();
+  int* jIdx = iIdx + numPts;
+  int* kIdx = jIdx + numPts;
+  double* r = pcoords;
+  double* s = r + numPts;
+  double* t = s + numPts;
+  const int* extent = this->Extent;
+  const double* spacing = this->Spacing;
+  vtkIdType numFound = 0;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    int idx[3] = { iIdx[i], jIdx[i], kIdx[i] };
+    if (!inBounds[i])
+    {
+      // If voxel index is out of bounds, check point against the bounds to
+      // see if within tolerance of the bounds, as FindCell() does.
+      double pc[3] = { r[i], s[i], t[i] };
+      double dist2 = 0.0;
+      for (int axis = 0; axis < 3; axis++)
+      {
+        const int minIdx = extent[axis * 2];
+        const int maxIdx = extent[axis * 2 + 1];
+        if (idx[axis] < minIdx)
+        {
+          const double dist = (idx[axis] + pc[axis] - minIdx) * spacing[axis];
+          idx[axis] = minIdx;
+          pc[axis] = 0.0;
+          dist2 += dist * dist;
+        }
+        else if (idx[axis] >= maxIdx)
+        {
+          const double dist = (idx[axis] + pc[axis] - maxIdx) * spacing[axis];
+          if (maxIdx == minIdx)
+          {
+            idx[axis] = minIdx;
+            pc[axis] = 0.0;
+          }
+          else
+          {
+            idx[axis] = maxIdx - 1;
+            pc[axis] = 1.0;
+          }
+          dist2 += dist * dist;
+        }
+      }
+      if (dist2 > tol2)
+      {
+        cellIds[i] = -1;
+        continue;
+      }
+      r[i] = pc[0];
+      s[i] = pc[1];
+      t[i] = pc[2];
+    }
+    cellIds[i] = vtkStructuredData::ComputeCellIdForExtent(extent, idx);
+    ++numFound;
+  }
+
+  vtkStructuredData::GetCellParametricCoordinates(this->DataDescription, numPts, pcoords);
+  if (weights)
+  {
+    vtkVoxel::InterpolationFunctions(numPts, pcoords, weights);
+  }
+  return numFound;
+}
+
 //------------------------------------------------------------------------------
 void vtkImageData::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -196,6 +196,31 @@ public:
    */
   virtual int ComputeStructuredCoordinates(const double x[3], int ijk[3], double pcoords[3]);
 
+  /**
+   * Batch version of ComputeStructuredCoordinates() for numPts points whose
+   * coordinates are interleaved in x. ijk and pcoords use a
+   * structure-of-arrays layout: ijk[c * numPts + i] and pcoords[c * numPts + i]
+   * are the c-th structured and parametric coordinates of point i. inBounds[i]
+   * is set to 1 if point i is inside of the volume, 0 otherwise. Returns the
+   * number of points inside of the volume. This method is thread safe.
+   */
+  vtkIdType ComputeStructuredCoordinates(
+    vtkIdType numPts, const double* x, int* ijk, double* pcoords, unsigned char* inBounds);
+
+  /**
+   * Batch version of FindCell() for numPts points whose coordinates are
+   * interleaved in x. cellIds[i] is set to the id of the cell containing
+   * point i, or -1 if there is none. If not null, pcoords and weights receive
+   * the parametric coordinates and the 8 voxel interpolation weights of each
+   * point in a structure-of-arrays layout (see
+   * vtkVoxel::InterpolationFunctions()). Parametric coordinates are expressed
+   * in the frame of the returned cell, so that the first weights match its
+   * points. tol2 has the same meaning as in FindCell(). Returns the number of
+   * points found. This method is thread safe.
+   */
+  virtual vtkIdType FindCells(vtkIdType numPts, const double* x, double tol2, vtkIdType* cellIds,
+    double* pcoords = nullptr, double* weights = nullptr);
+
   /**
    * Given structured coordinates (i,j,k) for a voxel cell, compute the eight
    * gradient values for the voxel corners. The order in which the gradient
@@ -33,8 +33,29 @@
 #include "vtkVertex.h"
 #include "vtkVoxel.h"
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkRectilinearGrid);
+
+//------------------------------------------------------------------------------
+struct vtkRectilinearGrid::vtkCoordinates
+{
+  std::vector<double> Coordinates[3];
+  bool Increasing = true;
+};
+
+//------------------------------------------------------------------------------
+struct vtkRectilinearGrid::vtkCoordinateCache
+{
+  std::mutex Lock;
+  std::shared_ptr<const vtkCoordinates> Coordinates;
+  vtkTimeStamp BuildTime;
+};
+
 vtkStandardExtendedNewMacro(vtkRectilinearGrid);
 
 vtkCxxSetObjectMacro(vtkRectilinearGrid, XCoordinates, vtkDataArray);
@@ -48,6 +69,7 @@ vtkRectilinearGrid::vtkRectilinearGrid()
   this->Line = vtkLine::New();
   this->Pixel = vtkPixel::New();
   this->Voxel = vtkVoxel::New();
+  this->CoordinateCache = new vtkCoordinateCache;
 
   this->Dimensions[0] = 0;
   this->Dimensions[1] = 0;
@@ -86,6 +108,7 @@ vtkRectilinearGrid::~vtkRectilinearGrid()
   this->Line->Delete();
   this->Pixel->Delete();
   this->Voxel->Delete();
+  delete this->CoordinateCache;
 }
 
 //------------------------------------------------------------------------------
@@ -1217,6 +1240,203 @@ int vtkRectilinearGrid::ComputeStructuredCoordinates(double x[3], int ijk[3], do
   return 1;
 }
 
+//------------------------------------------------------------------------------
+std::shared_ptr<const vtkRectilinearGrid::vtkCoordinates> vtkRectilinearGrid::GetCoordinates()
+{
+  vtkDataArray* scalars[3] = { this->XCoordinates, this->YCoordinates, this->ZCoordinates };
+  vtkMTimeType mtime = this->MTime.GetMTime();
+  for (vtkDataArray* array : scalars)
+  {
+    mtime = std::max(mtime, array ? array->GetMTime() : 0);
+  }
+
+  vtkCoordinateCache& cache = *this->CoordinateCache;
+  std::lock_guard<std::mutex> lock(cache.Lock);
+  if (!cache.Coordinates || mtime > cache.BuildTime.GetMTime())
+  {
+    // Build a new copy rather than updating the current one in place, since
+    // other threads may still be searching it.
+    auto coords = std::make_shared<vtkCoordinates>();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      std::vector<double>& axisCoords = coords->Coordinates[axis];
+      if (scalars[axis])
+      {
+        const auto range = vtk::DataArrayValueRange<1>(scalars[axis]);
+        axisCoords.assign(range.begin(), range.end());
+      }
+      coords->Increasing &=
+        !axisCoords.empty() && std::is_sorted(axisCoords.begin(), axisCoords.end());
+    }
+    cache.Coordinates = std::move(coords);
+    cache.BuildTime.Modified();
+  }
+  return cache.Coordinates;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkRectilinearGrid::ComputeStructuredCoordinates(
+  vtkIdType numPts, const double* x, int* ijk, double* pcoords, unsigned char* inBounds)
+{
+  return this->ComputeStructuredCoordinates(
+    *this->GetCoordinates(), numPts, x, ijk, pcoords, inBounds);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkRectilinearGrid::ComputeStructuredCoordinates(const vtkCoordinates& coords,
+  vtkIdType numPts, const double* x, int* ijk, double* pcoords, unsigned char* inBounds)
+{
+  // The binary search requires increasing coordinates: fall back to the
+  // single point version otherwise.
+  if (!coords.Increasing)
+  {
+    vtkIdType numInBounds = 0;
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      double pt[3] = { x[3 * i], x[3 * i + 1], x[3 * i + 2] };
+      int loc[3] = { 0, 0, 0 };
+      double pc[3] = { 0.0, 0.0, 0.0 };
+      inBounds[i] = static_cast<unsigned char>(this->ComputeStructuredCoordinates(pt, loc, pc));
+      numInBounds += inBounds[i];
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        ijk[axis * numPts + i] = loc[axis];
+        pcoords[axis * numPts + i] = pc[axis];
+      }
+    }
+    return numInBounds;
+  }
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const std::vector<double>& axisCoords = coords.Coordinates[axis];
+    const double xMin = axisCoords.front();
+    const double xMax = axisCoords.back();
+    const bool singleNode = (axisCoords.size() == 1 || this->Dimensions[axis] == 1);
+    int* axisIjk = ijk + axis * numPts;
+    double* axisPCoords = pcoords + axis * numPts;
+
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      const double xi = x[3 * i + axis];
+      axisIjk[i] = 0;
+      axisPCoords[i] = 0.0;
+      if (xi < xMin || xi > xMax || (xi == xMax && !singleNode))
+      {
+        inBounds[i] = 0;
+        continue;
+      }
+      inBounds[i] = (axis == 0 ? 1 : inBounds[i]);
+      if (axisCoords.size() > 1)
+      {
+        // First node that is not before the point. Points lying on a node are
+        // assigned to the cell before it, as in the single point version.
+        const auto next = std::lower_bound(axisCoords.begin() + 1, axisCoords.end(), xi);
+        const double xNext = *next;
+        const double xPrev = *(next - 1);
+        axisIjk[i] = static_cast<int>(next - axisCoords.begin()) - 1;
+        axisPCoords[i] = (xi == xNext ? 1.0 : (xi - xPrev) / (xNext - xPrev));
+      }
+    }
+  }
+
+  vtkIdType numInBounds = 0;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    numInBounds += inBounds[i];
+  }
+  return numInBounds;
+}
+
+//------------------------------------------------------------------------------
+bool vtkRectilinearGrid::SnapToBounds(const vtkCoordinates& coords, const double x[3],
+  double tol2, int ijk[3], double pcoords[3])
+{
+  if (!coords.Increasing)
+  {
+    return false;
+  }
+  // Check the point against the bounds to see if it is within tolerance, and
+  // move it to the nearest boundary cell if so.
+  double dist2 = 0.0;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const std::vector<double>& axisCoords = coords.Coordinates[axis];
+    const bool singleNode = (axisCoords.size() == 1 || this->Dimensions[axis] == 1);
+    if (x[axis] < axisCoords.front())
+    {
+      const double dist = axisCoords.front() - x[axis];
+      ijk[axis] = 0;
+      pcoords[axis] = 0.0;
+      dist2 += dist * dist;
+    }
+    else if (x[axis] > axisCoords.back() || (x[axis] == axisCoords.back() && !singleNode))
+    {
+      const double dist = x[axis] - axisCoords.back();
+      ijk[axis] = singleNode ? 0 : static_cast<int>(axisCoords.size()) - 2;
+      pcoords[axis] = singleNode ? 0.0 : 1.0;
+      dist2 += dist * dist;
+    }
+    else if (singleNode)
+    {
+      ijk[axis] = 0;
+      pcoords[axis] = 0.0;
+    }
+    else
+    {
+      const auto next = std::lower_bound(axisCoords.begin() + 1, axisCoords.end(), x[axis]);
+      ijk[axis] = static_cast<int>(next - axisCoords.begin()) - 1;
+      pcoords[axis] = (x[axis] == *next ? 1.0 : (x[axis] - *(next - 1)) / (*next - *(next - 1)));
+    }
+  }
+  return dist2 <= tol2;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkRectilinearGrid::FindCells(vtkIdType numPts, const double* x, double tol2,
+  vtkIdType* cellIds, double* pcoords, double* weights)
+{
+  std::vector<int> ijk(3 * numPts);
+  std::vector<double> localPCoords;
+  if (!pcoords)
+  {
+    localPCoords.resize(3 * numPts);
+    pcoords = localPCoords.data();
+  }
+  std::vector<unsigned char> inBounds(numPts);
+  const std::shared_ptr<const vtkCoordinates> coords = this->GetCoordinates();
+  this->ComputeStructuredCoordinates(*coords, numPts, x, ijk.data(), pcoords, inBounds.data());
+
+  vtkIdType numFound = 0;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    int loc[3] = { ijk[i], ijk[numPts + i], ijk[2 * numPts + i] };
+    if (!inBounds[i])
+    {
+      double pt[3] = { x[3 * i], x[3 * i + 1], x[3 * i + 2] };
+      double pc[3] = { pcoords[i], pcoords[numPts + i], pcoords[2 * numPts + i] };
+      if (!this->SnapToBounds(*coords, pt, tol2, loc, pc))
+      {
+        cellIds[i] = -1;
+        continue;
+      }
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        pcoords[axis * numPts + i] = pc[axis];
+      }
+    }
+    cellIds[i] = vtkStructuredData::ComputeCellId(this->Dimensions, loc);
+    ++numFound;
+  }
+
+  vtkStructuredData::GetCellParametricCoordinates(this->DataDescription, numPts, pcoords);
+  if (weights)
+  {
+    vtkVoxel::InterpolationFunctions(numPts, pcoords, weights);
+  }
+  return numFound;
+}
+
 //------------------------------------------------------------------------------
 unsigned long vtkRectilinearGrid::GetActualMemorySize()
 {
@@ -41,6 +41,8 @@
 #include "vtkDataSet.h"
 #include "vtkStructuredData.h" // For inline methods
 
+#include <memory> // For std::shared_ptr
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkVertex;
 class vtkLine;
@@ -179,6 +181,34 @@ public:
    */
   int ComputeStructuredCoordinates(double x[3], int ijk[3], double pcoords[3]);
 
+  /**
+   * Batch version of ComputeStructuredCoordinates() for numPts points whose
+   * coordinates are interleaved in x. The cell containing each point is found
+   * with a binary search along each axis. ijk and pcoords use a
+   * structure-of-arrays layout: ijk[c * numPts + i] and pcoords[c * numPts + i]
+   * are the c-th structured and parametric coordinates of point i. inBounds[i]
+   * is set to 1 if point i is inside of the grid, 0 otherwise. Returns the
+   * number of points inside of the grid. This method is thread safe.
+   */
+  vtkIdType ComputeStructuredCoordinates(
+    vtkIdType numPts, const double* x, int* ijk, double* pcoords, unsigned char* inBounds);
+
+  /**
+   * Batch version of FindCell() for numPts points whose coordinates are
+   * interleaved in x. cellIds[i] is set to the id of the cell containing
+   * point i, or -1 if there is none. If not null, pcoords and weights receive
+   * the parametric coordinates and the 8 voxel interpolation weights of each
+   * point in a structure-of-arrays layout (see
+   * vtkVoxel::InterpolationFunctions()). Unlike FindCell(), parametric
+   * coordinates are expressed in the frame of the returned cell, so that the
+   * first weights match its points. Unlike FindCell(), which ignores tol2,
+   * points outside of the grid but within sqrt(tol2) of its bounds are
+   * assigned to the nearest boundary cell. Returns the number of points
+   * found. This method is thread safe.
+   */
+  virtual vtkIdType FindCells(vtkIdType numPts, const double* x, double tol2, vtkIdType* cellIds,
+    double* pcoords = nullptr, double* weights = nullptr);
+
   /**
    * Given a location in structured coordinates (i-j-k), return the point id.
    */
@@ -316,6 +346,18 @@ protected:
 private:
   void Cleanup();
 
+  // Copy of the coordinates searched by the batch methods, replaced by a new
+  // copy when the grid or its coordinate arrays are modified. Each search
+  // holds on to the copy it started with.
+  struct vtkCoordinates;
+  struct vtkCoordinateCache;
+  vtkCoordinateCache* CoordinateCache;
+  std::shared_ptr<const vtkCoordinates> GetCoordinates();
+  vtkIdType ComputeStructuredCoordinates(const vtkCoordinates& coords, vtkIdType numPts,
+    const double* x, int* ijk, double* pcoords, unsigned char* inBounds);
+  bool SnapToBounds(const vtkCoordinates& coords, const double x[3], double tol2, int ijk[3],
+    double pcoords[3]);
+
   vtkRectilinearGrid(const vtkRectilinearGrid&) = delete;
   void operator=(const vtkRectilinearGrid&) = delete;
 };
@@ -0,0 +1,407 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurve.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpaceFillingCurve.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+constexpr unsigned int MaxCoordinate = (1u << vtkSpaceFillingCurve::BITS_PER_AXIS) - 1;
+
+//------------------------------------------------------------------------------
+// Spread the lowest 21 bits of v so that two zero bits separate each of them.
+inline vtkTypeUInt64 SpreadBits(vtkTypeUInt64 v)
+{
+  v &= 0x1fffff;
+  v = (v | v << 32) & 0x1f00000000ffffULL;
+  v = (v | v << 16) & 0x1f0000ff0000ffULL;
+  v = (v | v << 8) & 0x100f00f00f00f00fULL;
+  v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+  v = (v | v << 2) & 0x1249249249249249ULL;
+  return v;
+}
+
+//------------------------------------------------------------------------------
+// Map positions in the bounds onto the integer lattice.
+struct Quantizer
+{
+  double Origin[3];
+  double Scale[3];
+
+  Quantizer(const double bounds[6])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Origin[i] = bounds[2 * i];
+      const double length = bounds[2 * i + 1] - bounds[2 * i];
+      this->Scale[i] = (length > 0.0 ? MaxCoordinate / length : 0.0);
+    }
+  }
+
+  void operator()(const double x[3], unsigned int ijk[3]) const
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      const double t = (x[i] - this->Origin[i]) * this->Scale[i];
+      ijk[i] = (t <= 0.0 ? 0u
+                         : (t >= MaxCoordinate ? MaxCoordinate : static_cast<unsigned int>(t)));
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// A curve index associated with the id of a point or cell. Equal indices are
+// ordered by id so that sorting is deterministic.
+struct CurveEntry
+{
+  vtkTypeUInt64 Index;
+  vtkIdType Id;
+
+  bool operator<(const CurveEntry& other) const
+  {
+    return this->Index < other.Index || (this->Index == other.Index && this->Id < other.Id);
+  }
+};
+
+//------------------------------------------------------------------------------
+struct ComputePointIndices
+{
+  template <typename PointsT>
+  void operator()(PointsT* pts, int curve, const double* bounds, CurveEntry* entries)
+  {
+    const Quantizer quantize(bounds);
+    vtkSMPTools::For(0, pts->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      const auto points = vtk::DataArrayTupleRange<3>(pts, begin, end);
+      double x[3];
+      unsigned int ijk[3];
+      vtkIdType ptId = begin;
+      for (const auto pt : points)
+      {
+        x[0] = static_cast<double>(pt[0]);
+        x[1] = static_cast<double>(pt[1]);
+        x[2] = static_cast<double>(pt[2]);
+        quantize(x, ijk);
+        entries[ptId].Index = vtkSpaceFillingCurve::CurveIndex(curve, ijk[0], ijk[1], ijk[2]);
+        entries[ptId].Id = ptId;
+        ++ptId;
+      }
+    });
+  }
+};
+
+//------------------------------------------------------------------------------
+// Sort a range of entries along the curve.
+void SortEntries(std::vector<CurveEntry>& entries, vtkIdType begin, vtkIdType end)
+{
+  if (end - begin > 1)
+  {
+    vtkSMPTools::Sort(entries.begin() + begin, entries.begin() + end);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Write the ids of the sorted entries in the ordering.
+void ExtractOrdering(const std::vector<CurveEntry>& entries, vtkIdTypeArray* order)
+{
+  const vtkIdType num = static_cast<vtkIdType>(entries.size());
+  order->SetNumberOfComponents(1);
+  order->SetNumberOfTuples(num);
+  vtkIdType* ids = order->GetPointer(0);
+  vtkSMPTools::For(0, num, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      ids[i] = entries[i].Id;
+    }
+  });
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkSpaceFillingCurve::MortonIndex(unsigned int i, unsigned int j, unsigned int k)
+{
+  return (SpreadBits(i) << 2) | (SpreadBits(j) << 1) | SpreadBits(k);
+}
+
+//------------------------------------------------------------------------------
+// Uses the compact algorithm from J. Skilling, "Programming the Hilbert curve",
+// AIP Conference Proceedings 707, 2004: the coordinates are first converted in
+// place to the "transposed" Hilbert index, whose bits are then interleaved.
+vtkTypeUInt64 vtkSpaceFillingCurve::HilbertIndex(unsigned int i, unsigned int j, unsigned int k)
+{
+  unsigned int x[3] = { i & MaxCoordinate, j & MaxCoordinate, k & MaxCoordinate };
+  const unsigned int m = 1u << (BITS_PER_AXIS - 1);
+
+  // Inverse undo
+  for (unsigned int q = m; q > 1; q >>= 1)
+  {
+    const unsigned int p = q - 1;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (x[axis] & q)
+      {
+        x[0] ^= p; // invert
+      }
+      else
+      {
+        const unsigned int t = (x[0] ^ x[axis]) & p; // exchange
+        x[0] ^= t;
+        x[axis] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  x[1] ^= x[0];
+  x[2] ^= x[1];
+  unsigned int t = 0;
+  for (unsigned int q = m; q > 1; q >>= 1)
+  {
+    if (x[2] & q)
+    {
+      t ^= q - 1;
+    }
+  }
+  x[0] ^= t;
+  x[1] ^= t;
+  x[2] ^= t;
+
+  return MortonIndex(x[0], x[1], x[2]);
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkSpaceFillingCurve::CurveIndex(
+  int curve, unsigned int i, unsigned int j, unsigned int k)
+{
+  return curve == HILBERT ? HilbertIndex(i, j, k) : MortonIndex(i, j, k);
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkSpaceFillingCurve::ComputeIndex(
+  int curve, const double x[3], const double bounds[6])
+{
+  const Quantizer quantize(bounds);
+  unsigned int ijk[3];
+  quantize(x, ijk);
+  return CurveIndex(curve, ijk[0], ijk[1], ijk[2]);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSpaceFillingCurve::SortPoints(vtkPoints* points, int curve, vtkIdTypeArray* order)
+{
+  if (!points || !order)
+  {
+    return false;
+  }
+
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  std::vector<CurveEntry> entries(numPts);
+  if (numPts > 0)
+  {
+    double bounds[6];
+    points->GetBounds(bounds);
+
+    using Dispatcher = vtkArrayDispatch::DispatchByValueType<vtkArrayDispatch::Reals>;
+    ComputePointIndices worker;
+    if (!Dispatcher::Execute(points->GetData(), worker, curve, bounds, entries.data()))
+    {
+      worker(points->GetData(), curve, bounds, entries.data());
+    }
+    SortEntries(entries, 0, numPts);
+  }
+
+  ExtractOrdering(entries, order);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSpaceFillingCurve::SortPointsInRounds(
+  vtkPoints* points, int curve, vtkIdTypeArray* order, const double* bounds)
+{
+  if (!points || !order)
+  {
+    return false;
+  }
+
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  std::vector<CurveEntry> entries(numPts);
+  if (numPts > 0)
+  {
+    double pointBounds[6];
+    if (!bounds)
+    {
+      points->GetBounds(pointBounds);
+      bounds = pointBounds;
+    }
+
+    using Dispatcher = vtkArrayDispatch::DispatchByValueType<vtkArrayDispatch::Reals>;
+    ComputePointIndices worker;
+    if (!Dispatcher::Execute(points->GetData(), worker, curve, bounds, entries.data()))
+    {
+      worker(points->GetData(), curve, bounds, entries.data());
+    }
+
+    // Draw the round of each point: the last round holds about half of the
+    // points, the one before about a quarter, and so on.
+    int numRounds = 1;
+    while (numRounds < 32 && (static_cast<vtkIdType>(1) << numRounds) < numPts)
+    {
+      ++numRounds;
+    }
+    std::vector<unsigned char> rounds(numPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        // splitmix64 finalizer, so that the rounds do not depend on the numbering.
+        vtkTypeUInt64 hash = static_cast<vtkTypeUInt64>(ptId) + 0x9e3779b97f4a7c15ULL;
+        hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+        hash ^= hash >> 31;
+        int level = 0;
+        while (level < numRounds - 1 && !(hash & 1))
+        {
+          hash >>= 1;
+          ++level;
+        }
+        rounds[ptId] = static_cast<unsigned char>(numRounds - 1 - level);
+      }
+    });
+
+    // Group the points by round, then sort each round along the curve.
+    std::vector<vtkIdType> roundOffsets(numRounds + 1, 0);
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      ++roundOffsets[rounds[ptId] + 1];
+    }
+    for (int round = 0; round < numRounds; ++round)
+    {
+      roundOffsets[round + 1] += roundOffsets[round];
+    }
+    std::vector<CurveEntry> grouped(numPts);
+    std::vector<vtkIdType> next(roundOffsets.begin(), roundOffsets.end() - 1);
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      grouped[next[rounds[ptId]]++] = entries[ptId];
+    }
+    entries.swap(grouped);
+    for (int round = 0; round < numRounds; ++round)
+    {
+      SortEntries(entries, roundOffsets[round], roundOffsets[round + 1]);
+    }
+  }
+
+  ExtractOrdering(entries, order);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSpaceFillingCurve::SortCells(vtkDataSet* input, int curve, vtkIdTypeArray* order)
+{
+  if (!input || !order)
+  {
+    return false;
+  }
+
+  const vtkIdType numCells = input->GetNumberOfCells();
+  std::vector<CurveEntry> entries(numCells);
+  if (numCells > 0)
+  {
+    double bounds[6];
+    input->GetBounds(bounds);
+    const Quantizer quantize(bounds);
+
+    // Make sure the internal structures are built before threading.
+    input->GetCell(0);
+
+    vtkSMPThreadLocalObject<vtkIdList> tlIds;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* idList = tlIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      double x[3], center[3];
+      unsigned int ijk[3];
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        input->GetCellPoints(cellId, npts, pts, idList);
+        center[0] = center[1] = center[2] = 0.0;
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          input->GetPoint(pts[i], x);
+          center[0] += x[0];
+          center[1] += x[1];
+          center[2] += x[2];
+        }
+        if (npts > 0)
+        {
+          center[0] /= npts;
+          center[1] /= npts;
+          center[2] /= npts;
+        }
+        quantize(center, ijk);
+        entries[cellId].Index = CurveIndex(curve, ijk[0], ijk[1], ijk[2]);
+        entries[cellId].Id = cellId;
+      }
+    });
+
+    // Polydata cell ids are implicitly grouped by cell array: only sort
+    // inside of each group.
+    if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(input))
+    {
+      const vtkIdType groupSizes[4] = { polyData->GetNumberOfVerts(),
+        polyData->GetNumberOfLines(), polyData->GetNumberOfPolys(),
+        polyData->GetNumberOfStrips() };
+      vtkIdType groupBegin = 0;
+      for (vtkIdType groupSize : groupSizes)
+      {
+        SortEntries(entries, groupBegin, groupBegin + groupSize);
+        groupBegin += groupSize;
+      }
+    }
+    else
+    {
+      SortEntries(entries, 0, numCells);
+    }
+  }
+
+  ExtractOrdering(entries, order);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkSpaceFillingCurve::InvertOrdering(vtkIdTypeArray* order, vtkIdList* map)
+{
+  const vtkIdType num = order->GetNumberOfTuples();
+  map->SetNumberOfIds(num);
+  const vtkIdType* ids = order->GetPointer(0);
+  vtkIdType* mapPtr = map->GetPointer(0);
+  vtkSMPTools::For(0, num, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType newId = begin; newId < end; ++newId)
+    {
+      mapPtr[ids[newId]] = newId;
+    }
+  });
+}
+VTK_ABI_NAMESPACE_END
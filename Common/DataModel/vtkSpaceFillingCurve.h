@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurve.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSpaceFillingCurve
+ * @brief   order points and cells along a Morton or Hilbert curve
+ *
+ * vtkSpaceFillingCurve provides static methods to compute Morton (Z-order)
+ * and Hilbert indices of 3D positions, and to compute orderings of the
+ * points and cells of a dataset along these curves. Consecutive entries of
+ * such an ordering are close in space, so renumbering a dataset with it
+ * greatly improves the memory locality of algorithms that gather point
+ * values through cell connectivity.
+ *
+ * Positions are quantized on a 2^21 x 2^21 x 2^21 lattice spanning the
+ * supplied bounds, so indices fit in 63 bits. The orderings are computed
+ * in parallel using vtkSMPTools, and ties between equal indices are broken
+ * using the original ids so that the result is deterministic.
+ *
+ * @sa
+ * vtkSpaceFillingCurveReorder
+ */
+
+#ifndef vtkSpaceFillingCurve_h
+#define vtkSpaceFillingCurve_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkType.h"                  // For vtkIdType
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataSet;
+class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkSpaceFillingCurve
+{
+public:
+  /**
+   * The supported curves.
+   */
+  enum CurveType
+  {
+    MORTON = 0,
+    HILBERT = 1
+  };
+
+  /**
+   * Number of bits used to quantize each coordinate axis.
+   */
+  static constexpr int BITS_PER_AXIS = 21;
+
+  ///@{
+  /**
+   * Compute the index along the curve of the lattice cell (i,j,k). Each
+   * coordinate must be less than 2^BITS_PER_AXIS; higher bits are ignored.
+   */
+  static vtkTypeUInt64 MortonIndex(unsigned int i, unsigned int j, unsigned int k);
+  static vtkTypeUInt64 HilbertIndex(unsigned int i, unsigned int j, unsigned int k);
+  static vtkTypeUInt64 CurveIndex(int curve, unsigned int i, unsigned int j, unsigned int k);
+  ///@}
+
+  /**
+   * Compute the index along the curve of the point x, quantized in the given
+   * bounds. Points outside the bounds are clamped to them.
+   */
+  static vtkTypeUInt64 ComputeIndex(int curve, const double x[3], const double bounds[6]);
+
+  /**
+   * Compute an ordering of the points along the curve. On return, order
+   * contains the point ids sorted along the curve, i.e. order[newId] = oldId.
+   * Returns false if the ordering could not be computed.
+   */
+  static bool SortPoints(vtkPoints* points, int curve, vtkIdTypeArray* order);
+
+  /**
+   * Compute a biased randomized insertion order (BRIO) of the points, for
+   * incremental constructions such as Delaunay triangulations. The points are
+   * drawn into rounds of roughly doubling size by a pseudo-random hash of
+   * their ids, and sorted along the curve within each round. Consecutive points
+   * are then close in space, while the random rounds preserve the expected
+   * behavior of a random insertion order. The points are quantized in the
+   * given bounds, or in the bounds of the points if bounds is nullptr; a flat
+   * axis in the bounds is ignored. On return, order contains the point ids in
+   * insertion order. Returns false if the ordering could not be computed.
+   */
+  static bool SortPointsInRounds(
+    vtkPoints* points, int curve, vtkIdTypeArray* order, const double* bounds = nullptr);
+
+  /**
+   * Compute an ordering of the cells of a dataset along the curve, using the
+   * mean of each cell's points as its position. On return, order contains the
+   * cell ids sorted along the curve, i.e. order[newId] = oldId.
+   *
+   * For vtkPolyData, cells are only sorted within each of the vertex, line,
+   * polygon and strip cell arrays, so that the ordering can be used to renumber
+   * a vtkPolyData without changing the type of its cells.
+   * Returns false if the ordering could not be computed.
+   */
+  static bool SortCells(vtkDataSet* input, int curve, vtkIdTypeArray* order);
+
+  /**
+   * Given an ordering order[newId] = oldId, compute the inverse permutation
+   * map[oldId] = newId. The map is resized to the number of ids in order.
+   */
+  static void InvertOrdering(vtkIdTypeArray* order, vtkIdList* map);
+
+private:
+  vtkSpaceFillingCurve() = default;
+  ~vtkSpaceFillingCurve() = default;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -240,6 +240,55 @@ int vtkStructuredData::SetExtent(VTK_FUTURE_CONST int inExt[6], int ext[6])
   return dataDescription;
 }
 
+//------------------------------------------------------------------------------
+void vtkStructuredData::GetCellParametricCoordinates(
+  int dataDescription, vtkIdType numPts, double* pcoords)
+{
+  double* r = pcoords;
+  double* s = pcoords + numPts;
+  double* t = pcoords + 2 * numPts;
+
+  switch (dataDescription)
+  {
+    case VTK_XY_PLANE:
+      std::fill(t, t + numPts, 0.0);
+      break;
+
+    case VTK_YZ_PLANE:
+      std::copy(s, s + numPts, r);
+      std::copy(t, t + numPts, s);
+      std::fill(t, t + numPts, 0.0);
+      break;
+
+    case VTK_XZ_PLANE:
+      std::copy(t, t + numPts, s);
+      std::fill(t, t + numPts, 0.0);
+      break;
+
+    case VTK_X_LINE:
+      std::fill(s, s + 2 * numPts, 0.0);
+      break;
+
+    case VTK_Y_LINE:
+      std::copy(s, s + numPts, r);
+      std::fill(s, s + 2 * numPts, 0.0);
+      break;
+
+    case VTK_Z_LINE:
+      std::copy(t, t + numPts, r);
+      std::fill(s, s + 2 * numPts, 0.0);
+      break;
+
+    case VTK_SINGLE_POINT:
+    case VTK_EMPTY:
+      std::fill(r, r + 3 * numPts, 0.0);
+      break;
+
+    default: // VTK_XYZ_GRID
+      break;
+  }
+}
+
 //------------------------------------------------------------------------------
 // Get the points defining a cell. (See vtkDataSet for more info.)
 void vtkStructuredData::GetCellPoints(
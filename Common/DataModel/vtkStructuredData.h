@@ -161,6 +161,15 @@ public:
    */
   static void GetCellPoints(vtkIdType cellId, vtkIdList* ptIds, int dataDescription, int dim[3]);
 
+  /**
+   * Given the parametric coordinates of numPts points computed along the
+   * i-j-k axes of a dataset with the given data description, move them so
+   * that they are expressed in the frame of its cells (vtkPixel, vtkLine...).
+   * pcoords uses a structure-of-arrays layout: pcoords[c * numPts + i] is the
+   * c-th parametric coordinate of point i.
+   */
+  static void GetCellParametricCoordinates(int dataDescription, vtkIdType numPts, double* pcoords);
+
   /**
    * Get the cells using a point. (See vtkDataSet for more info.)
    */
@@ -583,6 +583,26 @@ vtkIdType vtkUniformGrid::FindCell(double x[3], vtkCell* vtkNotUsed(cell),
   return cellId;
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkUniformGrid::FindCells(vtkIdType numPts, const double* x, double tol2,
+  vtkIdType* cellIds, double* pcoords, double* weights)
+{
+  vtkIdType numFound = this->Superclass::FindCells(numPts, x, tol2, cellIds, pcoords, weights);
+
+  if (this->GetPointGhostArray() || this->GetCellGhostArray())
+  {
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      if (cellIds[i] >= 0 && !this->IsCellVisible(cellIds[i]))
+      {
+        cellIds[i] = -1;
+        --numFound;
+      }
+    }
+  }
+  return numFound;
+}
+
 //------------------------------------------------------------------------------
 vtkCell* vtkUniformGrid::FindAndGetCell(double x[3], vtkCell* vtkNotUsed(cell),
   vtkIdType vtkNotUsed(cellId), double vtkNotUsed(tol2), int& subId, double pcoords[3],
@@ -68,6 +68,8 @@ public:
     double tol2, int& subId, double pcoords[3], double* weights) override;
   vtkCell* FindAndGetCell(double x[3], vtkCell* cell, vtkIdType cellId, double tol2, int& subId,
     double pcoords[3], double* weights) override;
+  vtkIdType FindCells(vtkIdType numPts, const double* x, double tol2, vtkIdType* cellIds,
+    double* pcoords = nullptr, double* weights = nullptr) override;
   int GetCellType(vtkIdType cellId) override;
   using vtkDataSet::GetCellPoints;
   void GetCellPoints(vtkIdType cellId, vtkIdList* ptIds) override
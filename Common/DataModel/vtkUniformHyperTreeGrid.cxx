@@ -447,15 +447,8 @@ unsigned long vtkUniformHyperTreeGrid::GetActualMemorySizeBytes()
 {
   unsigned long size = 0; // in bytes
 
-  size += (this->Superclass::GetActualMemorySize() << 10);
-
-  // Iterate over all trees in grid
-  vtkHyperTreeGridIterator it;
-  it.Initialize(this);
-  while (vtkHyperTree* tree = it.GetNextTree())
-  {
-    size += tree->GetActualMemorySizeBytes();
-  }
+  // Includes the trees
+  size += this->Superclass::GetActualMemorySizeBytes();
 
   // Size of root cells sizes
   size += 3 * sizeof(double);
@@ -256,6 +256,38 @@ void vtkVoxel::InterpolationFunctions(const double pcoords[3], double sf[8])
   sf[7] = r * s * t;
 }
 
+//------------------------------------------------------------------------------
+void vtkVoxel::InterpolationFunctions(vtkIdType numPts, const double* pcoords, double* sf)
+{
+  const double* r = pcoords;
+  const double* s = pcoords + numPts;
+  const double* t = pcoords + 2 * numPts;
+  double* sf0 = sf;
+  double* sf1 = sf + numPts;
+  double* sf2 = sf + 2 * numPts;
+  double* sf3 = sf + 3 * numPts;
+  double* sf4 = sf + 4 * numPts;
+  double* sf5 = sf + 5 * numPts;
+  double* sf6 = sf + 6 * numPts;
+  double* sf7 = sf + 7 * numPts;
+
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    const double rm = 1. - r[i];
+    const double sm = 1. - s[i];
+    const double tm = 1. - t[i];
+
+    sf0[i] = rm * sm * tm;
+    sf1[i] = r[i] * sm * tm;
+    sf2[i] = rm * s[i] * tm;
+    sf3[i] = r[i] * s[i] * tm;
+    sf4[i] = rm * sm * t[i];
+    sf5[i] = r[i] * sm * t[i];
+    sf6[i] = rm * s[i] * t[i];
+    sf7[i] = r[i] * s[i] * t[i];
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkVoxel::InterpolationDerivs(const double pcoords[3], double derivs[24])
 {
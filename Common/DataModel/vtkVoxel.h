@@ -151,6 +151,14 @@ public:
    */
   static void InterpolationFunctions(const double pcoords[3], double weights[8]);
 
+  /**
+   * Compute the interpolation functions of numPts parametric coordinates at
+   * once. Both arrays use a structure-of-arrays layout: pcoords[c * numPts + i]
+   * is the c-th parametric coordinate of point i, and weights[w * numPts + i]
+   * receives its w-th weight.
+   */
+  static void InterpolationFunctions(vtkIdType numPts, const double* pcoords, double* weights);
+
   /**
    * Return the case table for table-based isocontouring (aka marching cubes
    * style implementations). A linear 3D cell with N vertices will have 2**N
@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConcurrentBranchPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkConcurrentBranchPipeline updates independent thread safe
+// branches concurrently, and the other ones serially.
+
+#include "vtkConcurrentBranchPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSMPTools.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+std::atomic<int> Running(0);
+std::atomic<int> MaxRunning(0);
+
+// Source producing a given number of points. While executing, it waits a bit
+// for other sources to start, to detect concurrent executions.
+class WaitingSource : public vtkPolyDataAlgorithm
+{
+public:
+  static WaitingSource* New();
+  vtkTypeMacro(WaitingSource, vtkPolyDataAlgorithm);
+
+  vtkIdType NumberOfPoints = 1;
+
+protected:
+  WaitingSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    const int running = ++Running;
+    int maxRunning = MaxRunning;
+    while (running > maxRunning && !MaxRunning.compare_exchange_weak(maxRunning, running))
+    {
+    }
+    const auto start = std::chrono::steady_clock::now();
+    while (Running < 2 && std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+    {
+      std::this_thread::yield();
+    }
+
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(this->NumberOfPoints);
+    vtkPolyData::GetData(outputVector)->SetPoints(points);
+    --Running;
+    return 1;
+  }
+};
+vtkStandardNewMacro(WaitingSource);
+
+// Filter with a repeatable input, producing as many points as its inputs.
+class SumPoints : public vtkPolyDataAlgorithm
+{
+public:
+  static SumPoints* New();
+  vtkTypeMacro(SumPoints, vtkPolyDataAlgorithm);
+
+protected:
+  int FillInputPortInformation(int port, vtkInformation* info) override
+  {
+    this->Superclass::FillInputPortInformation(port, info);
+    info->Set(vtkAlgorithm::INPUT_IS_REPEATABLE(), 1);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkIdType numberOfPoints = 0;
+    for (int i = 0; i < inputVector[0]->GetNumberOfInformationObjects(); ++i)
+    {
+      numberOfPoints += vtkPolyData::GetData(inputVector[0], i)->GetNumberOfPoints();
+    }
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(numberOfPoints);
+    vtkPolyData::GetData(outputVector)->SetPoints(points);
+    return 1;
+  }
+};
+vtkStandardNewMacro(SumPoints);
+
+// Filter passing its input.
+class PassPoints : public vtkPolyDataAlgorithm
+{
+public:
+  static PassPoints* New();
+  vtkTypeMacro(PassPoints, vtkPolyDataAlgorithm);
+
+protected:
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkPolyData::GetData(outputVector)->ShallowCopy(vtkPolyData::GetData(inputVector[0]));
+    return 1;
+  }
+};
+vtkStandardNewMacro(PassPoints);
+
+void SetThreadSafe(vtkAlgorithm* algorithm, bool threadSafe)
+{
+  algorithm->GetInformation()->Set(vtkConcurrentBranchPipeline::THREAD_SAFE(), threadSafe);
+}
+
+// Update the filter and return the maximum number of sources that executed at
+// the same time.
+int Update(vtkAlgorithm* filter, vtkIdType expectedNumberOfPoints)
+{
+  MaxRunning = 0;
+  filter->Modified();
+  filter->Update();
+  if (vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0))->GetNumberOfPoints() !=
+    expectedNumberOfPoints)
+  {
+    std::cerr << "Wrong number of points" << std::endl;
+    return -1;
+  }
+  return MaxRunning;
+}
+}
+
+int TestConcurrentBranchPipeline(int, char*[])
+{
+  const bool parallel = vtkSMPTools::GetEstimatedNumberOfThreads() > 1;
+
+  vtkNew<WaitingSource> source1;
+  source1->NumberOfPoints = 10;
+  vtkNew<WaitingSource> source2;
+  source2->NumberOfPoints = 20;
+  vtkNew<PassPoints> pass;
+  pass->SetInputConnection(source2->GetOutputPort());
+
+  vtkNew<SumPoints> sum;
+  vtkNew<vtkConcurrentBranchPipeline> executive;
+  sum->SetExecutive(executive);
+  sum->AddInputConnection(source1->GetOutputPort());
+  sum->AddInputConnection(pass->GetOutputPort());
+
+  // Undeclared algorithms are updated serially.
+  source1->Modified();
+  source2->Modified();
+  if (Update(sum, 30) != 1)
+  {
+    std::cerr << "Algorithms not declared thread safe were updated concurrently" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  SetThreadSafe(source1, true);
+  SetThreadSafe(source2, true);
+  SetThreadSafe(pass, true);
+  source1->Modified();
+  source2->Modified();
+  const int maxRunning = Update(sum, 30);
+  if (maxRunning < 1 || (parallel && maxRunning != 2))
+  {
+    std::cerr << "Independent branches were not updated concurrently" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Branches sharing an algorithm are updated serially.
+  sum->AddInputConnection(source2->GetOutputPort());
+  source1->Modified();
+  source2->Modified();
+  if (Update(sum, 50) != 1)
+  {
+    std::cerr << "Dependent branches were updated concurrently" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,252 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConcurrentLeafExecution.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check vtk::CompositeDataSetLeafRange and the concurrent execution of simple
+// algorithms on the leaves of composite datasets.
+
+#include "vtkCompositeDataPipeline.h"
+#include "vtkCompositeDataSetLeafRange.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPassInputTypeAlgorithm.h"
+#include "vtkSMPTools.h"
+#include "vtkThreadedCompositeDataPipeline.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Re-entrant algorithm that passes its input and records its number of points,
+// its execution order and whether nested parallelism is enabled in the field
+// data.
+class CountPoints : public vtkPassInputTypeAlgorithm
+{
+public:
+  static CountPoints* New();
+  vtkTypeMacro(CountPoints, vtkPassInputTypeAlgorithm);
+
+  std::atomic<vtkIdType> NumberOfExecutions{ 0 };
+
+protected:
+  int FillInputPortInformation(int, vtkInformation* info) override
+  {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkDataSet* input = vtkDataSet::GetData(inputVector[0]);
+    vtkDataSet* output = vtkDataSet::GetData(outputVector);
+    output->ShallowCopy(input);
+    vtkNew<vtkIdTypeArray> count;
+    count->SetName("Count");
+    count->InsertNextValue(input->GetNumberOfPoints());
+    count->InsertNextValue(this->NumberOfExecutions++);
+    count->InsertNextValue(vtkSMPTools::GetNestedParallelism());
+    output->GetFieldData()->AddArray(count);
+    return 1;
+  }
+};
+vtkStandardNewMacro(CountPoints);
+
+vtkSmartPointer<vtkImageData> MakeImage(int size)
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(size, size + 1, 2);
+  return image;
+}
+
+// Nested multiblock with empty blocks.
+vtkSmartPointer<vtkMultiBlockDataSet> MakeInput()
+{
+  auto input = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  input->SetNumberOfBlocks(25);
+  for (unsigned int block = 0; block < 25; ++block)
+  {
+    if (block % 7 == 3)
+    {
+      continue;
+    }
+    if (block % 5 == 1)
+    {
+      vtkNew<vtkMultiBlockDataSet> child;
+      child->SetNumberOfBlocks(3);
+      child->SetBlock(0, MakeImage(block + 2));
+      child->SetBlock(2, MakeImage(block + 3));
+      input->SetBlock(block, child);
+    }
+    else
+    {
+      input->SetBlock(block, MakeImage(block + 2));
+    }
+  }
+  return input;
+}
+
+bool TestRange(vtkMultiBlockDataSet* input)
+{
+  vtk::CompositeDataSetLeafRange leaves(input);
+  vtk::CompositeDataSetLeafRange allLeaves(input, vtk::CompositeDataSetOptions::None);
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(input->NewIterator());
+  vtkIdType index = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++index)
+  {
+    if (index >= leaves.size() || leaves[index] != iter->GetCurrentDataObject() ||
+      leaves.GetFlatIndex(index) != iter->GetCurrentFlatIndex())
+    {
+      std::cerr << "Wrong leaf " << index << std::endl;
+      return false;
+    }
+  }
+  if (index != leaves.size() || leaves.end() - leaves.begin() != index)
+  {
+    std::cerr << "Wrong number of leaves: " << leaves.size() << std::endl;
+    return false;
+  }
+
+  vtkIdType numberOfNullLeaves = 0;
+  for (vtkDataObject* dobj : allLeaves)
+  {
+    numberOfNullLeaves += dobj == nullptr;
+  }
+  if (numberOfNullLeaves == 0 || allLeaves.size() != leaves.size() + numberOfNullLeaves)
+  {
+    std::cerr << "Null leaves are not gathered" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestExecution(vtkMultiBlockDataSet* input, vtkCompositeDataPipeline* executive)
+{
+  vtkNew<CountPoints> filter;
+  filter->SetExecutive(executive);
+  filter->SetInputDataObject(input);
+  filter->Update();
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+
+  vtk::CompositeDataSetLeafRange inLeaves(input, vtk::CompositeDataSetOptions::None);
+  vtk::CompositeDataSetLeafRange outLeaves(output, vtk::CompositeDataSetOptions::None);
+  if (!output || output->GetNumberOfBlocks() != input->GetNumberOfBlocks() ||
+    outLeaves.size() != inLeaves.size())
+  {
+    std::cerr << executive->GetClassName() << ": wrong output structure" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < inLeaves.size(); ++i)
+  {
+    vtkDataSet* inLeaf = vtkDataSet::SafeDownCast(inLeaves[i]);
+    vtkDataSet* outLeaf = vtkDataSet::SafeDownCast(outLeaves[i]);
+    if (inLeaves.GetFlatIndex(i) != outLeaves.GetFlatIndex(i) || !inLeaf != !outLeaf)
+    {
+      std::cerr << executive->GetClassName() << ": wrong leaf " << i << std::endl;
+      return false;
+    }
+    if (!inLeaf)
+    {
+      continue;
+    }
+    vtkIdTypeArray* count =
+      vtkIdTypeArray::SafeDownCast(outLeaf->GetFieldData()->GetAbstractArray("Count"));
+    if (outLeaf == inLeaf || outLeaf->GetNumberOfPoints() != inLeaf->GetNumberOfPoints() ||
+      !count || count->GetValue(0) != inLeaf->GetNumberOfPoints())
+    {
+      std::cerr << executive->GetClassName() << ": wrong output for leaf " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Check that the largest leaves are executed first, with nested parallelism.
+bool TestScheduling(vtkMultiBlockDataSet* input)
+{
+  vtkNew<vtkCompositeDataPipeline> executive;
+  executive->ConcurrentLeafExecutionOn();
+  vtkNew<CountPoints> filter;
+  filter->SetExecutive(executive);
+  filter->SetInputDataObject(input);
+  // A single thread executes the leaves in order, without nested parallelism
+  // outside of the executive.
+  const bool nested = vtkSMPTools::GetNestedParallelism();
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1, vtkSMPTools::GetBackend(), false },
+    [&]() { filter->Update(); });
+  if (vtkSMPTools::GetNestedParallelism() != nested)
+  {
+    std::cerr << "Nested parallelism not restored" << std::endl;
+    return false;
+  }
+
+  vtk::CompositeDataSetLeafRange leaves(
+    vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0)));
+  std::vector<vtkIdType> sizes(leaves.size());
+  for (vtkIdType i = 0; i < leaves.size(); ++i)
+  {
+    vtkIdTypeArray* count =
+      vtkIdTypeArray::SafeDownCast(leaves[i]->GetFieldData()->GetAbstractArray("Count"));
+    const vtkIdType order = count->GetValue(1);
+    if (order < 0 || order >= leaves.size() || sizes[order] != 0 || count->GetValue(2) != 1)
+    {
+      std::cerr << "Wrong execution of leaf " << i << std::endl;
+      return false;
+    }
+    sizes[order] = vtkDataSet::SafeDownCast(leaves[i])->GetNumberOfCells();
+  }
+  if (!std::is_sorted(sizes.rbegin(), sizes.rend()))
+  {
+    std::cerr << "Leaves not executed from the largest to the smallest" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestConcurrentLeafExecution(int, char*[])
+{
+  vtkSmartPointer<vtkMultiBlockDataSet> input = MakeInput();
+  if (!TestRange(input))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkCompositeDataPipeline> serial;
+  vtkNew<vtkCompositeDataPipeline> concurrent;
+  concurrent->ConcurrentLeafExecutionOn();
+  vtkNew<vtkThreadedCompositeDataPipeline> threaded;
+  if (serial->GetConcurrentLeafExecution() || !threaded->GetConcurrentLeafExecution())
+  {
+    std::cerr << "Wrong default for ConcurrentLeafExecution" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!TestExecution(input, serial) || !TestExecution(input, concurrent) ||
+    !TestExecution(input, threaded) || !TestScheduling(input))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,238 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMultiTimeStepSources.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkMultiTimeStepAlgorithm obtains the requested time steps from
+// its time step sources, and reduces them in order.
+
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiTimeStepAlgorithm.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int NumberOfTimeSteps = 100;
+
+// Source producing a polydata with its time in the field data.
+class TimeSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TimeSource* New();
+  vtkTypeMacro(TimeSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions = 0;
+  int Piece = -1;
+  int NumberOfPieces = 0;
+  int GhostLevels = 0;
+
+protected:
+  TimeSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    std::vector<double> steps;
+    for (int i = 0; i < NumberOfTimeSteps; ++i)
+    {
+      steps.push_back(i);
+    }
+    const double range[2] = { 0.0, NumberOfTimeSteps - 1.0 };
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps.data(), NumberOfTimeSteps);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    this->Piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    this->NumberOfPieces =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    this->GhostLevels =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    vtkNew<vtkDoubleArray> time;
+    time->SetName("Time");
+    time->InsertNextValue(outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()));
+    vtkPolyData::GetData(outInfo)->GetFieldData()->AddArray(time);
+    return 1;
+  }
+};
+vtkStandardNewMacro(TimeSource);
+
+// Sum of the times of all the time steps, either reduced or executed at once.
+class SumTimes : public vtkMultiTimeStepAlgorithm
+{
+public:
+  static SumTimes* New();
+  vtkTypeMacro(SumTimes, vtkMultiTimeStepAlgorithm);
+
+  bool Reduce = false;
+  double Sum = 0.0;
+  bool InOrder = true;
+
+protected:
+  SumTimes() { this->SetNumberOfOutputPorts(1); }
+
+  int FillInputPortInformation(int, vtkInformation* info) override
+  {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+    return 1;
+  }
+
+  int FillOutputPortInformation(int, vtkInformation* info) override
+  {
+    info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkPolyData");
+    return 1;
+  }
+
+  int RequestUpdateExtent(
+    vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector*) override
+  {
+    std::vector<double> times;
+    for (int i = 0; i < NumberOfTimeSteps; ++i)
+    {
+      times.push_back(i);
+    }
+    inputVector[0]->GetInformationObject(0)->Set(
+      UPDATE_TIME_STEPS(), times.data(), NumberOfTimeSteps);
+    return 1;
+  }
+
+  static double GetTime(vtkDataObject* input)
+  {
+    return input->GetFieldData()->GetArray("Time")->GetComponent(0, 0);
+  }
+
+  int ReduceTimeStep(
+    vtkInformation*, int index, vtkDataObject* input, vtkInformationVector*) override
+  {
+    if (!this->Reduce)
+    {
+      return -1;
+    }
+    this->InOrder = this->InOrder && index == this->GetTime(input);
+    this->Sum += this->GetTime(input);
+    return 1;
+  }
+
+  int Execute(vtkInformation*, const std::vector<vtkSmartPointer<vtkDataObject>>& inputs,
+    vtkInformationVector*) override
+  {
+    if (this->Reduce != inputs.empty())
+    {
+      return 0;
+    }
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+      this->InOrder = this->InOrder && i == this->GetTime(inputs[i]);
+      this->Sum += this->GetTime(inputs[i]);
+    }
+    return 1;
+  }
+};
+vtkStandardNewMacro(SumTimes);
+}
+
+int TestMultiTimeStepSources(int, char*[])
+{
+  const double sum = NumberOfTimeSteps * (NumberOfTimeSteps - 1) / 2.0;
+  vtkNew<TimeSource> input;
+  vtkNew<SumTimes> filter;
+  filter->SetInputConnection(input->GetOutputPort());
+  vtkNew<TimeSource> sources[3];
+  for (auto& source : sources)
+  {
+    filter->AddTimeStepSource(source);
+  }
+
+  for (bool reduce : { false, true })
+  {
+    input->NumberOfExecutions = 0;
+    for (auto& source : sources)
+    {
+      source->NumberOfExecutions = 0;
+    }
+    filter->Reduce = reduce;
+    filter->Sum = 0.0;
+    filter->SetMaximumNumberOfTimeStepsInFlight(2);
+    filter->Modified();
+    if (!filter->UpdateTimeStep(0.0) || filter->Sum != sum || !filter->InOrder)
+    {
+      std::cerr << "Wrong sum of the time steps: " << filter->Sum << std::endl;
+      return EXIT_FAILURE;
+    }
+    // The input only produces the first time step, once.
+    int sourceExecutions = 0;
+    for (auto& source : sources)
+    {
+      sourceExecutions += source->NumberOfExecutions;
+    }
+    if (input->NumberOfExecutions != (reduce ? 0 : 1) ||
+      sourceExecutions != NumberOfTimeSteps - 1)
+    {
+      std::cerr << "Wrong number of executions: " << input->NumberOfExecutions << " and "
+                << sourceExecutions << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Without time step sources, the time steps are obtained from the input,
+  // which still holds the first one.
+  filter->RemoveAllTimeStepSources();
+  input->NumberOfExecutions = 0;
+  filter->Sum = 0.0;
+  if (!filter->UpdateTimeStep(0.0) || filter->Sum != sum || !filter->InOrder ||
+    input->NumberOfExecutions != NumberOfTimeSteps - 1)
+  {
+    std::cerr << "Wrong serial reduction: " << filter->Sum << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The time step sources produce the piece requested from the input.
+  for (auto& source : sources)
+  {
+    source->NumberOfExecutions = 0;
+    filter->AddTimeStepSource(source);
+  }
+  filter->Sum = 0.0;
+  filter->Modified();
+  if (!filter->UpdateTimeStep(0.0, 1, 3, 2) || filter->Sum != sum)
+  {
+    std::cerr << "Wrong sum of the time steps of a piece: " << filter->Sum << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (auto& source : sources)
+  {
+    if (source->NumberOfExecutions > 0 &&
+      (source->Piece != 1 || source->NumberOfPieces != 3 || source->GhostLevels != 2))
+    {
+      std::cerr << "Wrong piece produced by a time step source: " << source->Piece << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestParallelReaderPartitions.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkParallelReader reads its files as the partitions of a
+// vtkPartitionedDataSet, concurrently when the subclass allows it.
+
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkParallelReader.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+// Reader whose "files" are numbers of points. It records the maximum number
+// of files read at the same time.
+class PointsReader : public vtkParallelReader
+{
+public:
+  static PointsReader* New();
+  vtkTypeMacro(PointsReader, vtkParallelReader);
+
+  bool Concurrent = false;
+  std::atomic<int> Reading{ 0 };
+  std::atomic<int> MaximumReading{ 0 };
+
+protected:
+  int FillOutputPortInformation(int, vtkInformation* info) override
+  {
+    info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkPolyData");
+    return 1;
+  }
+
+  bool CanReadFilesConcurrently() override { return this->Concurrent; }
+
+  int ReadMesh(const std::string& fname, int, int, int, vtkDataObject* output) override
+  {
+    const int reading = ++this->Reading;
+    int maximum = this->MaximumReading;
+    while (reading > maximum && !this->MaximumReading.compare_exchange_weak(maximum, reading))
+    {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(std::stoi(fname));
+    vtkPolyData::SafeDownCast(output)->SetPoints(points);
+    --this->Reading;
+    return 1;
+  }
+
+  int ReadPoints(const std::string&, int, int, int, vtkDataObject*) override { return 1; }
+
+  int ReadArrays(const std::string&, int, int, int, vtkDataObject*) override { return 1; }
+};
+vtkStandardNewMacro(PointsReader);
+
+bool CheckPartitions(PointsReader* reader, int piece, int npieces, int first, int number)
+{
+  reader->UpdatePiece(piece, npieces, 0);
+  vtkPartitionedDataSet* output =
+    vtkPartitionedDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!output || static_cast<int>(output->GetNumberOfPartitions()) != number)
+  {
+    std::cerr << "Wrong number of partitions for piece " << piece << std::endl;
+    return false;
+  }
+  for (int i = 0; i < number; ++i)
+  {
+    vtkPolyData* partition = vtkPolyData::SafeDownCast(output->GetPartition(i));
+    if (!partition || partition->GetNumberOfPoints() != first + i + 1)
+    {
+      std::cerr << "Wrong partition " << i << " for piece " << piece << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestParallelReaderPartitions(int, char*[])
+{
+  vtkNew<PointsReader> reader;
+  for (int i = 1; i <= 8; ++i)
+  {
+    reader->AddFileName(std::to_string(i).c_str());
+  }
+  reader->ReadFilesAsPartitionsOn();
+  if (!CheckPartitions(reader, 0, 1, 0, 8) || reader->MaximumReading != 1)
+  {
+    std::cerr << "Wrong serial read" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  reader->Concurrent = true;
+  reader->MaximumReading = 0;
+  reader->SetMaximumNumberOfConcurrentReads(3);
+  if (!CheckPartitions(reader, 1, 2, 4, 4) || reader->MaximumReading < 2 ||
+    reader->MaximumReading > 3 || reader->GetCurrentFileName())
+  {
+    std::cerr << "Wrong concurrent read: " << reader->MaximumReading << " files at once"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The files are time steps again.
+  reader->ReadFilesAsPartitionsOff();
+  reader->UpdateTimeStep(2.0);
+  vtkPolyData* output = vtkPolyData::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfPoints() != 3 || !reader->GetCurrentFileName() ||
+    std::string(reader->GetCurrentFileName()) != "3")
+  {
+    std::cerr << "Wrong file series" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
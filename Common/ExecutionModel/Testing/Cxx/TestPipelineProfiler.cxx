@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkPipelineProfiler records the requests of every algorithm of a
+// pipeline, and exports them.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+// Source producing many points.
+class PointSource : public vtkPolyDataAlgorithm
+{
+public:
+  static PointSource* New();
+  vtkTypeMacro(PointSource, vtkPolyDataAlgorithm);
+
+protected:
+  PointSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(100000);
+    vtkPolyData::GetData(outputVector)->SetPoints(points);
+    return 1;
+  }
+};
+vtkStandardNewMacro(PointSource);
+
+// Filter passing its input, after waiting a given time.
+class SleepFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static SleepFilter* New();
+  vtkTypeMacro(SleepFilter, vtkPolyDataAlgorithm);
+
+  int Duration = 0;
+
+protected:
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(this->Duration));
+    vtkPolyData::GetData(outputVector)->ShallowCopy(vtkPolyData::GetData(inputVector[0]));
+    return 1;
+  }
+};
+vtkStandardNewMacro(SleepFilter);
+}
+
+int TestPipelineProfiler(int, char*[])
+{
+  vtkNew<PointSource> source;
+  vtkNew<SleepFilter> slow;
+  slow->Duration = 100;
+  slow->SetInputConnection(source->GetOutputPort());
+  vtkNew<SleepFilter> fast;
+  fast->SetInputConnection(slow->GetOutputPort());
+
+  vtkNew<vtkPipelineProfiler> profiler;
+  profiler->Attach(fast->GetExecutive());
+  fast->Update();
+
+  vtkAlgorithm* algorithms[] = { source, slow, fast };
+  for (vtkAlgorithm* algorithm : algorithms)
+  {
+    if (profiler->GetNumberOfPasses(algorithm, "REQUEST_INFORMATION") != 1 ||
+      profiler->GetNumberOfPasses(algorithm, "REQUEST_DATA") != 1)
+    {
+      std::cerr << "Wrong passes for " << algorithm->GetClassName() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (profiler->GetNumberOfPasses(slow, "REQUEST_UPDATE_EXTENT") != 1)
+  {
+    std::cerr << "REQUEST_UPDATE_EXTENT was not recorded" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (profiler->GetWallTime(slow, "REQUEST_DATA") < 0.09 ||
+    profiler->GetWallTime(fast) >= profiler->GetWallTime(slow))
+  {
+    std::cerr << "Wrong wall time" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (profiler->GetOutputMemorySize(source) < 1000)
+  {
+    std::cerr << "Wrong output memory size: " << profiler->GetOutputMemorySize(source)
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  if (trace.str().find("\"traceEvents\"") == std::string::npos ||
+    trace.str().find(slow->GetObjectDescription()) == std::string::npos)
+  {
+    std::cerr << "Wrong Chrome trace:\n" << trace.str() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ostringstream flameGraph;
+  profiler->WriteFlameGraph(flameGraph);
+  const std::string stack = slow->GetObjectDescription() + ";REQUEST_DATA ";
+  const std::size_t found = flameGraph.str().find(stack);
+  if (found == std::string::npos ||
+    std::stol(flameGraph.str().substr(found + stack.size())) < 90000)
+  {
+    std::cerr << "Wrong flame graph:\n" << flameGraph.str() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Detached executives are not profiled anymore.
+  const int numberOfRecords = profiler->GetNumberOfRecords();
+  profiler->Detach();
+  source->Modified();
+  fast->Update();
+  if (profiler->GetNumberOfRecords() != numberOfRecords)
+  {
+    std::cerr << "Detached executives were profiled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestResultCachePipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkResultCachePipeline restores the results of previous requests
+// and honors its memory limit.
+
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkResultCachePipeline.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <iostream>
+
+namespace
+{
+// Temporal source producing the same number of points for every request, and
+// recording the request in the field data.
+class RequestSource : public vtkPolyDataAlgorithm
+{
+public:
+  static RequestSource* New();
+  vtkTypeMacro(RequestSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions = 0;
+
+protected:
+  RequestSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double timeSteps[10];
+    for (int i = 0; i < 10; ++i)
+    {
+      timeSteps[i] = i;
+    }
+    double timeRange[2] = { 0.0, 9.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+    outInfo->Set(vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(10000);
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      points->SetPoint(i, i, 0.0, 0.0);
+    }
+    output->SetPoints(points);
+    vtkNew<vtkDoubleArray> request;
+    request->SetName("Request");
+    request->InsertNextValue(outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()));
+    request->InsertNextValue(
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()));
+    output->GetFieldData()->AddArray(request);
+    return 1;
+  }
+};
+vtkStandardNewMacro(RequestSource);
+
+// Update the source and check its output. Returns the number of executions.
+int Update(RequestSource* source, double time, int piece = 0, int numPieces = 1)
+{
+  const int numberOfExecutions = source->NumberOfExecutions;
+  source->UpdateTimeStep(time, piece, numPieces);
+  vtkPolyData* output = source->GetOutput();
+  vtkDoubleArray* request =
+    vtkDoubleArray::SafeDownCast(output->GetFieldData()->GetAbstractArray("Request"));
+  if (output->GetNumberOfPoints() != 10000 || !request || request->GetValue(0) != time ||
+    request->GetValue(1) != piece ||
+    output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != time)
+  {
+    std::cerr << "Wrong output for time " << time << " and piece " << piece << std::endl;
+    return -1;
+  }
+  return source->NumberOfExecutions - numberOfExecutions;
+}
+}
+
+int TestResultCachePipeline(int, char*[])
+{
+  vtkNew<vtkResultCachePipeline> executive;
+  vtkNew<RequestSource> source;
+  source->SetExecutive(executive);
+
+  // Time steps, executed once.
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    for (int time = 0; time < 5; ++time)
+    {
+      if (Update(source, time) != (pass == 0 ? 1 : 0))
+      {
+        std::cerr << "Wrong number of executions for time " << time << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Pieces.
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    for (int piece = 0; piece < 2; ++piece)
+    {
+      if (Update(source, 2.0, piece, 2) != (pass == 0 ? 1 : 0))
+      {
+        std::cerr << "Wrong number of executions for piece " << piece << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (executive->GetNumberOfCachedResults() != 7)
+  {
+    std::cerr << "Wrong number of cached results: " << executive->GetNumberOfCachedResults()
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the algorithm discards the cache.
+  source->Modified();
+  if (Update(source, 1.0) != 1 || Update(source, 2.0) != 1 ||
+    executive->GetNumberOfCachedResults() != 2)
+  {
+    std::cerr << "Outdated results were used" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Memory limit: only two results fit, the least recently used is evicted.
+  const unsigned long resultSize = executive->GetCacheMemorySize() / 2;
+  executive->SetCacheMemoryLimit(resultSize * 5 / 2);
+  if (Update(source, 3.0) != 1 || Update(source, 2.0) != 0 || Update(source, 1.0) != 1 ||
+    Update(source, 3.0) != 1 || executive->GetNumberOfCachedResults() != 2 ||
+    executive->GetCacheMemorySize() > executive->GetCacheMemoryLimit())
+  {
+    std::cerr << "Memory limit is not honored" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  executive->SetCacheMemoryLimit(0);
+  if (executive->GetNumberOfCachedResults() != 0 || Update(source, 2.0) != 1 ||
+    Update(source, 3.0) != 1 || Update(source, 2.0) != 1)
+  {
+    std::cerr << "The cache is not disabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -200,6 +200,15 @@ public:
    */
   void SetAbortExecuteAndUpdateTime();
 
+  /**
+   * Set the AbortExecute flag without modifying the algorithm, so that an
+   * execution running on another thread can be aborted. Unlike
+   * SetAbortExecuteAndUpdateTime(), the LastAbortTime shared by all the
+   * algorithms is not updated: the caller should do it with
+   * SetAbortExecuteAndUpdateTime() once the execution has returned.
+   */
+  void RequestAbortExecute() { this->AbortExecute = 1; }
+
   ///@{
   /**
    * Set/Get the AbortExecute flag for the process object. Process objects
@@ -17,6 +17,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSetLeafRange.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkFieldData.h"
 #include "vtkImageData.h"
@@ -32,15 +33,25 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSetCollection.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPProgressObserver.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
 #include "vtkTrivialProducer.h"
 #include "vtkUniformGrid.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCompositeDataPipeline);
 
@@ -51,10 +62,179 @@ vtkInformationKeyMacro(vtkCompositeDataPipeline, DATA_COMPOSITE_INDICES, Integer
 vtkInformationKeyMacro(vtkCompositeDataPipeline, SUPPRESS_RESET_PI, Integer);
 vtkInformationKeyMacro(vtkCompositeDataPipeline, BLOCK_AMOUNT_OF_DETAIL, Double);
 
+//------------------------------------------------------------------------------
+namespace
+{
+vtkInformationVector** Clone(vtkInformationVector** src, int n)
+{
+  vtkInformationVector** dst = new vtkInformationVector*[n];
+  for (int i = 0; i < n; ++i)
+  {
+    dst[i] = vtkInformationVector::New();
+    dst[i]->Copy(src[i], 1);
+  }
+  return dst;
+}
+void DeleteAll(vtkInformationVector** dst, int n)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    dst[i]->Delete();
+  }
+  delete[] dst;
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+class ProcessBlockData : public vtkObjectBase
+{
+public:
+  vtkBaseTypeMacro(ProcessBlockData, vtkObjectBase);
+  vtkInformationVector** In;
+  vtkInformationVector* Out;
+  int InSize;
+
+  static ProcessBlockData* New()
+  {
+    // Can't use object factory macros, this is not a vtkObject.
+    ProcessBlockData* ret = new ProcessBlockData;
+    ret->InitializeObjectBase();
+    return ret;
+  }
+
+  void Construct(
+    vtkInformationVector** inInfoVec, int inInfoVecSize, vtkInformationVector* outInfoVec)
+  {
+    this->InSize = inInfoVecSize;
+    this->In = Clone(inInfoVec, inInfoVecSize);
+    this->Out = vtkInformationVector::New();
+    this->Out->Copy(outInfoVec, 1);
+  }
+
+  ~ProcessBlockData() override
+  {
+    DeleteAll(this->In, this->InSize);
+    this->Out->Delete();
+  }
+
+protected:
+  ProcessBlockData()
+    : In(nullptr)
+    , Out(nullptr)
+  {
+  }
+};
+//------------------------------------------------------------------------------
+class ProcessBlock
+{
+public:
+  ProcessBlock(vtkCompositeDataPipeline* exec, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec, int compositePort, int connection, vtkInformation* request,
+    const vtk::CompositeDataSetLeafRange& inObjs, const std::vector<vtkIdType>& order,
+    std::vector<vtkDataObject*>& outObjs)
+    : Exec(exec)
+    , InInfoVec(inInfoVec)
+    , OutInfoVec(outInfoVec)
+    , CompositePort(compositePort)
+    , Connection(connection)
+    , Request(request)
+    , InObjs(inObjs)
+    , Order(order)
+  {
+    int numInputPorts = this->Exec->GetNumberOfInputPorts();
+    this->OutObjs = outObjs.data();
+    this->InfoPrototype = vtkSmartPointer<ProcessBlockData>::New();
+    this->InfoPrototype->Construct(this->InInfoVec, numInputPorts, this->OutInfoVec);
+  }
+
+  ~ProcessBlock()
+  {
+    vtkSMPThreadLocal<vtkInformationVector**>::iterator itr1 = this->InInfoVecs.begin();
+    vtkSMPThreadLocal<vtkInformationVector**>::iterator end1 = this->InInfoVecs.end();
+    while (itr1 != end1)
+    {
+      DeleteAll(*itr1, this->InfoPrototype->InSize);
+      ++itr1;
+    }
+
+    vtkSMPThreadLocal<vtkInformationVector*>::iterator itr2 = this->OutInfoVecs.begin();
+    vtkSMPThreadLocal<vtkInformationVector*>::iterator end2 = this->OutInfoVecs.end();
+    while (itr2 != end2)
+    {
+      (*itr2)->Delete();
+      ++itr2;
+    }
+  }
+
+  void Initialize()
+  {
+    vtkInformationVector**& inInfoVec = this->InInfoVecs.Local();
+    vtkInformationVector*& outInfoVec = this->OutInfoVecs.Local();
+
+    inInfoVec = Clone(this->InfoPrototype->In, this->InfoPrototype->InSize);
+    outInfoVec = vtkInformationVector::New();
+    outInfoVec->Copy(this->InfoPrototype->Out, 1);
+
+    vtkInformation*& request = this->Requests.Local();
+    request->Copy(this->Request, 1);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkInformationVector** inInfoVec = this->InInfoVecs.Local();
+    vtkInformationVector* outInfoVec = this->OutInfoVecs.Local();
+    vtkInformation* request = this->Requests.Local();
+
+    vtkInformation* inInfo = inInfoVec[this->CompositePort]->GetInformationObject(this->Connection);
+    vtkAlgorithm* algo = this->Exec->GetAlgorithm();
+    const int numOutputs = outInfoVec->GetNumberOfInformationObjects();
+
+    // The items are taken from the shared order rather than from the range,
+    // because the backends do not run their tasks in order.
+    for (vtkIdType k = begin; k < end; ++k)
+    {
+      const vtkIdType i = this->Order[this->Next++];
+      vtkDataObject* dobj = this->InObjs[i];
+      if (!dobj || algo->GetAbortOutput())
+      {
+        continue;
+      }
+      std::vector<vtkDataObject*> outObjList = this->Exec->ExecuteSimpleAlgorithmForBlock(
+        &inInfoVec[0], outInfoVec, inInfo, request, dobj);
+      for (int j = 0; j < static_cast<int>(outObjList.size()) && j < numOutputs; ++j)
+      {
+        this->OutObjs[i * numOutputs + j] = outObjList[j];
+      }
+    }
+  }
+
+  void Reduce() {}
+
+protected:
+  vtkCompositeDataPipeline* Exec;
+  vtkInformationVector** InInfoVec;
+  vtkInformationVector* OutInfoVec;
+  vtkSmartPointer<ProcessBlockData> InfoPrototype;
+  int CompositePort;
+  int Connection;
+  vtkInformation* Request;
+  const vtk::CompositeDataSetLeafRange& InObjs;
+  const std::vector<vtkIdType>& Order;
+  std::atomic<vtkIdType> Next{ 0 };
+  vtkDataObject** OutObjs;
+
+  vtkSMPThreadLocal<vtkInformationVector**> InInfoVecs;
+  vtkSMPThreadLocal<vtkInformationVector*> OutInfoVecs;
+  vtkSMPThreadLocalObject<vtkInformation> Requests;
+};
+
 //------------------------------------------------------------------------------
 vtkCompositeDataPipeline::vtkCompositeDataPipeline()
 {
   this->InLocalLoop = 0;
+  this->ConcurrentLeafExecution = false;
+  this->SizeOrderedLeafExecution = true;
+  this->NestedLeafParallelism = true;
   this->InformationCache = vtkInformation::New();
 
   this->GenericRequest = vtkInformation::New();
@@ -270,6 +450,13 @@ void vtkCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* iter,
   int connection, vtkInformation* request,
   std::vector<vtkSmartPointer<vtkCompositeDataSet>>& compositeOutputs)
 {
+  if (this->ConcurrentLeafExecution)
+  {
+    this->ExecuteEachConcurrently(
+      iter, inInfoVec, outInfoVec, compositePort, connection, request, compositeOutputs);
+    return;
+  }
+
   vtkInformation* inInfo = inInfoVec[compositePort]->GetInformationObject(connection);
 
   vtkIdType num_blocks = 0;
@@ -319,6 +506,82 @@ void vtkCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* iter,
   algo->SetProgressShiftScale(0.0, 1.0);
 }
 
+//------------------------------------------------------------------------------
+void vtkCompositeDataPipeline::ExecuteEachConcurrently(vtkCompositeDataIterator* iter,
+  vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec, int compositePort,
+  int connection, vtkInformation* request,
+  std::vector<vtkSmartPointer<vtkCompositeDataSet>>& compositeOutputs)
+{
+  // The items visited by the iterator, null ones included so that the
+  // outputs can be put back by traversing the iterator again.
+  vtk::CompositeDataSetLeafRange inObjs(iter);
+
+  // outObjs are the output objects created from inObjs, numOutputs per item.
+  const int numOutputs = outInfoVec->GetNumberOfInformationObjects();
+  std::vector<vtkDataObject*> outObjs(inObjs.size() * numOutputs, nullptr);
+
+  // The order in which the items are executed. Executing the largest items
+  // first, one item per task, lets the threads which get the small items
+  // pick the next ones instead of waiting for a thread stuck with several
+  // large items.
+  std::vector<vtkIdType> order(inObjs.size());
+  std::iota(order.begin(), order.end(), 0);
+  vtkIdType grain = 0;
+  if (this->SizeOrderedLeafExecution)
+  {
+    std::vector<vtkIdType> sizes(inObjs.size(), 0);
+    for (vtkIdType i = 0; i < inObjs.size(); ++i)
+    {
+      if (vtkDataObject* dobj = inObjs[i])
+      {
+        sizes[i] = std::max({ dobj->GetNumberOfElements(vtkDataObject::CELL),
+          dobj->GetNumberOfElements(vtkDataObject::POINT),
+          dobj->GetNumberOfElements(vtkDataObject::ROW) });
+      }
+    }
+    std::stable_sort(order.begin(), order.end(),
+      [&sizes](vtkIdType a, vtkIdType b) { return sizes[a] > sizes[b]; });
+    grain = 1;
+  }
+
+  ProcessBlock processBlock(
+    this, inInfoVec, outInfoVec, compositePort, connection, request, inObjs, order, outObjs);
+
+  vtkSmartPointer<vtkProgressObserver> origPo(this->Algorithm->GetProgressObserver());
+  vtkNew<vtkSMPProgressObserver> po;
+  this->Algorithm->SetProgressObserver(po);
+  // With nested parallelism, the vtkSMPTools loops of the algorithm are
+  // shared with the threads done with their items.
+  if (vtkSMPTools::GetNestedParallelism() == this->NestedLeafParallelism)
+  {
+    vtkSMPTools::For(0, inObjs.size(), grain, processBlock);
+  }
+  else
+  {
+    vtkSMPTools::Config config{ vtkSMPTools::GetEstimatedNumberOfThreads(),
+      vtkSMPTools::GetBackend(), this->NestedLeafParallelism };
+    vtkSMPTools::LocalScope(
+      config, [&]() { vtkSMPTools::For(0, inObjs.size(), grain, processBlock); });
+  }
+  this->Algorithm->SetProgressObserver(origPo);
+
+  vtkIdType i = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++i)
+  {
+    for (int port = 0; port < numOutputs; ++port)
+    {
+      if (vtkDataObject* outObj = outObjs[i * numOutputs + port])
+      {
+        if (compositeOutputs[port])
+        {
+          compositeOutputs[port]->SetDataSet(iter, outObj);
+        }
+        outObj->FastDelete();
+      }
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // Execute a simple (non-composite-aware) filter multiple times, once per
 // block. Collect the result in a composite dataset that is of the same
@@ -1127,5 +1390,45 @@ void vtkCompositeDataPipeline::MarkOutputsGenerated(
 void vtkCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ConcurrentLeafExecution: " << this->ConcurrentLeafExecution << endl;
+  os << indent << "SizeOrderedLeafExecution: " << this->SizeOrderedLeafExecution << endl;
+  os << indent << "NestedLeafParallelism: " << this->NestedLeafParallelism << endl;
+}
+
+//------------------------------------------------------------------------------
+int vtkCompositeDataPipeline::CallAlgorithm(vtkInformation* request, int direction,
+  vtkInformationVector** inInfo, vtkInformationVector* outInfo)
+{
+  if (!this->ConcurrentLeafExecution)
+  {
+    return this->Superclass::CallAlgorithm(request, direction, inInfo, outInfo);
+  }
+
+  // The algorithm may be running concurrently on several leaves, so the
+  // InAlgorithm flag of the executive is left alone.
+
+  // Copy default information in the direction of information flow.
+  this->CopyDefaultInformation(request, direction, inInfo, outInfo);
+
+  // Invoke the request on the algorithm.
+  vtkPipelineProfiler* profiler = this->Profiler;
+  if (profiler)
+  {
+    profiler->StartPass(this, request);
+  }
+  int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  if (profiler)
+  {
+    profiler->EndPass(this, request, outInfo);
+  }
+
+  // If the algorithm failed report it now.
+  if (!result)
+  {
+    vtkErrorMacro("Algorithm " << this->Algorithm->GetObjectDescription()
+                               << " returned failure for request: " << *request);
+  }
+
+  return result;
 }
 VTK_ABI_NAMESPACE_END
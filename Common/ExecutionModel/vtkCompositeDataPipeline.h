@@ -116,6 +116,58 @@ public:
    */
   static vtkInformationDoubleKey* BLOCK_AMOUNT_OF_DETAIL();
 
+  ///@{
+  /**
+   * When on, a simple (non composite-aware) algorithm is executed concurrently
+   * on the leaves of its composite input using vtkSMPTools, and its outputs
+   * are assembled in composite datasets with the structure of the input.
+   * This requires the algorithm to implement all pipeline passes in a
+   * re-entrant way: it should store/retrieve all state changes using the
+   * input and output information objects, which are unique to each thread.
+   * Default is off.
+   */
+  vtkSetMacro(ConcurrentLeafExecution, bool);
+  vtkGetMacro(ConcurrentLeafExecution, bool);
+  vtkBooleanMacro(ConcurrentLeafExecution, bool);
+  ///@}
+
+  ///@{
+  /**
+   * When on, the leaves are executed concurrently from the largest to the
+   * smallest, according to their number of cells (or points, or rows), and
+   * handed to the threads one at a time, so that uneven leaves are balanced
+   * between the threads: a few large leaves do not end up on the same thread
+   * after the small ones. When off, the leaves are split in contiguous
+   * ranges in traversal order. Only used with ConcurrentLeafExecution.
+   * Default is on.
+   */
+  vtkSetMacro(SizeOrderedLeafExecution, bool);
+  vtkGetMacro(SizeOrderedLeafExecution, bool);
+  vtkBooleanMacro(SizeOrderedLeafExecution, bool);
+  ///@}
+
+  ///@{
+  /**
+   * When on, the leaves are executed concurrently with the nested
+   * parallelism of vtkSMPTools enabled, so that the algorithm can use
+   * vtkSMPTools itself: the threads left idle once the small leaves are done
+   * help with the large ones. Only used with ConcurrentLeafExecution.
+   * Default is on.
+   *
+   * @sa vtkSMPTools::SetNestedParallelism
+   */
+  vtkSetMacro(NestedLeafParallelism, bool);
+  vtkGetMacro(NestedLeafParallelism, bool);
+  vtkBooleanMacro(NestedLeafParallelism, bool);
+  ///@}
+
+  /**
+   * An API to CallAlgorithm that allows you to pass in the info objects to
+   * be used
+   */
+  int CallAlgorithm(vtkInformation* request, int direction, vtkInformationVector** inInfo,
+    vtkInformationVector* outInfo) override;
+
 protected:
   vtkCompositeDataPipeline();
   ~vtkCompositeDataPipeline() override;
@@ -160,6 +212,11 @@ protected:
     vtkInformationVector* outInfoVec, int compositePort, int connection, vtkInformation* request,
     std::vector<vtkSmartPointer<vtkCompositeDataSet>>& compositeOutput);
 
+  // Implementation of ExecuteEach() used when ConcurrentLeafExecution is on.
+  void ExecuteEachConcurrently(vtkCompositeDataIterator* iter, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec, int compositePort, int connection, vtkInformation* request,
+    std::vector<vtkSmartPointer<vtkCompositeDataSet>>& compositeOutput);
+
   std::vector<vtkDataObject*> ExecuteSimpleAlgorithmForBlock(vtkInformationVector** inInfoVec,
     vtkInformationVector* outInfoVec, vtkInformation* inInfo, vtkInformation* request,
     vtkDataObject* dobj);
@@ -207,9 +264,14 @@ protected:
    */
   static vtkInformationIntegerVectorKey* DATA_COMPOSITE_INDICES();
 
+  bool ConcurrentLeafExecution;
+  bool SizeOrderedLeafExecution;
+  bool NestedLeafParallelism;
+
 private:
   vtkCompositeDataPipeline(const vtkCompositeDataPipeline&) = delete;
   void operator=(const vtkCompositeDataPipeline&) = delete;
+  friend class ProcessBlock;
 };
 
 VTK_ABI_NAMESPACE_END
@@ -0,0 +1,204 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConcurrentBranchPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkConcurrentBranchPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <set>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkConcurrentBranchPipeline);
+
+vtkInformationKeyMacro(vtkConcurrentBranchPipeline, THREAD_SAFE, Integer);
+
+namespace
+{
+struct Branch
+{
+  vtkExecutive* Executive;
+  int ProducerPort;
+  std::set<vtkExecutive*> Upstream;
+  bool Concurrent;
+  int Result;
+};
+
+void CollectUpstream(vtkExecutive* executive, std::set<vtkExecutive*>& upstream)
+{
+  if (!upstream.insert(executive).second)
+  {
+    return;
+  }
+  for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+  {
+    for (int j = 0; j < executive->GetNumberOfInputConnections(i); ++j)
+    {
+      if (vtkExecutive* input = executive->GetInputExecutive(i, j))
+      {
+        CollectUpstream(input, upstream);
+      }
+    }
+  }
+}
+
+bool IsThreadSafe(const std::set<vtkExecutive*>& upstream)
+{
+  for (vtkExecutive* executive : upstream)
+  {
+    vtkAlgorithm* algorithm = executive->GetAlgorithm();
+    if (!algorithm ||
+      !algorithm->GetInformation()->Get(vtkConcurrentBranchPipeline::THREAD_SAFE()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Intersects(const std::set<vtkExecutive*>& a, const std::set<vtkExecutive*>& b)
+{
+  for (vtkExecutive* executive : a)
+  {
+    if (b.count(executive))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+}
+
+//------------------------------------------------------------------------------
+vtkConcurrentBranchPipeline::vtkConcurrentBranchPipeline() = default;
+
+//------------------------------------------------------------------------------
+vtkConcurrentBranchPipeline::~vtkConcurrentBranchPipeline() = default;
+
+//------------------------------------------------------------------------------
+void vtkConcurrentBranchPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+
+//------------------------------------------------------------------------------
+int vtkConcurrentBranchPipeline::ForwardUpstream(vtkInformation* request)
+{
+  // Do not forward upstream if the input is shared with another
+  // executive.
+  if (this->SharedInputInformation || !request->Has(REQUEST_DATA()))
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  // Gather the branches and find the ones that can be updated concurrently.
+  std::vector<Branch> branches;
+  for (int i = 0; i < this->GetNumberOfInputPorts(); ++i)
+  {
+    vtkInformationVector* inVector = this->GetInputInformation()[i];
+    for (int j = 0; j < this->Algorithm->GetNumberOfInputConnections(i); ++j)
+    {
+      vtkInformation* info = inVector->GetInformationObject(j);
+      vtkExecutive* e;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(info, e, producerPort);
+      if (e)
+      {
+        Branch branch;
+        branch.Executive = e;
+        branch.ProducerPort = producerPort;
+        CollectUpstream(e, branch.Upstream);
+        branch.Concurrent = IsThreadSafe(branch.Upstream);
+        branch.Result = 1;
+        branches.push_back(std::move(branch));
+      }
+    }
+  }
+  std::vector<Branch*> concurrentBranches;
+  for (Branch& branch : branches)
+  {
+    for (Branch& other : branches)
+    {
+      if (branch.Concurrent && &other != &branch && Intersects(branch.Upstream, other.Upstream))
+      {
+        branch.Concurrent = false;
+      }
+    }
+    if (branch.Concurrent)
+    {
+      concurrentBranches.push_back(&branch);
+    }
+  }
+  if (concurrentBranches.size() < 2)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+  {
+    return 0;
+  }
+
+  vtkDebugMacro(<< "Updating " << concurrentBranches.size() << " branches concurrently");
+  vtkSMPTools::For(0, static_cast<vtkIdType>(concurrentBranches.size()), 1,
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        // Executives modify the request while processing it. Note that
+        // vtkInformation::Copy() does not copy the request key.
+        Branch* branch = concurrentBranches[i];
+        vtkNew<vtkInformation> branchRequest;
+        branchRequest->Copy(request, 1);
+        branchRequest->Set(REQUEST_DATA());
+        branchRequest->Set(FROM_OUTPUT_PORT(), branch->ProducerPort);
+        vtkExecutive* e = branch->Executive;
+        branch->Result =
+          e->ProcessRequest(branchRequest, e->GetInputInformation(), e->GetOutputInformation());
+      }
+    });
+
+  // Then the other branches, in order.
+  int result = 1;
+  const int port = request->Get(FROM_OUTPUT_PORT());
+  for (Branch& branch : branches)
+  {
+    if (!branch.Concurrent)
+    {
+      vtkExecutive* e = branch.Executive;
+      request->Set(FROM_OUTPUT_PORT(), branch.ProducerPort);
+      branch.Result =
+        e->ProcessRequest(request, e->GetInputInformation(), e->GetOutputInformation());
+      request->Set(FROM_OUTPUT_PORT(), port);
+    }
+    if (!branch.Result)
+    {
+      result = 0;
+    }
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  {
+    return 0;
+  }
+
+  return result;
+}
+VTK_ABI_NAMESPACE_END
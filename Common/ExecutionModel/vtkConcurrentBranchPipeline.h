@@ -0,0 +1,88 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConcurrentBranchPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConcurrentBranchPipeline
+ * @brief   Executive updating independent input branches concurrently
+ *
+ * The standard executives update the input connections of an algorithm one
+ * after the other. vtkConcurrentBranchPipeline instead forwards REQUEST_DATA
+ * to independent upstream branches as tasks of vtkSMPTools, so that, for
+ * instance, the two inputs of vtkProbeFilter or the inputs of vtkAppendFilter
+ * are produced at the same time, a reader waiting for I/O overlapping with a
+ * compute-bound branch.
+ *
+ * A branch is the set of algorithms upstream of an input connection. It is
+ * updated concurrently with the other branches only when:
+ * - it shares no algorithm with another branch, and
+ * - all of its algorithms are declared thread safe by setting THREAD_SAFE()
+ *   in their vtkAlgorithm::GetInformation(). Such an algorithm must not
+ *   access any state shared with other algorithms (static variables,
+ *   non thread safe libraries) while it executes.
+ * The other branches are updated one after the other, as usual.
+ *
+ * Only the executive of the algorithm consuming the branches needs to be a
+ * vtkConcurrentBranchPipeline. Note that observers of the upstream algorithms
+ * (progress events for instance) are invoked from the threads of vtkSMPTools.
+ *
+ * @code{cpp}
+ * reader->GetInformation()->Set(vtkConcurrentBranchPipeline::THREAD_SAFE(), 1);
+ * source->GetInformation()->Set(vtkConcurrentBranchPipeline::THREAD_SAFE(), 1);
+ * vtkNew<vtkConcurrentBranchPipeline> executive;
+ * probe->SetExecutive(executive);
+ * probe->SetInputConnection(reader->GetOutputPort());
+ * probe->SetSourceConnection(source->GetOutputPort());
+ * probe->Update();
+ * @endcode
+ *
+ * @sa
+ * vtkThreadedCompositeDataPipeline
+ */
+
+#ifndef vtkConcurrentBranchPipeline_h
+#define vtkConcurrentBranchPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkInformationIntegerKey;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkConcurrentBranchPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkConcurrentBranchPipeline* New();
+  vtkTypeMacro(vtkConcurrentBranchPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Key set to 1 in vtkAlgorithm::GetInformation() to declare that an
+   * algorithm can execute concurrently with other algorithms.
+   */
+  static vtkInformationIntegerKey* THREAD_SAFE();
+
+protected:
+  vtkConcurrentBranchPipeline();
+  ~vtkConcurrentBranchPipeline() override;
+
+  int ForwardUpstream(vtkInformation* request) override;
+  using vtkCompositeDataPipeline::ForwardUpstream;
+
+private:
+  vtkConcurrentBranchPipeline(const vtkConcurrentBranchPipeline&) = delete;
+  void operator=(const vtkConcurrentBranchPipeline&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
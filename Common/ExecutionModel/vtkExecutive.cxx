@@ -26,6 +26,7 @@
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 
 #include <sstream>
@@ -121,6 +122,7 @@ vtkExecutive::vtkExecutive()
   this->InAlgorithm = 0;
   this->SharedInputInformation = nullptr;
   this->SharedOutputInformation = nullptr;
+  this->Profiler = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -731,9 +733,18 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  vtkPipelineProfiler* profiler = this->Profiler;
+  if (profiler)
+  {
+    profiler->StartPass(this, request);
+  }
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
   this->InAlgorithm = 0;
+  if (profiler)
+  {
+    profiler->EndPass(this, request, outInfo);
+  }
 
   // If the algorithm failed report it now.
   if (!result)
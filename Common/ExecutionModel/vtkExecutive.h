@@ -43,6 +43,7 @@ class vtkInformationIntegerKey;
 class vtkInformationRequestKey;
 class vtkInformationKeyVectorKey;
 class vtkInformationVector;
+class vtkPipelineProfiler;
 
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkExecutive : public vtkObject
 {
@@ -227,6 +228,15 @@ public:
   virtual int CallAlgorithm(vtkInformation* request, int direction, vtkInformationVector** inInfo,
     vtkInformationVector* outInfo);
 
+  ///@{
+  /**
+   * Set/Get the profiler recording the requests processed by the algorithm.
+   * No reference is held, see vtkPipelineProfiler::Attach().
+   */
+  void SetProfiler(vtkPipelineProfiler* profiler) { this->Profiler = profiler; }
+  vtkPipelineProfiler* GetProfiler() { return this->Profiler; }
+  ///@}
+
 protected:
   vtkExecutive();
   ~vtkExecutive() override;
@@ -280,6 +290,10 @@ protected:
   vtkInformationVector** SharedInputInformation;
   vtkInformationVector* SharedOutputInformation;
 
+  // Profiler notified of the requests processed by the algorithm. No
+  // reference is held.
+  vtkPipelineProfiler* Profiler;
+
 private:
   // Store an information object for each output port of the algorithm.
   vtkInformationVector* OutputInformation;
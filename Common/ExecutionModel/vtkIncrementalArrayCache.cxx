@@ -0,0 +1,142 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkIncrementalArrayCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkIncrementalArrayCache.h"
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimeStamp.h"
+#include "vtkWeakPointer.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+class vtkIncrementalArrayCache::vtkInternals
+{
+public:
+  std::vector<vtkWeakPointer<vtkDataArray>> Inputs;
+  std::vector<vtkIdType> InputSizes;
+  vtkSmartPointer<vtkDataArray> Output;
+  vtkIdType OutputSize = 0;
+  vtkTimeStamp UpdateTime;
+};
+
+vtkStandardNewMacro(vtkIncrementalArrayCache);
+
+//------------------------------------------------------------------------------
+vtkIncrementalArrayCache::vtkIncrementalArrayCache()
+  : Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkIncrementalArrayCache::~vtkIncrementalArrayCache() = default;
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkIncrementalArrayCache::GetCachedOutput(
+  vtkObject* filter, int numberOfInputs, vtkDataArray** inputs, vtkIdTypeArray* ranges)
+{
+  vtkInternals& internals = *this->Internals;
+  const vtkMTimeType updateTime = internals.UpdateTime.GetMTime();
+  vtkDataArray* output = internals.Output;
+  if (!output || output->GetReferenceCount() != 1 || output->GetMTime() > updateTime ||
+    output->GetNumberOfTuples() != internals.OutputSize || filter->GetMTime() > updateTime ||
+    static_cast<int>(internals.Inputs.size()) != numberOfInputs)
+  {
+    return nullptr;
+  }
+
+  std::vector<std::pair<vtkIdType, vtkIdType>> collected;
+  vtkNew<vtkIdTypeArray> inputRanges;
+  for (int i = 0; i < numberOfInputs; ++i)
+  {
+    vtkDataArray* input = inputs[i];
+    if (input != internals.Inputs[i])
+    {
+      return nullptr;
+    }
+    if (!input)
+    {
+      continue;
+    }
+    if (input->GetNumberOfTuples() != internals.InputSizes[i] ||
+      !input->GetModifiedRanges(updateTime, inputRanges))
+    {
+      return nullptr;
+    }
+    for (vtkIdType r = 0; r < inputRanges->GetNumberOfTuples(); ++r)
+    {
+      collected.emplace_back(inputRanges->GetTypedComponent(r, 0),
+        std::min(inputRanges->GetTypedComponent(r, 1), internals.OutputSize));
+    }
+  }
+
+  // Merge the ranges of all the inputs.
+  std::sort(collected.begin(), collected.end());
+  ranges->Initialize();
+  ranges->SetNumberOfComponents(2);
+  for (const auto& range : collected)
+  {
+    const vtkIdType last = ranges->GetNumberOfTuples() - 1;
+    if (last >= 0 && range.first <= ranges->GetTypedComponent(last, 1))
+    {
+      ranges->SetTypedComponent(
+        last, 1, std::max(range.second, ranges->GetTypedComponent(last, 1)));
+    }
+    else if (range.first < range.second)
+    {
+      const vtkIdType tuple[2] = { range.first, range.second };
+      ranges->InsertNextTypedTuple(tuple);
+    }
+  }
+  return output;
+}
+
+//------------------------------------------------------------------------------
+void vtkIncrementalArrayCache::SetCachedOutput(
+  int numberOfInputs, vtkDataArray** inputs, vtkDataArray* output)
+{
+  vtkInternals& internals = *this->Internals;
+  internals.Inputs.assign(inputs, inputs + numberOfInputs);
+  internals.InputSizes.clear();
+  for (int i = 0; i < numberOfInputs; ++i)
+  {
+    internals.InputSizes.push_back(inputs[i] ? inputs[i]->GetNumberOfTuples() : 0);
+  }
+  internals.Output = output;
+  internals.OutputSize = output ? output->GetNumberOfTuples() : 0;
+  internals.UpdateTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkIncrementalArrayCache::Initialize()
+{
+  this->Internals->Inputs.clear();
+  this->Internals->InputSizes.clear();
+  this->Internals->Output = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkIncrementalArrayCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Output: " << this->Internals->Output.Get() << endl;
+}
+VTK_ABI_NAMESPACE_END
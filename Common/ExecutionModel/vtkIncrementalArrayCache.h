@@ -0,0 +1,90 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkIncrementalArrayCache.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkIncrementalArrayCache
+ * @brief   Keep the output array of a filter to update it incrementally
+ *
+ * vtkIncrementalArrayCache is used by the filters computing an output array
+ * tuple by tuple from input arrays with the same number of tuples, such as
+ * vtkElevationFilter. It keeps the output array of the last execution, so that
+ * the next execution recomputes only the tuples of the input arrays recorded
+ * as modified by vtkDataArray::ModifiedRange(), or nothing at all if the input
+ * arrays were not modified.
+ *
+ * The filter calls GetCachedOutput() at the beginning of its execution. If it
+ * returns an array, the filter recomputes the tuples in the returned ranges
+ * into it, and calls vtkDataArray::ModifiedRange() on it so that the filters
+ * downstream can update their outputs incrementally as well. Otherwise it
+ * executes entirely. In both cases, it calls SetCachedOutput() at the end of
+ * its execution.
+ *
+ * @sa
+ * vtkDataArray
+ */
+
+#ifndef vtkIncrementalArrayCache_h
+#define vtkIncrementalArrayCache_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <memory> // For unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+class vtkIdTypeArray;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkIncrementalArrayCache : public vtkObject
+{
+public:
+  static vtkIncrementalArrayCache* New();
+  vtkTypeMacro(vtkIncrementalArrayCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Get the output array of the last execution if it can be updated in
+   * place, and fill ranges with the [begin, end) ranges of the tuples to
+   * recompute. This requires the filter not to be modified since the last
+   * execution, the same input arrays with the same number of tuples, modified
+   * only by ranges, and an output array not referenced anywhere else.
+   * Returns nullptr otherwise. Null input arrays are allowed.
+   */
+  vtkDataArray* GetCachedOutput(
+    vtkObject* filter, int numberOfInputs, vtkDataArray** inputs, vtkIdTypeArray* ranges);
+
+  /**
+   * Keep the output array computed from the given input arrays.
+   */
+  void SetCachedOutput(int numberOfInputs, vtkDataArray** inputs, vtkDataArray* output);
+
+  /**
+   * Release the cached output array.
+   */
+  void Initialize();
+
+protected:
+  vtkIncrementalArrayCache();
+  ~vtkIncrementalArrayCache() override;
+
+private:
+  vtkIncrementalArrayCache(const vtkIncrementalArrayCache&) = delete;
+  void operator=(const vtkIncrementalArrayCache&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -27,6 +27,10 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkMultiTimeStepAlgorithm);
 
@@ -40,6 +44,33 @@ vtkMultiTimeStepAlgorithm::vtkMultiTimeStepAlgorithm()
   this->SetNumberOfInputPorts(1);
   this->CacheData = false;
   this->NumberOfCacheEntries = 1;
+  this->MaximumNumberOfTimeStepsInFlight = 16;
+}
+
+//------------------------------------------------------------------------------
+void vtkMultiTimeStepAlgorithm::AddTimeStepSource(vtkAlgorithm* source)
+{
+  if (source)
+  {
+    this->TimeStepSources.emplace_back(source);
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkMultiTimeStepAlgorithm::RemoveAllTimeStepSources()
+{
+  if (!this->TimeStepSources.empty())
+  {
+    this->TimeStepSources.clear();
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkMultiTimeStepAlgorithm::GetNumberOfTimeStepSources()
+{
+  return static_cast<int>(this->TimeStepSources.size());
 }
 
 //------------------------------------------------------------------------------
@@ -136,25 +167,13 @@ vtkTypeBool vtkMultiTimeStepAlgorithm::ProcessRequest(
     this->RequestUpdateIndex++;
 
     const size_t nTimeSteps = this->UpdateTimeSteps.size();
-    if (this->RequestUpdateIndex == static_cast<int>(nTimeSteps)) // all the time steps are here
+    const bool concurrent = !this->TimeStepSources.empty() && this->RequestUpdateIndex == 1;
+    if (concurrent || this->RequestUpdateIndex == static_cast<int>(nTimeSteps))
     {
-      // try calling the newer / recommended API first.
-      std::vector<vtkSmartPointer<vtkDataObject>> inputs(nTimeSteps);
-      for (size_t cc = 0; cc < nTimeSteps; ++cc)
-      {
-        if (this->IsInCache(this->UpdateTimeSteps[cc], idx))
-        {
-          inputs[cc] = this->Cache[idx].Data;
-        }
-        else
-        {
-          // This should never happen
-          vtkErrorMacro("exceptional condition reached! Please report.");
-          return 0;
-        }
-      }
-
-      retVal = this->Execute(request, inputs, outputVector);
+      // Either all the time steps are here, or the time step sources obtain
+      // the other ones.
+      retVal = concurrent ? this->ExecuteTimeStepsConcurrently(request, inInfo, outputVector)
+                          : this->ExecuteTimeSteps(request, outputVector);
 
       this->UpdateTimeSteps.clear();
       this->RequestUpdateIndex = 0;
@@ -165,14 +184,7 @@ vtkTypeBool vtkMultiTimeStepAlgorithm::ProcessRequest(
       }
       else
       {
-        // Caching, erase ones outside the cache
-        // Note that this is a first in first out implementation
-        size_t cacheSize = this->Cache.size();
-        if (cacheSize > this->NumberOfCacheEntries)
-        {
-          size_t nToErase = cacheSize - this->NumberOfCacheEntries;
-          this->Cache.erase(this->Cache.begin(), this->Cache.begin() + nToErase);
-        }
+        this->TrimCache();
       }
       request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
     }
@@ -195,9 +207,222 @@ vtkTypeBool vtkMultiTimeStepAlgorithm::ProcessRequest(
   return this->Superclass::ProcessRequest(request, inputVector, outputVector);
 }
 
+//------------------------------------------------------------------------------
+int vtkMultiTimeStepAlgorithm::ExecuteTimeSteps(
+  vtkInformation* request, vtkInformationVector* outputVector)
+{
+  // try calling the newer / recommended API first.
+  const size_t nTimeSteps = this->UpdateTimeSteps.size();
+  std::vector<vtkSmartPointer<vtkDataObject>> inputs(nTimeSteps);
+  for (size_t cc = 0; cc < nTimeSteps; ++cc)
+  {
+    size_t idx;
+    if (this->IsInCache(this->UpdateTimeSteps[cc], idx))
+    {
+      inputs[cc] = this->Cache[idx].Data;
+    }
+    else
+    {
+      // This should never happen
+      vtkErrorMacro("exceptional condition reached! Please report.");
+      return 0;
+    }
+  }
+
+  int reduced = -1;
+  for (size_t cc = 0; cc < nTimeSteps && reduced != 0; ++cc)
+  {
+    reduced = this->ReduceTimeStep(request, static_cast<int>(cc), inputs[cc], outputVector);
+    if (reduced == -1)
+    {
+      return this->Execute(request, inputs, outputVector);
+    }
+  }
+  return reduced ? this->Execute(request, {}, outputVector) : 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkMultiTimeStepAlgorithm::TrimCache()
+{
+  // Erase the entries outside of the cache, first in first out
+  size_t cacheSize = this->Cache.size();
+  if (cacheSize > this->NumberOfCacheEntries)
+  {
+    size_t nToErase = cacheSize - this->NumberOfCacheEntries;
+    this->Cache.erase(this->Cache.begin(), this->Cache.begin() + nToErase);
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkMultiTimeStepAlgorithm::ExecuteTimeStepsConcurrently(
+  vtkInformation* request, vtkInformation* inInfo, vtkInformationVector* outputVector)
+{
+  // The first time step comes from the input, and is in the cache. The time
+  // steps not in the cache are obtained by the time step sources.
+  const size_t nTimeSteps = this->UpdateTimeSteps.size();
+  std::vector<vtkSmartPointer<vtkDataObject>> inputs(nTimeSteps);
+  std::vector<size_t> pending;
+  for (size_t cc = 0; cc < nTimeSteps; ++cc)
+  {
+    size_t idx;
+    if (this->IsInCache(this->UpdateTimeSteps[cc], idx))
+    {
+      inputs[cc] = this->Cache[idx].Data;
+    }
+    else
+    {
+      pending.push_back(cc);
+    }
+  }
+  if (!inputs[0])
+  {
+    vtkErrorMacro("exceptional condition reached! Please report.");
+    return 0;
+  }
+
+  // Whether the subclass reduces the time steps is known from the first one.
+  int reduced = this->ReduceTimeStep(request, 0, inputs[0], outputVector);
+  const bool reduce = reduced != -1;
+  if (reduced == 0)
+  {
+    return 0;
+  }
+  if (reduce)
+  {
+    inputs[0] = nullptr;
+  }
+
+  // The sources produce the same piece or extent as requested from the input.
+  using vtkSDDP = vtkStreamingDemandDrivenPipeline;
+  int piece = -1;
+  int numPieces = 1;
+  int ghostLevels = 0;
+  if (inInfo->Has(vtkSDDP::UPDATE_PIECE_NUMBER()))
+  {
+    piece = inInfo->Get(vtkSDDP::UPDATE_PIECE_NUMBER());
+    numPieces = inInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_PIECES());
+    ghostLevels = inInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+  }
+  int extent[6];
+  const int* updateExtent = nullptr;
+  if (inInfo->Has(vtkSDDP::UPDATE_EXTENT()))
+  {
+    inInfo->Get(vtkSDDP::UPDATE_EXTENT(), extent);
+    updateExtent = extent;
+  }
+
+  // When reducing, a time step is only obtained when it is less than
+  // MaximumNumberOfTimeStepsInFlight time steps after the next one to reduce.
+  const size_t window =
+    reduce ? static_cast<size_t>(this->MaximumNumberOfTimeStepsInFlight) : nTimeSteps;
+  std::mutex mutex;
+  std::condition_variable condition;
+  size_t next = 0;     // index in pending of the next time step to obtain
+  size_t toReduce = 1; // next time step to reduce
+  bool failed = false;
+  auto obtain = [&](vtkAlgorithm* source) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+      condition.wait(lock, [&]() {
+        return failed || next == pending.size() || pending[next] < toReduce + window;
+      });
+      if (failed || next == pending.size())
+      {
+        return;
+      }
+      const size_t cc = pending[next++];
+      const double time = this->UpdateTimeSteps[cc];
+      lock.unlock();
+
+      vtkSmartPointer<vtkDataObject> copy;
+      vtkDataObject* output =
+        source->UpdateTimeStep(time, piece, numPieces, ghostLevels, updateExtent)
+        ? source->GetOutputDataObject(0)
+        : nullptr;
+      if (output)
+      {
+        copy.TakeReference(output->NewInstance());
+        copy->ShallowCopy(output);
+      }
+
+      lock.lock();
+      if (copy)
+      {
+        inputs[cc] = copy;
+      }
+      else
+      {
+        vtkErrorMacro("Time step source failed to produce time " << time);
+        failed = true;
+      }
+      condition.notify_all();
+    }
+  };
+
+  std::vector<std::future<void>> workers;
+  for (size_t i = 0; i < this->TimeStepSources.size() && i < pending.size(); ++i)
+  {
+    vtkAlgorithm* source = this->TimeStepSources[i];
+    workers.emplace_back(std::async(std::launch::async, [&obtain, source]() { obtain(source); }));
+  }
+
+  if (reduce)
+  {
+    for (size_t cc = 1; cc < nTimeSteps; ++cc)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [&]() { return failed || inputs[cc]; });
+      if (failed)
+      {
+        break;
+      }
+      vtkSmartPointer<vtkDataObject> input = std::move(inputs[cc]);
+      lock.unlock();
+
+      reduced = this->ReduceTimeStep(request, static_cast<int>(cc), input, outputVector);
+      size_t idx;
+      if (this->CacheData && !this->IsInCache(this->UpdateTimeSteps[cc], idx))
+      {
+        this->Cache.emplace_back(this->UpdateTimeSteps[cc], input);
+        this->TrimCache();
+      }
+
+      lock.lock();
+      failed = failed || !reduced;
+      toReduce = cc + 1;
+      condition.notify_all();
+    }
+  }
+  for (auto& worker : workers)
+  {
+    worker.wait();
+  }
+  if (failed)
+  {
+    return 0;
+  }
+  if (reduce)
+  {
+    return this->Execute(request, {}, outputVector);
+  }
+
+  if (this->CacheData)
+  {
+    for (size_t cc : pending)
+    {
+      this->Cache.emplace_back(this->UpdateTimeSteps[cc], inputs[cc]);
+    }
+  }
+  return this->Execute(request, inputs, outputVector);
+}
+
 //------------------------------------------------------------------------------
 void vtkMultiTimeStepAlgorithm::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfTimeStepSources: " << this->TimeStepSources.size() << endl;
+  os << indent << "MaximumNumberOfTimeStepsInFlight: " << this->MaximumNumberOfTimeStepsInFlight
+     << endl;
 }
 VTK_ABI_NAMESPACE_END
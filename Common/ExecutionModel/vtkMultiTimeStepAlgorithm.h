@@ -33,6 +33,22 @@
  * vtkPartitionedDataSetCollection in VTK 9.2, it is not possible to package all
  * input data types into a multiblock dataset. Hence, the method is deprecated
  * and only used when `Execute` is not overridden.
+ *
+ * By default, the upstream pipeline is executed once per requested timestep,
+ * one timestep after the other. When time step sources are added with
+ * `AddTimeStepSource`, only the first timestep is obtained from the input,
+ * and the other ones are obtained concurrently by the time step sources, one
+ * timestep per source at a time. A time step source must produce the same
+ * data as the input and share no algorithm with the input pipeline, such as
+ * another instance of the reader at the beginning of the input pipeline. It
+ * is asked for the piece, ghost levels and update extent requested from the
+ * input.
+ *
+ * Subclasses can also override `ReduceTimeStep` to process the timesteps one
+ * at a time, in order, instead of receiving all of them in `Execute`. With
+ * time step sources, the timesteps are then reduced as soon as they are
+ * obtained, and at most `MaximumNumberOfTimeStepsInFlight` timesteps are
+ * kept in memory.
  */
 
 #ifndef vtkMultiTimeStepAlgorithm_h
@@ -55,6 +71,28 @@ public:
   vtkTypeMacro(vtkMultiTimeStepAlgorithm, vtkAlgorithm);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * Add/remove the sources used to obtain the requested timesteps after the
+   * first one concurrently. Each source is updated by its own thread, so it
+   * must not share any algorithm with the input pipeline or with the other
+   * sources.
+   */
+  void AddTimeStepSource(vtkAlgorithm* source);
+  void RemoveAllTimeStepSources();
+  int GetNumberOfTimeStepSources();
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of timesteps obtained by the time step sources ahead of
+   * the timestep to reduce, when `ReduceTimeStep` is overridden. This bounds
+   * the memory used while reducing. Default is 16.
+   */
+  vtkSetClampMacro(MaximumNumberOfTimeStepsInFlight, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfTimeStepsInFlight, int);
+  ///@}
+
 protected:
   vtkMultiTimeStepAlgorithm();
 
@@ -102,6 +140,20 @@ protected:
     return -1;
   }
 
+  /**
+   * Subclasses can override this method to reduce the requested timesteps
+   * one at a time, in the requested order, instead of receiving all of them
+   * in `Execute`. `Execute` is then called with an empty vector of inputs
+   * once all the timesteps are reduced, to finalize the output. Returns 1 on
+   * success and 0 on failure. The default implementation returns -1, which
+   * means that the method is not overridden.
+   */
+  virtual int ReduceTimeStep(vtkInformation* vtkNotUsed(request), int vtkNotUsed(index),
+    vtkDataObject* vtkNotUsed(input), vtkInformationVector* vtkNotUsed(outputVector))
+  {
+    return -1;
+  }
+
   /**
    * This is called by the superclass.
    * This is the method you should override.
@@ -116,6 +168,7 @@ protected:
 
   bool CacheData;
   unsigned int NumberOfCacheEntries;
+  int MaximumNumberOfTimeStepsInFlight;
 
 private:
   vtkMultiTimeStepAlgorithm(const vtkMultiTimeStepAlgorithm&) = delete;
@@ -123,6 +176,11 @@ private:
   int RequestUpdateIndex;              // keep track of the time looping index
   std::vector<double> UpdateTimeSteps; // store the requested time steps
   bool IsInCache(double time, size_t& idx);
+  int ExecuteTimeSteps(vtkInformation* request, vtkInformationVector* outputVector);
+  int ExecuteTimeStepsConcurrently(
+    vtkInformation* request, vtkInformation* inInfo, vtkInformationVector* outputVector);
+  void TrimCache();
+  std::vector<vtkSmartPointer<vtkAlgorithm>> TimeStepSources;
   struct TimeCache
   {
     TimeCache(double time, vtkDataObject* data)
@@ -14,11 +14,20 @@
 =========================================================================*/
 #include "vtkParallelReader.h"
 
+#include "vtkDataObjectTypes.h"
 #include "vtkInformation.h"
+#include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <numeric>
 #include <vector>
 
@@ -27,6 +36,9 @@ struct vtkParallelReaderInternal
 {
   using FileNamesType = std::vector<std::string>;
   FileNamesType FileNames;
+  // Data type declared by FillOutputPortInformation(), used for the
+  // partitions when reading the files as partitions.
+  std::string PartitionType;
 };
 
 //------------------------------------------------------------------------------
@@ -34,6 +46,8 @@ vtkParallelReader::vtkParallelReader()
 {
   this->Internal = new vtkParallelReaderInternal;
   this->CurrentFileIndex = -1;
+  this->ReadFilesAsPartitions = false;
+  this->MaximumNumberOfConcurrentReads = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -46,6 +60,62 @@ vtkParallelReader::~vtkParallelReader()
 void vtkParallelReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ReadFilesAsPartitions: " << this->ReadFilesAsPartitions << endl;
+  os << indent << "MaximumNumberOfConcurrentReads: " << this->MaximumNumberOfConcurrentReads
+     << endl;
+}
+
+//------------------------------------------------------------------------------
+void vtkParallelReader::SetReadFilesAsPartitions(bool partitions)
+{
+  if (this->ReadFilesAsPartitions == partitions)
+  {
+    return;
+  }
+  this->ReadFilesAsPartitions = partitions;
+
+  // The output port declares the data type of the output, so that the
+  // executive does not replace it.
+  vtkNew<vtkInformation> declared;
+  this->FillOutputPortInformation(0, declared);
+  const char* type =
+    partitions ? "vtkPartitionedDataSet" : declared->Get(vtkDataObject::DATA_TYPE_NAME());
+  vtkInformation* portInfo = this->GetOutputPortInformation(0);
+  if (type)
+  {
+    portInfo->Set(vtkDataObject::DATA_TYPE_NAME(), type);
+  }
+  else
+  {
+    portInfo->Remove(vtkDataObject::DATA_TYPE_NAME());
+  }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkDataObject* vtkParallelReader::CreateOutput(vtkDataObject* currentOutput)
+{
+  if (!this->ReadFilesAsPartitions)
+  {
+    return this->Superclass::CreateOutput(currentOutput);
+  }
+
+  vtkNew<vtkInformation> declared;
+  const char* type = this->FillOutputPortInformation(0, declared)
+    ? declared->Get(vtkDataObject::DATA_TYPE_NAME())
+    : nullptr;
+  if (!type)
+  {
+    vtkErrorMacro("The output port does not specify the data type of the partitions.");
+    return nullptr;
+  }
+  this->Internal->PartitionType = type;
+
+  if (vtkPartitionedDataSet::SafeDownCast(currentOutput))
+  {
+    return currentOutput;
+  }
+  return vtkPartitionedDataSet::New();
 }
 
 //------------------------------------------------------------------------------
@@ -93,10 +163,10 @@ int vtkParallelReader::ReadMetaData(vtkInformation* metadata)
 {
   metadata->Set(vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), 1);
 
-  if (this->Internal->FileNames.empty())
+  if (this->Internal->FileNames.empty() || this->ReadFilesAsPartitions)
   {
-    // No file names specified. No meta-data. There is still
-    // no need to return with an error.
+    // No file names specified, or no file series. No meta-data. There is
+    // still no need to return with an error.
     return 1;
   }
 
@@ -135,6 +205,12 @@ int vtkParallelReader::ReadMetaData(vtkInformation* metadata)
 int vtkParallelReader::ReadMesh(
   int piece, int npieces, int nghosts, int timestep, vtkDataObject* output)
 {
+  if (this->ReadFilesAsPartitions)
+  {
+    this->CurrentFileIndex = -1;
+    return this->ReadPartitions(piece, npieces, output);
+  }
+
   int nTimes = static_cast<int>(this->Internal->FileNames.size());
   if (timestep >= nTimes)
   {
@@ -155,6 +231,12 @@ int vtkParallelReader::ReadMesh(
 int vtkParallelReader::ReadPoints(
   int piece, int npieces, int nghosts, int timestep, vtkDataObject* output)
 {
+  if (this->ReadFilesAsPartitions)
+  {
+    // The partitions are read entirely by ReadMesh().
+    return 1;
+  }
+
   int nTimes = static_cast<int>(this->Internal->FileNames.size());
   if (timestep >= nTimes)
   {
@@ -170,6 +252,12 @@ int vtkParallelReader::ReadPoints(
 int vtkParallelReader::ReadArrays(
   int piece, int npieces, int nghosts, int timestep, vtkDataObject* output)
 {
+  if (this->ReadFilesAsPartitions)
+  {
+    // The partitions are read entirely by ReadMesh().
+    return 1;
+  }
+
   int nTimes = static_cast<int>(this->Internal->FileNames.size());
   if (timestep >= nTimes)
   {
@@ -181,6 +269,86 @@ int vtkParallelReader::ReadArrays(
   return this->ReadArrays(this->Internal->FileNames[timestep], piece, npieces, nghosts, output);
 }
 
+//------------------------------------------------------------------------------
+int vtkParallelReader::ReadPartitions(int piece, int npieces, vtkDataObject* output)
+{
+  vtkPartitionedDataSet* partitioned = vtkPartitionedDataSet::SafeDownCast(output);
+  if (!partitioned)
+  {
+    vtkErrorMacro("The output is not a vtkPartitionedDataSet.");
+    return 0;
+  }
+
+  // Each piece reads a contiguous range of files.
+  const vtkParallelReaderInternal::FileNamesType& fileNames = this->Internal->FileNames;
+  const size_t begin = fileNames.size() * piece / npieces;
+  const size_t end = fileNames.size() * (piece + 1) / npieces;
+  std::vector<vtkSmartPointer<vtkDataObject>> partitions(end - begin);
+  const char* partitionType = this->Internal->PartitionType.c_str();
+  std::atomic<size_t> next(0);
+  std::atomic<bool> failed(false);
+  auto read = [&]() {
+    for (size_t i = next++; i < partitions.size() && !failed; i = next++)
+    {
+      const std::string& fname = fileNames[begin + i];
+      auto partition = vtk::TakeSmartPointer(vtkDataObjectTypes::NewDataObject(partitionType));
+      bool success = false;
+      try
+      {
+        success = partition && this->ReadMesh(fname, 0, 1, 0, partition) &&
+          this->ReadPoints(fname, 0, 1, 0, partition) &&
+          this->ReadArrays(fname, 0, 1, 0, partition);
+      }
+      catch (const std::exception&)
+      {
+        success = false;
+      }
+      if (success)
+      {
+        partitions[i] = partition;
+      }
+      else
+      {
+        failed = true;
+      }
+    }
+  };
+
+  // Reading is mostly bound by the storage, so the number of concurrent
+  // reads is not limited to the number of cores as with vtkSMPTools.
+  size_t numberOfReaders = 1;
+  if (this->CanReadFilesConcurrently())
+  {
+    numberOfReaders = this->MaximumNumberOfConcurrentReads > 0
+      ? static_cast<size_t>(this->MaximumNumberOfConcurrentReads)
+      : static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+    numberOfReaders = std::min(numberOfReaders, partitions.size());
+  }
+  std::vector<std::future<void>> readers;
+  for (size_t i = 1; i < numberOfReaders; ++i)
+  {
+    readers.emplace_back(std::async(std::launch::async, read));
+  }
+  read();
+  for (auto& reader : readers)
+  {
+    reader.wait();
+  }
+
+  partitioned->Initialize();
+  if (failed)
+  {
+    vtkErrorMacro("Failed to read the files of piece " << piece << ".");
+    return 0;
+  }
+  partitioned->SetNumberOfPartitions(static_cast<unsigned int>(partitions.size()));
+  for (size_t i = 0; i < partitions.size(); ++i)
+  {
+    partitioned->SetPartition(static_cast<unsigned int>(i), partitions[i]);
+  }
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 double vtkParallelReader::GetTimeValue(const std::string&)
 {
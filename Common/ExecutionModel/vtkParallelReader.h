@@ -21,6 +21,13 @@
  * can handle piece requests) but do not natively support time series.
  * This reader adds support for file series in order to support time
  * series.
+ *
+ * When ReadFilesAsPartitions is on, the files are instead the partitions of
+ * a single dataset. The output is then a vtkPartitionedDataSet holding one
+ * partition per file assigned to the requested piece. If the subclass can
+ * read different files concurrently (see CanReadFilesConcurrently()), the
+ * files of the piece are read by up to MaximumNumberOfConcurrentReads
+ * threads.
  */
 
 #ifndef vtkParallelReader_h
@@ -65,10 +72,36 @@ public:
 
   /**
    * Returns the filename that was last loaded by the reader.
-   * This is set internally in ReadMesh()
+   * This is set internally in ReadMesh(). Returns nullptr when reading the
+   * files as partitions, as several files are then read at once.
    */
   VTK_FILEPATH const char* GetCurrentFileName() const;
 
+  ///@{
+  /**
+   * When on, the files are the partitions of a single dataset instead of
+   * the time steps of a file series. The files are split between the
+   * requested pieces, and the output is a vtkPartitionedDataSet with one
+   * partition per file of the piece. The partitions have the data type
+   * declared by FillOutputPortInformation(), while the output port declares
+   * vtkPartitionedDataSet. Default is off.
+   */
+  virtual void SetReadFilesAsPartitions(bool partitions);
+  vtkGetMacro(ReadFilesAsPartitions, bool);
+  vtkBooleanMacro(ReadFilesAsPartitions, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of files read at the same time when reading the files
+   * as partitions with a subclass that can read files concurrently. 0, the
+   * default, means the number of threads of vtkSMPTools. The files are read
+   * by threads of their own, so this can exceed the number of cores.
+   */
+  vtkSetClampMacro(MaximumNumberOfConcurrentReads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfConcurrentReads, int);
+  ///@}
+
   ///@{
   /**
    * This is the superclass API overridden by this class
@@ -85,6 +118,12 @@ protected:
   vtkParallelReader();
   ~vtkParallelReader() override;
 
+  /**
+   * Overridden to create a vtkPartitionedDataSet when reading the files as
+   * partitions.
+   */
+  vtkDataObject* CreateOutput(vtkDataObject* currentOutput) override;
+
   /**
    * A subclass can override this method to provide an actual
    * time value for a given file (this method is called for
@@ -93,6 +132,14 @@ protected:
    */
   virtual double GetTimeValue(const std::string& fname);
 
+  /**
+   * A subclass can override this method to return true when the methods
+   * reading a given file can be called concurrently for different files
+   * and output data objects, to read the files as partitions concurrently.
+   * The default implementation returns false.
+   */
+  virtual bool CanReadFilesConcurrently() { return false; }
+
   /**
    * A method that needs to be override by the subclass to provide
    * the mesh (topology). Note that the filename is passed to this
@@ -121,11 +168,15 @@ protected:
     const std::string& fname, int piece, int npieces, int nghosts, vtkDataObject* output) = 0;
 
   int CurrentFileIndex;
+  bool ReadFilesAsPartitions;
+  int MaximumNumberOfConcurrentReads;
 
 private:
   vtkParallelReader(const vtkParallelReader&) = delete;
   void operator=(const vtkParallelReader&) = delete;
 
+  int ReadPartitions(int piece, int npieces, vtkDataObject* output);
+
   vtkParallelReaderInternal* Internal;
 };
 
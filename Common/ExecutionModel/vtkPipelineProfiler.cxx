@@ -0,0 +1,409 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+#include "vtkWeakPointer.h"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h> // Must be included before psapi.h
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Peak resident set size of the process, in kibibytes.
+long long GetPeakResidentSetSize()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+  {
+    return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+  }
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return static_cast<long long>(usage.ru_maxrss / 1024);
+#else
+  return static_cast<long long>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// The name of the request key, REQUEST_DATA for instance.
+std::string GetPassName(vtkInformation* request)
+{
+  vtkInformationRequestKey* key = request->GetRequest();
+  return key ? key->GetName() : "UNKNOWN_REQUEST";
+}
+
+void WriteJSONString(ostream& os, const std::string& str)
+{
+  os << '"';
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      os << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) >= 0x20)
+    {
+      os << c;
+    }
+  }
+  os << '"';
+}
+}
+
+//------------------------------------------------------------------------------
+class vtkPipelineProfiler::vtkInternals
+{
+public:
+  struct Record
+  {
+    vtkAlgorithm* Algorithm;
+    std::string Name;
+    std::string Pass;
+    // Frames of the enclosing requests, separated by ';'.
+    std::string Stack;
+    int Thread;
+    double Start;
+    double WallTime;
+    double SelfWallTime;
+    double CPUTime;
+    double Utilization;
+    unsigned long OutputMemorySize;
+    long long PeakResidentSetSizeDelta;
+  };
+
+  struct RunningPass
+  {
+    Record Pass;
+    double CPUStart;
+    long long PeakResidentSetSizeStart;
+    double ChildrenWallTime;
+  };
+
+  std::mutex Mutex;
+  std::chrono::steady_clock::time_point Origin = std::chrono::steady_clock::now();
+  std::vector<Record> Records;
+  std::map<std::thread::id, std::vector<RunningPass>> Stacks;
+  std::map<std::thread::id, int> Threads;
+  std::vector<vtkWeakPointer<vtkExecutive>> Executives;
+
+  double Now() const
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->Origin).count();
+  }
+
+  template <typename Functor>
+  void ForEachRecord(vtkAlgorithm* algorithm, const char* pass, Functor&& functor)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (const Record& record : this->Records)
+    {
+      if (record.Algorithm == algorithm && (!pass || record.Pass == pass))
+      {
+        functor(record);
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+  : Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler()
+{
+  this->Detach();
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfRecords: " << this->GetNumberOfRecords() << endl;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Attach(vtkExecutive* executive)
+{
+  std::set<vtkExecutive*> visited;
+  std::vector<vtkExecutive*> executives;
+  if (executive)
+  {
+    executives.push_back(executive);
+  }
+  while (!executives.empty())
+  {
+    vtkExecutive* e = executives.back();
+    executives.pop_back();
+    if (!visited.insert(e).second)
+    {
+      continue;
+    }
+    e->SetProfiler(this);
+    this->Internals->Executives.emplace_back(e);
+    for (int i = 0; i < e->GetNumberOfInputPorts(); ++i)
+    {
+      for (int j = 0; j < e->GetNumberOfInputConnections(i); ++j)
+      {
+        if (vtkExecutive* input = e->GetInputExecutive(i, j))
+        {
+          executives.push_back(input);
+        }
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Detach()
+{
+  for (vtkExecutive* executive : this->Internals->Executives)
+  {
+    if (executive && executive->GetProfiler() == this)
+    {
+      executive->SetProfiler(nullptr);
+    }
+  }
+  this->Internals->Executives.clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Records.clear();
+}
+
+//------------------------------------------------------------------------------
+int vtkPipelineProfiler::GetNumberOfRecords()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<int>(this->Internals->Records.size());
+}
+
+//------------------------------------------------------------------------------
+int vtkPipelineProfiler::GetNumberOfPasses(vtkAlgorithm* algorithm, const char* pass)
+{
+  int count = 0;
+  this->Internals->ForEachRecord(
+    algorithm, pass, [&count](const vtkInternals::Record&) { ++count; });
+  return count;
+}
+
+//------------------------------------------------------------------------------
+double vtkPipelineProfiler::GetWallTime(vtkAlgorithm* algorithm, const char* pass)
+{
+  double time = 0.0;
+  this->Internals->ForEachRecord(
+    algorithm, pass, [&time](const vtkInternals::Record& record) { time += record.WallTime; });
+  return time;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkPipelineProfiler::GetOutputMemorySize(vtkAlgorithm* algorithm)
+{
+  unsigned long size = 0;
+  this->Internals->ForEachRecord(algorithm, vtkDemandDrivenPipeline::REQUEST_DATA()->GetName(),
+    [&size](const vtkInternals::Record& record) { size = record.OutputMemorySize; });
+  return size;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::StartPass(vtkExecutive* executive, vtkInformation* request)
+{
+  vtkAlgorithm* algorithm = executive->GetAlgorithm();
+  vtkInternals::RunningPass running;
+  running.Pass.Algorithm = algorithm;
+  running.Pass.Name = algorithm->GetObjectDescription();
+  running.Pass.Pass = GetPassName(request);
+  running.ChildrenWallTime = 0.0;
+  running.PeakResidentSetSizeStart = GetPeakResidentSetSize();
+  running.CPUStart = vtkTimerLog::GetCPUTime();
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  const std::thread::id id = std::this_thread::get_id();
+  auto thread = this->Internals->Threads.find(id);
+  if (thread == this->Internals->Threads.end())
+  {
+    const int index = static_cast<int>(this->Internals->Threads.size());
+    thread = this->Internals->Threads.insert(std::make_pair(id, index)).first;
+  }
+  running.Pass.Thread = thread->second;
+  std::vector<vtkInternals::RunningPass>& stack = this->Internals->Stacks[id];
+  running.Pass.Stack = stack.empty() ? std::string() : stack.back().Pass.Stack + ';';
+  running.Pass.Stack += running.Pass.Name + ';' + running.Pass.Pass;
+  running.Pass.Start = this->Internals->Now();
+  stack.push_back(std::move(running));
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::EndPass(
+  vtkExecutive*, vtkInformation* request, vtkInformationVector* outInfo)
+{
+  const double cpuEnd = vtkTimerLog::GetCPUTime();
+  const double wallEnd = this->Internals->Now();
+  const long long peakResidentSetSize = GetPeakResidentSetSize();
+  unsigned long outputMemorySize = 0;
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    for (int i = 0; i < outInfo->GetNumberOfInformationObjects(); ++i)
+    {
+      if (vtkDataObject* output =
+            outInfo->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT()))
+      {
+        outputMemorySize += output->GetActualMemorySize();
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  std::vector<vtkInternals::RunningPass>& stack =
+    this->Internals->Stacks[std::this_thread::get_id()];
+  // The profiler may have been attached while the request was running.
+  if (stack.empty())
+  {
+    return;
+  }
+  vtkInternals::RunningPass running = std::move(stack.back());
+  stack.pop_back();
+
+  vtkInternals::Record& record = running.Pass;
+  record.WallTime = wallEnd - record.Start;
+  record.SelfWallTime = record.WallTime - running.ChildrenWallTime;
+  record.CPUTime = cpuEnd - running.CPUStart;
+  const int numberOfThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  record.Utilization = record.WallTime > 0.0 && numberOfThreads > 0
+    ? record.CPUTime / (record.WallTime * numberOfThreads)
+    : 0.0;
+  record.OutputMemorySize = outputMemorySize;
+  record.PeakResidentSetSizeDelta = peakResidentSetSize - running.PeakResidentSetSizeStart;
+  if (!stack.empty())
+  {
+    stack.back().ChildrenWallTime += record.WallTime;
+  }
+  this->Internals->Records.push_back(std::move(record));
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::WriteChromeTrace(ostream& os)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  const std::ios::fmtflags flags = os.flags();
+  const std::streamsize precision = os.precision();
+  os << std::fixed << std::setprecision(3);
+  os << "{\"traceEvents\":[";
+  const char* separator = "\n";
+  for (const vtkInternals::Record& record : this->Internals->Records)
+  {
+    os << separator << "{\"name\":";
+    WriteJSONString(os, record.Name);
+    os << ",\"cat\":";
+    WriteJSONString(os, record.Pass);
+    os << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << record.Thread
+       << ",\"ts\":" << record.Start * 1e6 << ",\"dur\":" << record.WallTime * 1e6
+       << ",\"args\":{\"cpu_time_s\":" << record.CPUTime
+       << ",\"thread_utilization\":" << record.Utilization
+       << ",\"output_memory_kib\":" << record.OutputMemorySize
+       << ",\"peak_rss_delta_kib\":" << record.PeakResidentSetSizeDelta << "}}";
+    separator = ",\n";
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  os.flags(flags);
+  os.precision(precision);
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::WriteChromeTrace(const char* filename)
+{
+  std::ofstream file(filename);
+  if (!file)
+  {
+    vtkErrorMacro("Unable to open " << filename);
+    return false;
+  }
+  this->WriteChromeTrace(file);
+  return static_cast<bool>(file);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::WriteFlameGraph(ostream& os)
+{
+  std::map<std::string, double> stacks;
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    for (const vtkInternals::Record& record : this->Internals->Records)
+    {
+      stacks[record.Stack] += record.SelfWallTime;
+    }
+  }
+  for (const auto& stack : stacks)
+  {
+    os << stack.first << ' ' << std::llround(stack.second * 1e6) << '\n';
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::WriteFlameGraph(const char* filename)
+{
+  std::ofstream file(filename);
+  if (!file)
+  {
+    vtkErrorMacro("Unable to open " << filename);
+    return false;
+  }
+  this->WriteFlameGraph(file);
+  return static_cast<bool>(file);
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,148 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPipelineProfiler
+ * @brief   Record the execution of every algorithm of a pipeline
+ *
+ * vtkPipelineProfiler records every request processed by the algorithms of
+ * a pipeline (REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT, REQUEST_DATA...)
+ * together with:
+ * - its wall clock time,
+ * - the CPU time of the process while the request was processed, and the
+ *   resulting utilization of the threads of vtkSMPTools,
+ * - the memory size of the outputs, for REQUEST_DATA,
+ * - the increase of the peak resident set size of the process.
+ *
+ * Attach() installs the profiler on an executive and on all the executives
+ * upstream, so call it once the pipeline is built. Requests processed while
+ * another one is running on the same thread, by an internal pipeline for
+ * instance, are nested in it.
+ *
+ * The records can be exported as a Chrome trace (JSON file to open in
+ * chrome://tracing or Perfetto), or as folded stacks for flame graph tools,
+ * weighted by the wall clock time spent in each request itself, in
+ * microseconds.
+ *
+ * @code{cpp}
+ * vtkNew<vtkPipelineProfiler> profiler;
+ * profiler->Attach(writer->GetExecutive());
+ * writer->Write();
+ * profiler->WriteChromeTrace("pipeline.json");
+ * profiler->WriteFlameGraph("pipeline.folded");
+ * @endcode
+ *
+ * @sa
+ * vtkExecutionTimer
+ */
+
+#ifndef vtkPipelineProfiler_h
+#define vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <memory> // For unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkExecutive;
+class vtkInformation;
+class vtkInformationVector;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler* New();
+  vtkTypeMacro(vtkPipelineProfiler, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Profile the given executive and all the executives upstream.
+   */
+  void Attach(vtkExecutive* executive);
+
+  /**
+   * Stop profiling the executives this profiler is attached to.
+   */
+  void Detach();
+
+  /**
+   * Discard the records.
+   */
+  void Reset();
+
+  /**
+   * Get the number of recorded requests.
+   */
+  int GetNumberOfRecords();
+
+  ///@{
+  /**
+   * Get the number of requests processed by an algorithm, and the wall
+   * clock time in seconds it spent processing them. If pass is not nullptr,
+   * only the requests with this name (REQUEST_DATA for instance) are
+   * considered.
+   */
+  int GetNumberOfPasses(vtkAlgorithm* algorithm, const char* pass = nullptr);
+  double GetWallTime(vtkAlgorithm* algorithm, const char* pass = nullptr);
+  ///@}
+
+  /**
+   * Get the memory size in kibibytes of the outputs of the last REQUEST_DATA
+   * processed by an algorithm.
+   */
+  unsigned long GetOutputMemorySize(vtkAlgorithm* algorithm);
+
+  ///@{
+  /**
+   * Write the records as a Chrome trace. Returns false if the file can not
+   * be written.
+   */
+  void WriteChromeTrace(ostream& os);
+  bool WriteChromeTrace(const char* filename);
+  ///@}
+
+  ///@{
+  /**
+   * Write the records as folded stacks, one "frame;frame;... value" line per
+   * stack. Returns false if the file can not be written.
+   */
+  void WriteFlameGraph(ostream& os);
+  bool WriteFlameGraph(const char* filename);
+  ///@}
+
+  ///@{
+  /**
+   * Called by vtkExecutive::CallAlgorithm() around each request. These
+   * methods are thread safe.
+   */
+  void StartPass(vtkExecutive* executive, vtkInformation* request);
+  void EndPass(vtkExecutive* executive, vtkInformation* request, vtkInformationVector* outInfo);
+  ///@}
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler() override;
+
+private:
+  vtkPipelineProfiler(const vtkPipelineProfiler&) = delete;
+  void operator=(const vtkPipelineProfiler&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
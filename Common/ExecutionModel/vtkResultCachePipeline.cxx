@@ -0,0 +1,341 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkResultCachePipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkResultCachePipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimeStamp.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkResultCachePipeline::vtkInternals
+{
+public:
+  struct Result
+  {
+    std::string Key;
+    std::vector<vtkSmartPointer<vtkDataObject>> Outputs;
+    vtkMTimeType Time;
+    unsigned long Size;
+  };
+
+  // Most recently used results first.
+  std::list<Result> Results;
+  std::map<std::string, std::list<Result>::iterator> Index;
+  unsigned long Size = 0;
+  std::vector<vtkInformationKey*> Keys;
+
+  void Erase(std::list<Result>::iterator it)
+  {
+    this->Size -= it->Size;
+    this->Index.erase(it->Key);
+    this->Results.erase(it);
+  }
+
+  void EvictLeastRecentlyUsed(unsigned long limit)
+  {
+    while (this->Size > limit && !this->Results.empty())
+    {
+      this->Erase(std::prev(this->Results.end()));
+    }
+  }
+
+  // Results computed before the last modification of the pipeline are
+  // discarded.
+  void EvictOutdated(vtkMTimeType pipelineMTime)
+  {
+    for (auto it = this->Results.begin(); it != this->Results.end();)
+    {
+      auto current = it++;
+      if (current->Time < pipelineMTime)
+      {
+        this->Erase(current);
+      }
+    }
+  }
+
+  std::string ComputeKey(vtkInformationVector* outInfoVec) const
+  {
+    std::ostringstream key;
+    key.precision(17);
+    for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+    {
+      vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+      key << "port" << i << ';';
+      vtkInformationKey* standardKeys[] = { vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(),
+        vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(),
+        vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+        vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES() };
+      for (vtkInformationKey* infoKey : standardKeys)
+      {
+        this->AppendKey(key, infoKey, outInfo);
+      }
+      for (vtkInformationKey* infoKey : this->Keys)
+      {
+        this->AppendKey(key, infoKey, outInfo);
+      }
+    }
+    return key.str();
+  }
+
+  void AppendKey(std::ostream& key, vtkInformationKey* infoKey, vtkInformation* info) const
+  {
+    if (info->Has(infoKey))
+    {
+      key << infoKey->GetLocation() << "::" << infoKey->GetName() << '=';
+      infoKey->Print(key, info);
+      key << ';';
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkStandardNewMacro(vtkResultCachePipeline);
+
+//------------------------------------------------------------------------------
+vtkResultCachePipeline::vtkResultCachePipeline()
+  : CacheMemoryLimit(1048576)
+  , Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkResultCachePipeline::~vtkResultCachePipeline() = default;
+
+//------------------------------------------------------------------------------
+void vtkResultCachePipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << endl;
+  os << indent << "NumberOfCachedResults: " << this->Internals->Results.size() << endl;
+  os << indent << "CacheMemorySize: " << this->Internals->Size << endl;
+}
+
+//------------------------------------------------------------------------------
+void vtkResultCachePipeline::SetCacheMemoryLimit(unsigned long limit)
+{
+  if (this->CacheMemoryLimit == limit)
+  {
+    return;
+  }
+  this->CacheMemoryLimit = limit;
+  this->Internals->EvictLeastRecentlyUsed(limit);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkResultCachePipeline::GetCacheMemorySize()
+{
+  return this->Internals->Size;
+}
+
+//------------------------------------------------------------------------------
+int vtkResultCachePipeline::GetNumberOfCachedResults()
+{
+  return static_cast<int>(this->Internals->Results.size());
+}
+
+//------------------------------------------------------------------------------
+void vtkResultCachePipeline::ClearCache()
+{
+  this->Internals->EvictLeastRecentlyUsed(0);
+}
+
+//------------------------------------------------------------------------------
+void vtkResultCachePipeline::AddCacheKey(vtkInformationKey* key)
+{
+  std::vector<vtkInformationKey*>& keys = this->Internals->Keys;
+  if (key && std::find(keys.begin(), keys.end(), key) == keys.end())
+  {
+    keys.push_back(key);
+    this->ClearCache();
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkResultCachePipeline::RemoveAllCacheKeys()
+{
+  if (!this->Internals->Keys.empty())
+  {
+    this->Internals->Keys.clear();
+    this->ClearCache();
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkTypeBool vtkResultCachePipeline::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  if (this->Algorithm && request->Has(REQUEST_DATA()))
+  {
+    int outputPort = -1;
+    if (request->Has(FROM_OUTPUT_PORT()))
+    {
+      outputPort = request->Get(FROM_OUTPUT_PORT());
+    }
+    if (this->NeedToExecuteData(outputPort, inInfoVec, outInfoVec) &&
+      this->RestoreResult(request, inInfoVec, outInfoVec))
+    {
+      return 1;
+    }
+  }
+
+  return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+}
+
+//------------------------------------------------------------------------------
+int vtkResultCachePipeline::ExecuteData(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  if (result && !this->ContinueExecuting && !this->Algorithm->GetAbortOutput())
+  {
+    this->StoreResult(outInfoVec);
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+bool vtkResultCachePipeline::RestoreResult(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  // Streaming algorithms execute several times per request.
+  if (this->ContinueExecuting)
+  {
+    return false;
+  }
+
+  this->Internals->EvictOutdated(this->PipelineMTime);
+  if (this->Internals->Results.empty())
+  {
+    return false;
+  }
+
+  auto found = this->Internals->Index.find(this->Internals->ComputeKey(outInfoVec));
+  if (found == this->Internals->Index.end())
+  {
+    return false;
+  }
+  vtkInternals::Result& result = *found->second;
+
+  const int numberOfOutputs = outInfoVec->GetNumberOfInformationObjects();
+  for (int i = 0; i < numberOfOutputs; ++i)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    vtkDataObject* cached = result.Outputs[i];
+    // Outputs cropped to the exact update extent after execution are cached
+    // before being cropped.
+    if (outInfo->Get(EXACT_EXTENT()) ||
+      (cached && (!output || output->GetDataObjectType() != cached->GetDataObjectType())))
+    {
+      return false;
+    }
+  }
+
+  vtkDebugMacro(<< "Restoring the outputs of " << this->Algorithm->GetObjectDescription()
+                << " from the cache");
+  this->Internals->Results.splice(
+    this->Internals->Results.begin(), this->Internals->Results, found->second);
+
+  for (int i = 0; i < numberOfOutputs; ++i)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (vtkDataObject* cached = result.Outputs[i])
+    {
+      output->PrepareForNewData();
+      output->ShallowCopy(cached);
+    }
+  }
+  this->MarkOutputsGenerated(request, inInfoVec, outInfoVec);
+
+  // Finish the request as vtkStreamingDemandDrivenPipeline does after
+  // executing the algorithm.
+  for (int i = 0; i < numberOfOutputs; ++i)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    if (outInfo->Has(COMBINED_UPDATE_EXTENT()))
+    {
+      static int emptyExt[6] = { 0, -1, 0, -1, 0, -1 };
+      outInfo->Set(COMBINED_UPDATE_EXTENT(), emptyExt, 6);
+    }
+  }
+  this->DataTime.Modified();
+  this->InformationTime.Modified();
+  this->DataObjectTime.Modified();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkResultCachePipeline::StoreResult(vtkInformationVector* outInfoVec)
+{
+  if (this->CacheMemoryLimit == 0)
+  {
+    return;
+  }
+
+  vtkInternals::Result result;
+  result.Key = this->Internals->ComputeKey(outInfoVec);
+  result.Size = 0;
+  for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkDataObject* output = outInfoVec->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+    vtkSmartPointer<vtkDataObject> copy;
+    if (output)
+    {
+      copy.TakeReference(output->NewInstance());
+      copy->ShallowCopy(output);
+      result.Size += copy->GetActualMemorySize();
+    }
+    result.Outputs.push_back(copy);
+  }
+  vtkTimeStamp time;
+  time.Modified();
+  result.Time = time.GetMTime();
+
+  auto found = this->Internals->Index.find(result.Key);
+  if (found != this->Internals->Index.end())
+  {
+    this->Internals->Erase(found->second);
+  }
+  if (result.Size > this->CacheMemoryLimit)
+  {
+    return;
+  }
+
+  this->Internals->EvictLeastRecentlyUsed(this->CacheMemoryLimit - result.Size);
+  this->Internals->Size += result.Size;
+  this->Internals->Results.push_front(std::move(result));
+  this->Internals->Index[this->Internals->Results.front().Key] = this->Internals->Results.begin();
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkResultCachePipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkResultCachePipeline
+ * @brief   Executive that caches the results of an algorithm
+ *
+ * vtkResultCachePipeline keeps shallow copies of the outputs produced by its
+ * algorithm, keyed on the request that produced them: the time step, the
+ * piece, the number of pieces and ghost levels, the update extent and the
+ * composite indices requested from each output port, along with any key
+ * added with AddCacheKey(). When a request matches a cached result, the
+ * outputs are restored from the cache without updating the inputs nor
+ * executing the algorithm.
+ *
+ * Unlike vtkCachedStreamingDemandDrivenPipeline, which keeps a fixed number of
+ * images, the cache works for any data type and is bounded by the memory
+ * used by the cached outputs, as reported by
+ * vtkDataObject::GetActualMemorySize(). The least recently used results are
+ * evicted first. All results are discarded when the algorithm or its inputs
+ * are modified.
+ *
+ * Typical use is keeping the time steps and pieces recently requested by an
+ * interactive application:
+ *
+ * @code{cpp}
+ * vtkNew<vtkResultCachePipeline> executive;
+ * executive->SetCacheMemoryLimit(512 * 1024); // 512 MiB
+ * reader->SetExecutive(executive);
+ * @endcode
+ *
+ * @sa
+ * vtkCachedStreamingDemandDrivenPipeline vtkTemporalDataSetCache
+ */
+
+#ifndef vtkResultCachePipeline_h
+#define vtkResultCachePipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+#include <memory> // For std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkInformationKey;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkResultCachePipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkResultCachePipeline* New();
+  vtkTypeMacro(vtkResultCachePipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Maximum amount of memory, in kibibytes, used by the cached results.
+   * A result larger than the limit is not cached. A limit of 0 disables the
+   * cache. Default is 1048576 (1 GiB).
+   */
+  void SetCacheMemoryLimit(unsigned long limit);
+  vtkGetMacro(CacheMemoryLimit, unsigned long);
+  ///@}
+
+  /**
+   * Amount of memory, in kibibytes, used by the cached results. Arrays shared
+   * between several results are counted once per result.
+   */
+  unsigned long GetCacheMemorySize();
+
+  /**
+   * Number of results in the cache.
+   */
+  int GetNumberOfCachedResults();
+
+  /**
+   * Discard all cached results.
+   */
+  void ClearCache();
+
+  ///@{
+  /**
+   * Keys of the output information, in addition to the standard request
+   * keys, that distinguish results. Use this for algorithms producing
+   * different outputs for different values of a custom request key.
+   */
+  void AddCacheKey(vtkInformationKey* key);
+  void RemoveAllCacheKeys();
+  ///@}
+
+  /**
+   * Restore the outputs from the cache when possible, or forward to the
+   * superclass.
+   */
+  vtkTypeBool ProcessRequest(
+    vtkInformation* request, vtkInformationVector** inInfo, vtkInformationVector* outInfo) override;
+
+protected:
+  vtkResultCachePipeline();
+  ~vtkResultCachePipeline() override;
+
+  int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
+  // Restore the outputs from a cached result matching the request. Returns
+  // false when there is no such result.
+  bool RestoreResult(
+    vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec);
+
+  // Cache the outputs produced by the algorithm.
+  void StoreResult(vtkInformationVector* outInfoVec);
+
+  unsigned long CacheMemoryLimit;
+
+private:
+  vtkResultCachePipeline(const vtkResultCachePipeline&) = delete;
+  void operator=(const vtkResultCachePipeline&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
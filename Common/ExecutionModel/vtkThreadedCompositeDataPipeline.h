@@ -23,6 +23,8 @@
  * algorithm implement all pipeline passes in a re-entrant way. It should
  * store/retrieve all state changes using input and output information
  * objects, which are unique to each thread.
+ *
+ * This is a vtkCompositeDataPipeline with ConcurrentLeafExecution on.
  */
 
 #ifndef vtkThreadedCompositeDataPipeline_h
@@ -32,9 +34,6 @@
 #include "vtkCompositeDataPipeline.h"
 
 VTK_ABI_NAMESPACE_BEGIN
-class vtkInformationVector;
-class vtkInformation;
-
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkThreadedCompositeDataPipeline
   : public vtkCompositeDataPipeline
 {
@@ -43,24 +42,13 @@ public:
   vtkTypeMacro(vtkThreadedCompositeDataPipeline, vtkCompositeDataPipeline);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
-  /**
-   * An API to CallAlgorithm that allows you to pass in the info objects to
-   * be used
-   */
-  int CallAlgorithm(vtkInformation* request, int direction, vtkInformationVector** inInfo,
-    vtkInformationVector* outInfo) override;
-
 protected:
   vtkThreadedCompositeDataPipeline();
   ~vtkThreadedCompositeDataPipeline() override;
-  void ExecuteEach(vtkCompositeDataIterator* iter, vtkInformationVector** inInfoVec,
-    vtkInformationVector* outInfoVec, int compositePort, int connection, vtkInformation* request,
-    std::vector<vtkSmartPointer<vtkCompositeDataSet>>& compositeOutput) override;
 
 private:
   vtkThreadedCompositeDataPipeline(const vtkThreadedCompositeDataPipeline&) = delete;
   void operator=(const vtkThreadedCompositeDataPipeline&) = delete;
-  friend class ProcessBlock;
 };
 
 VTK_ABI_NAMESPACE_END
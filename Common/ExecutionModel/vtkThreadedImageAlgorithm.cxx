@@ -17,16 +17,20 @@
 #include "vtkCellData.h"
 #include "vtkCommand.h"
 #include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
+#include "vtkIncrementalArrayCache.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiThreader.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkSMP.h"
 #include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <vector>
 
 // If SMP backend is Sequential then fall back to vtkMultiThreader,
@@ -65,12 +69,22 @@ vtkThreadedImageAlgorithm::vtkThreadedImageAlgorithm()
 
   // The desired block size in bytes
   this->DesiredBytesPerPiece = 65536;
+
+  // Incremental execution
+  this->PointLocal = false;
+  this->IncrementalCache = nullptr;
+  this->IncrementalScalars = nullptr;
+  std::fill(this->IncrementalExtents, this->IncrementalExtents + 12, 0);
 }
 
 //------------------------------------------------------------------------------
 vtkThreadedImageAlgorithm::~vtkThreadedImageAlgorithm()
 {
   this->Threader->Delete();
+  if (this->IncrementalCache)
+  {
+    this->IncrementalCache->Delete();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -483,7 +497,16 @@ void vtkThreadedImageAlgorithm::PrepareImageData(vtkInformationVector** inputVec
 
       // unlike geometry filters, for image filters data is pre-allocated
       // in the superclass (which means, in this class)
-      this->AllocateOutputData(outData, info, updateExtent);
+      if (i == 0 && this->IncrementalScalars)
+      {
+        // reuse the scalars of the last execution, updated incrementally
+        outData->SetExtent(updateExtent);
+        outData->GetPointData()->SetScalars(this->IncrementalScalars);
+      }
+      else
+      {
+        this->AllocateOutputData(outData, info, updateExtent);
+      }
     }
   }
 
@@ -555,8 +578,14 @@ int vtkThreadedImageAlgorithm::RequestData(
     outputs = &connections[offset];
   }
 
+  // check whether the output scalars can be updated incrementally
+  vtkNew<vtkIdTypeArray> ranges;
+  vtkDataArray* incrementalScalars = this->GetIncrementalScalars(inputVector, outputVector, ranges);
+
   // allocate the output data and call CopyAttributeData
+  this->IncrementalScalars = incrementalScalars;
   this->PrepareImageData(inputVector, outputVector, inputs, outputs);
+  this->IncrementalScalars = nullptr;
 
   // need bytes per voxel to compute block size
   int bytesPerVoxel = 1;
@@ -590,9 +619,102 @@ int vtkThreadedImageAlgorithm::RequestData(
     }
   }
 
+  if (!incrementalScalars)
+  {
+    this->ExecuteExtent(
+      request, inputVector, outputVector, inputs, outputs, updateExtent, bytesPerVoxel);
+  }
+  else
+  {
+    // Only execute over the extents containing the modified input points.
+    vtkImageData* inData = inputs[0][0];
+    int inExt[6];
+    inData->GetExtent(inExt);
+    const vtkIdType inDims[2] = { inExt[1] - inExt[0] + 1, inExt[3] - inExt[2] + 1 };
+    const vtkIdType outDims[2] = { updateExtent[1] - updateExtent[0] + 1,
+      updateExtent[3] - updateExtent[2] + 1 };
+    for (vtkIdType r = 0; r < ranges->GetNumberOfTuples(); ++r)
+    {
+      int first[3];
+      int last[3];
+      vtkIdType ids[2] = { ranges->GetTypedComponent(r, 0), ranges->GetTypedComponent(r, 1) - 1 };
+      int* ijks[2] = { first, last };
+      for (int i = 0; i < 2; ++i)
+      {
+        ijks[i][0] = inExt[0] + static_cast<int>(ids[i] % inDims[0]);
+        ijks[i][1] = inExt[2] + static_cast<int>((ids[i] / inDims[0]) % inDims[1]);
+        ijks[i][2] = inExt[4] + static_cast<int>(ids[i] / (inDims[0] * inDims[1]));
+      }
+      // bounding extent of the range, clipped to the update extent
+      int extent[6] = { first[0], last[0], first[1], last[1], first[2], last[2] };
+      if (first[2] != last[2])
+      {
+        extent[2] = inExt[2];
+        extent[3] = inExt[3];
+      }
+      if (first[1] != last[1] || first[2] != last[2])
+      {
+        extent[0] = inExt[0];
+        extent[1] = inExt[1];
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        extent[2 * i] = std::max(extent[2 * i], updateExtent[2 * i]);
+        extent[2 * i + 1] = std::min(extent[2 * i + 1], updateExtent[2 * i + 1]);
+      }
+      if (extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5])
+      {
+        continue;
+      }
+      this->ExecuteExtent(
+        request, inputVector, outputVector, inputs, outputs, extent, bytesPerVoxel);
+
+      // Let the algorithms downstream update their outputs incrementally.
+      for (int i = 0; i < 2; ++i)
+      {
+        const int* ijk = extent + i;
+        ids[i] = (ijk[0] - updateExtent[0]) +
+          outDims[0] * ((ijk[2] - updateExtent[2]) + outDims[1] * (ijk[4] - updateExtent[4]));
+      }
+      incrementalScalars->ModifiedRange(ids[0], ids[1] + 1);
+    }
+  }
+
+  // Keep the output scalars to update them incrementally.
+  if (this->PointLocal)
+  {
+    vtkDataArray* inArray = nullptr;
+    vtkDataArray* outArray = nullptr;
+    if (numInputPorts == 1 && numOutputPorts == 1 &&
+      inputVector[0]->GetNumberOfInformationObjects() == 1 && inputs[0][0] && outputs[0])
+    {
+      int association = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+      inArray = this->GetInputArrayToProcess(0, inputVector, association);
+      outArray = outputs[0]->GetPointData()->GetScalars();
+      inputs[0][0]->GetExtent(this->IncrementalExtents);
+      outputs[0]->GetExtent(this->IncrementalExtents + 6);
+      if (association != vtkDataObject::FIELD_ASSOCIATION_POINTS)
+      {
+        inArray = outArray = nullptr;
+      }
+    }
+    if (!this->IncrementalCache)
+    {
+      this->IncrementalCache = vtkIncrementalArrayCache::New();
+    }
+    this->IncrementalCache->SetCachedOutput(1, &inArray, inArray ? outArray : nullptr);
+  }
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedImageAlgorithm::ExecuteExtent(vtkInformation* request,
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector, vtkImageData*** inputs,
+  vtkImageData** outputs, int extent[6], int bytesPerVoxel)
+{
   // verify that there is an extent for execution
-  if (updateExtent[0] <= updateExtent[1] && updateExtent[2] <= updateExtent[3] &&
-    updateExtent[4] <= updateExtent[5])
+  if (extent[0] <= extent[1] && extent[2] <= extent[3] && extent[4] <= extent[5])
   {
     if (this->EnableSMP)
     {
@@ -601,9 +723,9 @@ int vtkThreadedImageAlgorithm::RequestData(
 
       // compute a reasonable number of pieces, this will be a multiple of
       // the number of available threads and relative to the data size
-      vtkTypeInt64 bytesize = (static_cast<vtkTypeInt64>(updateExtent[1] - updateExtent[0] + 1) *
-        static_cast<vtkTypeInt64>(updateExtent[3] - updateExtent[2] + 1) *
-        static_cast<vtkTypeInt64>(updateExtent[5] - updateExtent[4] + 1) * bytesPerVoxel);
+      vtkTypeInt64 bytesize = (static_cast<vtkTypeInt64>(extent[1] - extent[0] + 1) *
+        static_cast<vtkTypeInt64>(extent[3] - extent[2] + 1) *
+        static_cast<vtkTypeInt64>(extent[5] - extent[4] + 1) * bytesPerVoxel);
       vtkTypeInt64 bytesPerPiece = this->DesiredBytesPerPiece;
 
       if (bytesPerPiece > 0 && bytesPerPiece < bytesize)
@@ -613,14 +735,14 @@ int vtkThreadedImageAlgorithm::RequestData(
       }
       // do a dummy execution of SplitExtent to compute the number of pieces
       int subExtent[6];
-      pieces = this->SplitExtent(subExtent, updateExtent, 0, pieces);
+      pieces = this->SplitExtent(subExtent, extent, 0, pieces);
 
       // always shut off debugging to avoid threading problems with GetMacros
       bool debug = this->Debug;
       this->Debug = false;
 
       vtkThreadedImageAlgorithmFunctor functor(
-        this, request, inputVector, outputVector, inputs, outputs, updateExtent, pieces);
+        this, request, inputVector, outputVector, inputs, outputs, extent, pieces);
 
       vtkSMPTools::For(0, pieces, functor);
 
@@ -636,11 +758,11 @@ int vtkThreadedImageAlgorithm::RequestData(
       str.OutputsInfo = outputVector;
       str.Inputs = inputs;
       str.Outputs = outputs;
-      str.UpdateExtent = updateExtent;
+      str.UpdateExtent = extent;
 
       // do a dummy execution of SplitExtent to compute the number of pieces
       int subExtent[6];
-      vtkIdType pieces = this->SplitExtent(subExtent, updateExtent, 0, this->NumberOfThreads);
+      vtkIdType pieces = this->SplitExtent(subExtent, extent, 0, this->NumberOfThreads);
       this->Threader->SetNumberOfThreads(pieces);
       this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute, &str);
       // always shut off debugging to avoid threading problems with GetMacros
@@ -650,8 +772,49 @@ int vtkThreadedImageAlgorithm::RequestData(
       this->Debug = debug;
     }
   }
+}
 
-  return 1;
+//------------------------------------------------------------------------------
+vtkDataArray* vtkThreadedImageAlgorithm::GetIncrementalScalars(
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector, vtkIdTypeArray* ranges)
+{
+  if (!this->PointLocal || !this->IncrementalCache || this->GetNumberOfInputPorts() != 1 ||
+    this->GetNumberOfOutputPorts() != 1 || inputVector[0]->GetNumberOfInformationObjects() != 1)
+  {
+    return nullptr;
+  }
+
+  // The extents must be the ones of the last execution.
+  vtkImageData* input = vtkImageData::GetData(inputVector[0]);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  int extents[12];
+  if (!input || !outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()))
+  {
+    return nullptr;
+  }
+  input->GetExtent(extents);
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extents + 6);
+  if (!std::equal(extents, extents + 12, this->IncrementalExtents))
+  {
+    return nullptr;
+  }
+
+  int association = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  vtkDataArray* inArray = this->GetInputArrayToProcess(0, inputVector, association);
+  if (!inArray || association != vtkDataObject::FIELD_ASSOCIATION_POINTS)
+  {
+    return nullptr;
+  }
+
+  // The output keeps its scalars between executions (see
+  // vtkImageData::PrepareForNewData()), release them so that the cache
+  // only reuses them if they are not referenced anywhere else.
+  vtkImageData* output = vtkImageData::GetData(outInfo);
+  if (output)
+  {
+    output->GetPointData()->SetScalars(nullptr);
+  }
+  return this->IncrementalCache->GetCachedOutput(this, 1, &inArray, ranges);
 }
 
 //------------------------------------------------------------------------------
@@ -33,7 +33,10 @@
 #include "vtkThreads.h" // for VTK_MAX_THREADS
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+class vtkIdTypeArray;
 class vtkImageData;
+class vtkIncrementalArrayCache;
 class vtkMultiThreader;
 
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkThreadedImageAlgorithm : public vtkImageAlgorithm
@@ -144,6 +147,15 @@ protected:
   int MinimumPieceSize[3];
   vtkIdType DesiredBytesPerPiece;
 
+  /**
+   * Set by subclasses whose output point values only depend on the input
+   * point values at the same location, with a single input and output. Their
+   * output scalars are then updated in place when only ranges of the input
+   * scalars were modified (see vtkDataArray::ModifiedRange()), and reused
+   * when the input scalars were not modified. Defaults to false.
+   */
+  bool PointLocal;
+
   /**
    * This is called by the superclass.
    * This is the method you should override.
@@ -176,6 +188,21 @@ private:
   void operator=(const vtkThreadedImageAlgorithm&) = delete;
 
   friend class vtkThreadedImageAlgorithmFunctor;
+
+  // Execute the algorithm over the given extent of the output.
+  void ExecuteExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector, vtkImageData*** inputs, vtkImageData** outputs,
+    int extent[6], int bytesPerVoxel);
+
+  // Get the output scalars of the last execution of a point local
+  // algorithm if they can be updated in place, and the modified ranges of
+  // the input scalars.
+  vtkDataArray* GetIncrementalScalars(
+    vtkInformationVector** inputVector, vtkInformationVector* outputVector, vtkIdTypeArray* ranges);
+
+  vtkIncrementalArrayCache* IncrementalCache;
+  vtkDataArray* IncrementalScalars;
+  int IncrementalExtents[12];
 };
 
 VTK_ABI_NAMESPACE_END
@@ -0,0 +1,327 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCleanPolyDataThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded clean of vtkCleanPolyData produces the same output
+// as the serial one, which is used when a locator is specified.
+
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMergePoints.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+// Points on a small lattice, each lattice point being used by several points
+// when duplicates is true, and random cells of all types and sizes, many of
+// which are degenerate.
+void MakeInput(vtkPolyData* input, bool duplicates)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  const vtkIdType numPts = 2000;
+  const int numLatticePts = duplicates ? 400 : numPts;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdTypeArray> latticeIds;
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    const int latticeId =
+      duplicates ? static_cast<int>(random->GetNextRangeValue(0, numLatticePts)) : i;
+    points->InsertNextPoint(latticeId % 7, (latticeId / 7) % 11, latticeId / 77);
+    latticeIds->InsertNextValue(latticeId);
+    pointIds->InsertNextValue(i);
+  }
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(pointIds);
+  input->GetPointData()->SetGlobalIds(latticeIds);
+
+  vtkNew<vtkCellArray> cells[4];
+  vtkNew<vtkIdList> ptIds;
+  for (int type = 0; type < 4; ++type)
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      const int npts = static_cast<int>(random->GetNextRangeValue(1, 4 + 2 * type));
+      ptIds->SetNumberOfIds(npts);
+      for (int j = 0; j < npts; ++j)
+      {
+        // Nearby points, so that consecutive points are often merged.
+        ptIds->SetId(j, static_cast<vtkIdType>(random->GetNextRangeValue(0, 50)) + 40 * i / 30);
+      }
+      cells[type]->InsertNextCell(ptIds);
+    }
+  }
+  input->SetVerts(cells[0]);
+  input->SetLines(cells[1]);
+  input->SetPolys(cells[2]);
+  input->SetStrips(cells[3]);
+
+  vtkNew<vtkDoubleArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  input->GetCellData()->AddArray(cellIds);
+}
+
+bool SameCells(vtkCellArray* threaded, vtkCellArray* serial)
+{
+  if (threaded->GetNumberOfCells() != serial->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkNew<vtkIdList> threadedIds;
+  vtkNew<vtkIdList> serialIds;
+  for (vtkIdType i = 0; i < threaded->GetNumberOfCells(); ++i)
+  {
+    threaded->GetCellAtId(i, threadedIds);
+    serial->GetCellAtId(i, serialIds);
+    if (threadedIds->GetNumberOfIds() != serialIds->GetNumberOfIds() ||
+      !std::equal(threadedIds->begin(), threadedIds->end(), serialIds->begin()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameArrays(vtkDataArray* threaded, vtkDataArray* serial)
+{
+  if (!threaded || !serial || threaded->GetDataType() != serial->GetDataType() ||
+    threaded->GetNumberOfTuples() != serial->GetNumberOfTuples())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < threaded->GetNumberOfTuples(); ++i)
+  {
+    if (threaded->GetComponent(i, 0) != serial->GetComponent(i, 0))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutputs(vtkPolyData* threaded, vtkPolyData* serial)
+{
+  if (threaded->GetNumberOfPoints() != serial->GetNumberOfPoints() ||
+    threaded->GetPoints()->GetDataType() != serial->GetPoints()->GetDataType() ||
+    threaded->GetNumberOfPolys() == 0)
+  {
+    std::cerr << "Different points: " << threaded->GetNumberOfPoints() << " and "
+              << serial->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < threaded->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    threaded->GetPoint(i, x);
+    serial->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Different point " << i << std::endl;
+      return false;
+    }
+  }
+  if (!SameCells(threaded->GetVerts(), serial->GetVerts()) ||
+    !SameCells(threaded->GetLines(), serial->GetLines()) ||
+    !SameCells(threaded->GetPolys(), serial->GetPolys()) ||
+    !SameCells(threaded->GetStrips(), serial->GetStrips()))
+  {
+    std::cerr << "Different cells" << std::endl;
+    return false;
+  }
+  if (!SameArrays(threaded->GetPointData()->GetArray("PointIds"),
+        serial->GetPointData()->GetArray("PointIds")) ||
+    !SameArrays(threaded->GetCellData()->GetArray("CellIds"),
+      serial->GetCellData()->GetArray("CellIds")))
+  {
+    std::cerr << "Different attributes" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Records the points passed to OperateOnPoint, which is only declared thread
+// safe when ThreadSafe is set.
+class vtkRecordingCleanPolyData : public vtkCleanPolyData
+{
+public:
+  static vtkRecordingCleanPolyData* New();
+  vtkTypeMacro(vtkRecordingCleanPolyData, vtkCleanPolyData);
+
+  void OperateOnPoint(double in[3], double out[3]) override
+  {
+    std::lock_guard<std::mutex> lock(this->CallsMutex);
+    this->Calls.insert(this->Calls.end(), in, in + 3);
+    std::copy(in, in + 3, out);
+  }
+
+  std::vector<double> Calls;
+  bool ThreadSafe = false;
+  std::mutex CallsMutex;
+
+protected:
+  bool IsOperateOnPointThreadSafe() override { return this->ThreadSafe; }
+};
+vtkStandardNewMacro(vtkRecordingCleanPolyData);
+
+// Return the points passed to OperateOnPoint by a zero tolerance clean of
+// input, which follows the traversal order of the cells when serial.
+std::vector<double> RecordCalls(vtkPolyData* input, bool threadSafe, bool sequential, bool locator)
+{
+  vtkNew<vtkRecordingCleanPolyData> filter;
+  filter->ThreadSafe = threadSafe;
+  filter->SetSequentialProcessing(sequential);
+  if (locator)
+  {
+    vtkNew<vtkMergePoints> mergePoints;
+    filter->SetLocator(mergePoints);
+  }
+  filter->SetInputData(input);
+  filter->Update();
+  return filter->Calls;
+}
+}
+
+int TestCleanPolyDataThreaded(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  MakeInput(input, true);
+  vtkNew<vtkPolyData> distinctInput;
+  MakeInput(distinctInput, false);
+  // The serial clean merges the points by coordinates, which matches the
+  // lattice ids used as global ids.
+  vtkNew<vtkPolyData> serialInput;
+  serialInput->DeepCopy(input);
+  serialInput->GetPointData()->SetGlobalIds(nullptr);
+
+  vtkNew<vtkCleanPolyData> serial;
+  vtkNew<vtkCleanPolyData> threaded;
+  for (int option = 0; option < 32; ++option)
+  {
+    const int mode = option % 4;
+    for (vtkCleanPolyData* filter : { threaded.Get(), serial.Get() })
+    {
+      filter->SetConvertLinesToPoints((option & 4) != 0);
+      filter->SetConvertPolysToLines((option & 8) != 0);
+      filter->SetConvertStripsToPolys((option & 16) != 0);
+      filter->SetToleranceIsAbsolute(mode == 1);
+      filter->SetAbsoluteTolerance(0.0);
+      filter->SetOutputPointsPrecision(
+        mode == 2 ? vtkAlgorithm::DOUBLE_PRECISION : vtkAlgorithm::DEFAULT_PRECISION);
+    }
+    // Merge by coordinates, then by global ids, then do not merge points that
+    // are all distinct anyway.
+    vtkNew<vtkMergePoints> locator;
+    serial->SetLocator(locator);
+    serial->SetInputData(mode == 3 ? distinctInput.Get() : serialInput.Get());
+    serial->Update();
+    if (mode == 3)
+    {
+      threaded->SetInputData(distinctInput);
+    }
+    else
+    {
+      threaded->SetInputData(mode == 2 ? input.Get() : serialInput.Get());
+    }
+    threaded->SetPointMerging(mode != 3);
+    threaded->Update();
+    if (threaded->GetLocator() || !SameOutputs(threaded->GetOutput(), serial->GetOutput()))
+    {
+      std::cerr << "Different outputs for option " << option << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The locator created by a serial execution, here with a non-zero
+  // tolerance, must not be taken for a locator specified by the user.
+  threaded->SetInputData(serialInput);
+  threaded->SetPointMerging(true);
+  threaded->SetTolerance(1e-6);
+  threaded->Update();
+  threaded->SetTolerance(0.0);
+  threaded->Update();
+  serial->SetInputData(serialInput);
+  serial->Update();
+  if (threaded->GetLocator() || !SameOutputs(threaded->GetOutput(), serial->GetOutput()))
+  {
+    std::cerr << "Different outputs after a serial execution" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Bit arrays are not handled by the threaded path.
+  vtkNew<vtkBitArray> bits;
+  bits->SetName("Bits");
+  for (vtkIdType i = 0; i < serialInput->GetNumberOfPoints(); ++i)
+  {
+    bits->InsertNextValue(i % 2);
+  }
+  vtkNew<vtkPolyData> bitInput;
+  bitInput->ShallowCopy(serialInput);
+  bitInput->GetPointData()->AddArray(bits);
+  threaded->SetInputData(bitInput);
+  threaded->Update();
+  vtkBitArray* outBits =
+    vtkBitArray::SafeDownCast(threaded->GetOutput()->GetPointData()->GetArray("Bits"));
+  vtkDataArray* outIds = threaded->GetOutput()->GetPointData()->GetArray("PointIds");
+  if (!outBits || outBits->GetNumberOfTuples() != threaded->GetOutput()->GetNumberOfPoints())
+  {
+    std::cerr << "Missing bit array" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < outBits->GetNumberOfTuples(); ++i)
+  {
+    if (outBits->GetValue(i) != static_cast<vtkIdType>(outIds->GetComponent(i, 0)) % 2)
+    {
+      std::cerr << "Different bit " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Subclasses overriding OperateOnPoint are cleaned serially, unless they
+  // declare it thread safe, and SequentialProcessing forces the serial clean.
+  const std::vector<double> serialCalls = RecordCalls(serialInput, false, false, true);
+  if (serialCalls.size() <= 3 * static_cast<size_t>(serialInput->GetNumberOfPoints()) ||
+    RecordCalls(serialInput, false, false, false) != serialCalls ||
+    RecordCalls(serialInput, true, true, false) != serialCalls)
+  {
+    std::cerr << "OperateOnPoint not invoked serially" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (RecordCalls(serialInput, true, false, false).size() >
+    3 * static_cast<size_t>(serialInput->GetNumberOfPoints()))
+  {
+    std::cerr << "OperateOnPoint not invoked once per point when thread safe" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,295 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityFiltersParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel labelling of vtkConnectivityFilter and
+// vtkPolyDataConnectivityFilter extracts the same regions as the serial
+// traversal, which is used with scalar connectivity over the whole range, and
+// that the output points are numbered by region, then by first use. With
+// SequentialProcessing, the output is the one of the serial traversal.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace
+{
+// Many small pieces: random vertices, lines and triangles between nearby
+// points, and unused points.
+void MakeInput(vtkPolyData* input)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  const vtkIdType numPts = 3000;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointIds;
+  pointIds->SetName("PointIds");
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    points->InsertNextPoint(i % 13, (i / 13) % 17, i / 221);
+    pointIds->InsertNextValue(i);
+    scalars->InsertNextValue(0.0);
+  }
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(pointIds);
+  input->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkCellArray> cells[3];
+  vtkNew<vtkIdList> ptIds;
+  for (int type = 0; type < 3; ++type)
+  {
+    for (int i = 0; i < 600; ++i)
+    {
+      ptIds->SetNumberOfIds(type + 1);
+      for (int j = 0; j <= type; ++j)
+      {
+        ptIds->SetId(j, static_cast<vtkIdType>(random->GetNextRangeValue(0, 12)) + 4 * i);
+      }
+      cells[type]->InsertNextCell(ptIds);
+    }
+  }
+  input->SetVerts(cells[0]);
+  input->SetLines(cells[1]);
+  input->SetPolys(cells[2]);
+
+  vtkNew<vtkDoubleArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  input->GetCellData()->AddArray(cellIds);
+}
+
+// Compare the cells, through the input ids of their points, and the region
+// ids of the points and cells. vtkConnectivityFilter passes the region ids of
+// all the input cells, so they are only compared when all cells are output.
+bool SameOutputs(vtkPointSet* parallel, vtkPointSet* serial, bool allCells)
+{
+  if (parallel->GetNumberOfPoints() != serial->GetNumberOfPoints() ||
+    parallel->GetNumberOfCells() != serial->GetNumberOfCells() ||
+    parallel->GetNumberOfCells() == 0)
+  {
+    std::cerr << "Different sizes: " << parallel->GetNumberOfPoints() << " and "
+              << serial->GetNumberOfPoints() << " points, " << parallel->GetNumberOfCells()
+              << " and " << serial->GetNumberOfCells() << " cells" << std::endl;
+    return false;
+  }
+  vtkDataArray* parallelPointIds = parallel->GetPointData()->GetArray("PointIds");
+  vtkDataArray* serialPointIds = serial->GetPointData()->GetArray("PointIds");
+  std::vector<double> parallelIds, serialIds;
+  for (vtkIdType i = 0; i < parallel->GetNumberOfPoints(); ++i)
+  {
+    parallelIds.push_back(parallelPointIds->GetComponent(i, 0));
+    serialIds.push_back(serialPointIds->GetComponent(i, 0));
+  }
+  std::sort(parallelIds.begin(), parallelIds.end());
+  std::sort(serialIds.begin(), serialIds.end());
+  if (parallelIds != serialIds)
+  {
+    std::cerr << "Different points" << std::endl;
+    return false;
+  }
+
+  vtkDataArray* parallelPointRegions = parallel->GetPointData()->GetArray("RegionId");
+  vtkDataArray* serialPointRegions = serial->GetPointData()->GetArray("RegionId");
+  vtkDataArray* parallelCellRegions = parallel->GetCellData()->GetArray("RegionId");
+  vtkDataArray* serialCellRegions = serial->GetCellData()->GetArray("RegionId");
+  vtkDataArray* parallelCellIds = parallel->GetCellData()->GetArray("CellIds");
+  vtkDataArray* serialCellIds = serial->GetCellData()->GetArray("CellIds");
+  vtkNew<vtkIdList> parallelCell;
+  vtkNew<vtkIdList> serialCell;
+  for (vtkIdType i = 0; i < parallel->GetNumberOfCells(); ++i)
+  {
+    parallel->GetCellPoints(i, parallelCell);
+    serial->GetCellPoints(i, serialCell);
+    if (parallelCell->GetNumberOfIds() != serialCell->GetNumberOfIds() ||
+      parallelCellIds->GetComponent(i, 0) != serialCellIds->GetComponent(i, 0) ||
+      (parallelCellRegions && allCells &&
+        parallelCellRegions->GetComponent(i, 0) != serialCellRegions->GetComponent(i, 0)))
+    {
+      std::cerr << "Different cell " << i << std::endl;
+      return false;
+    }
+    for (vtkIdType j = 0; j < parallelCell->GetNumberOfIds(); ++j)
+    {
+      const vtkIdType parallelId = parallelCell->GetId(j);
+      const vtkIdType serialId = serialCell->GetId(j);
+      if (parallelPointIds->GetComponent(parallelId, 0) !=
+          serialPointIds->GetComponent(serialId, 0) ||
+        (parallelPointRegions &&
+          parallelPointRegions->GetComponent(parallelId, 0) !=
+            serialPointRegions->GetComponent(serialId, 0)))
+      {
+        std::cerr << "Different points of cell " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Check that the output points of each region are numbered consecutively, in
+// the order of their first use by the output cells.
+bool NumberedByFirstUse(vtkPointSet* output)
+{
+  vtkDataArray* pointRegions = output->GetPointData()->GetArray("RegionId");
+  std::map<double, vtkIdType> nextIds;
+  for (vtkIdType i = output->GetNumberOfPoints() - 1; i >= 0; --i)
+  {
+    nextIds[pointRegions->GetComponent(i, 0)] = i;
+  }
+  std::vector<bool> used(output->GetNumberOfPoints(), false);
+  vtkNew<vtkIdList> cell;
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+  {
+    output->GetCellPoints(i, cell);
+    for (vtkIdType ptId : *cell)
+    {
+      if (!used[ptId] && ptId != nextIds[pointRegions->GetComponent(ptId, 0)]++)
+      {
+        std::cerr << "Point " << ptId << " is not numbered by its first use" << std::endl;
+        return false;
+      }
+      used[ptId] = true;
+    }
+  }
+  return true;
+}
+
+// Check that the output points are the same, in the same order.
+bool SamePointOrder(vtkPointSet* sequential, vtkPointSet* serial)
+{
+  vtkDataArray* sequentialPointIds = sequential->GetPointData()->GetArray("PointIds");
+  vtkDataArray* serialPointIds = serial->GetPointData()->GetArray("PointIds");
+  for (vtkIdType i = 0; i < serial->GetNumberOfPoints(); ++i)
+  {
+    if (sequentialPointIds->GetComponent(i, 0) != serialPointIds->GetComponent(i, 0))
+    {
+      std::cerr << "Different point " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TFilter>
+bool TestFilter(TFilter* parallel, TFilter* serial, TFilter* sequential)
+{
+  const int modes[] = { VTK_EXTRACT_POINT_SEEDED_REGIONS, VTK_EXTRACT_CELL_SEEDED_REGIONS,
+    VTK_EXTRACT_SPECIFIED_REGIONS, VTK_EXTRACT_LARGEST_REGION, VTK_EXTRACT_ALL_REGIONS,
+    VTK_EXTRACT_CLOSEST_POINT_REGION };
+  for (TFilter* filter : { parallel, serial, sequential })
+  {
+    filter->AddSeed(0);
+    filter->AddSeed(1700);
+    filter->AddSpecifiedRegion(2);
+    filter->AddSpecifiedRegion(5);
+    filter->SetClosestPoint(0.1, 0.2, 0.0);
+    filter->SetScalarRange(-1.0, 1.0);
+    filter->ColorRegionsOn();
+  }
+  parallel->ScalarConnectivityOff();
+  serial->ScalarConnectivityOn();
+  sequential->ScalarConnectivityOff();
+  sequential->SequentialProcessingOn();
+  for (int mode : modes)
+  {
+    parallel->SetExtractionMode(mode);
+    parallel->Update();
+    serial->SetExtractionMode(mode);
+    serial->Update();
+    sequential->SetExtractionMode(mode);
+    sequential->Update();
+    if (parallel->GetNumberOfExtractedRegions() != serial->GetNumberOfExtractedRegions() ||
+      !SameOutputs(vtkPointSet::SafeDownCast(parallel->GetOutputDataObject(0)),
+        vtkPointSet::SafeDownCast(serial->GetOutputDataObject(0)),
+        mode == VTK_EXTRACT_ALL_REGIONS) ||
+      !NumberedByFirstUse(vtkPointSet::SafeDownCast(parallel->GetOutputDataObject(0))) ||
+      sequential->GetNumberOfExtractedRegions() != serial->GetNumberOfExtractedRegions() ||
+      !SameOutputs(vtkPointSet::SafeDownCast(sequential->GetOutputDataObject(0)),
+        vtkPointSet::SafeDownCast(serial->GetOutputDataObject(0)),
+        mode == VTK_EXTRACT_ALL_REGIONS) ||
+      !SamePointOrder(vtkPointSet::SafeDownCast(sequential->GetOutputDataObject(0)),
+        vtkPointSet::SafeDownCast(serial->GetOutputDataObject(0))))
+    {
+      std::cerr << "Different outputs for " << parallel->GetClassName() << " and mode " << mode
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestConnectivityFiltersParallel(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  MakeInput(input);
+  std::cout << input->GetNumberOfCells() << " cells" << std::endl;
+
+  vtkNew<vtkPolyDataConnectivityFilter> polyDataParallel;
+  polyDataParallel->SetInputData(input);
+  vtkNew<vtkPolyDataConnectivityFilter> polyDataSerial;
+  polyDataSerial->SetInputData(input);
+  vtkNew<vtkPolyDataConnectivityFilter> polyDataSequential;
+  polyDataSequential->SetInputData(input);
+  if (!TestFilter(polyDataParallel.Get(), polyDataSerial.Get(), polyDataSequential.Get()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkAppendFilter> append;
+  append->AddInputData(input);
+  append->Update();
+  vtkDataSet* grid = append->GetOutput();
+  for (vtkDataSet* dataSet : { static_cast<vtkDataSet*>(input), grid })
+  {
+    vtkNew<vtkConnectivityFilter> parallel;
+    parallel->SetInputData(dataSet);
+    vtkNew<vtkConnectivityFilter> serial;
+    serial->SetInputData(dataSet);
+    vtkNew<vtkConnectivityFilter> sequential;
+    sequential->SetInputData(dataSet);
+    for (int assignment : { vtkConnectivityFilter::UNSPECIFIED,
+           vtkConnectivityFilter::CELL_COUNT_DESCENDING,
+           vtkConnectivityFilter::CELL_COUNT_ASCENDING })
+    {
+      parallel->SetRegionIdAssignmentMode(assignment);
+      serial->SetRegionIdAssignmentMode(assignment);
+      sequential->SetRegionIdAssignmentMode(assignment);
+      if (!TestFilter(parallel.Get(), serial.Get(), sequential.Get()))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunaySpatialPointInsertion.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the spatially sorted point insertion of vtkDelaunay2D and
+// vtkDelaunay3D produces the same triangulations as the given order.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay2D.h"
+#include "vtkDelaunay3D.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace
+{
+// The cells of a dataset with the given number of points, as sorted point ids.
+std::set<std::vector<vtkIdType>> GetCells(vtkDataSet* output, vtkIdType size)
+{
+  std::set<std::vector<vtkIdType>> cells;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, ptIds);
+    if (ptIds->GetNumberOfIds() != size)
+    {
+      continue;
+    }
+    std::vector<vtkIdType> cell(ptIds->begin(), ptIds->end());
+    std::sort(cell.begin(), cell.end());
+    cells.insert(cell);
+  }
+  return cells;
+}
+
+// Points in general position, in a unit square or cube.
+void MakePoints(vtkPolyData* input, vtkIdType numPts, bool flat)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetValue();
+      random->Next();
+    }
+    if (flat)
+    {
+      x[2] *= 0.01;
+    }
+    points->InsertNextPoint(x);
+  }
+  input->SetPoints(points);
+}
+}
+
+int TestDelaunaySpatialPointInsertion(int, char*[])
+{
+  vtkNew<vtkPolyData> input2D;
+  MakePoints(input2D, 20000, true);
+  for (double alpha : { 0.0, 0.02 })
+  {
+    vtkNew<vtkDelaunay2D> given;
+    given->SetInputData(input2D);
+    given->SetAlpha(alpha);
+    given->Update();
+    vtkNew<vtkDelaunay2D> spatial;
+    spatial->SetInputData(input2D);
+    spatial->SetAlpha(alpha);
+    spatial->SpatialPointInsertionOn();
+    spatial->Update();
+    std::cout << "2D, alpha " << alpha << ": " << given->GetOutput()->GetNumberOfCells() << " and "
+              << spatial->GetOutput()->GetNumberOfCells() << " cells" << std::endl;
+    if (given->GetOutput()->GetNumberOfCells() == 0 ||
+      GetCells(given->GetOutput(), 3) != GetCells(spatial->GetOutput(), 3))
+    {
+      std::cerr << "Different 2D triangulations for alpha " << alpha << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The alpha triangles, lines and vertices of vtkDelaunay3D next to the
+  // bounding tetrahedra depend on the numbering of the tetrahedra, so only
+  // the tetrahedra are compared.
+  vtkNew<vtkPolyData> input3D;
+  MakePoints(input3D, 3000, false);
+  for (double alpha : { 0.0, 0.1 })
+  {
+    vtkNew<vtkDelaunay3D> given;
+    given->SetInputData(input3D);
+    given->SetAlpha(alpha);
+    given->Update();
+    vtkNew<vtkDelaunay3D> spatial;
+    spatial->SetInputData(input3D);
+    spatial->SetAlpha(alpha);
+    spatial->SpatialPointInsertionOn();
+    spatial->Update();
+    std::cout << "3D, alpha " << alpha << ": " << given->GetOutput()->GetNumberOfCells() << " and "
+              << spatial->GetOutput()->GetNumberOfCells() << " cells" << std::endl;
+    if (given->GetOutput()->GetNumberOfCells() == 0 ||
+      GetCells(given->GetOutput(), 4) != GetCells(spatial->GetOutput(), 4))
+    {
+      std::cerr << "Different 3D triangulations for alpha " << alpha << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
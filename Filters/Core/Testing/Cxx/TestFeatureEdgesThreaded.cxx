@@ -0,0 +1,311 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFeatureEdgesThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded extraction of vtkFeatureEdges produces the same
+// output as the serial one, which is used when a locator is specified or
+// SequentialProcessing is on, and copies the bit arrays too.
+
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFeatureEdges.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+
+#include <iostream>
+#include <utility>
+
+namespace
+{
+// An open sphere made of polygons next to an open sphere made of strips,
+// with non-manifold fins, a quad patch whose points are duplicates of the
+// sphere points, lines and vertices.
+void MakeInput(vtkPolyData* input)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(24);
+  sphere->SetPhiResolution(16);
+  sphere->SetEndTheta(300.0);
+  sphere->Update();
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(sphere->GetOutputPort());
+  stripper->Update();
+
+  vtkPolyData* polys = sphere->GetOutput();
+  vtkPolyData* strips = stripper->GetOutput();
+  const vtkIdType numPolyPts = polys->GetNumberOfPoints();
+  vtkNew<vtkPoints> points;
+  for (vtkIdType i = 0; i < numPolyPts; ++i)
+  {
+    points->InsertNextPoint(polys->GetPoint(i));
+  }
+  for (vtkIdType i = 0; i < strips->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    strips->GetPoint(i, x);
+    points->InsertNextPoint(x[0] + 1.5, x[1], x[2]);
+  }
+
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->DeepCopy(polys->GetPolys());
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType i = 0; i < 40; i += 4)
+  {
+    // Fins on the edges of some triangles.
+    polys->GetPolys()->GetCellAtId(3 * i, ptIds);
+    const vtkIdType tip = points->InsertNextPoint(0.0, 0.0, 2.0 + i);
+    const vtkIdType fin[3] = { ptIds->GetId(1), ptIds->GetId(0), tip };
+    newPolys->InsertNextCell(3, fin);
+  }
+  for (vtkIdType i = 0; i < 6; ++i)
+  {
+    // Quads on duplicates of the sphere points.
+    vtkIdType quad[4];
+    for (int j = 0; j < 4; ++j)
+    {
+      quad[j] = points->InsertNextPoint(polys->GetPoint(2 + i + (j % 2) + 16 * (j / 2)));
+    }
+    std::swap(quad[2], quad[3]);
+    newPolys->InsertNextCell(4, quad);
+  }
+
+  vtkNew<vtkCellArray> shiftedStrips;
+  for (vtkIdType i = 0; i < strips->GetStrips()->GetNumberOfCells(); ++i)
+  {
+    strips->GetStrips()->GetCellAtId(i, ptIds);
+    for (vtkIdType j = 0; j < ptIds->GetNumberOfIds(); ++j)
+    {
+      ptIds->SetId(j, ptIds->GetId(j) + numPolyPts);
+    }
+    shiftedStrips->InsertNextCell(ptIds);
+  }
+
+  vtkNew<vtkCellArray> lines;
+  const vtkIdType polyLine[5] = { 0, 5, 9, numPolyPts + 3, numPolyPts + 7 };
+  lines->InsertNextCell(5, polyLine);
+  const vtkIdType line[2] = { 11, points->GetNumberOfPoints() - 1 };
+  lines->InsertNextCell(2, line);
+  vtkNew<vtkCellArray> verts;
+  const vtkIdType vert[1] = { 4 };
+  verts->InsertNextCell(1, vert);
+
+  input->SetPoints(points);
+  input->SetVerts(verts);
+  input->SetLines(lines);
+  input->SetPolys(newPolys);
+  input->SetStrips(shiftedStrips);
+
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    pointIds->InsertNextValue(i);
+  }
+  input->GetPointData()->AddArray(pointIds);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  input->GetCellData()->AddArray(cellIds);
+}
+
+bool SameArrays(vtkDataArray* threaded, vtkDataArray* serial)
+{
+  if (!threaded || !serial || threaded->GetDataType() != serial->GetDataType() ||
+    threaded->GetNumberOfTuples() != serial->GetNumberOfTuples())
+  {
+    return threaded == serial;
+  }
+  for (vtkIdType i = 0; i < threaded->GetNumberOfTuples(); ++i)
+  {
+    if (threaded->GetComponent(i, 0) != serial->GetComponent(i, 0))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutputs(vtkPolyData* threaded, vtkPolyData* serial)
+{
+  if (threaded->GetNumberOfPoints() != serial->GetNumberOfPoints() ||
+    threaded->GetPoints()->GetDataType() != serial->GetPoints()->GetDataType() ||
+    threaded->GetNumberOfLines() != serial->GetNumberOfLines())
+  {
+    std::cerr << "Different sizes: " << threaded->GetNumberOfPoints() << " and "
+              << serial->GetNumberOfPoints() << " points, " << threaded->GetNumberOfLines()
+              << " and " << serial->GetNumberOfLines() << " lines" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < threaded->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    threaded->GetPoint(i, x);
+    serial->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Different point " << i << std::endl;
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> threadedIds;
+  vtkNew<vtkIdList> serialIds;
+  for (vtkIdType i = 0; i < threaded->GetNumberOfLines(); ++i)
+  {
+    threaded->GetLines()->GetCellAtId(i, threadedIds);
+    serial->GetLines()->GetCellAtId(i, serialIds);
+    if (threadedIds->GetNumberOfIds() != 2 || serialIds->GetNumberOfIds() != 2 ||
+      threadedIds->GetId(0) != serialIds->GetId(0) || threadedIds->GetId(1) != serialIds->GetId(1))
+    {
+      std::cerr << "Different line " << i << std::endl;
+      return false;
+    }
+  }
+  if (!SameArrays(threaded->GetPointData()->GetArray("PointIds"),
+        serial->GetPointData()->GetArray("PointIds")) ||
+    !SameArrays(threaded->GetCellData()->GetArray("CellIds"),
+      serial->GetCellData()->GetArray("CellIds")) ||
+    !SameArrays(threaded->GetCellData()->GetArray("Edge Types"),
+      serial->GetCellData()->GetArray("Edge Types")))
+  {
+    std::cerr << "Different attributes" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Check that the bit array of the attributes holds the parity of their ids.
+bool SameParity(vtkDataSetAttributes* attributes, const char* bitsName, const char* idsName)
+{
+  vtkBitArray* bits = vtkBitArray::SafeDownCast(attributes->GetAbstractArray(bitsName));
+  vtkDataArray* ids = attributes->GetArray(idsName);
+  if (!bits || !ids || bits->GetNumberOfTuples() != ids->GetNumberOfTuples() ||
+    bits->GetNumberOfTuples() == 0)
+  {
+    std::cerr << "Missing " << bitsName << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < bits->GetNumberOfTuples(); ++i)
+  {
+    if (bits->GetValue(i) != static_cast<vtkIdType>(ids->GetComponent(i, 0)) % 2)
+    {
+      std::cerr << "Different " << bitsName << " " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestFeatureEdgesThreaded(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  MakeInput(input);
+
+  vtkNew<vtkFeatureEdges> threaded;
+  threaded->SetInputData(input);
+  vtkNew<vtkFeatureEdges> serial;
+  serial->SetInputData(input);
+  vtkNew<vtkMergePoints> locator;
+  serial->SetLocator(locator);
+  vtkNew<vtkFeatureEdges> sequential;
+  sequential->SetInputData(input);
+  sequential->SequentialProcessingOn();
+  for (int option = 0; option < 128; ++option)
+  {
+    for (vtkFeatureEdges* filter : { threaded.Get(), serial.Get(), sequential.Get() })
+    {
+      filter->SetBoundaryEdges((option & 1) != 0);
+      filter->SetNonManifoldEdges((option & 2) != 0);
+      filter->SetFeatureEdges((option & 4) != 0);
+      filter->SetManifoldEdges((option & 8) != 0);
+      filter->SetPassLines((option & 16) != 0);
+      filter->SetColoring((option & 32) != 0);
+      filter->SetOutputPointsPrecision(
+        (option & 64) ? vtkAlgorithm::DOUBLE_PRECISION : vtkAlgorithm::DEFAULT_PRECISION);
+      filter->SetFeatureAngle(20.0);
+      filter->Update();
+    }
+    if (threaded->GetLocator() || sequential->GetLocator() ||
+      !SameOutputs(threaded->GetOutput(), serial->GetOutput()) ||
+      !SameOutputs(sequential->GetOutput(), serial->GetOutput()))
+    {
+      std::cerr << "Different outputs for option " << option << std::endl;
+      return EXIT_FAILURE;
+    }
+    // Each type of edge is found alone.
+    if ((option == 1 || option == 2 || option == 4 || option == 8 || option == 16) &&
+      threaded->GetOutput()->GetNumberOfLines() == 0)
+    {
+      std::cerr << "No edges for option " << option << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The locator created by a serial execution, here for a degenerate
+  // polygon, must not be taken for a locator specified by the user.
+  vtkNew<vtkPolyData> degenerateInput;
+  degenerateInput->DeepCopy(input);
+  const vtkIdType degenerate[4] = { 0, 1, 0, 2 };
+  degenerateInput->GetPolys()->InsertNextCell(4, degenerate);
+  vtkIdTypeArray::SafeDownCast(degenerateInput->GetCellData()->GetArray("CellIds"))
+    ->InsertNextValue(input->GetNumberOfCells());
+  threaded->SetInputData(degenerateInput);
+  threaded->Update();
+  threaded->SetInputData(input);
+  threaded->Update();
+  if (threaded->GetLocator() || !SameOutputs(threaded->GetOutput(), serial->GetOutput()))
+  {
+    std::cerr << "Different outputs after a serial execution" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Bit arrays are not handled by the threaded path, but must still be
+  // copied to the output points and edges.
+  vtkNew<vtkPolyData> bitInput;
+  bitInput->ShallowCopy(input);
+  vtkNew<vtkBitArray> pointBits;
+  pointBits->SetName("PointBits");
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    pointBits->InsertNextValue(i % 2);
+  }
+  bitInput->GetPointData()->AddArray(pointBits);
+  vtkNew<vtkBitArray> cellBits;
+  cellBits->SetName("CellBits");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellBits->InsertNextValue(i % 2);
+  }
+  bitInput->GetCellData()->AddArray(cellBits);
+  threaded->SetInputData(bitInput);
+  threaded->Update();
+  if (threaded->GetLocator() || !SameOutputs(threaded->GetOutput(), serial->GetOutput()) ||
+    !SameParity(threaded->GetOutput()->GetPointData(), "PointBits", "PointIds") ||
+    !SameParity(threaded->GetOutput()->GetCellData(), "CellBits", "CellIds"))
+  {
+    std::cerr << "Different outputs with bit arrays" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,489 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks of the threaded generation of vtkGlyph3D: the same output as the
+// sequential one for all the modes, the direction towards the camera of each
+// glyph, the table of instances and its prototypes generated with
+// InstancedOutput on, and the string and bit arrays, which are only copied by
+// the sequential processing.
+
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConeSource.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkStringArray.h"
+#include "vtkTexturedSphereSource.h"
+#include "vtkTransform.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+// Random points with scalars, vectors and normals, including vectors along
+// the x axis and null vectors, and a few ghost points.
+static void MakeInput(vtkPolyData* input)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  const vtkIdType numPts = 500;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    points->InsertNextPoint(random->GetNextRangeValue(-5, 5), random->GetNextRangeValue(-5, 5),
+      random->GetNextRangeValue(-5, 5));
+    scalars->InsertNextValue(random->GetNextRangeValue(-0.5, 1.5));
+    double v[3] = { random->GetNextRangeValue(-1, 1), random->GetNextRangeValue(-1, 1),
+      random->GetNextRangeValue(-1, 1) };
+    if (i % 17 == 0)
+    {
+      v[1] = v[2] = 0.0;
+    }
+    if (i % 23 == 0)
+    {
+      v[0] = v[1] = v[2] = 0.0;
+    }
+    vectors->InsertNextTuple(v);
+    normals->InsertNextTuple3(random->GetNextRangeValue(-1, 1), random->GetNextRangeValue(-1, 1),
+      random->GetNextRangeValue(-1, 1));
+    pointIds->InsertNextValue(i);
+    ghosts->InsertNextValue(i % 31 == 0 ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+  }
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->SetNormals(normals);
+  input->GetPointData()->AddArray(pointIds);
+  input->GetPointData()->AddArray(ghosts);
+}
+
+static const char* const GlyphArrayNames[] = { "Normals", "TCoords", "GlyphVector", "GlyphScale",
+  "Scalars", "VectorMagnitude", "PointIds", "InputPointIds" };
+
+// Both arrays are missing, or have the same type, size and values.
+static bool SameArrays(vtkDataArray* threaded, vtkDataArray* serial)
+{
+  if (!threaded || !serial)
+  {
+    return !threaded && !serial;
+  }
+  if (threaded->GetDataType() != serial->GetDataType() ||
+    threaded->GetNumberOfTuples() != serial->GetNumberOfTuples() ||
+    threaded->GetNumberOfComponents() != serial->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < threaded->GetNumberOfTuples(); ++i)
+  {
+    for (int j = 0; j < threaded->GetNumberOfComponents(); ++j)
+    {
+      if (threaded->GetComponent(i, j) != serial->GetComponent(i, j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool SameCells(vtkCellArray* threaded, vtkCellArray* serial)
+{
+  return threaded->GetNumberOfCells() == serial->GetNumberOfCells() &&
+    SameArrays(threaded->GetOffsetsArray(), serial->GetOffsetsArray()) &&
+    SameArrays(threaded->GetConnectivityArray(), serial->GetConnectivityArray());
+}
+
+static bool SameGlyphs(vtkPolyData* threaded, vtkPolyData* serial)
+{
+  if (threaded->GetNumberOfPoints() == 0 ||
+    !SameArrays(threaded->GetPoints()->GetData(), serial->GetPoints()->GetData()))
+  {
+    std::cerr << "Different points: " << threaded->GetNumberOfPoints() << " and "
+              << serial->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+  if (!SameCells(threaded->GetVerts(), serial->GetVerts()) ||
+    !SameCells(threaded->GetLines(), serial->GetLines()) ||
+    !SameCells(threaded->GetPolys(), serial->GetPolys()) ||
+    !SameCells(threaded->GetStrips(), serial->GetStrips()))
+  {
+    std::cerr << "Different cells" << std::endl;
+    return false;
+  }
+  for (const char* name : GlyphArrayNames)
+  {
+    if (!SameArrays(
+          threaded->GetPointData()->GetArray(name), serial->GetPointData()->GetArray(name)))
+    {
+      std::cerr << "Different " << name << std::endl;
+      return false;
+    }
+  }
+  if (!SameArrays(threaded->GetPointData()->GetScalars(), serial->GetPointData()->GetScalars()) ||
+    !SameArrays(
+      threaded->GetCellData()->GetArray("PointIds"), serial->GetCellData()->GetArray("PointIds")))
+  {
+    std::cerr << "Different scalars or cell point ids" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Sources with normals, with texture coordinates, and with neither.
+static void MakeSources(vtkPolyData* sources[3])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(12);
+  sphere->SetPhiResolution(8);
+  sphere->Update();
+  vtkNew<vtkTexturedSphereSource> texturedSphere;
+  texturedSphere->Update();
+  vtkNew<vtkConeSource> cone;
+  cone->Update();
+  vtkAlgorithm* algorithms[3] = { sphere, texturedSphere, cone };
+  for (int i = 0; i < 3; ++i)
+  {
+    sources[i] = vtkPolyData::New();
+    sources[i]->ShallowCopy(algorithms[i]->GetOutputDataObject(0));
+  }
+}
+
+// Set up the filter for one of 96 combinations of the modes and options.
+static void SetOptions(vtkGlyph3D* filter, int option, vtkPolyData* input, vtkPolyData* sources[3],
+  vtkTransform* sourceTransform)
+{
+  const int indexMode = option % 3;
+  filter->SetScaleMode(option % 4);
+  filter->SetColorMode((option / 4) % 3);
+  filter->SetVectorMode((option / 3) % 4);
+  filter->SetOrient(option % 5 != 0);
+  filter->SetClamping(option % 7 == 0);
+  filter->SetScaling(option % 11 != 0);
+  filter->SetScaleFactor(0.3);
+  filter->SetRange(-0.2, 1.2);
+  double cameraPosition[3] = { 10.0, 20.0, 30.0 };
+  filter->SetFollowedCameraPosition(cameraPosition);
+  filter->SetIndexMode(indexMode);
+  filter->SetGeneratePointIds(option % 2);
+  filter->SetFillCellData((option / 2) % 2);
+  filter->SetSourceTransform(option % 8 < 3 ? sourceTransform : nullptr);
+  filter->SetOutputPointsPrecision(
+    (option / 8) % 2 ? vtkAlgorithm::DOUBLE_PRECISION : vtkAlgorithm::DEFAULT_PRECISION);
+  filter->RemoveAllInputConnections(1);
+  filter->SetInputData(input);
+  for (int i = 0; i < (indexMode ? 3 : 1); ++i)
+  {
+    filter->SetSourceData(i, sources[indexMode ? i : (option / 16) % 3]);
+  }
+}
+
+// The threaded glyphs are the sequential ones, for all the scale, color,
+// vector and index modes, with and without point ids, cell data and source
+// transform, and with both output precisions.
+static bool TestGlyph3DThreaded_SameAsSequential(
+  vtkPolyData* input, vtkPolyData* sources[3], vtkTransform* sourceTransform)
+{
+  vtkNew<vtkGlyph3D> threaded;
+  vtkNew<vtkGlyph3D> serial;
+  serial->SequentialProcessingOn();
+  for (int option = 0; option < 96; ++option)
+  {
+    SetOptions(threaded, option, input, sources, sourceTransform);
+    SetOptions(serial, option, input, sources, sourceTransform);
+    threaded->Update();
+    serial->Update();
+    if (!SameGlyphs(threaded->GetOutput(), serial->GetOutput()))
+    {
+      std::cerr << "Different outputs for option " << option << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// In the FollowCameraDirection vector mode, the GlyphVector of each glyph is
+// the direction from its input point towards the camera.
+static bool TestGlyph3DThreaded_FollowCameraDirection(vtkPolyData* input, vtkPolyData* source)
+{
+  double camera[3] = { 10.0, 20.0, 30.0 };
+  for (bool sequential : { false, true })
+  {
+    vtkNew<vtkGlyph3D> glyph3D;
+    glyph3D->SetSequentialProcessing(sequential);
+    glyph3D->SetVectorModeToFollowCameraDirection();
+    glyph3D->SetFollowedCameraPosition(camera);
+    glyph3D->GeneratePointIdsOn();
+    glyph3D->SetInputData(input);
+    glyph3D->SetSourceData(source);
+    glyph3D->Update();
+    vtkPointData* outPD = glyph3D->GetOutput()->GetPointData();
+    vtkDataArray* glyphVectors = outPD->GetArray("GlyphVector");
+    vtkDataArray* inputIds = outPD->GetArray("InputPointIds");
+    if (!glyphVectors || !inputIds || glyph3D->GetOutput()->GetNumberOfPoints() == 0)
+    {
+      std::cerr << "No GlyphVector" << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < glyphVectors->GetNumberOfTuples(); ++i)
+    {
+      double x[3], v[3];
+      input->GetPoint(static_cast<vtkIdType>(inputIds->GetComponent(i, 0)), x);
+      for (int k = 0; k < 3; ++k)
+      {
+        v[k] = camera[k] - x[k];
+      }
+      vtkMath::Normalize(v);
+      for (int k = 0; k < 3; ++k)
+      {
+        if (std::abs(glyphVectors->GetComponent(i, k) - v[k]) > 1e-6)
+        {
+          std::cerr << "Wrong GlyphVector for point " << i << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// The instances transform the source points to the glyph points, and have
+// the attributes of their glyphs.
+static bool SameInstances(vtkPolyData* instances, vtkPolyData* glyphs, vtkPolyData* source)
+{
+  const vtkIdType numInstances = instances->GetNumberOfPoints();
+  const vtkIdType numSourcePts = source->GetNumberOfPoints();
+  vtkDataArray* transforms = instances->GetPointData()->GetArray("GlyphTransform");
+  if (numInstances * numSourcePts != glyphs->GetNumberOfPoints() ||
+    instances->GetNumberOfVerts() != numInstances || !transforms ||
+    transforms->GetNumberOfComponents() != 16)
+  {
+    std::cerr << "Wrong number of instances: " << numInstances << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < numInstances; ++i)
+  {
+    double matrix[16];
+    transforms->GetTuple(i, matrix);
+    for (vtkIdType j = 0; j < numSourcePts; ++j)
+    {
+      double p[3], x[3];
+      source->GetPoint(j, p);
+      glyphs->GetPoint(i * numSourcePts + j, x);
+      for (int k = 0; k < 3; ++k)
+      {
+        const double y = matrix[4 * k] * p[0] + matrix[4 * k + 1] * p[1] +
+          matrix[4 * k + 2] * p[2] + matrix[4 * k + 3];
+        if (std::abs(y - x[k]) > 1e-5 * (1.0 + std::abs(x[k])))
+        {
+          std::cerr << "Wrong transform for instance " << i << std::endl;
+          return false;
+        }
+      }
+    }
+    for (const char* name : GlyphArrayNames)
+    {
+      vtkDataArray* instanceArray = instances->GetPointData()->GetArray(name);
+      vtkDataArray* glyphArray = glyphs->GetPointData()->GetArray(name);
+      if (!instanceArray || std::string(name) == "Normals" || std::string(name) == "TCoords")
+      {
+        continue;
+      }
+      for (int k = 0; k < instanceArray->GetNumberOfComponents(); ++k)
+      {
+        if (!glyphArray ||
+          instanceArray->GetComponent(i, k) != glyphArray->GetComponent(i * numSourcePts, k))
+        {
+          std::cerr << "Wrong " << name << " for instance " << i << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// With InstancedOutput on, the table of instances places the source at the
+// glyphs, and gives the index of the source of each glyph when indexing.
+static bool TestGlyph3DThreaded_Instances(
+  vtkPolyData* input, vtkPolyData* sources[3], vtkTransform* sourceTransform)
+{
+  vtkNew<vtkGlyph3D> glyphs;
+  vtkNew<vtkGlyph3D> instances;
+  for (int option = 0; option < 96; ++option)
+  {
+    SetOptions(glyphs, option, input, sources, sourceTransform);
+    SetOptions(instances, option, input, sources, sourceTransform);
+    instances->InstancedOutputOn();
+    glyphs->Update();
+    instances->Update();
+    vtkPolyData* output = instances->GetOutput();
+    if (option % 3 == 0 && !SameInstances(output, glyphs->GetOutput(), sources[(option / 16) % 3]))
+    {
+      std::cerr << "Wrong instances for option " << option << std::endl;
+      return false;
+    }
+    if (option % 3 != 0 &&
+      (!output->GetPointData()->GetArray("GlyphSourceIndex") || output->GetNumberOfPoints() == 0))
+    {
+      std::cerr << "No source indices for option " << option << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The second output holds a block per source when indexing, the source or
+// the default line otherwise, and nothing when InstancedOutput is off.
+static bool TestGlyph3DThreaded_Prototypes(vtkPolyData* input, vtkPolyData* sources[3])
+{
+  vtkNew<vtkGlyph3D> glyph3D;
+  glyph3D->SetInputData(input);
+  glyph3D->InstancedOutputOn();
+  glyph3D->SetIndexModeToScalar();
+  for (int i = 0; i < 3; ++i)
+  {
+    glyph3D->SetSourceData(i, sources[i]);
+  }
+  glyph3D->Update();
+  vtkMultiBlockDataSet* prototypes = glyph3D->GetPrototypesOutput();
+  if (!prototypes || prototypes->GetNumberOfBlocks() != 3)
+  {
+    std::cerr << "Expected a prototype per source" << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    vtkPolyData* prototype = vtkPolyData::SafeDownCast(prototypes->GetBlock(i));
+    if (!prototype || prototype->GetPoints() != sources[i]->GetPoints())
+    {
+      std::cerr << "Wrong prototype " << i << std::endl;
+      return false;
+    }
+  }
+
+  glyph3D->SetIndexModeToOff();
+  glyph3D->RemoveAllInputConnections(1);
+  glyph3D->Update();
+  prototypes = glyph3D->GetPrototypesOutput();
+  vtkPolyData* line = vtkPolyData::SafeDownCast(prototypes->GetBlock(0));
+  if (prototypes->GetNumberOfBlocks() != 1 || !line || line->GetNumberOfPoints() != 2 ||
+    line->GetNumberOfLines() != 1 || line->GetPoint(1)[0] != 1.0)
+  {
+    std::cerr << "Expected the default line as prototype" << std::endl;
+    return false;
+  }
+
+  glyph3D->InstancedOutputOff();
+  glyph3D->Update();
+  if (glyph3D->GetPrototypesOutput()->GetNumberOfBlocks() != 0)
+  {
+    std::cerr << "Expected no prototypes without InstancedOutput" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// String and bit arrays, which are only copied by the sequential
+// processing, are passed to the output.
+static bool TestGlyph3DThreaded_StringAndBitArrays(vtkPolyData* input, vtkPolyData* source)
+{
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  vtkNew<vtkBitArray> bits;
+  bits->SetName("Bits");
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    names->InsertNextValue(std::to_string(i));
+    bits->InsertNextValue(i % 2);
+  }
+  vtkNew<vtkPolyData> namesInput;
+  namesInput->ShallowCopy(input);
+  namesInput->GetPointData()->AddArray(names);
+  namesInput->GetPointData()->AddArray(bits);
+
+  vtkNew<vtkGlyph3D> glyph3D;
+  glyph3D->SetInputData(namesInput);
+  glyph3D->SetSourceData(source);
+  glyph3D->Update();
+  vtkPolyData* output = glyph3D->GetOutput();
+  vtkPointData* outPD = output->GetPointData();
+  vtkStringArray* outNames = vtkArrayDownCast<vtkStringArray>(outPD->GetAbstractArray("Names"));
+  vtkDataArray* outBits = outPD->GetArray("Bits");
+  vtkDataArray* outIds = outPD->GetArray("PointIds");
+  if (!outNames || !outBits || !outIds || output->GetNumberOfPoints() == 0 ||
+    outNames->GetNumberOfValues() != output->GetNumberOfPoints() ||
+    outBits->GetNumberOfTuples() != output->GetNumberOfPoints())
+  {
+    std::cerr << "Missing string or bit array" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < outNames->GetNumberOfValues(); ++i)
+  {
+    const vtkIdType id = static_cast<vtkIdType>(outIds->GetComponent(i, 0));
+    if (outNames->GetValue(i) != std::to_string(id) || outBits->GetComponent(i, 0) != id % 2)
+    {
+      std::cerr << "Different string or bit value " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int TestGlyph3DThreaded(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  MakeInput(input);
+  vtkPolyData* sources[3];
+  MakeSources(sources);
+  vtkNew<vtkTransform> sourceTransform;
+  sourceTransform->RotateZ(30.0);
+  sourceTransform->Scale(0.5, 1.0, 2.0);
+
+  bool success = TestGlyph3DThreaded_SameAsSequential(input, sources, sourceTransform) &&
+    TestGlyph3DThreaded_FollowCameraDirection(input, sources[2]) &&
+    TestGlyph3DThreaded_Instances(input, sources, sourceTransform) &&
+    TestGlyph3DThreaded_Prototypes(input, sources) &&
+    TestGlyph3DThreaded_StringAndBitArrays(input, sources[0]);
+
+  for (vtkPolyData* source : sources)
+  {
+    source->Delete();
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
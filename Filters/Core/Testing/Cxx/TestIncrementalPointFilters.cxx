@@ -0,0 +1,220 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIncrementalPointFilters.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the point local filters only recompute the tuples of their
+// cached output that depend on the ranges modified in their input arrays.
+
+#include "vtkArrayCalculator.h"
+#include "vtkElevationFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkImageMapToColors.h"
+#include "vtkImageShiftScale.h"
+#include "vtkLookupTable.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTimeStamp.h"
+#include "vtkWarpScalar.h"
+
+#include <iostream>
+
+namespace
+{
+const vtkIdType NumberOfPoints = 1000;
+
+#define CHECK(condition, message)                                                                  \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(condition))                                                                              \
+    {                                                                                              \
+      std::cerr << "Line " << __LINE__ << ": " << message << std::endl;                            \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+//------------------------------------------------------------------------------
+bool TestModifiedRanges()
+{
+  vtkNew<vtkFloatArray> array;
+  array->SetNumberOfTuples(100);
+  vtkNew<vtkIdTypeArray> ranges;
+  vtkTimeStamp before;
+  before.Modified();
+  CHECK(array->GetModifiedRanges(before, ranges) && ranges->GetNumberOfTuples() == 0,
+    "Ranges for an unmodified array");
+
+  array->Modified();
+  vtkTimeStamp modified;
+  modified.Modified();
+  array->ModifiedRange(10, 20);
+  array->ModifiedRange(50, 51);
+  array->ModifiedRange(15, 30);
+  CHECK(array->GetModifiedRanges(modified, ranges), "Missing ranges");
+  CHECK(ranges->GetNumberOfTuples() == 2 && ranges->GetValue(0) == 10 &&
+      ranges->GetValue(1) == 30 && ranges->GetValue(2) == 50 && ranges->GetValue(3) == 51,
+    "Wrong merged ranges");
+  CHECK(!array->GetModifiedRanges(before, ranges), "Ranges since before a full modification");
+
+  array->Modified();
+  CHECK(!array->GetModifiedRanges(modified, ranges), "Ranges after a full modification");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestPointSetFilters()
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("s");
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->InsertNextPoint(0.0, 0.0, i / static_cast<double>(NumberOfPoints));
+    scalars->InsertNextValue(1.0);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputData(input);
+  vtkNew<vtkArrayCalculator> calculator;
+  calculator->SetInputData(input);
+  calculator->AddScalarArrayName("s");
+  calculator->SetFunction("2*s");
+  calculator->SetResultArrayName("result");
+  calculator->SetResultArrayType(VTK_FLOAT);
+  vtkNew<vtkWarpScalar> warp;
+  warp->SetInputData(input);
+  warp->SetScaleFactor(1.0);
+  warp->UseNormalOn();
+
+  elevation->Update();
+  calculator->Update();
+  warp->Update();
+  vtkDataArray* elevationArray = elevation->GetOutput()->GetPointData()->GetArray("Elevation");
+  vtkDataArray* resultArray = calculator->GetDataSetOutput()->GetPointData()->GetArray("result");
+  vtkDataArray* warpedPoints = warp->GetOutput()->GetPoints()->GetData();
+
+  // Poison a tuple which is not modified, to check it is not computed again.
+  elevationArray->SetComponent(0, 0, -1.0);
+  resultArray->SetComponent(0, 0, -1.0);
+  warpedPoints->SetComponent(0, 2, -1.0);
+
+  for (vtkIdType i = 500; i < 510; ++i)
+  {
+    points->GetData()->SetComponent(i, 2, 1.0);
+    scalars->SetValue(i, 3.0);
+  }
+  points->GetData()->ModifiedRange(500, 510);
+  scalars->ModifiedRange(500, 510);
+
+  elevation->Update();
+  calculator->Update();
+  warp->Update();
+  CHECK(elevation->GetOutput()->GetPointData()->GetArray("Elevation") == elevationArray,
+    "Elevation not updated in place");
+  CHECK(calculator->GetDataSetOutput()->GetPointData()->GetArray("result") == resultArray,
+    "Calculator result not updated in place");
+  CHECK(warp->GetOutput()->GetPoints()->GetData() == warpedPoints, "Points not warped in place");
+  CHECK(elevationArray->GetComponent(0, 0) == -1.0 && resultArray->GetComponent(0, 0) == -1.0 &&
+      warpedPoints->GetComponent(0, 2) == -1.0,
+    "Unmodified tuples computed again");
+  for (vtkIdType i = 500; i < 510; ++i)
+  {
+    CHECK(elevationArray->GetComponent(i, 0) == 1.0, "Wrong elevation");
+    CHECK(resultArray->GetComponent(i, 0) == 6.0, "Wrong calculator result");
+    CHECK(warpedPoints->GetComponent(i, 2) == 4.0, "Wrong warped point");
+  }
+  vtkNew<vtkIdTypeArray> ranges;
+  CHECK(!elevationArray->GetModifiedRanges(0, ranges) &&
+      elevationArray->GetModifiedRanges(elevationArray->GetMTime() - 1, ranges) &&
+      ranges->GetNumberOfTuples() == 1 && ranges->GetValue(0) == 500 && ranges->GetValue(1) == 510,
+    "Modified ranges not propagated to the elevation");
+
+  // A full modification executes entirely.
+  scalars->Modified();
+  calculator->Update();
+  resultArray = calculator->GetDataSetOutput()->GetPointData()->GetArray("result");
+  CHECK(resultArray->GetComponent(0, 0) == 2.0, "Calculator not executed entirely");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestImageFilters()
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 20, 20);
+  image->AllocateScalars(VTK_FLOAT, 1);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  scalars->Fill(0.0);
+
+  vtkNew<vtkImageShiftScale> shiftScale;
+  shiftScale->SetInputData(image);
+  shiftScale->SetShift(1.0);
+  shiftScale->SetScale(2.0);
+  shiftScale->SetOutputScalarTypeToFloat();
+  vtkNew<vtkLookupTable> table;
+  table->SetRange(0.0, 10.0);
+  table->Build();
+  vtkNew<vtkImageMapToColors> colors;
+  colors->SetInputConnection(shiftScale->GetOutputPort());
+  colors->SetLookupTable(table);
+  colors->Update();
+
+  vtkDataArray* shifted = shiftScale->GetOutput()->GetPointData()->GetScalars();
+  vtkDataArray* mapped = colors->GetOutput()->GetPointData()->GetScalars();
+  shifted->SetComponent(0, 0, -1.0);
+  mapped->SetComponent(0, 0, 1.0);
+  double color[4];
+  table->GetColor(2.0, color);
+  const double background = static_cast<unsigned char>(color[0] * 255.0 + 0.5);
+  table->GetColor(10.0, color);
+  const double foreground = static_cast<unsigned char>(color[0] * 255.0 + 0.5);
+
+  // A partial row of the slice 10.
+  for (vtkIdType i = 4005; i < 4015; ++i)
+  {
+    scalars->SetComponent(i, 0, 4.0);
+  }
+  scalars->ModifiedRange(4005, 4015);
+  colors->Update();
+  CHECK(shiftScale->GetOutput()->GetPointData()->GetScalars() == shifted &&
+      colors->GetOutput()->GetPointData()->GetScalars() == mapped,
+    "Image scalars not updated in place");
+  CHECK(shifted->GetComponent(0, 0) == -1.0 && mapped->GetComponent(0, 0) == 1.0,
+    "Unmodified voxels computed again");
+  for (vtkIdType i = 4005; i < 4015; ++i)
+  {
+    CHECK(shifted->GetComponent(i, 0) == 10.0, "Wrong shifted value");
+    CHECK(mapped->GetComponent(i, 0) == foreground, "Wrong mapped color");
+  }
+  CHECK(shifted->GetComponent(4004, 0) == 2.0 && mapped->GetComponent(4004, 0) == background,
+    "Wrong unmodified voxel");
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestIncrementalPointFilters(int, char*[])
+{
+  if (!TestModifiedRanges() || !TestPointSetFilters() || !TestImageFilters())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,242 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricClusteringThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded binning of polygons and strips in
+// vtkQuadricClustering produces the same output as the serial one.
+
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricClustering.h"
+#include "vtkSphereSource.h"
+#include "vtkStringArray.h"
+#include "vtkStripper.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+// An open sphere made of polygons next to an open sphere made of strips.
+void MakeInput(vtkPolyData* input)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(60);
+  sphere->SetPhiResolution(40);
+  sphere->SetEndTheta(300.0);
+  sphere->Update();
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(sphere->GetOutputPort());
+  stripper->Update();
+
+  vtkPolyData* polys = sphere->GetOutput();
+  vtkPolyData* strips = stripper->GetOutput();
+  const vtkIdType numPolyPts = polys->GetNumberOfPoints();
+  vtkNew<vtkPoints> points;
+  for (vtkIdType i = 0; i < numPolyPts; ++i)
+  {
+    points->InsertNextPoint(polys->GetPoint(i));
+  }
+  for (vtkIdType i = 0; i < strips->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    strips->GetPoint(i, x);
+    points->InsertNextPoint(x[0] + 0.7, x[1], x[2]);
+  }
+  input->SetPoints(points);
+  input->SetPolys(polys->GetPolys());
+
+  vtkNew<vtkCellArray> shiftedStrips;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType i = 0; i < strips->GetStrips()->GetNumberOfCells(); ++i)
+  {
+    strips->GetStrips()->GetCellAtId(i, ptIds);
+    for (vtkIdType j = 0; j < ptIds->GetNumberOfIds(); ++j)
+    {
+      ptIds->SetId(j, ptIds->GetId(j) + numPolyPts);
+    }
+    shiftedStrips->InsertNextCell(ptIds);
+  }
+  input->SetStrips(shiftedStrips);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  input->GetCellData()->AddArray(cellIds);
+}
+
+// The cell ids of the serial output are shifted by the cells its input has in
+// addition to the threaded one.
+bool SameOutputs(vtkPolyData* threaded, vtkPolyData* serial, vtkIdType shift = 1)
+{
+  if (threaded->GetNumberOfPoints() != serial->GetNumberOfPoints() ||
+    threaded->GetNumberOfPolys() != serial->GetNumberOfPolys() ||
+    threaded->GetNumberOfLines() != 0 || threaded->GetNumberOfPolys() == 0)
+  {
+    std::cerr << "Different sizes: " << threaded->GetNumberOfPoints() << " and "
+              << serial->GetNumberOfPoints() << " points, " << threaded->GetNumberOfPolys()
+              << " and " << serial->GetNumberOfPolys() << " triangles" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < threaded->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    threaded->GetPoint(i, x);
+    serial->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Different point " << i << std::endl;
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> threadedIds;
+  vtkNew<vtkIdList> serialIds;
+  vtkStringArray* threadedNames =
+    vtkStringArray::SafeDownCast(threaded->GetCellData()->GetAbstractArray("Names"));
+  vtkStringArray* serialNames =
+    vtkStringArray::SafeDownCast(serial->GetCellData()->GetAbstractArray("Names"));
+  vtkDataArray* threadedOdd = threaded->GetCellData()->GetArray("Odd");
+  vtkDataArray* serialOdd = serial->GetCellData()->GetArray("Odd");
+  vtkDataArray* threadedCellIds = threaded->GetCellData()->GetArray("CellIds");
+  vtkDataArray* serialCellIds = serial->GetCellData()->GetArray("CellIds");
+  if (threadedCellIds && threadedCellIds->GetDataType() != serialCellIds->GetDataType())
+  {
+    std::cerr << "Different cell data types" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < threaded->GetNumberOfPolys(); ++i)
+  {
+    threaded->GetPolys()->GetCellAtId(i, threadedIds);
+    serial->GetPolys()->GetCellAtId(i, serialIds);
+    for (vtkIdType j = 0; j < 3; ++j)
+    {
+      if (threadedIds->GetId(j) != serialIds->GetId(j))
+      {
+        std::cerr << "Different triangle " << i << std::endl;
+        return false;
+      }
+    }
+    if (threadedCellIds &&
+      threadedCellIds->GetComponent(i, 0) + shift != serialCellIds->GetComponent(i, 0))
+    {
+      std::cerr << "Different cell data for triangle " << i << std::endl;
+      return false;
+    }
+    if ((threadedNames && threadedNames->GetValue(i) != serialNames->GetValue(i)) ||
+      (threadedOdd && threadedOdd->GetComponent(i, 0) != serialOdd->GetComponent(i, 0)))
+    {
+      std::cerr << "Different string or bit cell data for triangle " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestQuadricClusteringThreaded(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  MakeInput(input);
+
+  // The same input with a degenerate line first, which does not change the
+  // output but makes the filter bin the cells serially.
+  vtkNew<vtkPolyData> serialInput;
+  serialInput->SetPoints(input->GetPoints());
+  vtkNew<vtkCellArray> lines;
+  const vtkIdType line[2] = { 0, 0 };
+  lines->InsertNextCell(2, line);
+  serialInput->SetLines(lines);
+  serialInput->SetPolys(input->GetPolys());
+  serialInput->SetStrips(input->GetStrips());
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < serialInput->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  serialInput->GetCellData()->AddArray(cellIds);
+
+  vtkNew<vtkQuadricClustering> threaded;
+  threaded->SetInputData(input);
+  vtkNew<vtkQuadricClustering> serial;
+  serial->SetInputData(serialInput);
+  vtkNew<vtkQuadricClustering> sequential;
+  sequential->SetInputData(input);
+  sequential->SequentialProcessingOn();
+  for (int option = 0; option < 5; ++option)
+  {
+    for (vtkQuadricClustering* filter : { threaded.Get(), serial.Get(), sequential.Get() })
+    {
+      filter->SetNumberOfDivisions(24, 20, 16);
+      filter->SetCopyCellData(option == 0);
+      filter->SetUseFeatureEdges(option == 1 || option == 2);
+      filter->SetUseFeaturePoints(option == 2);
+      filter->SetUseInternalTriangles(option != 3);
+      filter->SetPreventDuplicateCells(option != 3);
+      filter->SetUseInputPoints(option == 4);
+      filter->Update();
+    }
+    if (!SameOutputs(threaded->GetOutput(), serial->GetOutput()) ||
+      !SameOutputs(threaded->GetOutput(), sequential->GetOutput(), 0))
+    {
+      std::cerr << "Different outputs for option " << option << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // String and bit cell arrays are copied too, by the serial binning.
+  for (vtkPolyData* pd : { input.Get(), serialInput.Get() })
+  {
+    // The serial input has an additional first cell.
+    const vtkIdType shift = pd == input ? 1 : 0;
+    vtkNew<vtkStringArray> names;
+    names->SetName("Names");
+    vtkNew<vtkBitArray> odd;
+    odd->SetName("Odd");
+    for (vtkIdType i = 0; i < pd->GetNumberOfCells(); ++i)
+    {
+      names->InsertNextValue(std::to_string(i + shift));
+      odd->InsertNextValue((i + shift) % 2);
+    }
+    pd->GetCellData()->AddArray(names);
+    pd->GetCellData()->AddArray(odd);
+  }
+  for (vtkQuadricClustering* filter : { threaded.Get(), serial.Get() })
+  {
+    filter->SetCopyCellData(true);
+    filter->SetUseFeatureEdges(false);
+    filter->SetUseFeaturePoints(false);
+    filter->SetUseInternalTriangles(true);
+    filter->SetPreventDuplicateCells(true);
+    filter->SetUseInputPoints(false);
+    filter->Modified();
+    filter->Update();
+  }
+  if (!threaded->GetOutput()->GetCellData()->GetAbstractArray("Names") ||
+    !threaded->GetOutput()->GetCellData()->GetArray("Odd") ||
+    !SameOutputs(threaded->GetOutput(), serial->GetOutput()))
+  {
+    std::cerr << "Different outputs with string and bit cell data" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricDecimationPartitions.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel decimation in partitions of vtkQuadricDecimation
+// reaches the target reduction with a quality close to the serial one, and
+// that it rejects non-triangles and can be aborted like the serial one.
+
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkDoubleArray.h"
+#include "vtkFeatureEdges.h"
+#include "vtkInformation.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSphereSource.h"
+#include "vtkTestErrorObserver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// Maximum distance of the points to the unit sphere.
+double GetMaximumError(vtkPolyData* mesh)
+{
+  double error = 0.0;
+  for (vtkIdType i = 0; i < mesh->GetNumberOfPoints(); i++)
+  {
+    double x[3];
+    mesh->GetPoint(i, x);
+    error = std::max(error, std::abs(vtkMath::Norm(x) - 1.0));
+  }
+  return error;
+}
+
+vtkIdType GetNumberOfBoundaryEdges(vtkPolyData* mesh)
+{
+  vtkNew<vtkFeatureEdges> edges;
+  edges->SetInputData(mesh);
+  edges->BoundaryEdgesOn();
+  edges->FeatureEdgesOff();
+  edges->NonManifoldEdgesOn();
+  edges->ManifoldEdgesOff();
+  edges->Update();
+  return edges->GetOutput()->GetNumberOfCells();
+}
+}
+
+int TestQuadricDecimationPartitions(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(1.0);
+  sphere->SetThetaResolution(150);
+  sphere->SetPhiResolution(150);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Height");
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); i++)
+  {
+    scalars->InsertNextValue(input->GetPoint(i)[2]);
+  }
+  input->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkQuadricDecimation> serial;
+  serial->SetInputData(input);
+  serial->SetTargetReduction(0.9);
+  serial->MapPointDataOn();
+  serial->Update();
+  vtkPolyData* serialOutput = serial->GetOutput();
+
+  vtkNew<vtkQuadricDecimation> parallel;
+  parallel->SetInputData(input);
+  parallel->SetTargetReduction(0.9);
+  parallel->MapPointDataOn();
+  parallel->SetNumberOfPartitions(4);
+  parallel->Update();
+  vtkPolyData* parallelOutput = parallel->GetOutput();
+
+  const double serialCells = serialOutput->GetNumberOfCells();
+  const double parallelCells = parallelOutput->GetNumberOfCells();
+  if (std::abs(parallelCells - serialCells) > 0.02 * serialCells ||
+    std::abs(parallel->GetActualReduction() - serial->GetActualReduction()) > 0.02)
+  {
+    std::cerr << "Target reduction not reached: " << parallelCells << " cells instead of "
+              << serialCells << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const double serialError = GetMaximumError(serialOutput);
+  const double parallelError = GetMaximumError(parallelOutput);
+  if (parallelError > 2.0 * serialError + 1e-3)
+  {
+    std::cerr << "Quality too far from the serial decimation: error " << parallelError
+              << " instead of " << serialError << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (GetNumberOfBoundaryEdges(parallelOutput) != GetNumberOfBoundaryEdges(serialOutput))
+  {
+    std::cerr << "Seams between the partitions not closed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkDataArray* height = parallelOutput->GetPointData()->GetArray("Height");
+  if (!height || height->GetNumberOfTuples() != parallelOutput->GetNumberOfPoints() ||
+    parallelOutput->GetPointData()->GetNumberOfArrays() !=
+      serialOutput->GetPointData()->GetNumberOfArrays())
+  {
+    std::cerr << "Wrong point data" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // An aborted decimation produces no output.
+  vtkNew<vtkQuadricDecimation> aborted;
+  aborted->SetInputData(input);
+  aborted->SetTargetReduction(0.9);
+  aborted->SetNumberOfPartitions(4);
+  aborted->SetAbortExecuteAndUpdateTime();
+  aborted->Update();
+  if (!aborted->GetOutputInformation(0)->Get(vtkAlgorithm::ABORTED()) ||
+    aborted->GetOutput()->GetNumberOfCells() != 0)
+  {
+    std::cerr << "Decimation not aborted" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Polygons that are not triangles are reported, as by the serial
+  // decimation.
+  vtkNew<vtkPolyData> degenerate;
+  degenerate->DeepCopy(input);
+  const vtkIdType segment[2] = { 0, 1 };
+  degenerate->GetPolys()->InsertNextCell(2, segment);
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  parallel->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  parallel->SetInputData(degenerate);
+  parallel->Update();
+  if (errorObserver->CheckErrorMessage("Can only decimate triangles") ||
+    parallel->GetOutput()->GetNumberOfCells() != 0)
+  {
+    std::cerr << "Non-triangles not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,329 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSmoothPolyDataFilterThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded vtkSmoothPolyDataFilter produces the same output
+// whatever the number of threads, that simple vertices are moved toward the
+// mean of their neighbors, that boundary vertices are fixed when boundary
+// smoothing is off, that the convergence criterion stops the iterations, and
+// that constrained points stay on the source. The default, sequential
+// smoothing moves the points in place, so it differs from the threaded one.
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkSphereSource.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStripper.h"
+
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// An open sphere made of polygons, next to an open sphere made of strips, and
+// a polyline crossing a vertex.
+void MakeInput(vtkPolyData* input)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(30);
+  sphere->SetEndTheta(300.0);
+  sphere->Update();
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(sphere->GetOutputPort());
+  stripper->Update();
+
+  vtkPolyData* polys = sphere->GetOutput();
+  vtkPolyData* strips = stripper->GetOutput();
+  const vtkIdType numPolyPts = polys->GetNumberOfPoints();
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (vtkIdType i = 0; i < numPolyPts; ++i)
+  {
+    points->InsertNextPoint(polys->GetPoint(i));
+  }
+  for (vtkIdType i = 0; i < strips->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    strips->GetPoint(i, x);
+    points->InsertNextPoint(x[0] + 1.5, x[1], x[2]);
+  }
+  input->SetPoints(points);
+  input->SetPolys(polys->GetPolys());
+
+  vtkNew<vtkCellArray> shiftedStrips;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType i = 0; i < strips->GetStrips()->GetNumberOfCells(); ++i)
+  {
+    strips->GetStrips()->GetCellAtId(i, ptIds);
+    for (vtkIdType j = 0; j < ptIds->GetNumberOfIds(); ++j)
+    {
+      ptIds->SetId(j, ptIds->GetId(j) + numPolyPts);
+    }
+    shiftedStrips->InsertNextCell(ptIds);
+  }
+  input->SetStrips(shiftedStrips);
+
+  vtkNew<vtkCellArray> lines;
+  ptIds->Reset();
+  for (int i = 0; i < 10; ++i)
+  {
+    ptIds->InsertNextId(points->InsertNextPoint(-2.0 + 0.1 * i, 0.05 * i * i, 0.0));
+  }
+  lines->InsertNextCell(ptIds);
+  const vtkIdType crossing[3] = { points->InsertNextPoint(-1.5, -0.5, 0.0), ptIds->GetId(5),
+    points->InsertNextPoint(-1.5, 0.5, 0.0) };
+  lines->InsertNextCell(3, crossing);
+  input->SetLines(lines);
+}
+
+bool SamePoints(vtkPolyData* output0, vtkPolyData* output1, double tolerance)
+{
+  if (output0->GetNumberOfPoints() != output1->GetNumberOfPoints())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < output0->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    output0->GetPoint(i, x);
+    output1->GetPoint(i, y);
+    if (std::fabs(x[0] - y[0]) > tolerance || std::fabs(x[1] - y[1]) > tolerance ||
+      std::fabs(x[2] - y[2]) > tolerance)
+    {
+      std::cerr << "Different point " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Jacobi iterations of Laplacian smoothing over the edges of a closed mesh.
+void Smooth(vtkPolyData* input, int numberOfIterations, double factor, std::vector<double>& x)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  std::vector<std::set<vtkIdType>> neighbors(numPts);
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType i = 0; i < input->GetNumberOfPolys(); ++i)
+  {
+    input->GetPolys()->GetCellAtId(i, ptIds);
+    for (vtkIdType j = 0; j < ptIds->GetNumberOfIds(); ++j)
+    {
+      const vtkIdType p1 = ptIds->GetId(j);
+      const vtkIdType p2 = ptIds->GetId((j + 1) % ptIds->GetNumberOfIds());
+      neighbors[p1].insert(p2);
+      neighbors[p2].insert(p1);
+    }
+  }
+  x.resize(3 * numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    input->GetPoint(i, x.data() + 3 * i);
+  }
+  std::vector<double> y(x.size());
+  for (int iteration = 0; iteration < numberOfIterations; ++iteration)
+  {
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      for (int k = 0; k < 3; ++k)
+      {
+        double mean = 0.0;
+        for (vtkIdType nei : neighbors[i])
+        {
+          mean += x[3 * nei + k];
+        }
+        mean /= neighbors[i].size();
+        y[3 * i + k] = x[3 * i + k] + factor * (mean - x[3 * i + k]);
+      }
+    }
+    x.swap(y);
+  }
+}
+
+std::set<vtkIdType> BoundaryPoints(vtkPolyData* input)
+{
+  std::map<std::pair<vtkIdType, vtkIdType>, int> edges;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType i = 0; i < input->GetNumberOfPolys(); ++i)
+  {
+    input->GetPolys()->GetCellAtId(i, ptIds);
+    for (vtkIdType j = 0; j < ptIds->GetNumberOfIds(); ++j)
+    {
+      const vtkIdType p1 = ptIds->GetId(j);
+      const vtkIdType p2 = ptIds->GetId((j + 1) % ptIds->GetNumberOfIds());
+      ++edges[std::make_pair(std::min(p1, p2), std::max(p1, p2))];
+    }
+  }
+  std::set<vtkIdType> boundary;
+  for (const auto& edge : edges)
+  {
+    if (edge.second == 1)
+    {
+      boundary.insert(edge.first.first);
+      boundary.insert(edge.first.second);
+    }
+  }
+  return boundary;
+}
+}
+
+int TestSmoothPolyDataFilterThreaded(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  MakeInput(input);
+  vtkNew<vtkSphereSource> source;
+  source->SetThetaResolution(20);
+  source->SetPhiResolution(10);
+  source->SetRadius(0.5);
+  source->Update();
+
+  // The same output with one thread and with the default number of threads.
+  vtkNew<vtkSmoothPolyDataFilter> serial;
+  vtkNew<vtkSmoothPolyDataFilter> threaded;
+  for (int option = 0; option < 16; ++option)
+  {
+    for (vtkSmoothPolyDataFilter* filter : { serial.Get(), threaded.Get() })
+    {
+      filter->SetInputData(input);
+      filter->SetSourceData(option % 4 == 3 ? source->GetOutput() : nullptr);
+      filter->SetNumberOfIterations(30);
+      filter->SetRelaxationFactor(0.3);
+      filter->SetFeatureEdgeSmoothing(option % 2);
+      filter->SetFeatureAngle(30.0);
+      filter->SetBoundarySmoothing((option / 2) % 2);
+      filter->SetConvergence(option >= 8 ? 0.001 : 0.0);
+      filter->SetOutputPointsPrecision(
+        option % 3 ? vtkAlgorithm::DOUBLE_PRECISION : vtkAlgorithm::SINGLE_PRECISION);
+      filter->SequentialProcessingOff();
+    }
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { serial->Update(); });
+    threaded->Update();
+    if (!SamePoints(threaded->GetOutput(), serial->GetOutput(), 0.0))
+    {
+      std::cerr << "Different outputs for option " << option << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Simple vertices of a closed sphere.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(30);
+  sphere->SetPhiResolution(20);
+  sphere->Update();
+  vtkNew<vtkSmoothPolyDataFilter> smooth;
+  smooth->SetInputConnection(sphere->GetOutputPort());
+  smooth->SetNumberOfIterations(10);
+  smooth->SetRelaxationFactor(0.5);
+  smooth->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+  smooth->SequentialProcessingOff();
+  smooth->Update();
+  std::vector<double> expected;
+  Smooth(sphere->GetOutput(), 10, 0.5, expected);
+  for (vtkIdType i = 0; i < sphere->GetOutput()->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    smooth->GetOutput()->GetPoint(i, x);
+    for (int k = 0; k < 3; ++k)
+    {
+      if (std::fabs(x[k] - expected[3 * i + k]) > 1e-12)
+      {
+        std::cerr << "Unexpected smoothed point " << i << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  vtkNew<vtkSmoothPolyDataFilter> inPlace;
+  inPlace->SetInputConnection(sphere->GetOutputPort());
+  inPlace->SetNumberOfIterations(10);
+  inPlace->SetRelaxationFactor(0.5);
+  inPlace->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+  inPlace->Update();
+  if (!inPlace->GetSequentialProcessing() ||
+    SamePoints(inPlace->GetOutput(), smooth->GetOutput(), 1e-6))
+  {
+    std::cerr << "Points not moved in place by default" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The iterations stop once the points move less than the convergence.
+  vtkNew<vtkSmoothPolyDataFilter> once;
+  once->SetInputConnection(sphere->GetOutputPort());
+  once->SetNumberOfIterations(1);
+  once->SetRelaxationFactor(0.5);
+  once->SequentialProcessingOff();
+  once->Update();
+  smooth->SetNumberOfIterations(100);
+  smooth->SetConvergence(1.0);
+  smooth->SetOutputPointsPrecision(vtkAlgorithm::DEFAULT_PRECISION);
+  smooth->Update();
+  if (!SamePoints(smooth->GetOutput(), once->GetOutput(), 0.0))
+  {
+    std::cerr << "Convergence not reached after one iteration" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Fixed boundary, threaded or not.
+  for (bool sequential : { false, true })
+  {
+    threaded->SetSourceData(nullptr);
+    threaded->SetBoundarySmoothing(false);
+    threaded->SetConvergence(0.0);
+    threaded->SetSequentialProcessing(sequential);
+    threaded->Update();
+    for (vtkIdType ptId : BoundaryPoints(input))
+    {
+      double x[3], y[3];
+      input->GetPoint(ptId, x);
+      threaded->GetOutput()->GetPoint(ptId, y);
+      if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+        std::cerr << "Boundary point " << ptId << " moved" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  threaded->SequentialProcessingOff();
+
+  // Points constrained to the source.
+  threaded->SetSourceData(source->GetOutput());
+  threaded->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+  threaded->Update();
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(source->GetOutput());
+  locator->BuildLocator();
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    double x[3], closestPt[3], dist2;
+    vtkIdType cellId;
+    int subId;
+    threaded->GetOutput()->GetPoint(i, x);
+    locator->FindClosestPoint(x, closestPt, cell, cellId, subId, dist2);
+    if (dist2 > 1e-12)
+    {
+      std::cerr << "Point " << i << " not on the source" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,280 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSpaceFillingCurveReorder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSpaceFillingCurveReorder.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int Dim = 12;
+
+// Return a random permutation of [0, num).
+std::vector<vtkIdType> Shuffled(vtkIdType num, std::mt19937& generator)
+{
+  std::vector<vtkIdType> ids(num);
+  std::iota(ids.begin(), ids.end(), 0);
+  std::shuffle(ids.begin(), ids.end(), generator);
+  return ids;
+}
+
+// Create Dim^3 points with a random numbering, along with point data, some
+// of which are not data arrays or are bit arrays.
+void CreatePoints(vtkPointSet* ds, std::vector<vtkIdType>& gridToId, std::mt19937& generator)
+{
+  const vtkIdType numPts = Dim * Dim * Dim;
+  gridToId = Shuffled(numPts, generator);
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(numPts);
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  names->SetNumberOfValues(numPts);
+  vtkNew<vtkBitArray> odd;
+  odd->SetName("Odd");
+  odd->SetNumberOfValues(numPts);
+  for (int k = 0; k < Dim; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        const vtkIdType ptId = gridToId[i + Dim * (j + Dim * k)];
+        points->SetPoint(ptId, i, j, k);
+        scalars->SetValue(ptId, i + 10.0 * j + 100.0 * k);
+        names->SetValue(ptId, std::to_string(i + 10 * j + 100 * k));
+        odd->SetValue(ptId, (i + j + k) % 2);
+      }
+    }
+  }
+  ds->SetPoints(points);
+  ds->GetPointData()->SetScalars(scalars);
+  ds->GetPointData()->AddArray(names);
+  ds->GetPointData()->AddArray(odd);
+}
+
+// Total spread of the point ids used by each cell: small values mean that
+// cells reference points close in memory.
+vtkIdType ConnectivitySpread(vtkDataSet* ds)
+{
+  vtkIdType spread = 0;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < ds->GetNumberOfCells(); ++cellId)
+  {
+    ds->GetCellPoints(cellId, ptIds);
+    const auto range = std::minmax_element(ptIds->begin(), ptIds->end());
+    spread += *range.second - *range.first;
+  }
+  return spread;
+}
+
+// Check that the output is the input renumbered along the original ids.
+bool CheckPermutation(vtkDataSet* input, vtkDataSet* output)
+{
+  if (input->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+    input->GetNumberOfCells() != output->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of points or cells" << std::endl;
+    return false;
+  }
+
+  auto originalPtIds =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  auto originalCellIds =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  if (!originalPtIds || !originalCellIds)
+  {
+    std::cerr << "Missing original ids arrays" << std::endl;
+    return false;
+  }
+
+  auto inScalars = input->GetPointData()->GetArray("Scalars");
+  auto outScalars = output->GetPointData()->GetArray("Scalars");
+  auto inNames = vtkStringArray::SafeDownCast(input->GetPointData()->GetAbstractArray("Names"));
+  auto outNames = vtkStringArray::SafeDownCast(output->GetPointData()->GetAbstractArray("Names"));
+  auto inOdd = vtkBitArray::SafeDownCast(input->GetPointData()->GetArray("Odd"));
+  auto outOdd = vtkBitArray::SafeDownCast(output->GetPointData()->GetArray("Odd"));
+  if (!outNames || !outOdd || outNames->GetNumberOfValues() != output->GetNumberOfPoints() ||
+    outOdd->GetNumberOfValues() != output->GetNumberOfPoints())
+  {
+    std::cerr << "Missing string or bit point data" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    const vtkIdType inPtId = originalPtIds->GetValue(ptId);
+    double inX[3], outX[3];
+    input->GetPoint(inPtId, inX);
+    output->GetPoint(ptId, outX);
+    if (inX[0] != outX[0] || inX[1] != outX[1] || inX[2] != outX[2] ||
+      inScalars->GetTuple1(inPtId) != outScalars->GetTuple1(ptId) ||
+      inNames->GetValue(inPtId) != outNames->GetValue(ptId) ||
+      inOdd->GetValue(inPtId) != outOdd->GetValue(ptId))
+    {
+      std::cerr << "Point " << ptId << " does not match input point " << inPtId << std::endl;
+      return false;
+    }
+  }
+
+  auto inCellIds = input->GetCellData()->GetArray("CellIds");
+  auto outCellIds = output->GetCellData()->GetArray("CellIds");
+  vtkNew<vtkIdList> inPts, outPts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType inCellId = originalCellIds->GetValue(cellId);
+    input->GetCellPoints(inCellId, inPts);
+    output->GetCellPoints(cellId, outPts);
+    bool same = input->GetCellType(inCellId) == output->GetCellType(cellId) &&
+      inPts->GetNumberOfIds() == outPts->GetNumberOfIds() &&
+      inCellIds->GetTuple1(inCellId) == outCellIds->GetTuple1(cellId);
+    for (vtkIdType i = 0; same && i < inPts->GetNumberOfIds(); ++i)
+    {
+      same = originalPtIds->GetValue(outPts->GetId(i)) == inPts->GetId(i);
+    }
+    if (!same)
+    {
+      std::cerr << "Cell " << cellId << " does not match input cell " << inCellId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestUnstructuredGrid(int curve)
+{
+  std::mt19937 generator(42);
+  vtkNew<vtkUnstructuredGrid> ug;
+  std::vector<vtkIdType> gridToId;
+  CreatePoints(ug, gridToId, generator);
+
+  const vtkIdType numCells = (Dim - 1) * (Dim - 1) * (Dim - 1);
+  std::vector<vtkIdType> cellOrder = Shuffled(numCells, generator);
+  ug->AllocateExact(numCells, 8 * numCells);
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cell : cellOrder)
+  {
+    const int i = cell % (Dim - 1);
+    const int j = (cell / (Dim - 1)) % (Dim - 1);
+    const int k = cell / ((Dim - 1) * (Dim - 1));
+    const vtkIdType corner = i + Dim * (j + Dim * k);
+    const vtkIdType hex[8] = { gridToId[corner], gridToId[corner + 1],
+      gridToId[corner + 1 + Dim], gridToId[corner + Dim], gridToId[corner + Dim * Dim],
+      gridToId[corner + 1 + Dim * Dim], gridToId[corner + 1 + Dim + Dim * Dim],
+      gridToId[corner + Dim + Dim * Dim] };
+    ug->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+    cellIds->InsertNextValue(static_cast<int>(cell));
+  }
+  ug->GetCellData()->AddArray(cellIds);
+
+  vtkNew<vtkSpaceFillingCurveReorder> reorder;
+  reorder->SetInputData(ug);
+  reorder->SetCurveType(curve);
+  reorder->GenerateOriginalIdsOn();
+  reorder->Update();
+  auto output = vtkUnstructuredGrid::SafeDownCast(reorder->GetOutput());
+
+  if (!output || !CheckPermutation(ug, output))
+  {
+    std::cerr << "Unstructured grid reordering failed for curve " << curve << std::endl;
+    return false;
+  }
+  if (ConnectivitySpread(output) >= ConnectivitySpread(ug))
+  {
+    std::cerr << "Reordering did not improve locality for curve " << curve << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestPolyData(int curve)
+{
+  std::mt19937 generator(7);
+  vtkNew<vtkPolyData> pd;
+  std::vector<vtkIdType> gridToId;
+  CreatePoints(pd, gridToId, generator);
+
+  // A few vertices followed by the triangles of the bottom face, in random order.
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType ptId = 0; ptId < 2 * Dim; ptId += 3)
+  {
+    verts->InsertNextCell(1, &ptId);
+    cellIds->InsertNextValue(static_cast<int>(ptId));
+  }
+  for (vtkIdType cell : Shuffled((Dim - 1) * (Dim - 1), generator))
+  {
+    const vtkIdType corner = cell % (Dim - 1) + Dim * (cell / (Dim - 1));
+    const vtkIdType tri0[3] = { gridToId[corner], gridToId[corner + 1], gridToId[corner + Dim] };
+    const vtkIdType tri1[3] = { gridToId[corner + 1], gridToId[corner + Dim + 1],
+      gridToId[corner + Dim] };
+    polys->InsertNextCell(3, tri0);
+    polys->InsertNextCell(3, tri1);
+    cellIds->InsertNextValue(static_cast<int>(1000 + 2 * cell));
+    cellIds->InsertNextValue(static_cast<int>(1001 + 2 * cell));
+  }
+  pd->SetVerts(verts);
+  pd->SetPolys(polys);
+  pd->GetCellData()->AddArray(cellIds);
+
+  vtkNew<vtkSpaceFillingCurveReorder> reorder;
+  reorder->SetInputData(pd);
+  reorder->SetCurveType(curve);
+  reorder->GenerateOriginalIdsOn();
+  reorder->Update();
+  auto output = vtkPolyData::SafeDownCast(reorder->GetOutput());
+
+  if (!output || !CheckPermutation(pd, output) ||
+    output->GetNumberOfVerts() != pd->GetNumberOfVerts() ||
+    output->GetNumberOfPolys() != pd->GetNumberOfPolys())
+  {
+    std::cerr << "Poly data reordering failed for curve " << curve << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestSpaceFillingCurveReorder(int, char*[])
+{
+  bool success = true;
+  for (int curve : { vtkSpaceFillingCurve::MORTON, vtkSpaceFillingCurve::HILBERT })
+  {
+    success &= TestUnstructuredGrid(curve);
+    success &= TestPolyData(curve);
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
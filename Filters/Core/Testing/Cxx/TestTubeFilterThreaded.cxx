@@ -0,0 +1,349 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTubeFilterThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks of the threaded generation of vtkTubeFilter: the same output as the
+// sequential one for all the options, the sides at the radius from the
+// polylines with the normals pointing away from them, and the string and bit
+// arrays, which are only copied by the sequential processing.
+
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkTubeFilter.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+// A vertex followed by polylines of all kinds: polylines sharing points, a
+// closed polyline, polylines with consecutive coincident points, polylines
+// too short to be tubed, a straight polyline along the z axis, which cannot
+// be tubed with the default normal, and many random walks.
+static void MakeInput(vtkPolyData* input)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkIdList> ptIds;
+
+  // A helix, and a polyline going back along a part of it.
+  for (int i = 0; i < 200; ++i)
+  {
+    points->InsertNextPoint(std::cos(0.2 * i), std::sin(0.2 * i), 0.05 * i);
+    ptIds->InsertNextId(i);
+  }
+  verts->InsertNextCell(1, ptIds->GetPointer(0));
+  lines->InsertNextCell(ptIds);
+  ptIds->Reset();
+  for (vtkIdType i = 120; i >= 50; --i)
+  {
+    ptIds->InsertNextId(i);
+  }
+  lines->InsertNextCell(ptIds);
+
+  // A closed polyline, using its first point twice.
+  ptIds->Reset();
+  for (int i = 0; i < 40; ++i)
+  {
+    ptIds->InsertNextId(points->InsertNextPoint(3.0 + std::cos(0.1 * i), std::sin(0.1 * i), 1.0));
+  }
+  ptIds->InsertNextId(ptIds->GetId(0));
+  lines->InsertNextCell(ptIds);
+
+  // Consecutive coincident points, with the same or different ids.
+  ptIds->Reset();
+  for (int i = 0; i < 10; ++i)
+  {
+    const vtkIdType id = points->InsertNextPoint(0.3 * i, -2.0, 0.1 * i * i);
+    ptIds->InsertNextId(id);
+    if (i % 3 == 0)
+    {
+      ptIds->InsertNextId(points->InsertNextPoint(0.3 * i, -2.0, 0.1 * i * i));
+    }
+    if (i % 4 == 1)
+    {
+      ptIds->InsertNextId(id);
+    }
+  }
+  lines->InsertNextCell(ptIds);
+
+  // Polylines left with less than two points.
+  const vtkIdType single[1] = { 5 };
+  lines->InsertNextCell(1, single);
+  const vtkIdType coincident[3] = { 7, 7, 7 };
+  lines->InsertNextCell(3, coincident);
+
+  // A straight polyline along the z axis.
+  ptIds->Reset();
+  for (int i = 0; i < 5; ++i)
+  {
+    ptIds->InsertNextId(points->InsertNextPoint(5.0, 5.0, i));
+  }
+  lines->InsertNextCell(ptIds);
+
+  // Random walks.
+  for (int line = 0; line < 300; ++line)
+  {
+    ptIds->Reset();
+    double x[3] = { random->GetNextRangeValue(-5, 5), random->GetNextRangeValue(-5, 5),
+      random->GetNextRangeValue(-5, 5) };
+    const int npts = static_cast<int>(random->GetNextRangeValue(2, 30));
+    for (int i = 0; i < npts; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        x[j] += random->GetNextRangeValue(-0.5, 0.5);
+      }
+      ptIds->InsertNextId(points->InsertNextPoint(x));
+    }
+    lines->InsertNextCell(ptIds);
+  }
+  input->SetPoints(points);
+  input->SetVerts(verts);
+  input->SetLines(lines);
+
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    scalars->InsertNextValue(random->GetNextRangeValue(0.5, 2.0));
+    vectors->InsertNextTuple3(random->GetNextRangeValue(0.5, 1.0),
+      random->GetNextRangeValue(-1.0, 1.0), random->GetNextRangeValue(-1.0, 1.0));
+    normals->InsertNextTuple3(0.0, 0.0, 1.0);
+    pointIds->InsertNextValue(i);
+  }
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->AddArray(normals);
+  input->GetPointData()->AddArray(pointIds);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  input->GetCellData()->AddArray(cellIds);
+}
+
+// Both arrays are missing, or have the same type, size and values.
+static bool SameArrays(vtkDataArray* threaded, vtkDataArray* serial)
+{
+  if (!threaded || !serial)
+  {
+    return !threaded && !serial;
+  }
+  if (threaded->GetDataType() != serial->GetDataType() ||
+    threaded->GetNumberOfTuples() != serial->GetNumberOfTuples() ||
+    threaded->GetNumberOfComponents() != serial->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < threaded->GetNumberOfTuples(); ++i)
+  {
+    for (int j = 0; j < threaded->GetNumberOfComponents(); ++j)
+    {
+      if (threaded->GetComponent(i, j) != serial->GetComponent(i, j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool SameStrips(vtkPolyData* threaded, vtkPolyData* serial)
+{
+  vtkCellArray* threadedStrips = threaded->GetStrips();
+  vtkCellArray* serialStrips = serial->GetStrips();
+  return threadedStrips->GetNumberOfCells() != 0 &&
+    SameArrays(threadedStrips->GetOffsetsArray(), serialStrips->GetOffsetsArray()) &&
+    SameArrays(threadedStrips->GetConnectivityArray(), serialStrips->GetConnectivityArray());
+}
+
+// String and bit arrays, which are only copied by the sequential
+// processing, are passed to the output.
+static bool CopiesStringAndBitArrays(vtkPolyDataAlgorithm* filter, vtkPolyData* input)
+{
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  vtkNew<vtkBitArray> bits;
+  bits->SetName("Bits");
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    names->InsertNextValue(std::to_string(i));
+    bits->InsertNextValue(i % 2);
+  }
+  vtkNew<vtkPolyData> namesInput;
+  namesInput->ShallowCopy(input);
+  namesInput->GetPointData()->AddArray(names);
+  namesInput->GetPointData()->AddArray(bits);
+  filter->SetInputData(namesInput);
+  filter->Update();
+  vtkPolyData* output = filter->GetOutput();
+  vtkPointData* outPD = output->GetPointData();
+  vtkStringArray* outNames = vtkArrayDownCast<vtkStringArray>(outPD->GetAbstractArray("Names"));
+  vtkDataArray* outBits = outPD->GetArray("Bits");
+  vtkDataArray* outIds = outPD->GetArray("PointIds");
+  if (!outNames || !outBits || !outIds || output->GetNumberOfPoints() == 0 ||
+    outNames->GetNumberOfValues() != output->GetNumberOfPoints() ||
+    outBits->GetNumberOfTuples() != output->GetNumberOfPoints())
+  {
+    std::cerr << "Missing string or bit array" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < outNames->GetNumberOfValues(); ++i)
+  {
+    const vtkIdType id = static_cast<vtkIdType>(outIds->GetComponent(i, 0));
+    if (outNames->GetValue(i) != std::to_string(id) || outBits->GetComponent(i, 0) != id % 2)
+    {
+      std::cerr << "Different string or bit value " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The threaded tubes are the sequential ones, with and without varying
+// radius, texture coordinates, capping, shared side vertices, input normals
+// and default normal, and with both output precisions.
+static bool TestTubeFilterThreaded_SameAsSequential(vtkPolyData* input, vtkPolyData* normalsInput)
+{
+  vtkNew<vtkTubeFilter> threaded;
+  vtkNew<vtkTubeFilter> serial;
+  serial->SequentialProcessingOn();
+  for (int option = 0; option < 80; ++option)
+  {
+    const int normalsMode = option % 3;
+    for (vtkTubeFilter* filter : { threaded.Get(), serial.Get() })
+    {
+      filter->SetVaryRadius(option % 5);
+      filter->SetGenerateTCoords((option / 5) % 4);
+      filter->SetCapping((option / 20) % 2);
+      filter->SetSidesShareVertices((option / 40) % 2);
+      filter->SetNumberOfSides(option % 4 == 0 ? 3 : 8);
+      filter->SetOnRatio(option % 7 == 0 ? 3 : 1);
+      filter->SetOffset(option % 7 == 0 ? 1 : 0);
+      filter->SetInputData(normalsMode == 2 ? normalsInput : input);
+      filter->SetUseDefaultNormal(normalsMode == 1);
+      filter->SetRadius(0.1);
+      filter->SetOutputPointsPrecision(
+        option % 2 ? vtkAlgorithm::DOUBLE_PRECISION : vtkAlgorithm::DEFAULT_PRECISION);
+      filter->Update();
+    }
+    vtkPolyData* threadedOutput = threaded->GetOutput();
+    vtkPolyData* serialOutput = serial->GetOutput();
+    vtkPointData* threadedPD = threadedOutput->GetPointData();
+    vtkPointData* serialPD = serialOutput->GetPointData();
+    bool same = threadedOutput->GetNumberOfPoints() != 0 &&
+      SameArrays(threadedOutput->GetPoints()->GetData(), serialOutput->GetPoints()->GetData()) &&
+      SameStrips(threadedOutput, serialOutput) &&
+      SameArrays(threadedPD->GetTCoords(), serialPD->GetTCoords()) &&
+      SameArrays(threadedOutput->GetCellData()->GetArray("CellIds"),
+        serialOutput->GetCellData()->GetArray("CellIds"));
+    for (const char* name : { "TubeNormals", "Scalars", "Vectors", "PointIds" })
+    {
+      same = same && SameArrays(threadedPD->GetArray(name), serialPD->GetArray(name));
+    }
+    if (!same)
+    {
+      std::cerr << "Different outputs for option " << option << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Without capping nor varying radius, each point of the sides is at the
+// radius from its input point, along its normal.
+static bool TestTubeFilterThreaded_Radius(vtkPolyData* input)
+{
+  const double radius = 0.1;
+  for (bool sequential : { false, true })
+  {
+    vtkNew<vtkTubeFilter> tubeFilter;
+    tubeFilter->SetSequentialProcessing(sequential);
+    tubeFilter->SetInputData(input);
+    tubeFilter->SetRadius(radius);
+    tubeFilter->SetNumberOfSides(6);
+    tubeFilter->Update();
+    vtkPolyData* output = tubeFilter->GetOutput();
+    vtkDataArray* normals = output->GetPointData()->GetArray("TubeNormals");
+    vtkDataArray* pointIds = output->GetPointData()->GetArray("PointIds");
+    if (output->GetNumberOfPoints() == 0 || !normals || !pointIds)
+    {
+      std::cerr << "No tube normals or point ids" << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+      double x[3], p[3], n[3];
+      output->GetPoint(i, x);
+      input->GetPoint(static_cast<vtkIdType>(pointIds->GetComponent(i, 0)), p);
+      normals->GetTuple(i, n);
+      for (int k = 0; k < 3; ++k)
+      {
+        if (std::abs(x[k] - p[k] - radius * n[k]) > 1e-5)
+        {
+          std::cerr << "Point " << i << " is not at the radius along its normal" << std::endl;
+          return false;
+        }
+      }
+      if (std::abs(vtkMath::Norm(n) - 1.0) > 1e-5)
+      {
+        std::cerr << "Normal " << i << " is not a unit vector" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int TestTubeFilterThreaded(int, char*[])
+{
+  // The straight polyline cannot be tubed with the default normal.
+  vtkObject::GlobalWarningDisplayOff();
+
+  vtkNew<vtkPolyData> input;
+  MakeInput(input);
+  vtkNew<vtkPolyData> normalsInput;
+  normalsInput->ShallowCopy(input);
+  normalsInput->GetPointData()->SetNormals(normalsInput->GetPointData()->GetArray("Normals"));
+
+  vtkNew<vtkTubeFilter> tubeFilter;
+  bool success = TestTubeFilterThreaded_SameAsSequential(input, normalsInput) &&
+    TestTubeFilterThreaded_Radius(input) && CopiesStringAndBitArrays(tubeFilter, input);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -24,9 +24,12 @@
 #include "vtkFieldData.h"
 #include "vtkFunctionParser.h"
 #include "vtkGraph.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIncrementalArrayCache.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMolecule.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
@@ -64,6 +67,7 @@ vtkArrayCalculator::vtkArrayCalculator()
   this->ReplacementValue = 0.0;
   this->IgnoreMissingArrays = false;
   this->ResultArrayType = VTK_DOUBLE;
+  this->IncrementalCache = vtkIncrementalArrayCache::New();
 }
 
 //------------------------------------------------------------------------------
@@ -85,6 +89,8 @@ vtkArrayCalculator::~vtkArrayCalculator()
   this->CoordinateVectorVariableNames.clear();
   this->SelectedCoordinateScalarComponents.clear();
   this->SelectedCoordinateVectorComponents.clear();
+
+  this->IncrementalCache->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -419,7 +425,7 @@ struct vtkArrayCalculatorWorker
     const std::vector<vtkTuple<int, 3>>& selectedCoordinateVectorComponents,
     const std::vector<vtkDataArray*>& scalarArrays, const std::vector<vtkDataArray*>& vectorArrays,
     const std::vector<int>& scalarArrayIndices, const std::vector<int>& vectorArrayIndices,
-    vtkIdType numTuples)
+    vtkIdType numTuples, vtkIdTypeArray* ranges)
   {
     // Execute functor for all tuples
     vtkArrayCalculatorFunctor<TFunctionParser, TResultArray> arrayCalculatorFunctor(dsInput,
@@ -437,13 +443,24 @@ struct vtkArrayCalculatorWorker
       // when writing to a vtkBitArray.
       grain = sizeof(vtkIdType) * 64;
     }
-    vtkSMPTools::For(0, numTuples, grain, arrayCalculatorFunctor);
+    if (!ranges)
+    {
+      vtkSMPTools::For(0, numTuples, grain, arrayCalculatorFunctor);
+      return;
+    }
+    // Only the modified tuples
+    for (vtkIdType r = 0; r < ranges->GetNumberOfTuples(); ++r)
+    {
+      vtkSMPTools::For(ranges->GetTypedComponent(r, 0), ranges->GetTypedComponent(r, 1), grain,
+        arrayCalculatorFunctor);
+    }
   }
 };
 
 //------------------------------------------------------------------------------
 template <typename TFunctionParser>
-int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* output)
+int vtkArrayCalculator::ProcessDataObject(
+  vtkDataObject* input, vtkDataObject* output, bool incremental)
 {
   vtkDataSet* dsInput = vtkDataSet::SafeDownCast(input);
   vtkGraph* graphInput = vtkGraph::SafeDownCast(input);
@@ -613,51 +630,6 @@ int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* o
     return 1;
   }
 
-  vtkSmartPointer<vtkPoints> resultPoints;
-  vtkSmartPointer<vtkDataArray> resultArray;
-  if (resultType == VECTOR_RESULT && this->CoordinateResults != 0 &&
-    (psOutput || vtkGraph::SafeDownCast(output)))
-  {
-    resultPoints = vtkSmartPointer<vtkPoints>::New();
-    resultPoints->SetDataType(this->ResultArrayType);
-    resultPoints->SetNumberOfPoints(numTuples);
-    resultArray = resultPoints->GetData();
-  }
-  else if (this->CoordinateResults != 0)
-  {
-    if (resultType != VECTOR_RESULT)
-    {
-      vtkErrorMacro("Coordinate output specified, "
-                    "but there are no vector results");
-    }
-    else if (!psOutput)
-    {
-      vtkErrorMacro("Coordinate output specified, "
-                    "but output is not polydata or unstructured grid");
-    }
-    return 1;
-  }
-  else
-  {
-    resultArray.TakeReference(
-      vtkArrayDownCast<vtkDataArray>(vtkAbstractArray::CreateArray(this->ResultArrayType)));
-  }
-
-  if (resultType == SCALAR_RESULT)
-  {
-    resultArray->SetNumberOfComponents(1);
-    resultArray->SetNumberOfTuples(numTuples);
-    double scalarResult = functionParser->GetScalarResult();
-    resultArray->SetTuple(0, &scalarResult);
-  }
-  else
-  {
-    resultArray->Allocate(numTuples * 3);
-    resultArray->SetNumberOfComponents(3);
-    resultArray->SetNumberOfTuples(numTuples);
-    resultArray->SetTuple(0, functionParser->GetVectorResult());
-  }
-
   // Save array pointers to avoid looking them up for each tuple.
   std::vector<vtkDataArray*> scalarArrays(this->ScalarArrayNames.size());
   std::vector<vtkDataArray*> vectorArrays(this->VectorArrayNames.size());
@@ -706,6 +678,78 @@ int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* o
     }
   }
 
+  // Reuse the result array of the last execution if only ranges of the
+  // arrays used by the function were modified.
+  std::vector<vtkDataArray*> usedArrays(scalarArrays);
+  usedArrays.insert(usedArrays.end(), vectorArrays.begin(), vectorArrays.end());
+  if (attributeType == vtkDataObject::POINT &&
+    (!this->CoordinateScalarVariableNames.empty() || !this->CoordinateVectorVariableNames.empty()))
+  {
+    vtkPointSet* psInput = vtkPointSet::SafeDownCast(input);
+    vtkPoints* inPoints = psInput ? psInput->GetPoints() : nullptr;
+    usedArrays.push_back(inPoints ? inPoints->GetData() : nullptr);
+    incremental = incremental && usedArrays.back();
+  }
+  incremental = incremental && !this->CoordinateResults;
+  vtkNew<vtkIdTypeArray> ranges;
+  vtkSmartPointer<vtkDataArray> resultArray = incremental
+    ? this->IncrementalCache->GetCachedOutput(
+        this, static_cast<int>(usedArrays.size()), usedArrays.data(), ranges)
+    : nullptr;
+  vtkIdTypeArray* modifiedRanges = resultArray ? ranges.Get() : nullptr;
+
+  vtkSmartPointer<vtkPoints> resultPoints;
+  if (modifiedRanges)
+  {
+    // The result array is updated in place below.
+  }
+  else if (resultType == VECTOR_RESULT && this->CoordinateResults != 0 &&
+    (psOutput || vtkGraph::SafeDownCast(output)))
+  {
+    resultPoints = vtkSmartPointer<vtkPoints>::New();
+    resultPoints->SetDataType(this->ResultArrayType);
+    resultPoints->SetNumberOfPoints(numTuples);
+    resultArray = resultPoints->GetData();
+  }
+  else if (this->CoordinateResults != 0)
+  {
+    if (resultType != VECTOR_RESULT)
+    {
+      vtkErrorMacro("Coordinate output specified, "
+                    "but there are no vector results");
+    }
+    else if (!psOutput)
+    {
+      vtkErrorMacro("Coordinate output specified, "
+                    "but output is not polydata or unstructured grid");
+    }
+    return 1;
+  }
+  else
+  {
+    resultArray.TakeReference(
+      vtkArrayDownCast<vtkDataArray>(vtkAbstractArray::CreateArray(this->ResultArrayType)));
+  }
+
+  if (modifiedRanges)
+  {
+    // Only the modified tuples are computed.
+  }
+  else if (resultType == SCALAR_RESULT)
+  {
+    resultArray->SetNumberOfComponents(1);
+    resultArray->SetNumberOfTuples(numTuples);
+    double scalarResult = functionParser->GetScalarResult();
+    resultArray->SetTuple(0, &scalarResult);
+  }
+  else
+  {
+    resultArray->Allocate(numTuples * 3);
+    resultArray->SetNumberOfComponents(3);
+    resultArray->SetNumberOfTuples(numTuples);
+    resultArray->SetTuple(0, functionParser->GetVectorResult());
+  }
+
   vtkArrayCalculatorWorker<TFunctionParser> arrayCalculatorWorker;
   if (!vtkArrayDispatch::Dispatch::Execute(resultArray.Get(), arrayCalculatorWorker, dsInput,
         graphInput, inFD, attributeType, this->Function, this->ReplaceInvalidValues,
@@ -714,7 +758,8 @@ int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* o
         this->SelectedScalarComponents, this->SelectedVectorComponents,
         this->CoordinateScalarVariableNames, this->CoordinateVectorVariableNames,
         this->SelectedCoordinateScalarComponents, this->SelectedCoordinateVectorComponents,
-        scalarArrays, vectorArrays, scalarArrayIndices, vectorArrayIndices, numTuples))
+        scalarArrays, vectorArrays, scalarArrayIndices, vectorArrayIndices, numTuples,
+        modifiedRanges))
   {
     arrayCalculatorWorker(resultArray.Get(), dsInput, graphInput, inFD, attributeType,
       this->Function, this->ReplaceInvalidValues, this->ReplacementValue, this->IgnoreMissingArrays,
@@ -722,7 +767,14 @@ int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* o
       this->VectorVariableNames, this->SelectedScalarComponents, this->SelectedVectorComponents,
       this->CoordinateScalarVariableNames, this->CoordinateVectorVariableNames,
       this->SelectedCoordinateScalarComponents, this->SelectedCoordinateVectorComponents,
-      scalarArrays, vectorArrays, scalarArrayIndices, vectorArrayIndices, numTuples);
+      scalarArrays, vectorArrays, scalarArrayIndices, vectorArrayIndices, numTuples,
+      modifiedRanges);
+  }
+
+  // Let the filters downstream update their outputs incrementally.
+  for (vtkIdType r = 0; modifiedRanges && r < ranges->GetNumberOfTuples(); ++r)
+  {
+    resultArray->ModifiedRange(ranges->GetTypedComponent(r, 0), ranges->GetTypedComponent(r, 1));
   }
 
   output->ShallowCopy(input);
@@ -792,6 +844,13 @@ int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* o
     }
   }
 
+  // Keep the result array to update it incrementally.
+  if (incremental)
+  {
+    this->IncrementalCache->SetCachedOutput(static_cast<int>(usedArrays.size()), usedArrays.data(),
+      this->GetAbortOutput() ? nullptr : resultArray.Get());
+  }
+
   return 1;
 }
 
@@ -849,11 +908,11 @@ int vtkArrayCalculator::RequestData(vtkInformation* vtkNotUsed(request),
   // Not a composite data set.
   if (this->FunctionParserType == FunctionParser)
   {
-    return this->ProcessDataObject<vtkFunctionParser>(input, output);
+    return this->ProcessDataObject<vtkFunctionParser>(input, output, true);
   }
   else if (this->FunctionParserType == ExprTkFunctionParser)
   {
-    return this->ProcessDataObject<vtkExprTkFunctionParser>(input, output);
+    return this->ProcessDataObject<vtkExprTkFunctionParser>(input, output, true);
   }
   else
   {
@@ -63,6 +63,12 @@
  * tuple-wise (i.e., tuple-by-tuple). The user must specify which arrays to use as
  * vectors and/or scalars, and the name of the output data array.
  *
+ * When the input is not a composite dataset and the arrays used by the
+ * function (and the points, if coordinates are used) were only modified by
+ * ranges (see vtkDataArray::ModifiedRange()), only the modified tuples are
+ * computed again, in place, as long as the result array of the last execution
+ * is not referenced anywhere else. This is not done with CoordinateResults.
+ *
  * @sa
  * For more detailed documentation of the supported functionality see:
  * 1) vtkFunctionParser
@@ -80,6 +86,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkDataSet;
+class vtkIncrementalArrayCache;
 
 class VTKFILTERSCORE_EXPORT vtkArrayCalculator : public vtkPassInputTypeAlgorithm
 {
@@ -374,9 +381,12 @@ private:
   vtkArrayCalculator(const vtkArrayCalculator&) = delete;
   void operator=(const vtkArrayCalculator&) = delete;
 
-  // Do the bulk of the work
+  // Do the bulk of the work, updating the result array of the last
+  // execution in place when incremental is true and it is possible.
   template <typename TFunctionParser>
-  int ProcessDataObject(vtkDataObject* input, vtkDataObject* output);
+  int ProcessDataObject(vtkDataObject* input, vtkDataObject* output, bool incremental = false);
+
+  vtkIncrementalArrayCache* IncrementalCache;
 };
 
 VTK_ABI_NAMESPACE_END
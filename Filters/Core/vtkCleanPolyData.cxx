@@ -14,20 +14,31 @@
 =========================================================================*/
 #include "vtkCleanPolyData.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <typeinfo>
 #include <unordered_map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCleanPolyData);
@@ -48,6 +59,53 @@ bool InsertPointUsingGlobalId(vtkIdType globalId, vtkPoints* newPts,
   ptId = it->second;
   return false;
 }
+
+// Replace the points of a cell of the given type (0 for a vertex, 1 for a
+// line, 2 for a polygon and 3 for a strip) by the merged ones and remove the
+// repeated points the same way vtkCleanPolyData::RequestData() does. Return
+// the type of the output cell, or -1 if the cell is eliminated.
+int CleanCell(int type, vtkIdType npts, const vtkIdType* pts, const vtkIdType* pointMap,
+  vtkTypeBool linesToPoints, vtkTypeBool polysToLines, vtkTypeBool stripsToPolys,
+  std::vector<vtkIdType>& updatedPts)
+{
+  updatedPts.clear();
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    const vtkIdType ptId = pointMap[pts[i]];
+    if (type == 0 || updatedPts.empty() || ptId != updatedPts.back())
+    {
+      updatedPts.push_back(ptId);
+    }
+  }
+  const vtkIdType numNewPts = static_cast<vtkIdType>(updatedPts.size());
+  if (((type == 2 && numNewPts > 2) || (type == 3 && numNewPts > 1)) &&
+    updatedPts.front() == updatedPts.back())
+  {
+    updatedPts.pop_back();
+  }
+
+  // Degenerate cells become cells of a lower type when enabled, or when they
+  // were such cells to begin with.
+  const vtkIdType minNumPts[4] = { 1, 2, 3, 4 };
+  const vtkIdType numCleanPts = static_cast<vtkIdType>(updatedPts.size());
+  if (numCleanPts >= minNumPts[type])
+  {
+    return type;
+  }
+  if (numCleanPts == 3 && (npts == 3 || stripsToPolys))
+  {
+    return 2;
+  }
+  if (numCleanPts == 2 && (npts == 2 || polysToLines))
+  {
+    return 1;
+  }
+  if (numCleanPts == 1 && (npts == 1 || linesToPoints))
+  {
+    return 0;
+  }
+  return -1;
+}
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -69,6 +127,7 @@ vtkCleanPolyData::vtkCleanPolyData()
   this->Locator = nullptr;
   this->PieceInvariant = 1;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 }
 
 //------------------------------------------------------------------------------
@@ -85,6 +144,12 @@ void vtkCleanPolyData::OperateOnPoint(double in[3], double out[3])
   out[2] = in[2];
 }
 
+//------------------------------------------------------------------------------
+bool vtkCleanPolyData::IsOperateOnPointThreadSafe()
+{
+  return typeid(*this) == typeid(vtkCleanPolyData);
+}
+
 //------------------------------------------------------------------------------
 void vtkCleanPolyData::OperateOnBounds(double in[6], double out[6])
 {
@@ -152,6 +217,10 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
+  if (this->ThreadedClean(input, output))
+  {
+    return 1;
+  }
   vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -193,7 +262,10 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   vtkCellData* inputCD = input->GetCellData();
 
   // We must be careful to 'operate' on the bounds of the locator so
-  // that all inserted points lie inside it
+  // that all inserted points lie inside it. A locator created here is
+  // released at the end, so that it is not taken for a locator specified
+  // by the user in the next execution.
+  const bool createLocator = this->PointMerging && !this->Locator;
   if (this->PointMerging)
   {
     this->CreateDefaultLocator(input);
@@ -609,7 +681,13 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   // Update ourselves and release memory
   //
   delete[] updatedPts;
-  if (this->PointMerging)
+  if (createLocator)
+  {
+    // Not ReleaseLocator(), which would modify the filter.
+    this->Locator->UnRegister(this);
+    this->Locator = nullptr;
+  }
+  else if (this->PointMerging)
   {
     this->Locator->Initialize(); // release memory.
   }
@@ -678,6 +756,372 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+bool vtkCleanPolyData::ThreadedClean(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkIdTypeArray* globalIdsArray = vtkIdTypeArray::SafeDownCast(inputPD->GetGlobalIds());
+
+  if (this->SequentialProcessing || !this->IsOperateOnPointThreadSafe() ||
+    !CanUseArrayList(inputPD) || !CanUseArrayList(inputCD))
+  {
+    return false;
+  }
+
+  // Points with the same coordinates are merged exactly like vtkMergePoints
+  // does when the tolerance is zero and the default locator would be used.
+  // With a non-zero tolerance, the points merged by the locator depend on
+  // the insertion order, so the serial path is taken.
+  const bool mergeCoordinates = this->PointMerging && !globalIdsArray;
+  if (mergeCoordinates &&
+    (this->Locator ||
+      (this->ToleranceIsAbsolute ? this->AbsoluteTolerance
+                                 : this->Tolerance * input->GetLength()) != 0.0))
+  {
+    return false;
+  }
+  int dataType = inPts->GetDataType();
+  if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    dataType = VTK_FLOAT;
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    dataType = VTK_DOUBLE;
+  }
+  if (mergeCoordinates && dataType != VTK_FLOAT && dataType != VTK_DOUBLE)
+  {
+    return false;
+  }
+
+  // The cells are traversed as verts, lines, polys and strips, which gives
+  // the input cell ids and the position of each cell point in the traversal.
+  vtkCellArray* inCells[4] = { input->GetVerts(), input->GetLines(), input->GetPolys(),
+    input->GetStrips() };
+  vtkIdType cellOffsets[5] = { 0 };
+  vtkIdType connOffsets[5] = { 0 };
+  for (int type = 0; type < 4; ++type)
+  {
+    cellOffsets[type + 1] = cellOffsets[type] + inCells[type]->GetNumberOfCells();
+    connOffsets[type + 1] = connOffsets[type] + inCells[type]->GetNumberOfConnectivityIds();
+  }
+  const vtkIdType numCells = cellOffsets[4];
+
+  // The first use of each point in the traversal. The serial path copies the
+  // coordinates and attributes of the first point of a merged set, and
+  // numbers the output points in the order of their first use.
+  const vtkIdType unused = VTK_ID_MAX;
+  std::vector<std::atomic<vtkIdType>> firstUse(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUse[ptId].store(unused, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPThreadLocalObject<vtkIdList> cellPointIds;
+  for (int type = 0; type < 4; ++type)
+  {
+    vtkCellArray* cells = inCells[type];
+    vtkSMPTools::For(0, cells->GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* ptIdList = cellPointIds.Local();
+      const vtkIdType* pts = nullptr;
+      vtkIdType npts = 0;
+      for (; cellId < endCellId; ++cellId)
+      {
+        cells->GetCellAtId(cellId, npts, pts, ptIdList);
+        const vtkIdType position = connOffsets[type] + cells->GetOffset(cellId);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          std::atomic<vtkIdType>& use = firstUse[pts[i]];
+          vtkIdType current = use.load(std::memory_order_relaxed);
+          while (position + i < current && !use.compare_exchange_weak(current, position + i))
+          {
+          }
+        }
+      }
+    });
+  }
+
+  // Operate on the used points. With a float output, points whose mapped
+  // coordinates are not floats may be merged differently by vtkMergePoints,
+  // which compares them after the conversion, so the serial path is taken.
+  std::vector<double> newx(3 * numPts);
+  std::atomic<bool> exact(true);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (firstUse[ptId].load(std::memory_order_relaxed) == unused)
+      {
+        continue;
+      }
+      inPts->GetPoint(ptId, x);
+      double* y = newx.data() + 3 * ptId;
+      this->OperateOnPoint(x, y);
+      if (mergeCoordinates &&
+        (!std::isfinite(y[0]) || !std::isfinite(y[1]) || !std::isfinite(y[2]) ||
+          (dataType == VTK_FLOAT &&
+            (static_cast<float>(y[0]) != y[0] || static_cast<float>(y[1]) != y[1] ||
+              static_cast<float>(y[2]) != y[2]))))
+      {
+        exact = false;
+      }
+    }
+  });
+  if (!exact)
+  {
+    return false;
+  }
+  vtkDebugMacro(<< "Cleaning with threads");
+
+  // Sort the used points by coordinates or global id, then by first use, so
+  // that the first point of each run of merged points represents the run.
+  std::vector<vtkIdType> usedPts;
+  usedPts.reserve(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (firstUse[ptId].load(std::memory_order_relaxed) != unused)
+    {
+      usedPts.push_back(ptId);
+    }
+  }
+  const vtkIdType numUsedPts = static_cast<vtkIdType>(usedPts.size());
+  auto sameKey = [&](vtkIdType ptId0, vtkIdType ptId1) {
+    if (globalIdsArray && this->PointMerging)
+    {
+      return globalIdsArray->GetValue(ptId0) == globalIdsArray->GetValue(ptId1);
+    }
+    const double* x0 = newx.data() + 3 * ptId0;
+    const double* x1 = newx.data() + 3 * ptId1;
+    return x0[0] == x1[0] && x0[1] == x1[1] && x0[2] == x1[2];
+  };
+  if (globalIdsArray && this->PointMerging)
+  {
+    vtkSMPTools::Sort(usedPts.begin(), usedPts.end(), [&](vtkIdType ptId0, vtkIdType ptId1) {
+      const vtkIdType id0 = globalIdsArray->GetValue(ptId0);
+      const vtkIdType id1 = globalIdsArray->GetValue(ptId1);
+      return id0 < id1 || (id0 == id1 && firstUse[ptId0] < firstUse[ptId1]);
+    });
+  }
+  else if (mergeCoordinates)
+  {
+    vtkSMPTools::Sort(usedPts.begin(), usedPts.end(), [&](vtkIdType ptId0, vtkIdType ptId1) {
+      const double* x0 = newx.data() + 3 * ptId0;
+      const double* x1 = newx.data() + 3 * ptId1;
+      for (int j = 0; j < 3; ++j)
+      {
+        if (x0[j] != x1[j])
+        {
+          return x0[j] < x1[j];
+        }
+      }
+      return firstUse[ptId0] < firstUse[ptId1];
+    });
+  }
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkSMPTools::For(0, numUsedPts, [&](vtkIdType i, vtkIdType end) {
+    vtkIdType first = i;
+    while (this->PointMerging && first > 0 && sameKey(usedPts[first - 1], usedPts[first]))
+    {
+      --first;
+    }
+    for (; i < end; ++i)
+    {
+      if (!this->PointMerging || (i > first && !sameKey(usedPts[i - 1], usedPts[i])))
+      {
+        first = i;
+      }
+      pointMap[usedPts[i]] = usedPts[first];
+    }
+  });
+
+  // Number the representative points in the order of their first use.
+  std::vector<vtkIdType> newToOld;
+  for (vtkIdType ptId : usedPts)
+  {
+    if (pointMap[ptId] == ptId)
+    {
+      newToOld.push_back(ptId);
+    }
+  }
+  vtkSMPTools::Sort(newToOld.begin(), newToOld.end(),
+    [&](vtkIdType ptId0, vtkIdType ptId1) { return firstUse[ptId0] < firstUse[ptId1]; });
+  const vtkIdType numNewPts = static_cast<vtkIdType>(newToOld.size());
+  std::vector<vtkIdType> newIds(numPts);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType newId, vtkIdType endNewId) {
+    for (; newId < endNewId; ++newId)
+    {
+      newIds[newToOld[newId]] = newId;
+    }
+  });
+  vtkSMPTools::For(0, numUsedPts, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      pointMap[usedPts[i]] = newIds[pointMap[usedPts[i]]];
+    }
+  });
+  this->UpdateProgress(0.5);
+
+  // Copy the representative points and their attributes.
+  vtkPointData* outputPD = output->GetPointData();
+  if (!this->PointMerging || globalIdsArray)
+  {
+    outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  }
+  outputPD->CopyAllocate(inputPD, numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, inputPD, outputPD, /*nullValue*/ 0.0, /*promote*/ false);
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(dataType);
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType newId, vtkIdType endNewId) {
+    for (; newId < endNewId; ++newId)
+    {
+      newPts->SetPoint(newId, newx.data() + 3 * newToOld[newId]);
+      pointArrays.Copy(newToOld[newId], newId);
+    }
+  });
+  output->SetPoints(newPts);
+
+  // Clean the cells, then lay out the output cells of each type in the
+  // order of the input cells.
+  std::vector<signed char> outTypes(numCells);
+  std::vector<vtkIdType> outSizes(numCells);
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localUpdatedPts;
+  auto cleanCells = [&](bool fill, vtkIdType* const* outConn, const vtkIdType* outIds,
+                      const vtkIdType* outConnIds, ArrayList* cellArrays,
+                      const vtkIdType* typeOffsets) {
+    for (int type = 0; type < 4; ++type)
+    {
+      vtkCellArray* cells = inCells[type];
+      vtkSMPTools::For(0, cells->GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+        vtkIdList* ptIdList = cellPointIds.Local();
+        std::vector<vtkIdType>& updatedPts = localUpdatedPts.Local();
+        const vtkIdType* pts = nullptr;
+        vtkIdType npts = 0;
+        bool isFirst = vtkSMPTools::GetSingleThread();
+        vtkIdType checkAbortInterval = std::min((endCellId - cellId) / 10 + 1, (vtkIdType)1000);
+        for (; cellId < endCellId; ++cellId)
+        {
+          if (cellId % checkAbortInterval == 0)
+          {
+            if (isFirst)
+            {
+              this->CheckAbort();
+            }
+            if (this->GetAbortOutput())
+            {
+              break;
+            }
+          }
+          const vtkIdType inCellId = cellOffsets[type] + cellId;
+          if (fill && outTypes[inCellId] < 0)
+          {
+            continue;
+          }
+          cells->GetCellAtId(cellId, npts, pts, ptIdList);
+          const int outType = CleanCell(type, npts, pts, pointMap.data(),
+            this->ConvertLinesToPoints, this->ConvertPolysToLines, this->ConvertStripsToPolys,
+            updatedPts);
+          if (!fill)
+          {
+            outTypes[inCellId] = static_cast<signed char>(outType);
+            outSizes[inCellId] = static_cast<vtkIdType>(updatedPts.size());
+            continue;
+          }
+          std::copy(updatedPts.begin(), updatedPts.end(), outConn[outType] + outConnIds[inCellId]);
+          cellArrays->Copy(inCellId, typeOffsets[outType] + outIds[inCellId]);
+        }
+      });
+    }
+  };
+  cleanCells(false, nullptr, nullptr, nullptr, nullptr, nullptr);
+  if (this->GetAbortOutput())
+  {
+    return true;
+  }
+  this->UpdateProgress(0.75);
+
+  std::vector<vtkIdType> outIds(numCells);
+  std::vector<vtkIdType> outConnIds(numCells);
+  vtkIdType numOutCells[4] = { 0, 0, 0, 0 };
+  vtkIdType outConnSizes[4] = { 0, 0, 0, 0 };
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    const int outType = outTypes[cellId];
+    if (outType >= 0)
+    {
+      outIds[cellId] = numOutCells[outType]++;
+      outConnIds[cellId] = outConnSizes[outType];
+      outConnSizes[outType] += outSizes[cellId];
+    }
+  }
+
+  vtkNew<vtkIdTypeArray> offsets[4];
+  vtkNew<vtkIdTypeArray> conn[4];
+  vtkIdType* outConn[4];
+  vtkIdType typeOffsets[4] = { 0, 0, 0, 0 };
+  for (int type = 0; type < 4; ++type)
+  {
+    offsets[type]->SetNumberOfValues(numOutCells[type] + 1);
+    offsets[type]->SetValue(numOutCells[type], outConnSizes[type]);
+    outConn[type] = conn[type]->WritePointer(0, outConnSizes[type]);
+    if (type > 0)
+    {
+      typeOffsets[type] = typeOffsets[type - 1] + numOutCells[type - 1];
+    }
+  }
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      const int outType = outTypes[cellId];
+      if (outType >= 0)
+      {
+        offsets[outType]->SetValue(outIds[cellId], outConnIds[cellId]);
+      }
+    }
+  });
+
+  vtkCellData* outputCD = output->GetCellData();
+  const vtkIdType numOutputCells = typeOffsets[3] + numOutCells[3];
+  outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  outputCD->CopyAllocate(inputCD, numOutputCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(
+    numOutputCells, inputCD, outputCD, /*nullValue*/ 0.0, /*promote*/ false);
+  cleanCells(true, outConn, outIds.data(), outConnIds.data(), &cellArrays, typeOffsets);
+
+  for (int type = 0; type < 4; ++type)
+  {
+    if (numOutCells[type] == 0 && inCells[type]->GetNumberOfCells() == 0)
+    {
+      continue;
+    }
+    vtkNew<vtkCellArray> outCells;
+    outCells->SetData(offsets[type], conn[type]);
+    switch (type)
+    {
+      case 0:
+        output->SetVerts(outCells);
+        break;
+      case 1:
+        output->SetLines(outCells);
+        break;
+      case 2:
+        output->SetPolys(outCells);
+        break;
+      default:
+        output->SetStrips(outCells);
+    }
+  }
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points and "
+                << numCells - numOutputCells << " cells");
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
@@ -750,6 +1194,7 @@ void vtkCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "PieceInvariant: " << (this->PieceInvariant ? "On\n" : "Off\n");
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
@@ -53,6 +53,15 @@
  * will not be used, and points that are not used by any cells will be
  * eliminated, but never merged.
  *
+ * The filter is threaded with vtkSMPTools when its output does not depend on
+ * the order in which the points are inserted: when the points are not merged,
+ * when they are merged by global id, and when they are merged with a zero
+ * tolerance and no locator is specified. The output is then identical to the
+ * one of the serial traversal. Subclasses overriding OperateOnPoint are
+ * cleaned serially, unless they override IsOperateOnPointThreadSafe() to
+ * allow concurrent invocations. SequentialProcessing forces the serial
+ * traversal.
+ *
  * @warning
  * Merging points can alter topology, including introducing non-manifold
  * forms. The tolerance should be chosen carefully to avoid these problems.
@@ -164,7 +173,8 @@ public:
   ///@{
   /**
    * Set/Get a spatial locator for speeding the search process. By
-   * default an instance of vtkMergePoints is used.
+   * default an instance of vtkMergePoints is used, which is created by the
+   * serial traversal and released at its end.
    */
   virtual void SetLocator(vtkIncrementalPointLocator* locator);
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
@@ -214,6 +224,17 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the cleaning. By
+   * default, sequential processing is off. The output is the same either
+   * way. This flag is typically used for benchmarking and testing purposes.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkCleanPolyData();
   ~vtkCleanPolyData() override;
@@ -222,6 +243,21 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Return true if OperateOnPoint() may be invoked concurrently, which lets
+   * the input be cleaned with threads. The default implementation only
+   * returns true for vtkCleanPolyData itself: subclasses, which may keep
+   * state in OperateOnPoint(), are cleaned serially unless they override
+   * this method.
+   */
+  virtual bool IsOperateOnPointThreadSafe();
+
+  /**
+   * Clean the input with threads when the merged points do not depend on the
+   * traversal order. Return false without modifying the output otherwise.
+   */
+  bool ThreadedClean(vtkPolyData* input, vtkPolyData* output);
+
   vtkTypeBool PointMerging;
   double Tolerance;
   double AbsoluteTolerance;
@@ -233,6 +269,7 @@ protected:
 
   vtkTypeBool PieceInvariant;
   int OutputPointsPrecision;
+  bool SequentialProcessing;
 
 private:
   vtkCleanPolyData(const vtkCleanPolyData&) = delete;
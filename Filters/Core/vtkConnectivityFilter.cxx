@@ -16,6 +16,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectedComponents.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -28,9 +29,12 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
@@ -62,6 +66,7 @@ vtkConnectivityFilter::vtkConnectivityFilter()
   this->NewCellScalars = nullptr;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 }
 
 vtkConnectivityFilter::~vtkConnectivityFilter()
@@ -242,32 +247,51 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (!this->InScalars && !this->SequentialProcessing)
     {
-      if (cellId && !(cellId % 5000))
+      if (!this->CheckAbort())
+      {
+        this->LabelRegions(input, nullptr);
+      }
+      for (i = 0; i < this->RegionNumber; i++)
       {
-        if (this->CheckAbort())
+        if (this->RegionSizes->GetValue(i) > maxCellsInRegion)
         {
-          break;
+          maxCellsInRegion = this->RegionSizes->GetValue(i);
+          largestRegionId = i;
         }
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
       }
-
-      if (this->Visited[cellId] < 0)
+      this->UpdateProgress(0.9);
+    }
+    else
+    {
+      for (cellId = 0; cellId < numCells; cellId++)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave->InsertNextId(cellId);
-        this->TraverseAndMark(input);
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
+        if (cellId && !(cellId % 5000))
         {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
+          if (this->CheckAbort())
+          {
+            break;
+          }
+          this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
         }
 
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        if (this->Visited[cellId] < 0)
+        {
+          this->NumCellsInRegion = 0;
+          this->Wave->InsertNextId(cellId);
+          this->TraverseAndMark(input);
+
+          if (this->NumCellsInRegion > maxCellsInRegion)
+          {
+            maxCellsInRegion = this->NumCellsInRegion;
+            largestRegionId = this->RegionNumber;
+          }
+
+          this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
+          this->Wave->Reset();
+          this->Wave2->Reset();
+        }
       }
     }
   }
@@ -345,8 +369,18 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark(input);
-    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    if (!this->InScalars && !this->SequentialProcessing)
+    {
+      if (!this->CheckAbort())
+      {
+        this->LabelRegions(input, this->Wave);
+      }
+    }
+    else
+    {
+      this->TraverseAndMark(input);
+      this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    }
     this->UpdateProgress(0.9);
   }
 
@@ -632,6 +666,97 @@ void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
   } // while wave is not empty
 }
 
+// Mark the cells and points of the regions from the connected components of
+// the cells, which are labelled in parallel. The points are numbered by
+// region, then in the order of their first use by the cells of the region.
+//
+void vtkConnectivityFilter::LabelRegions(vtkDataSet* input, vtkIdList* seeds)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  std::vector<vtkIdType> pointLabels(numPts);
+  vtkIdType numRegions =
+    vtkConnectedComponents::LabelCells(input, this->Visited, pointLabels.data());
+  this->UpdateProgress(seeds ? 0.7 : 0.5);
+
+  if (seeds)
+  {
+    // the components of the seeds form region 0, the other ones are not visited
+    std::vector<vtkIdType> seeded(numRegions, -1);
+    for (vtkIdType i = 0; i < seeds->GetNumberOfIds(); i++)
+    {
+      seeded[this->Visited[seeds->GetId(i)]] = 0;
+    }
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; cellId++)
+      {
+        this->Visited[cellId] = seeded[this->Visited[cellId]];
+      }
+    });
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ptId++)
+      {
+        if (pointLabels[ptId] >= 0)
+        {
+          pointLabels[ptId] = seeded[pointLabels[ptId]];
+        }
+      }
+    });
+    numRegions = 1;
+  }
+  else
+  {
+    this->RegionNumber = numRegions;
+  }
+
+  this->RegionSizes->SetNumberOfValues(numRegions);
+  vtkIdType* regionSizes = this->RegionSizes->GetPointer(0);
+  std::fill_n(regionSizes, numRegions, 0);
+  vtkIdType* cellRegionIds = this->NewCellScalars->GetPointer(0);
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+  {
+    vtkIdType regionId = this->Visited[cellId];
+    cellRegionIds[cellId] = regionId;
+    if (regionId >= 0)
+    {
+      regionSizes[regionId]++;
+    }
+  }
+
+  std::vector<vtkIdType> pointOffsets(numRegions + 1, 0);
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+  {
+    if (pointLabels[ptId] >= 0)
+    {
+      pointOffsets[pointLabels[ptId] + 1]++;
+    }
+  }
+  for (vtkIdType regionId = 0; regionId < numRegions; regionId++)
+  {
+    pointOffsets[regionId + 1] += pointOffsets[regionId];
+  }
+  vtkIdType* pointRegionIds = this->NewScalars->GetPointer(0);
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+  {
+    vtkIdType regionId = this->Visited[cellId];
+    if (regionId < 0)
+    {
+      continue;
+    }
+    input->GetCellPoints(cellId, this->PointIds);
+    for (vtkIdType i = 0; i < this->PointIds->GetNumberOfIds(); i++)
+    {
+      vtkIdType ptId = this->PointIds->GetId(i);
+      if (this->PointMap[ptId] < 0)
+      {
+        this->PointMap[ptId] = pointOffsets[regionId]++;
+        pointRegionIds[this->PointMap[ptId]] = regionId;
+      }
+    }
+  }
+  this->PointNumber = pointOffsets[numRegions];
+}
+
 void vtkConnectivityFilter::OrderRegionIds(
   vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds)
 {
@@ -790,5 +915,6 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   double* range = this->GetScalarRange();
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
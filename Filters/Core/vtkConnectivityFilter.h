@@ -50,8 +50,17 @@
  * was processed and has no other significance with respect to the size of
  * or number of cells.
  *
+ * When ScalarConnectivity is off, the regions are the connected components
+ * of the cells, which are labelled in parallel with vtkConnectedComponents
+ * instead of being traversed one after the other. The regions are numbered
+ * in the same order, but the output points are numbered by region, then in
+ * the order of their first use by the cells of the region taken by
+ * increasing id. This differs from the order of the traversal, which was
+ * used before and is still used with ScalarConnectivity or
+ * SequentialProcessing.
+ *
  * @sa
- * vtkPolyDataConnectivityFilter
+ * vtkPolyDataConnectivityFilter vtkConnectedComponents
  */
 
 #ifndef vtkConnectivityFilter_h
@@ -216,6 +225,19 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the regions, which
+   * are then traversed one after the other. By default, sequential
+   * processing is off. The regions and the output cells are the same either
+   * way, but the output points are numbered in the order of the traversal.
+   * This flag is typically used for benchmarking and testing purposes.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkConnectivityFilter();
   ~vtkConnectivityFilter() override;
@@ -233,6 +255,7 @@ protected:
   vtkTypeBool ColorRegions; // boolean turns on/off scalar gen for separate regions
   int ExtractionMode;       // how to extract regions
   int OutputPointsPrecision;
+  bool SequentialProcessing;
   vtkIdList* Seeds;              // id's of points or cells used to seed regions
   vtkIdList* SpecifiedRegionIds; // regions specified for extraction
   vtkIdTypeArray* RegionSizes;   // size (in cells) of each region extracted
@@ -246,6 +269,13 @@ protected:
 
   void TraverseAndMark(vtkDataSet* input);
 
+  /**
+   * Mark the regions without scalar connectivity, using a parallel labelling
+   * of the connected components. If seeds is nullptr, every component is a
+   * region; otherwise the components of the seed cells form region 0.
+   */
+  void LabelRegions(vtkDataSet* input, vtkIdList* seeds);
+
   void OrderRegionIds(vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds);
 
 private:
@@ -17,6 +17,7 @@
 #include "vtkAbstractTransform.h"
 #include "vtkCellArray.h"
 #include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -25,6 +26,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSpaceFillingCurve.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
 #include "vtkTriangle.h"
@@ -45,6 +47,7 @@ vtkDelaunay2D::vtkDelaunay2D()
   this->BoundingTriangulation = 0;
   this->Offset = 1.0;
   this->RandomPointInsertion = 0;
+  this->SpatialPointInsertion = 0;
   this->Transform = nullptr;
   this->ProjectionPlaneMode = VTK_DELAUNAY_XY_PLANE;
 
@@ -467,6 +470,14 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   const double* bounds = points->GetBounds();
+  vtkNew<vtkIdTypeArray> insertionOrder;
+  if (this->SpatialPointInsertion)
+  {
+    // The points are projected on the z=0 plane, possibly after the transform.
+    double planeBounds[6] = { bounds[0], bounds[1], bounds[2], bounds[3], 0.0, 0.0 };
+    vtkSpaceFillingCurve::SortPointsInRounds(
+      points, vtkSpaceFillingCurve::HILBERT, insertionOrder, planeBounds);
+  }
   center[0] = (bounds[0] + bounds[1]) / 2.0;
   center[1] = (bounds[2] + bounds[3]) / 2.0;
   center[2] = (bounds[4] + bounds[5]) / 2.0;
@@ -524,12 +535,15 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   // neighboring triangles for Delaunay criterion. Triangles that do not
   // satisfy criterion have their edges swapped. This continues recursively
   // until all triangles have been shown to be Delaunay. The points may be
-  // traversed in given order, or pseudo-random order.
+  // traversed in given order, pseudo-random order, or spatially sorted
+  // rounds (the search of each triangle then starts next to the point).
   //
   GCDTraversal gcdIter(numPoints);
   for (auto idx = 0; idx < numPoints; idx++)
   {
-    ptId = (this->RandomPointInsertion ? gcdIter.GetPointId(idx) : idx);
+    ptId = (this->SpatialPointInsertion ? insertionOrder->GetValue(idx)
+        : this->RandomPointInsertion    ? gcdIter.GetPointId(idx)
+                                        : idx);
     this->GetPoint(ptId, x);
     nei[0] = (-1); // where we are coming from...nowhere initially
 
@@ -1652,6 +1666,8 @@ void vtkDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Random Point Insertion: " << (this->RandomPointInsertion ? "On" : "Off") << "\n";
+  os << indent << "Spatial Point Insertion: " << (this->SpatialPointInsertion ? "On" : "Off")
+     << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -68,7 +68,8 @@
  * problems are present, you will see a warning message to this effect at
  * the end of the triangulation process. Note also that the
  * RandomPointInsertion mode can be set which will insert the points in
- * pseudo-random order.
+ * pseudo-random order. On large point sets, the SpatialPointInsertion mode
+ * inserts the points in a spatially coherent order, which is much faster.
  *
  * To create constrained meshes, you must define an additional
  * input. This input is an instance of vtkPolyData which contains
@@ -267,6 +268,21 @@ public:
   vtkBooleanMacro(RandomPointInsertion, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to insert the points in a biased randomized insertion
+   * order (BRIO): the points are drawn into rounds of doubling size, and
+   * sorted along a Hilbert curve within each round. Consecutive points are
+   * then close to each other, so that locating the triangle of each point
+   * only walks a few triangles. This is much faster on large point sets, and
+   * takes precedence over RandomPointInsertion. The points are still inserted
+   * one at a time, only their order changes. Off by default.
+   */
+  vtkSetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkGetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkBooleanMacro(SpatialPointInsertion, vtkTypeBool);
+  ///@}
+
 protected:
   vtkDelaunay2D();
 
@@ -277,6 +293,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   vtkTypeBool RandomPointInsertion;
+  vtkTypeBool SpatialPointInsertion;
 
   // Transform input points (if necessary)
   vtkSmartPointer<vtkAbstractTransform> Transform;
@@ -17,14 +17,17 @@
 
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
+#include "vtkSpaceFillingCurve.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
@@ -139,6 +142,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->SpatialPointInsertion = 0;
   this->Locator = nullptr;
   this->TetraArray = nullptr;
   this->References = nullptr;
@@ -150,6 +154,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->Faces->Allocate(15);
   this->CheckedTetras = vtkIdList::New();
   this->CheckedTetras->Allocate(25);
+  this->LastInsertedPoint = -1;
 }
 
 //------------------------------------------------------------------------------
@@ -205,22 +210,33 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
     return 0;
   }
 
-  closestPoint = locator->FindClosestInsertedPoint(x);
   vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetLinks());
-  int numCells = links->GetNcells(closestPoint);
-  vtkIdType* cells = links->GetCells(closestPoint);
-  if (numCells <= 0) // shouldn't happen
+  tetraId = -1;
+  if (this->SpatialPointInsertion && this->LastInsertedPoint >= 0 &&
+    links->GetNcells(this->LastInsertedPoint) > 0)
   {
-    this->NumberOfDegeneracies++;
-    return 0;
+    // The previous point is close, walk from one of its tetras.
+    tetraId = this->FindTetra(Mesh, xd, links->GetCells(this->LastInsertedPoint)[0], 0);
   }
-  else
+
+  if (tetraId < 0)
   {
-    tetraId = cells[0];
-  }
+    closestPoint = locator->FindClosestInsertedPoint(x);
+    int numCells = links->GetNcells(closestPoint);
+    vtkIdType* cells = links->GetCells(closestPoint);
+    if (numCells <= 0) // shouldn't happen
+    {
+      this->NumberOfDegeneracies++;
+      return 0;
+    }
+    else
+    {
+      tetraId = cells[0];
+    }
 
-  // Okay, walk towards the containing tetrahedron
-  tetraId = this->FindTetra(Mesh, xd, tetraId, 0);
+    // Okay, walk towards the containing tetrahedron
+    tetraId = this->FindTetra(Mesh, xd, tetraId, 0);
+  }
   if (tetraId < 0)
   {
     this->NumberOfDegeneracies++;
@@ -496,17 +512,25 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   // Insert each point into triangulation. Points laying "inside"
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
-  // tetrahedra.
-  for (ptId = 0; ptId < numPoints; ptId++)
+  // tetrahedra. The points are inserted in given order, or in spatially
+  // sorted rounds.
+  vtkNew<vtkIdTypeArray> insertionOrder;
+  if (this->SpatialPointInsertion)
+  {
+    vtkSpaceFillingCurve::SortPointsInRounds(
+      inPoints, vtkSpaceFillingCurve::HILBERT, insertionOrder);
+  }
+  for (vtkIdType idx = 0; idx < numPoints; idx++)
   {
+    ptId = (this->SpatialPointInsertion ? insertionOrder->GetValue(idx) : idx);
     inPoints->GetPoint(ptId, x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if (!(ptId % 250))
+    if (!(idx % 250))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << idx);
+      this->UpdateProgress(static_cast<double>(idx) / numPoints);
       if (this->CheckAbort())
       {
         break;
@@ -799,6 +823,7 @@ vtkUnstructuredGrid* vtkDelaunay3D::InitPointInsertion(
 
   this->NumberOfDuplicatePoints = 0;
   this->NumberOfDegeneracies = 0;
+  this->LastInsertedPoint = -1;
 
   if (length <= 0.0)
   {
@@ -923,6 +948,7 @@ void vtkDelaunay3D::InsertPoint(
   if ((numFaces = this->FindEnclosingFaces(x, Mesh, this->Tetras, this->Faces, this->Locator)) > 0)
   {
     this->Locator->InsertPoint(ptId, x); // point is part of mesh now
+    this->LastInsertedPoint = ptId;
     numTetras = this->Tetras->GetNumberOfIds();
 
     // create new tetra for each face
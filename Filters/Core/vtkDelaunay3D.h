@@ -198,6 +198,22 @@ public:
   vtkBooleanMacro(BoundingTriangulation, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to insert the points in a biased randomized insertion
+   * order (BRIO): the points are drawn into rounds of doubling size, and
+   * sorted along a Hilbert curve within each round. Consecutive points are
+   * then close to each other, so that the search of the tetrahedron of each
+   * point starts from the previous point instead of querying the locator,
+   * and only walks a few tetrahedra. This is much faster on large point sets.
+   * The locator is still used to discard coincident points, and the points
+   * are still inserted one at a time, only their order changes. Off by default.
+   */
+  vtkSetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkGetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkBooleanMacro(SpatialPointInsertion, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set / get a spatial locator for merging points. By default,
@@ -279,6 +295,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  vtkTypeBool SpatialPointInsertion;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
 
@@ -302,6 +319,7 @@ private:                    // members added for performance
   vtkIdList* Tetras;        // used in InsertPoint
   vtkIdList* Faces;         // used in InsertPoint
   vtkIdList* CheckedTetras; // used by InsertPoint
+  vtkIdType LastInsertedPoint; // start of the search with SpatialPointInsertion
 
   vtkDelaunay3D(const vtkDelaunay3D&) = delete;
   void operator=(const vtkDelaunay3D&) = delete;
@@ -19,9 +19,12 @@
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIncrementalArrayCache.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
@@ -114,12 +117,21 @@ struct vtkElevationAlgorithm
 struct Elevate
 {
   template <typename PointArrayT>
-  void operator()(
-    PointArrayT* pointArray, vtkElevationFilter* filter, double* v, double l2, float* scalars)
+  void operator()(PointArrayT* pointArray, vtkElevationFilter* filter, double* v, double l2,
+    float* scalars, vtkIdTypeArray* ranges)
   {
     // Okay now generate samples using SMP tools
     vtkElevationAlgorithm<PointArrayT> algo{ pointArray, filter, scalars, v, l2 };
-    vtkSMPTools::For(0, pointArray->GetNumberOfTuples(), algo);
+    if (!ranges)
+    {
+      vtkSMPTools::For(0, pointArray->GetNumberOfTuples(), algo);
+      return;
+    }
+    // Only the modified points
+    for (vtkIdType r = 0; r < ranges->GetNumberOfTuples(); ++r)
+    {
+      vtkSMPTools::For(ranges->GetTypedComponent(r, 0), ranges->GetTypedComponent(r, 1), algo);
+    }
   }
 };
 
@@ -139,10 +151,15 @@ vtkElevationFilter::vtkElevationFilter()
 
   this->ScalarRange[0] = 0.0;
   this->ScalarRange[1] = 1.0;
+
+  this->IncrementalCache = vtkIncrementalArrayCache::New();
 }
 
 //------------------------------------------------------------------------------
-vtkElevationFilter::~vtkElevationFilter() = default;
+vtkElevationFilter::~vtkElevationFilter()
+{
+  this->IncrementalCache->Delete();
+}
 
 //------------------------------------------------------------------------------
 void vtkElevationFilter::PrintSelf(ostream& os, vtkIndent indent)
@@ -172,9 +189,19 @@ int vtkElevationFilter::RequestData(
     return 1;
   }
 
-  // Allocate space for the elevation scalar data.
-  vtkSmartPointer<vtkFloatArray> newScalars = vtkSmartPointer<vtkFloatArray>::New();
-  newScalars->SetNumberOfTuples(numPts);
+  // Reuse the elevation of the last execution if only ranges of the points
+  // were modified, else allocate space for the elevation scalar data.
+  vtkPointSet* ps = vtkPointSet::SafeDownCast(input);
+  vtkDataArray* pointsArray = ps && ps->GetPoints() ? ps->GetPoints()->GetData() : nullptr;
+  vtkNew<vtkIdTypeArray> ranges;
+  vtkSmartPointer<vtkFloatArray> newScalars = vtkFloatArray::SafeDownCast(
+    this->IncrementalCache->GetCachedOutput(this, 1, &pointsArray, ranges));
+  const bool incremental = pointsArray && newScalars;
+  if (!incremental)
+  {
+    newScalars = vtkSmartPointer<vtkFloatArray>::New();
+    newScalars->SetNumberOfTuples(numPts);
+  }
 
   // Set up 1D parametric system and make sure it is valid.
   double diffVector[3] = { this->HighPoint[0] - this->LowPoint[0],
@@ -193,21 +220,26 @@ int vtkElevationFilter::RequestData(
 
   // Create a fast path for point set input
   //
-  vtkPointSet* ps = vtkPointSet::SafeDownCast(input);
-  if (ps)
+  if (pointsArray)
   {
     float* scalars = newScalars->GetPointer(0);
-    vtkPoints* points = ps->GetPoints();
-    vtkDataArray* pointsArray = points->GetData();
+    vtkIdTypeArray* modifiedRanges = incremental ? ranges.Get() : nullptr;
 
     Elevate worker; // Entry point to vtkElevationAlgorithm
 
     // Generate an optimized fast-path for float/double
     using FastValueTypes = vtkArrayDispatch::Reals;
     using Dispatcher = vtkArrayDispatch::DispatchByValueType<FastValueTypes>;
-    if (!Dispatcher::Execute(pointsArray, worker, this, diffVector, length2, scalars))
+    if (!Dispatcher::Execute(
+          pointsArray, worker, this, diffVector, length2, scalars, modifiedRanges))
     { // fallback for unknown arrays and integral value types:
-      worker(pointsArray, this, diffVector, length2, scalars);
+      worker(pointsArray, this, diffVector, length2, scalars, modifiedRanges);
+    }
+
+    // Let the filters downstream update their outputs incrementally.
+    for (vtkIdType r = 0; incremental && r < ranges->GetNumberOfTuples(); ++r)
+    {
+      newScalars->ModifiedRange(ranges->GetTypedComponent(r, 0), ranges->GetTypedComponent(r, 1));
     }
   } // fast path
 
@@ -252,6 +284,8 @@ int vtkElevationFilter::RequestData(
   newScalars->SetName("Elevation");
   output->GetPointData()->AddArray(newScalars);
   output->GetPointData()->SetActiveScalars("Elevation");
+  this->IncrementalCache->SetCachedOutput(
+    1, &pointsArray, pointsArray && !this->GetAbortOutput() ? newScalars.Get() : nullptr);
 
   return 1;
 }
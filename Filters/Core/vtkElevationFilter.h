@@ -31,6 +31,12 @@
  * non-sequential type (set in the CMake variable
  * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
  *
+ * @warning
+ * When the input is a vtkPointSet whose points were only modified by ranges
+ * (see vtkDataArray::ModifiedRange()), the elevation of the modified points
+ * only is recomputed, in place, as long as the elevation array of the last
+ * execution is not referenced anywhere else.
+ *
  * @sa
  * vtkSimpleElevationFilter
  */
@@ -42,6 +48,8 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkIncrementalArrayCache;
+
 class VTKFILTERSCORE_EXPORT vtkElevationFilter : public vtkDataSetAlgorithm
 {
 public:
@@ -88,6 +96,8 @@ protected:
 private:
   vtkElevationFilter(const vtkElevationFilter&) = delete;
   void operator=(const vtkElevationFilter&) = delete;
+
+  vtkIncrementalArrayCache* IncrementalCache;
 };
 
 VTK_ABI_NAMESPACE_END
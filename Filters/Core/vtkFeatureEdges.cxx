@@ -14,9 +14,12 @@
 =========================================================================*/
 #include "vtkFeatureEdges.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -27,11 +30,21 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleStrip.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <map>
+#include <numeric>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkFeatureEdges);
@@ -40,6 +53,168 @@ namespace
 {
 constexpr unsigned char CELL_NOT_VISIBLE =
   vtkDataSetAttributes::HIDDENCELL | vtkDataSetAttributes::DUPLICATECELL;
+
+// The scalars of the edges in the order of their types: boundary,
+// non-manifold, feature and manifold edges, then the lines passed.
+constexpr float EDGE_TYPE_SCALARS[5] = { 0.0f, 0.222222f, 0.444444f, 0.666667f, 0.888889f };
+
+// Classify the edges of the mesh cells, identified by their position in the
+// mesh connectivity, using ids of type TId to sort them. Return false when a
+// cell uses a point twice.
+template <typename TId>
+bool ClassifyEdges(vtkFeatureEdges* self, vtkCellArray* mesh, vtkPoints* inPts,
+  const std::vector<vtkIdType>& meshOffsets, std::vector<signed char>& edgeTypes)
+{
+  const vtkIdType numMeshCells = mesh->GetNumberOfCells();
+  const vtkIdType numEdges = mesh->GetNumberOfConnectivityIds();
+
+  const bool boundaryEdges = self->GetBoundaryEdges();
+  const bool nonManifoldEdges = self->GetNonManifoldEdges();
+  const bool featureEdges = self->GetFeatureEdges();
+  const bool manifoldEdges = self->GetManifoldEdges();
+  const vtkIdType cellSize = numMeshCells > 0 ? meshOffsets[1] : 0;
+  std::atomic<bool> uniformSize(true);
+
+  // Gather the edges of the mesh cells with the position as edge data, and
+  // compute the cell normals in single precision, as the serial path does.
+  // The serial path finds the neighbors of an edge from the cells using its
+  // points, which counts the cells using a point twice several times, so
+  // these degenerate cells are left to it.
+  using EdgeTupleType = EdgeTuple<TId, TId>;
+  std::vector<EdgeTupleType> edges(numEdges);
+  std::vector<float> normals(featureEdges ? 3 * numMeshCells : 0);
+  std::atomic<bool> degenerate(false);
+  vtkSMPThreadLocalObject<vtkIdList> cellPointIds;
+  vtkSMPTools::For(0, numMeshCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* ptIdList = cellPointIds.Local();
+    const vtkIdType* pts = nullptr;
+    vtkIdType npts = 0;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endCellId - cellId) / 10 + 1, (vtkIdType)1000);
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          self->CheckAbort();
+        }
+        if (self->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      mesh->GetCellAtId(cellId, npts, pts, ptIdList);
+      const vtkIdType position = meshOffsets[cellId];
+      if (npts != cellSize)
+      {
+        uniformSize = false;
+      }
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        if (std::find(pts, pts + i, pts[i]) != pts + i)
+        {
+          degenerate = true;
+        }
+        edges[position + i] = EdgeTupleType(static_cast<TId>(pts[i]),
+          static_cast<TId>(pts[(i + 1) % npts]), static_cast<TId>(position + i));
+      }
+      if (featureEdges)
+      {
+        double n[3];
+        vtkPolygon::ComputeNormal(inPts, npts, pts, n);
+        std::copy(n, n + 3, normals.begin() + 3 * cellId);
+      }
+    }
+  });
+  if (degenerate)
+  {
+    return false;
+  }
+  if (self->GetAbortOutput())
+  {
+    return true;
+  }
+  self->UpdateProgress(0.25);
+
+  // The cells of the common meshes have the same size, which avoids
+  // searching the offsets for the cell of an edge.
+  const bool uniform = uniformSize;
+  auto meshCellId = [&](vtkIdType position) {
+    if (uniform)
+    {
+      return position / cellSize;
+    }
+    return static_cast<vtkIdType>(
+      std::upper_bound(meshOffsets.begin(), meshOffsets.end(), position) - meshOffsets.begin() - 1);
+  };
+
+  // Sort the edges to group the uses of each edge, then classify the uses of
+  // an edge from the distinct cells using it, the first of which extracts
+  // the non-manifold edges. The edge types index EDGE_TYPE_SCALARS, and -1
+  // marks the uses which are not extracted.
+  vtkStaticEdgeLocatorTemplate<TId, TId> edgeLocator;
+  vtkIdType numUniqueEdges = 0;
+  const TId* edgeOffsets = edgeLocator.MergeEdges(numEdges, edges.data(), numUniqueEdges);
+  const double cosAngle = std::cos(vtkMath::RadiansFromDegrees(self->GetFeatureAngle()));
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localUseCells;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localCells;
+  vtkSMPTools::For(0, numUniqueEdges, [&](vtkIdType edgeId, vtkIdType endEdgeId) {
+    std::vector<vtkIdType>& useCells = localUseCells.Local();
+    std::vector<vtkIdType>& cells = localCells.Local();
+    for (; edgeId < endEdgeId; ++edgeId)
+    {
+      const EdgeTupleType* uses = edges.data() + edgeOffsets[edgeId];
+      const vtkIdType numUses = edgeOffsets[edgeId + 1] - edgeOffsets[edgeId];
+      useCells.resize(numUses);
+      for (vtkIdType i = 0; i < numUses; ++i)
+      {
+        useCells[i] = meshCellId(uses[i].Data);
+      }
+      cells = useCells;
+      if (numUses > 2)
+      {
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+      }
+      else if (numUses == 2 && cells[0] >= cells[1])
+      {
+        std::swap(cells[0], cells[1]);
+        cells.resize(cells[0] == cells[1] ? 1 : 2);
+      }
+      const vtkIdType numNei = static_cast<vtkIdType>(cells.size()) - 1;
+
+      for (vtkIdType i = 0; i < numUses; ++i)
+      {
+        const vtkIdType cellId = useCells[i];
+        const vtkIdType nei = numNei == 1 ? (cells[0] == cellId ? cells[1] : cells[0]) : -1;
+        signed char type = -1;
+        if (boundaryEdges && numNei < 1)
+        {
+          type = 0;
+        }
+        else if (nonManifoldEdges && numNei > 1)
+        {
+          type = cellId == cells[0] ? 1 : -1;
+        }
+        else if (featureEdges && numNei == 1 && nei > cellId)
+        {
+          const float* n0 = normals.data() + 3 * cellId;
+          const float* n1 = normals.data() + 3 * nei;
+          const double dot = static_cast<double>(n0[0]) * n1[0] +
+            static_cast<double>(n0[1]) * n1[1] + static_cast<double>(n0[2]) * n1[2];
+          type = dot <= cosAngle ? 2 : -1;
+        }
+        else if (manifoldEdges && numNei == 1 && nei > cellId)
+        {
+          type = 3;
+        }
+        edgeTypes[uses[i].Data] = type;
+      }
+    }
+  });
+  return true;
+}
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -57,6 +232,7 @@ vtkFeatureEdges::vtkFeatureEdges()
   this->Coloring = true;
   this->Locator = nullptr;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 }
 
 //------------------------------------------------------------------------------
@@ -146,6 +322,13 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "All edge types turned off!");
   }
 
+  // The classification of the edges at ghost interfaces depends on the
+  // traversal of the neighbors, so ghost cells are handled serially.
+  if (!ghosts && this->ThreadedExtract(input, output))
+  {
+    return 1;
+  }
+
   // Build cell structure.  Might have to triangulate the strips.
   Mesh = vtkPolyData::New();
   Mesh->SetPoints(inPts);
@@ -254,9 +437,12 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   outPD->CopyAllocate(pd, numPts);
   outCD->CopyAllocate(cd, numCells);
 
-  // Get our locator for merging points
+  // Get our locator for merging points. A locator created here is released
+  // at the end, so that it is not taken for a locator specified by the user
+  // in the next execution.
   //
-  if (this->Locator == nullptr)
+  const bool createLocator = this->Locator == nullptr;
+  if (createLocator)
   {
     this->CreateDefaultLocator();
   }
@@ -513,7 +699,16 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
 
   output->SetLines(newLines);
   newLines->Delete();
-  this->Locator->Initialize(); // release any extra memory
+  if (createLocator)
+  {
+    // Not SetLocator(nullptr), which would modify the filter.
+    this->Locator->UnRegister(this);
+    this->Locator = nullptr;
+  }
+  else
+  {
+    this->Locator->Initialize(); // release any extra memory
+  }
   if (this->Coloring)
   {
     int idx = outCD->AddArray(newScalars);
@@ -524,6 +719,343 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+bool vtkFeatureEdges::ThreadedExtract(vtkPolyData* input, vtkPolyData* output)
+{
+  // The points are merged by coordinates exactly like the default
+  // vtkMergePoints does, so a user-specified locator requires the serial path.
+  if (this->SequentialProcessing || this->Locator)
+  {
+    return false;
+  }
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* pd = input->GetPointData();
+  vtkCellData* cd = input->GetCellData();
+  int dataType = inPts->GetDataType();
+  if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    dataType = VTK_FLOAT;
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    dataType = VTK_DOUBLE;
+  }
+  if (dataType != VTK_FLOAT && dataType != VTK_DOUBLE)
+  {
+    return false;
+  }
+  if (!CanUseArrayList(pd) || !CanUseArrayList(cd))
+  {
+    return false;
+  }
+
+  const vtkIdType numVerts = input->GetNumberOfVerts();
+  const vtkIdType numLines = this->PassLines ? input->GetNumberOfLines() : 0;
+  const vtkIdType numPolys = input->GetNumberOfPolys();
+  const vtkIdType firstPolyId = numVerts + input->GetNumberOfLines();
+  vtkCellArray* lines = input->GetLines();
+
+  // The polygons followed by the triangles of the strips form the mesh, as in
+  // the serial path. The triangles of a strip start at its stripStarts entry.
+  vtkSmartPointer<vtkCellArray> mesh = input->GetPolys();
+  std::vector<vtkIdType> stripStarts;
+  if (input->GetNumberOfStrips() > 0)
+  {
+    mesh = vtkSmartPointer<vtkCellArray>::New();
+    mesh->DeepCopy(input->GetPolys());
+    vtkCellArray* strips = input->GetStrips();
+    stripStarts.reserve(strips->GetNumberOfCells());
+    vtkIdType npts = 0;
+    const vtkIdType* pts = nullptr;
+    for (strips->InitTraversal(); strips->GetNextCell(npts, pts);)
+    {
+      stripStarts.push_back(mesh->GetNumberOfCells());
+      vtkTriangleStrip::DecomposeStrip(npts, pts, mesh);
+    }
+  }
+  auto inputCellId = [&](vtkIdType meshCellId) {
+    if (meshCellId < numPolys)
+    {
+      return firstPolyId + meshCellId;
+    }
+    const auto strip = std::upper_bound(stripStarts.begin(), stripStarts.end(), meshCellId) - 1;
+    return firstPolyId + numPolys + static_cast<vtkIdType>(strip - stripStarts.begin());
+  };
+
+  // Each edge of a mesh cell is identified by its position in the mesh
+  // connectivity, which orders the edges by cell, then by edge.
+  const vtkIdType numMeshCells = mesh->GetNumberOfCells();
+  const vtkIdType numEdges = mesh->GetNumberOfConnectivityIds();
+  std::vector<vtkIdType> meshOffsets(numMeshCells + 1);
+  vtkSMPTools::For(0, numMeshCells + 1, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      meshOffsets[cellId] = mesh->GetOffset(cellId);
+    }
+  });
+  std::vector<signed char> edgeTypes(numEdges, -1);
+  const bool classified = numEdges < VTK_INT_MAX && numPts < VTK_INT_MAX
+    ? ClassifyEdges<int>(this, mesh, inPts, meshOffsets, edgeTypes)
+    : ClassifyEdges<vtkIdType>(this, mesh, inPts, meshOffsets, edgeTypes);
+  if (!classified)
+  {
+    return false;
+  }
+  if (this->GetAbortOutput())
+  {
+    return true;
+  }
+  vtkDebugMacro(<< "Extracted edges with threads");
+  this->UpdateProgress(0.5);
+
+  // Lay out the output lines: the segments of the lines passed, then the
+  // extracted edges in the order of the mesh cells.
+  std::vector<vtkIdType> lineStarts(numLines + 1, 0);
+  for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+  {
+    lineStarts[lineId + 1] =
+      lineStarts[lineId] + std::max(lines->GetCellSize(lineId) - 1, static_cast<vtkIdType>(0));
+  }
+  std::vector<vtkIdType> cellStarts(numMeshCells + 1);
+  cellStarts[0] = lineStarts[numLines];
+  vtkSMPTools::For(0, numMeshCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellStarts[cellId + 1] = std::count_if(edgeTypes.begin() + meshOffsets[cellId],
+        edgeTypes.begin() + meshOffsets[cellId + 1], [](signed char type) { return type >= 0; });
+    }
+  });
+  std::partial_sum(cellStarts.begin(), cellStarts.end(), cellStarts.begin());
+  const vtkIdType numOutLines = cellStarts[numMeshCells];
+
+  // Produce the output lines with the input point ids, the cells they come
+  // from and their types.
+  vtkSMPThreadLocalObject<vtkIdList> cellPointIds;
+  vtkNew<vtkIdTypeArray> conn;
+  vtkIdType* outConn = conn->WritePointer(0, 2 * numOutLines);
+  std::vector<vtkIdType> sourceCells(numOutLines);
+  std::vector<signed char> outTypes(numOutLines);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType lineId, vtkIdType endLineId) {
+    vtkIdList* ptIdList = cellPointIds.Local();
+    const vtkIdType* pts = nullptr;
+    vtkIdType npts = 0;
+    for (; lineId < endLineId; ++lineId)
+    {
+      lines->GetCellAtId(lineId, npts, pts, ptIdList);
+      for (vtkIdType i = 0; i < npts - 1; ++i)
+      {
+        const vtkIdType lineEdgeId = lineStarts[lineId] + i;
+        outConn[2 * lineEdgeId] = pts[i];
+        outConn[2 * lineEdgeId + 1] = pts[i + 1];
+        sourceCells[lineEdgeId] = numVerts + lineId;
+        outTypes[lineEdgeId] = 4;
+      }
+    }
+  });
+  vtkSMPTools::For(0, numMeshCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* ptIdList = cellPointIds.Local();
+    const vtkIdType* pts = nullptr;
+    vtkIdType npts = 0;
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellStarts[cellId + 1] == cellStarts[cellId])
+      {
+        continue;
+      }
+      mesh->GetCellAtId(cellId, npts, pts, ptIdList);
+      vtkIdType lineEdgeId = cellStarts[cellId];
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        const signed char type = edgeTypes[meshOffsets[cellId] + i];
+        if (type >= 0)
+        {
+          outConn[2 * lineEdgeId] = pts[i];
+          outConn[2 * lineEdgeId + 1] = pts[(i + 1) % npts];
+          sourceCells[lineEdgeId] = inputCellId(cellId);
+          outTypes[lineEdgeId++] = type;
+        }
+      }
+    }
+  });
+  this->UpdateProgress(0.75);
+
+  // The first use of each point in the output lines. The serial locator
+  // copies the coordinates and attributes of the first point of a set of
+  // coincident points, and numbers the output points in the order of their
+  // first use.
+  const vtkIdType unused = VTK_ID_MAX;
+  std::vector<std::atomic<vtkIdType>> firstUse(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUse[ptId].store(unused, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, 2 * numOutLines, [&](vtkIdType position, vtkIdType endPosition) {
+    for (; position < endPosition; ++position)
+    {
+      std::atomic<vtkIdType>& use = firstUse[outConn[position]];
+      vtkIdType current = use.load(std::memory_order_relaxed);
+      while (position < current && !use.compare_exchange_weak(current, position))
+      {
+      }
+    }
+  });
+
+  // With a float output, points whose coordinates are not floats may be
+  // merged differently by vtkMergePoints, which compares them after the
+  // conversion, so the serial path is taken.
+  std::vector<vtkIdType> usedPts;
+  usedPts.reserve(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (firstUse[ptId].load(std::memory_order_relaxed) != unused)
+    {
+      usedPts.push_back(ptId);
+    }
+  }
+  const vtkIdType numUsedPts = static_cast<vtkIdType>(usedPts.size());
+  std::vector<double> usedx(3 * numPts);
+  std::atomic<bool> exact(true);
+  vtkSMPTools::For(0, numUsedPts, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      double* x = usedx.data() + 3 * usedPts[i];
+      inPts->GetPoint(usedPts[i], x);
+      for (int j = 0; j < 3; ++j)
+      {
+        if (!std::isfinite(x[j]) || (dataType == VTK_FLOAT && static_cast<float>(x[j]) != x[j]))
+        {
+          exact = false;
+        }
+      }
+    }
+  });
+  if (!exact)
+  {
+    return false;
+  }
+
+  // Sort the used points by coordinates, then by first use, so that the
+  // first point of each run of coincident points represents the run.
+  auto coincident = [&](vtkIdType ptId0, vtkIdType ptId1) {
+    const double* x0 = usedx.data() + 3 * ptId0;
+    const double* x1 = usedx.data() + 3 * ptId1;
+    return x0[0] == x1[0] && x0[1] == x1[1] && x0[2] == x1[2];
+  };
+  vtkSMPTools::Sort(usedPts.begin(), usedPts.end(), [&](vtkIdType ptId0, vtkIdType ptId1) {
+    const double* x0 = usedx.data() + 3 * ptId0;
+    const double* x1 = usedx.data() + 3 * ptId1;
+    for (int j = 0; j < 3; ++j)
+    {
+      if (x0[j] != x1[j])
+      {
+        return x0[j] < x1[j];
+      }
+    }
+    return firstUse[ptId0] < firstUse[ptId1];
+  });
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkSMPTools::For(0, numUsedPts, [&](vtkIdType i, vtkIdType end) {
+    vtkIdType first = i;
+    while (first > 0 && coincident(usedPts[first - 1], usedPts[first]))
+    {
+      --first;
+    }
+    for (; i < end; ++i)
+    {
+      if (i > first && !coincident(usedPts[i - 1], usedPts[i]))
+      {
+        first = i;
+      }
+      pointMap[usedPts[i]] = usedPts[first];
+    }
+  });
+
+  // Number the representative points in the order of their first use.
+  std::vector<vtkIdType> newToOld;
+  for (vtkIdType ptId : usedPts)
+  {
+    if (pointMap[ptId] == ptId)
+    {
+      newToOld.push_back(ptId);
+    }
+  }
+  vtkSMPTools::Sort(newToOld.begin(), newToOld.end(),
+    [&](vtkIdType ptId0, vtkIdType ptId1) { return firstUse[ptId0] < firstUse[ptId1]; });
+  const vtkIdType numNewPts = static_cast<vtkIdType>(newToOld.size());
+  std::vector<vtkIdType> newIds(numPts);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType newId, vtkIdType endNewId) {
+    for (; newId < endNewId; ++newId)
+    {
+      newIds[newToOld[newId]] = newId;
+    }
+  });
+  vtkSMPTools::For(0, 2 * numOutLines, [&](vtkIdType position, vtkIdType endPosition) {
+    for (; position < endPosition; ++position)
+    {
+      outConn[position] = newIds[pointMap[outConn[position]]];
+    }
+  });
+
+  // Copy the points, the lines and their attributes.
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(pd, numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, pd, outPD, /*nullValue*/ 0.0, /*promote*/ false);
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(dataType);
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType newId, vtkIdType endNewId) {
+    for (; newId < endNewId; ++newId)
+    {
+      newPts->SetPoint(newId, usedx.data() + 3 * newToOld[newId]);
+      pointArrays.Copy(newToOld[newId], newId);
+    }
+  });
+  output->SetPoints(newPts);
+
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkIdType* outOffsets = offsets->WritePointer(0, numOutLines + 1);
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(cd, numOutLines);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutLines, cd, outCD, /*nullValue*/ 0.0, /*promote*/ false);
+  vtkNew<vtkFloatArray> newScalars;
+  if (this->Coloring)
+  {
+    newScalars->SetName("Edge Types");
+    newScalars->SetNumberOfValues(numOutLines);
+  }
+  vtkSMPTools::For(0, numOutLines + 1, [&](vtkIdType lineEdgeId, vtkIdType endLineEdgeId) {
+    for (; lineEdgeId < endLineEdgeId; ++lineEdgeId)
+    {
+      outOffsets[lineEdgeId] = 2 * lineEdgeId;
+      if (lineEdgeId == numOutLines)
+      {
+        break;
+      }
+      cellArrays.Copy(sourceCells[lineEdgeId], lineEdgeId);
+      if (this->Coloring)
+      {
+        newScalars->SetValue(lineEdgeId, EDGE_TYPE_SCALARS[outTypes[lineEdgeId]]);
+      }
+    }
+  });
+  vtkNew<vtkCellArray> newLines;
+  newLines->SetData(offsets, conn);
+  output->SetLines(newLines);
+  if (this->Coloring)
+  {
+    int idx = outCD->AddArray(newScalars);
+    outCD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+  }
+
+  vtkDebugMacro(<< "Created " << numOutLines << " lines.");
+  return true;
+}
+
 //------------------------------------------------------------------------------
 void vtkFeatureEdges::CreateDefaultLocator()
 {
@@ -633,5 +1165,6 @@ void vtkFeatureEdges::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -27,13 +27,24 @@
  * based on edge type. The cell coloring is assigned to the cell data of
  * the extracted edges.
  *
+ * The edges are classified with vtkSMPTools: the edges of all the polygons
+ * are sorted with vtkStaticEdgeLocatorTemplate to group the polygons using
+ * each edge, and the output points are merged with a parallel sort of their
+ * coordinates, so that the output matches the serial traversal. The serial
+ * traversal is still used for input with ghost cells, when a locator is
+ * specified, for degenerate polygons using a point twice, and when
+ * SequentialProcessing is on. Unlike the
+ * threaded path, it also counts a polygon among the neighbors of an edge
+ * when the edge is one of its diagonals, which only happens with
+ * non-conforming polygons.
+ *
  * @warning
  * To see the coloring of the lines you may have to set the ScalarMode
  * instance variable of the mapper to SetScalarModeToUseCellData(). (This
  * is only a problem if there are point data scalars.)
  *
  * @sa
- * vtkExtractEdges
+ * vtkExtractEdges vtkStaticEdgeLocatorTemplate
  */
 
 #ifndef vtkFeatureEdges_h
@@ -156,7 +167,8 @@ public:
   ///@{
   /**
    * Set / get a spatial locator for merging points. By
-   * default an instance of vtkMergePoints is used.
+   * default an instance of vtkMergePoints is used, which is created by the
+   * serial traversal and released at its end.
    */
   void SetLocator(vtkIncrementalPointLocator* locator);
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
@@ -182,6 +194,17 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the edges. By
+   * default, sequential processing is off. The output is the same either
+   * way. This flag is typically used for benchmarking and testing purposes.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkFeatureEdges();
   ~vtkFeatureEdges() override;
@@ -190,6 +213,13 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Extract the edges with threads when the input has no ghost cells, no
+   * locator is specified and SequentialProcessing is off. Return false without modifying the output when
+   * the serial path must be taken.
+   */
+  bool ThreadedExtract(vtkPolyData* input, vtkPolyData* output);
+
   double FeatureAngle;
   bool BoundaryEdges;
   bool FeatureEdges;
@@ -200,6 +230,7 @@ protected:
   bool PassGlobalIds;
   bool RemoveGhostInterfaces;
   int OutputPointsPrecision;
+  bool SequentialProcessing;
   vtkIncrementalPointLocator* Locator;
 
 private:
@@ -14,18 +14,27 @@
 =========================================================================*/
 #include "vtkGlyph3D.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -33,10 +42,31 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
+namespace
+{
+// Make the default source, the line from (0,0,0) to (1,0,0).
+void MakeDefaultSource(vtkPolyData* defaultSource)
+{
+  defaultSource->AllocateExact(0, 0, 1, 2, 0, 0, 0, 0);
+  vtkNew<vtkPoints> defaultPoints;
+  defaultPoints->Allocate(6);
+  defaultPoints->InsertNextPoint(0, 0, 0);
+  defaultPoints->InsertNextPoint(1, 0, 0);
+  vtkIdType defaultPointIds[2];
+  defaultPointIds[0] = 0;
+  defaultPointIds[1] = 1;
+  defaultSource->SetPoints(defaultPoints);
+  defaultSource->InsertNextCell(VTK_LINE, 2, defaultPointIds);
+}
+}
+
 //------------------------------------------------------------------------------
 // Construct object with scaling on, scaling mode is by scalar value,
 // scale factor = 1.0, the range is (0,1), orient geometry is on, and
@@ -63,9 +93,12 @@ vtkGlyph3D::vtkGlyph3D()
   this->PointIdsName = nullptr;
   this->SetPointIdsName("InputPointIds");
   this->SetNumberOfInputPorts(2);
+  this->SetNumberOfOutputPorts(2);
   this->FillCellData = 0;
+  this->InstancedOutput = 0;
   this->SourceTransform = nullptr;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(
@@ -108,8 +141,46 @@ int vtkGlyph3D::RequestData(vtkInformation* vtkNotUsed(request), vtkInformationV
   // get the info objects
   vtkDataSet* input = vtkDataSet::GetData(inputVector[0], 0);
   vtkPolyData* output = vtkPolyData::GetData(outputVector, 0);
+  vtkMultiBlockDataSet* prototypes = vtkMultiBlockDataSet::GetData(outputVector, 1);
 
-  return this->Execute(input, inputVector[1], output) ? 1 : 0;
+  if (!this->Execute(input, inputVector[1], output))
+  {
+    return 0;
+  }
+
+  // The prototypes of the instances, untransformed: the sources when
+  // indexing, otherwise the source or the default line.
+  if (prototypes && this->InstancedOutput)
+  {
+    if (this->IndexMode != VTK_INDEXING_OFF)
+    {
+      const int numberOfSources = this->GetNumberOfInputConnections(1);
+      prototypes->SetNumberOfBlocks(numberOfSources);
+      for (int i = 0; i < numberOfSources; ++i)
+      {
+        if (vtkPolyData* source = this->GetSource(i, inputVector[1]))
+        {
+          vtkNew<vtkPolyData> prototype;
+          prototype->ShallowCopy(source);
+          prototypes->SetBlock(i, prototype);
+        }
+      }
+    }
+    else
+    {
+      vtkNew<vtkPolyData> prototype;
+      if (vtkPolyData* source = this->GetSource(0, inputVector[1]))
+      {
+        prototype->ShallowCopy(source);
+      }
+      else
+      {
+        MakeDefaultSource(prototype);
+      }
+      prototypes->SetBlock(0, prototype);
+    }
+  }
+  return 1;
 }
 
 //------------------------------------------------------------------------------
@@ -248,19 +319,30 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   if (source == nullptr)
   {
     vtkNew<vtkPolyData> defaultSource;
-    defaultSource->AllocateExact(0, 0, 1, 2, 0, 0, 0, 0);
-    vtkNew<vtkPoints> defaultPoints;
-    defaultPoints->Allocate(6);
-    defaultPoints->InsertNextPoint(0, 0, 0);
-    defaultPoints->InsertNextPoint(1, 0, 0);
-    vtkIdType defaultPointIds[2];
-    defaultPointIds[0] = 0;
-    defaultPointIds[1] = 1;
-    defaultSource->SetPoints(defaultPoints);
-    defaultSource->InsertNextCell(VTK_LINE, 2, defaultPointIds);
+    MakeDefaultSource(defaultSource);
     source = defaultSource;
   }
 
+  if (haveVectors && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION)
+  {
+    vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+      pts->Delete();
+      trans->Delete();
+      return false;
+    }
+  }
+
+  if (this->ThreadedExecute(input, sourceVector, source, output, inSScalars, inVectors, inNormals,
+        inCScalars, inGhostLevels, den, haveVectors != 0))
+  {
+    pts->Delete();
+    trans->Delete();
+    return true;
+  }
+
   if (this->IndexMode != VTK_INDEXING_OFF)
   {
     pd = nullptr;
@@ -434,28 +516,17 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     {
       if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
       {
-        vMag = 1.0; // v will be set later
+        // v = glyphNormal_World (glyph normal direction in World coordinate system)
+        input->GetPoint(inPtId, x);
+        v[0] = this->FollowedCameraPosition[0] - x[0];
+        v[1] = this->FollowedCameraPosition[1] - x[1];
+        v[2] = this->FollowedCameraPosition[2] - x[2];
+        vtkMath::Normalize(v);
+        vMag = 1.0;
       }
       else
       {
         vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-        if (array3D->GetNumberOfComponents() > 3)
-        {
-          vtkErrorMacro(<< "vtkDataArray " << array3D->GetName()
-                        << " has more than 3 components.\n");
-          pts->Delete();
-          trans->Delete();
-          if (newPts)
-          {
-            newPts->Delete();
-          }
-          if (newVectors)
-          {
-            newVectors->Delete();
-          }
-          return false;
-        }
-
         v[0] = 0;
         v[1] = 0;
         v[2] = 0;
@@ -571,11 +642,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
       {
         if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
         {
-          // v = glyphNormal_World (glyph normal direction in World coordinate system)
-          v[0] = this->FollowedCameraPosition[0] - x[0];
-          v[1] = this->FollowedCameraPosition[1] - x[1];
-          v[2] = this->FollowedCameraPosition[2] - x[2];
-          vtkMath::Normalize(v);
           double glyphRight_World[3]; // glyph right direction in World coordinate system
           vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
           // glyph up direction in World coordinate system
@@ -758,6 +824,626 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   return true;
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// A source of glyphs, with its points transformed by the SourceTransform.
+struct GlyphSource
+{
+  vtkPolyData* Source = nullptr;
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells = 0;
+  std::vector<double> Points;
+  std::vector<double> Normals;
+  std::vector<double> TCoords;
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Connectivity;
+};
+
+// Apply the matrix of a glyph to the source points, as
+// vtkLinearTransform::TransformPoints() does.
+template <typename T>
+void TransformGlyphPoints(double matrix[4][4], const double* in, T* out, vtkIdType n)
+{
+  for (vtkIdType i = 0; i < n; ++i, in += 3, out += 3)
+  {
+    out[0] = static_cast<T>(
+      matrix[0][0] * in[0] + matrix[0][1] * in[1] + matrix[0][2] * in[2] + matrix[0][3]);
+    out[1] = static_cast<T>(
+      matrix[1][0] * in[0] + matrix[1][1] * in[1] + matrix[1][2] * in[2] + matrix[1][3]);
+    out[2] = static_cast<T>(
+      matrix[2][0] * in[0] + matrix[2][1] * in[1] + matrix[2][2] * in[2] + matrix[2][3]);
+  }
+}
+
+// Apply the transposed inverse matrix of a glyph to the source normals, as
+// vtkLinearTransform::TransformNormals() does.
+void TransformGlyphNormals(double matrix[4][4], const double* in, float* out, vtkIdType n)
+{
+  for (vtkIdType i = 0; i < n; ++i, in += 3, out += 3)
+  {
+    out[0] = static_cast<float>(matrix[0][0] * in[0] + matrix[0][1] * in[1] + matrix[0][2] * in[2]);
+    out[1] = static_cast<float>(matrix[1][0] * in[0] + matrix[1][1] * in[1] + matrix[1][2] * in[2]);
+    out[2] = static_cast<float>(matrix[2][0] * in[0] + matrix[2][1] * in[1] + matrix[2][2] * in[2]);
+    vtkMath::Normalize(out);
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkGlyph3D::ThreadedExecute(vtkDataSet* input, vtkInformationVector* sourceVector,
+  vtkPolyData* source, vtkPolyData* output, vtkDataArray* inSScalars, vtkDataArray* inVectors,
+  vtkDataArray* inNormals, vtkDataArray* inCScalars, unsigned char* inGhostLevels, double den,
+  bool haveVectors)
+{
+  const bool instances = this->InstancedOutput != 0;
+  if (this->SequentialProcessing && !instances)
+  {
+    return false;
+  }
+  const bool indexing = this->IndexMode != VTK_INDEXING_OFF;
+  // As in the serial path, the point data is not copied when indexing.
+  vtkPointData* pd = indexing ? nullptr : input->GetPointData();
+  // The glyph attributes are copied with ArrayList.
+  if (pd && !instances && !CanUseArrayList(pd))
+  {
+    return false;
+  }
+
+  // The sources are gathered once. Their cells must all go to the same cell
+  // array of the output, so that the cell ids are those of the serial path.
+  const int numberOfSources = indexing ? this->GetNumberOfInputConnections(1) : 1;
+  std::vector<GlyphSource> sources(numberOfSources);
+  int cellsType = -1;
+  bool haveNormals = indexing;
+  bool haveTCoords = false;
+  int numTCoordsComps = 0;
+  for (int index = 0; index < numberOfSources; ++index)
+  {
+    GlyphSource& glyphSource = sources[index];
+    glyphSource.Source = indexing ? this->GetSource(index, sourceVector) : source;
+    if (!glyphSource.Source || instances)
+    {
+      continue;
+    }
+    vtkPoints* sourcePts = glyphSource.Source->GetPoints();
+    vtkDataArray* sourceNormals = glyphSource.Source->GetPointData()->GetNormals();
+    vtkDataArray* sourceTCoords = glyphSource.Source->GetPointData()->GetTCoords();
+    if (indexing)
+    {
+      haveNormals = haveNormals && sourceNormals;
+    }
+    else
+    {
+      haveNormals = sourceNormals != nullptr;
+      haveTCoords = sourceTCoords != nullptr;
+    }
+    if (sourceNormals && sourceNormals->GetDataType() != VTK_FLOAT &&
+      sourceNormals->GetDataType() != VTK_DOUBLE)
+    {
+      return false;
+    }
+
+    vtkCellArray* sourceCells[4] = { glyphSource.Source->GetVerts(),
+      glyphSource.Source->GetLines(), glyphSource.Source->GetPolys(),
+      glyphSource.Source->GetStrips() };
+    for (int type = 0; type < 4; ++type)
+    {
+      if (sourceCells[type]->GetNumberOfCells() == 0)
+      {
+        continue;
+      }
+      if (cellsType >= 0 && cellsType != type)
+      {
+        return false;
+      }
+      cellsType = type;
+      glyphSource.NumberOfCells = sourceCells[type]->GetNumberOfCells();
+      glyphSource.Offsets.push_back(0);
+      auto iter = vtk::TakeSmartPointer(sourceCells[type]->NewIterator());
+      for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+      {
+        vtkIdType npts;
+        const vtkIdType* ptIds;
+        iter->GetCurrentCell(npts, ptIds);
+        glyphSource.Connectivity.insert(glyphSource.Connectivity.end(), ptIds, ptIds + npts);
+        glyphSource.Offsets.push_back(static_cast<vtkIdType>(glyphSource.Connectivity.size()));
+      }
+    }
+
+    glyphSource.NumberOfPoints = sourcePts ? sourcePts->GetNumberOfPoints() : 0;
+    if (glyphSource.NumberOfPoints == 0)
+    {
+      continue;
+    }
+    vtkSmartPointer<vtkPoints> points = sourcePts;
+    if (this->SourceTransform)
+    {
+      points = vtkSmartPointer<vtkPoints>::New();
+      points->SetDataTypeToDouble();
+      this->SourceTransform->TransformPoints(sourcePts, points);
+    }
+    glyphSource.Points.resize(3 * glyphSource.NumberOfPoints);
+    for (vtkIdType i = 0; i < glyphSource.NumberOfPoints; ++i)
+    {
+      points->GetPoint(i, &glyphSource.Points[3 * i]);
+    }
+    if (sourceNormals)
+    {
+      glyphSource.Normals.resize(3 * glyphSource.NumberOfPoints);
+      for (vtkIdType i = 0; i < glyphSource.NumberOfPoints; ++i)
+      {
+        sourceNormals->GetTuple(i, &glyphSource.Normals[3 * i]);
+      }
+    }
+    if (haveTCoords)
+    {
+      numTCoordsComps = sourceTCoords->GetNumberOfComponents();
+      glyphSource.TCoords.resize(numTCoordsComps * glyphSource.NumberOfPoints);
+      for (vtkIdType i = 0; i < glyphSource.NumberOfPoints; ++i)
+      {
+        sourceTCoords->GetTuple(i, &glyphSource.TCoords[numTCoordsComps * i]);
+      }
+    }
+  }
+
+  // The scale factors, the vector and its magnitude at an input point, before
+  // scaling, as in the serial path.
+  vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+  auto getGlyphValues = [&](vtkIdType inPtId, const double x[3], double& s, double v[3],
+                          double& vMag, double scale[3]) {
+    s = vMag = 0.0;
+    scale[0] = scale[1] = scale[2] = 1.0;
+    if (inSScalars)
+    {
+      s = inSScalars->GetComponent(inPtId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = s;
+      }
+    }
+    if (haveVectors)
+    {
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        for (int j = 0; j < 3; ++j)
+        {
+          v[j] = this->FollowedCameraPosition[j] - x[j];
+        }
+        vtkMath::Normalize(v);
+        vMag = 1.0;
+      }
+      else
+      {
+        v[0] = v[1] = v[2] = 0.0;
+        array3D->GetTuple(inPtId, v);
+        vMag = vtkMath::Norm(v);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+          scale[0] = v[0];
+          scale[1] = v[1];
+          scale[2] = v[2];
+        }
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+          scale[0] = scale[1] = scale[2] = vMag;
+        }
+      }
+    }
+    if (this->Clamping)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        scale[j] = (scale[j] < this->Range[0]
+            ? this->Range[0]
+            : (scale[j] > this->Range[1] ? this->Range[1] : scale[j]));
+        scale[j] = (scale[j] - this->Range[0]) / den;
+      }
+    }
+  };
+
+  // The transform of a glyph, built with the same operations as in the serial
+  // path so that its matrix is the same.
+  auto placeGlyph = [&](vtkTransform* trans, const double x[3], const double v[3], double vMag,
+                      const double glyphScale[3]) {
+    trans->Identity();
+    trans->Translate(x[0], x[1], x[2]);
+    if (haveVectors && this->Orient)
+    {
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        double glyphRight_World[3];
+        vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
+        double glyphUp_World[3];
+        vtkMath::Cross(v, glyphRight_World, glyphUp_World);
+        double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
+          glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
+          v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
+        trans->Concatenate(glyphToWorld);
+      }
+      else if (vMag > 0.0)
+      {
+        if (v[1] == 0.0 && v[2] == 0.0)
+        {
+          if (v[0] < 0)
+          {
+            trans->RotateWXYZ(180.0, 0, 1, 0);
+          }
+        }
+        else
+        {
+          trans->RotateWXYZ(180.0, (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0);
+        }
+      }
+    }
+    if (this->Scaling)
+    {
+      double scale[3];
+      for (int j = 0; j < 3; ++j)
+      {
+        scale[j] = this->ScaleMode == VTK_DATA_SCALING_OFF ? this->ScaleFactor
+                                                           : glyphScale[j] * this->ScaleFactor;
+        if (scale[j] == 0.0)
+        {
+          scale[j] = 1.0e-10;
+        }
+      }
+      trans->Scale(scale[0], scale[1], scale[2]);
+    }
+  };
+
+  // Select the glyphed points and their sources from a single thread, since
+  // IsPointVisible() may not be thread-safe.
+  vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  std::vector<vtkIdType> glyphPoints;
+  std::vector<int> glyphSources;
+  for (vtkIdType inPtId = 0; inPtId < numPts; ++inPtId)
+  {
+    int index = 0;
+    if (indexing)
+    {
+      double x[3], v[3], s, vMag, scale[3];
+      input->GetPoint(inPtId, x);
+      getGlyphValues(inPtId, x, s, v, vMag, scale);
+      const double value = this->IndexMode == VTK_INDEXING_BY_SCALAR ? s : vMag;
+      index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
+      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+    }
+    if (!sources[index].Source ||
+      (inGhostLevels &&
+        inGhostLevels[inPtId] &
+          (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT)) ||
+      (inputUG && !inputUG->IsPointVisible(inPtId)) || !this->IsPointVisible(input, inPtId))
+    {
+      continue;
+    }
+    glyphPoints.push_back(inPtId);
+    glyphSources.push_back(index);
+  }
+  const vtkIdType numGlyphs = static_cast<vtkIdType>(glyphPoints.size());
+
+  // Prefix sums over the glyphs give where their points, cells and cell
+  // connectivity go in the output. An instance is a single vertex.
+  std::vector<vtkIdType> pointStarts(numGlyphs + 1, 0);
+  std::vector<vtkIdType> cellStarts(numGlyphs + 1, 0);
+  std::vector<vtkIdType> connStarts(numGlyphs + 1, 0);
+  for (vtkIdType glyph = 0; glyph < numGlyphs; ++glyph)
+  {
+    const GlyphSource& glyphSource = sources[glyphSources[glyph]];
+    pointStarts[glyph + 1] = pointStarts[glyph] + (instances ? 1 : glyphSource.NumberOfPoints);
+    cellStarts[glyph + 1] = cellStarts[glyph] + (instances ? 1 : glyphSource.NumberOfCells);
+    connStarts[glyph + 1] = connStarts[glyph] +
+      (instances ? 1 : static_cast<vtkIdType>(glyphSource.Connectivity.size()));
+  }
+  const vtkIdType numNewPts = pointStarts[numGlyphs];
+  const vtkIdType numNewCells = cellStarts[numGlyphs];
+  if (instances)
+  {
+    cellsType = 0;
+  }
+
+  // Allocate the output arrays, in the same way as the serial path.
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+  ArrayList pointArrays;
+  ArrayList cellArrays;
+  vtkNew<vtkIdList> glyphPointIds;
+  if (pd)
+  {
+    outputPD->CopyAllocate(pd, numNewPts);
+    if (this->FillCellData)
+    {
+      outputCD->CopyGlobalIdsOn();
+      outputCD->CopyAllocate(pd, numNewCells);
+    }
+    if (instances)
+    {
+      // The attributes of the instances are copied at once, whatever their
+      // arrays.
+      glyphPointIds->SetNumberOfIds(numGlyphs);
+      std::copy(glyphPoints.begin(), glyphPoints.end(), glyphPointIds->begin());
+      outputPD->CopyData(pd, glyphPointIds);
+      if (this->FillCellData)
+      {
+        outputCD->CopyData(pd, glyphPointIds);
+      }
+    }
+    else
+    {
+      pointArrays.AddArrays(numNewPts, pd, outputPD, /*nullValue*/ 0.0, /*promote*/ false);
+      if (this->FillCellData)
+      {
+        cellArrays.AddArrays(numNewCells, pd, outputCD, /*nullValue*/ 0.0, /*promote*/ false);
+      }
+    }
+  }
+
+  vtkNew<vtkPoints> newPts;
+  if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+  else
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkSmartPointer<vtkIdTypeArray> pointIds;
+  if (this->GeneratePointIds)
+  {
+    pointIds = vtkSmartPointer<vtkIdTypeArray>::New();
+    pointIds->SetName(this->PointIdsName);
+    pointIds->SetNumberOfValues(numNewPts);
+  }
+  ArrayList colorArrays;
+  vtkSmartPointer<vtkDataArray> newScalars;
+  vtkFloatArray* floatScalars = nullptr;
+  if (this->ColorMode == VTK_COLOR_BY_SCALAR && inCScalars)
+  {
+    vtkStdString name = inCScalars->GetName() ? inCScalars->GetName() : "";
+    newScalars = vtkDataArray::SafeDownCast(colorArrays.AddArrayPair(
+      numNewPts, inCScalars, name, /*nullValue*/ 0.0, /*promote*/ false));
+    newScalars->SetName(inCScalars->GetName());
+  }
+  else if ((this->ColorMode == VTK_COLOR_BY_SCALE && inSScalars) ||
+    (this->ColorMode == VTK_COLOR_BY_VECTOR && haveVectors))
+  {
+    floatScalars = vtkFloatArray::New();
+    newScalars.TakeReference(floatScalars);
+    floatScalars->SetNumberOfValues(numNewPts);
+    if (this->ColorMode == VTK_COLOR_BY_VECTOR)
+    {
+      floatScalars->SetName("VectorMagnitude");
+    }
+    else
+    {
+      floatScalars->SetName(
+        this->ScaleMode == VTK_SCALE_BY_SCALAR ? inSScalars->GetName() : "GlyphScale");
+    }
+  }
+  vtkSmartPointer<vtkFloatArray> newVectors;
+  if (haveVectors)
+  {
+    newVectors = vtkSmartPointer<vtkFloatArray>::New();
+    newVectors->SetNumberOfComponents(3);
+    newVectors->SetNumberOfTuples(numNewPts);
+    newVectors->SetName("GlyphVector");
+  }
+  vtkSmartPointer<vtkFloatArray> newNormals;
+  vtkSmartPointer<vtkFloatArray> newTCoords;
+  vtkSmartPointer<vtkDoubleArray> glyphTransforms;
+  vtkSmartPointer<vtkIntArray> glyphSourceIndices;
+  if (instances)
+  {
+    glyphTransforms = vtkSmartPointer<vtkDoubleArray>::New();
+    glyphTransforms->SetNumberOfComponents(16);
+    glyphTransforms->SetNumberOfTuples(numNewPts);
+    glyphTransforms->SetName("GlyphTransform");
+    if (indexing)
+    {
+      glyphSourceIndices = vtkSmartPointer<vtkIntArray>::New();
+      glyphSourceIndices->SetNumberOfValues(numNewPts);
+      glyphSourceIndices->SetName("GlyphSourceIndex");
+    }
+  }
+  else
+  {
+    if (haveNormals)
+    {
+      newNormals = vtkSmartPointer<vtkFloatArray>::New();
+      newNormals->SetNumberOfComponents(3);
+      newNormals->SetNumberOfTuples(numNewPts);
+      newNormals->SetName("Normals");
+    }
+    if (haveTCoords)
+    {
+      newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+      newTCoords->SetNumberOfComponents(numTCoordsComps);
+      newTCoords->SetNumberOfTuples(numNewPts);
+      newTCoords->SetName("TCoords");
+    }
+  }
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numNewCells + 1);
+  offsets->SetValue(numNewCells, connStarts[numGlyphs]);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(connStarts[numGlyphs]);
+  vtkIdType* outOffsets = offsets->GetPointer(0);
+  vtkIdType* outConn = conn->GetPointer(0);
+  vtkNew<vtkMatrix4x4> sourceMatrix;
+  if (instances && this->SourceTransform)
+  {
+    sourceMatrix->DeepCopy(this->SourceTransform->GetMatrix());
+  }
+
+  // Each glyph transforms the points and normals of its source with its
+  // matrix, and copies the attributes of its input point.
+  vtkSMPThreadLocalObject<vtkTransform> transforms;
+  vtkSMPTools::For(0, numGlyphs, [&](vtkIdType glyph, vtkIdType endGlyph) {
+    vtkTransform* trans = transforms.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endGlyph - glyph) / 10 + 1, (vtkIdType)1000);
+    double x[3], v[3], s, vMag, scale[3];
+    double normalMatrix[4][4];
+    for (; glyph < endGlyph; ++glyph)
+    {
+      if (glyph % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      const vtkIdType inPtId = glyphPoints[glyph];
+      const GlyphSource& glyphSource = sources[glyphSources[glyph]];
+      const vtkIdType ptStart = pointStarts[glyph];
+      const vtkIdType numGlyphPts = pointStarts[glyph + 1] - ptStart;
+      input->GetPoint(inPtId, x);
+      getGlyphValues(inPtId, x, s, v, vMag, scale);
+      placeGlyph(trans, x, v, vMag, scale);
+
+      if (instances)
+      {
+        newPts->SetPoint(ptStart, x);
+        if (this->SourceTransform)
+        {
+          trans->Concatenate(sourceMatrix);
+        }
+        std::copy(*trans->GetMatrix()->Element, *trans->GetMatrix()->Element + 16,
+          glyphTransforms->GetPointer(16 * ptStart));
+        if (glyphSourceIndices)
+        {
+          glyphSourceIndices->SetValue(ptStart, glyphSources[glyph]);
+        }
+      }
+      else
+      {
+        double(*matrix)[4] = trans->GetMatrix()->Element;
+        if (newPts->GetDataType() == VTK_DOUBLE)
+        {
+          TransformGlyphPoints(matrix, glyphSource.Points.data(),
+            static_cast<double*>(newPts->GetData()->GetVoidPointer(3 * ptStart)), numGlyphPts);
+        }
+        else
+        {
+          TransformGlyphPoints(matrix, glyphSource.Points.data(),
+            static_cast<float*>(newPts->GetData()->GetVoidPointer(3 * ptStart)), numGlyphPts);
+        }
+        if (newNormals)
+        {
+          vtkMatrix4x4::DeepCopy(*normalMatrix, trans->GetMatrix());
+          vtkMatrix4x4::Invert(*normalMatrix, *normalMatrix);
+          vtkMatrix4x4::Transpose(*normalMatrix, *normalMatrix);
+          TransformGlyphNormals(normalMatrix, glyphSource.Normals.data(),
+            newNormals->GetPointer(3 * ptStart), numGlyphPts);
+        }
+        if (newTCoords)
+        {
+          std::copy(glyphSource.TCoords.begin(), glyphSource.TCoords.end(),
+            newTCoords->GetPointer(numTCoordsComps * ptStart));
+        }
+        const vtkIdType cellStart = cellStarts[glyph];
+        const vtkIdType connStart = connStarts[glyph];
+        for (vtkIdType i = 0; i < glyphSource.NumberOfCells; ++i)
+        {
+          outOffsets[cellStart + i] = connStart + glyphSource.Offsets[i];
+        }
+        for (size_t i = 0; i < glyphSource.Connectivity.size(); ++i)
+        {
+          outConn[connStart + i] = ptStart + glyphSource.Connectivity[i];
+        }
+        for (vtkIdType i = 0; i < glyphSource.NumberOfCells; ++i)
+        {
+          cellArrays.Copy(inPtId, cellStart + i);
+        }
+      }
+
+      for (vtkIdType i = ptStart; i < ptStart + numGlyphPts; ++i)
+      {
+        if (!instances)
+        {
+          pointArrays.Copy(inPtId, i);
+        }
+        colorArrays.Copy(inPtId, i);
+        if (floatScalars)
+        {
+          floatScalars->SetValue(
+            i, static_cast<float>(this->ColorMode == VTK_COLOR_BY_VECTOR ? vMag : scale[0]));
+        }
+        if (newVectors)
+        {
+          newVectors->SetTuple(i, v);
+        }
+        if (pointIds)
+        {
+          pointIds->SetValue(i, inPtId);
+        }
+      }
+    }
+  });
+
+  if (instances)
+  {
+    for (vtkIdType i = 0; i < numNewCells; ++i)
+    {
+      outOffsets[i] = outConn[i] = i;
+    }
+  }
+  output->SetPoints(newPts);
+  vtkNew<vtkCellArray> newCells;
+  newCells->SetData(offsets, conn);
+  switch (cellsType)
+  {
+    case 0:
+      output->SetVerts(newCells);
+      break;
+    case 1:
+      output->SetLines(newCells);
+      break;
+    case 2:
+      output->SetPolys(newCells);
+      break;
+    case 3:
+      output->SetStrips(newCells);
+      break;
+  }
+  if (pointIds)
+  {
+    outputPD->AddArray(pointIds);
+  }
+  if (newScalars)
+  {
+    int idx = outputPD->AddArray(newScalars);
+    outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+  }
+  if (newVectors)
+  {
+    outputPD->SetVectors(newVectors);
+  }
+  if (newNormals)
+  {
+    outputPD->SetNormals(newNormals);
+  }
+  if (newTCoords)
+  {
+    outputPD->SetTCoords(newTCoords);
+  }
+  if (glyphTransforms)
+  {
+    outputPD->AddArray(glyphTransforms);
+  }
+  if (glyphSourceIndices)
+  {
+    outputPD->AddArray(glyphSourceIndices);
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // Specify a source object at a specified table location.
 void vtkGlyph3D::SetSourceConnection(int id, vtkAlgorithmOutput* algOutput)
@@ -905,6 +1591,8 @@ void vtkGlyph3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Fill Cell Data: " << (this->FillCellData ? "On\n" : "Off\n");
+  os << indent << "Instanced Output: " << (this->InstancedOutput ? "On\n" : "Off\n");
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 
   os << indent << "SourceTransform: ";
   if (this->SourceTransform)
@@ -954,6 +1642,23 @@ vtkPolyData* vtkGlyph3D::GetSource(int idx, vtkInformationVector* sourceInfo)
   return vtkPolyData::SafeDownCast(info->Get(vtkDataObject::DATA_OBJECT()));
 }
 
+//------------------------------------------------------------------------------
+vtkMultiBlockDataSet* vtkGlyph3D::GetPrototypesOutput()
+{
+  return vtkMultiBlockDataSet::SafeDownCast(this->GetOutputDataObject(1));
+}
+
+//------------------------------------------------------------------------------
+int vtkGlyph3D::FillOutputPortInformation(int port, vtkInformation* info)
+{
+  if (port == 1)
+  {
+    info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkMultiBlockDataSet");
+    return 1;
+  }
+  return this->Superclass::FillOutputPortInformation(port, info);
+}
+
 //------------------------------------------------------------------------------
 int vtkGlyph3D::FillInputPortInformation(int port, vtkInformation* info)
 {
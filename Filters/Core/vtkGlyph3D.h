@@ -73,6 +73,20 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * The glyphs are generated with threads: the output points and cells are
+ * laid out with prefix sums over the glyphed points, and each glyph is
+ * transformed by applying its matrix to the source points. The output is the
+ * same as the one of the serial generation, which is used when
+ * SequentialProcessing is on, when the input point data has string or bit
+ * arrays, when the sources have cells of types stored in different cell
+ * arrays of vtkPolyData, or when their normals are neither float nor double.
+ *
+ * @warning
+ * With InstancedOutput on, the output is a table of instances rather than
+ * the glyph geometry, see SetInstancedOutput(). The prototypes of the
+ * instances are then given by the second output, see GetPrototypesOutput().
+ *
  * @sa
  * vtkTensorGlyph
  */
@@ -102,6 +116,7 @@
 #define VTK_INDEXING_BY_VECTOR 2
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkMultiBlockDataSet;
 class vtkTransform;
 
 class VTKFILTERSCORE_EXPORT vtkGlyph3D : public vtkPolyDataAlgorithm
@@ -302,6 +317,43 @@ public:
   vtkBooleanMacro(FillCellData, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Enable/disable the generation of a table of instances instead of the
+   * glyph geometry. When on, the output has a vertex per glyph, located at
+   * the glyphed input point, and the point data holds a 16-component
+   * "GlyphTransform" double array with the row-major 4x4 matrix placing the
+   * source at the glyph, SourceTransform included. It also holds the scalars,
+   * "GlyphVector" array, point ids and input point data that the glyph points
+   * would get, and, when indexing, a "GlyphSourceIndex" array with the index
+   * of the source of each glyph in the table. The sources are the prototypes
+   * of the instances, and are passed in the second output (see
+   * GetPrototypesOutput()); the default prototype, used when no source is
+   * given, is the line from (0,0,0) to (1,0,0). Such an output is much
+   * smaller than the glyphs for large inputs, and lets consumers draw or
+   * write instances. Off by default.
+   */
+  vtkSetMacro(InstancedOutput, vtkTypeBool);
+  vtkGetMacro(InstancedOutput, vtkTypeBool);
+  vtkBooleanMacro(InstancedOutput, vtkTypeBool);
+  ///@}
+
+  /**
+   * Return the prototypes of the table of instances generated with
+   * InstancedOutput on. It is a vtkMultiBlockDataSet whose block i is the
+   * source i when indexing, matching the "GlyphSourceIndex" array, and whose
+   * only block is the source, or the default prototype, otherwise. The
+   * prototypes are not transformed by SourceTransform, which the
+   * "GlyphTransform" matrices include. The multiblock is empty when
+   * InstancedOutput is off.
+   */
+  vtkMultiBlockDataSet* GetPrototypesOutput();
+
+  /**
+   * Return the output port (a vtkAlgorithmOutput) of the prototypes.
+   */
+  vtkAlgorithmOutput* GetPrototypesOutputPort() { return this->GetOutputPort(1); }
+
   /**
    * This can be overwritten by subclass to return 0 when a point is
    * blanked. Default implementation is to always return 1;
@@ -333,6 +385,19 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the glyphs. By
+   * default, sequential processing is off. The output is the same either
+   * way, and the table of instances generated with InstancedOutput on is
+   * not affected. This flag is typically used for benchmarking and testing
+   * purposes.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkGlyph3D();
   ~vtkGlyph3D() override;
@@ -340,6 +405,7 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int, vtkInformation*) override;
+  int FillOutputPortInformation(int, vtkInformation*) override;
 
   vtkPolyData* GetSource(int idx, vtkInformationVector* sourceInfo);
 
@@ -354,6 +420,19 @@ protected:
     vtkDataArray* inSScalars, vtkDataArray* inVectors);
   ///@}
 
+  /**
+   * Glyph the input with threads, or generate the table of instances when
+   * InstancedOutput is on, from the arrays and the source prepared by
+   * Execute(). IsPointVisible() is called from a single thread. Return false,
+   * leaving the output untouched, when the glyphs must be generated serially
+   * (see the class documentation); the table of instances is always
+   * generated.
+   */
+  bool ThreadedExecute(vtkDataSet* input, vtkInformationVector* sourceVector, vtkPolyData* source,
+    vtkPolyData* output, vtkDataArray* inSScalars, vtkDataArray* inVectors,
+    vtkDataArray* inNormals, vtkDataArray* inCScalars, unsigned char* inGhostLevels, double den,
+    bool haveVectors);
+
   vtkPolyData** Source; // Geometry to copy to each point
   vtkTypeBool Scaling;  // Determine whether scaling of geometry is performed
   int ScaleMode;        // Scale by scalar value or vector magnitude
@@ -369,9 +448,11 @@ protected:
   int IndexMode;                  // what to use to index into glyph table
   vtkTypeBool GeneratePointIds;   // produce input points ids for each output point
   vtkTypeBool FillCellData;       // whether to fill output cell data
+  vtkTypeBool InstancedOutput;    // output a table of instances instead of glyphs
   char* PointIdsName;
   vtkTransform* SourceTransform;
   int OutputPointsPrecision;
+  bool SequentialProcessing;
 
 private:
   vtkGlyph3D(const vtkGlyph3D&) = delete;
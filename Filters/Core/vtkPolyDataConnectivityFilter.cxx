@@ -17,6 +17,7 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectedComponents.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -26,8 +27,10 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm> // for fill_n
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
@@ -59,6 +62,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->VisitedPointIds = vtkIdList::New();
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
@@ -134,7 +138,17 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   //
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  if (this->InScalars || this->SequentialProcessing ||
+    this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+  {
+    this->Mesh->BuildLinks();
+  }
+  else
+  {
+    // links are only needed to traverse the regions or find the seed cells
+    this->Mesh->BuildCells();
+  }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -190,32 +204,51 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (!this->InScalars && !this->SequentialProcessing)
     {
-      if (cellId && !(cellId % 5000))
+      if (!this->CheckAbort())
+      {
+        this->LabelRegions(false);
+      }
+      for (i = 0; i < this->RegionNumber; i++)
       {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
-        if (this->CheckAbort())
+        if (this->RegionSizes->GetValue(i) > maxCellsInRegion)
         {
-          break;
+          maxCellsInRegion = this->RegionSizes->GetValue(i);
+          largestRegionId = i;
         }
       }
-
-      if (this->Visited[cellId] < 0)
+      this->UpdateProgress(0.9);
+    }
+    else
+    {
+      for (cellId = 0; cellId < numCells; cellId++)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave.push_back(cellId);
-        this->TraverseAndMark();
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
+        if (cellId && !(cellId % 5000))
         {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
+          this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
+          if (this->CheckAbort())
+          {
+            break;
+          }
         }
 
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave.clear();
-        this->Wave2.clear();
+        if (this->Visited[cellId] < 0)
+        {
+          this->NumCellsInRegion = 0;
+          this->Wave.push_back(cellId);
+          this->TraverseAndMark();
+
+          if (this->NumCellsInRegion > maxCellsInRegion)
+          {
+            maxCellsInRegion = this->NumCellsInRegion;
+            largestRegionId = this->RegionNumber;
+          }
+
+          this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
+          this->Wave.clear();
+          this->Wave2.clear();
+        }
       }
     }
   }
@@ -287,8 +320,18 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark();
-    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    if (!this->InScalars && !this->SequentialProcessing)
+    {
+      if (!this->CheckAbort())
+      {
+        this->LabelRegions(true);
+      }
+    }
+    else
+    {
+      this->TraverseAndMark();
+      this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    }
     this->UpdateProgress(0.9);
   } // else extracted seeded cells
 
@@ -544,6 +587,96 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark()
   } // while wave is not empty
 }
 
+//------------------------------------------------------------------------------
+// Mark the cells and points of the regions from the connected components of
+// the cells, which are labelled in parallel. The points are numbered by
+// region, then in the order of their first use by the cells of the region.
+void vtkPolyDataConnectivityFilter::LabelRegions(bool seeded)
+{
+  const vtkIdType numCells = this->Mesh->GetNumberOfCells();
+  const vtkIdType numPts = this->Mesh->GetNumberOfPoints();
+  std::vector<vtkIdType> pointLabels(numPts);
+  vtkIdType numRegions =
+    vtkConnectedComponents::LabelCells(this->Mesh, this->Visited, pointLabels.data());
+  this->UpdateProgress(seeded ? 0.7 : 0.5);
+
+  if (seeded)
+  {
+    // the components of the seeds form region 0, the other ones are not visited
+    std::vector<vtkIdType> seededRegions(numRegions, -1);
+    for (vtkIdType cellId : this->Wave)
+    {
+      seededRegions[this->Visited[cellId]] = 0;
+    }
+    this->Wave.clear();
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; cellId++)
+      {
+        this->Visited[cellId] = seededRegions[this->Visited[cellId]];
+      }
+    });
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ptId++)
+      {
+        if (pointLabels[ptId] >= 0)
+        {
+          pointLabels[ptId] = seededRegions[pointLabels[ptId]];
+        }
+      }
+    });
+    numRegions = 1;
+  }
+  else
+  {
+    this->RegionNumber = numRegions;
+  }
+
+  this->RegionSizes->SetNumberOfValues(numRegions);
+  vtkIdType* regionSizes = this->RegionSizes->GetPointer(0);
+  std::fill_n(regionSizes, numRegions, 0);
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+  {
+    if (this->Visited[cellId] >= 0)
+    {
+      regionSizes[this->Visited[cellId]]++;
+    }
+  }
+
+  std::vector<vtkIdType> pointOffsets(numRegions + 1, 0);
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+  {
+    if (pointLabels[ptId] >= 0)
+    {
+      pointOffsets[pointLabels[ptId] + 1]++;
+    }
+  }
+  for (vtkIdType regionId = 0; regionId < numRegions; regionId++)
+  {
+    pointOffsets[regionId + 1] += pointOffsets[regionId];
+  }
+  vtkIdType* pointRegionIds = vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars)->GetPointer(0);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+  {
+    const vtkIdType regionId = this->Visited[cellId];
+    if (regionId < 0)
+    {
+      continue;
+    }
+    this->Mesh->GetCellPoints(cellId, npts, pts);
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      if (this->PointMap[pts[i]] < 0)
+      {
+        this->PointMap[pts[i]] = pointOffsets[regionId]++;
+        pointRegionIds[this->PointMap[pts[i]]] = regionId;
+      }
+    }
+  }
+  this->PointNumber = pointOffsets[numRegions];
+}
+
 //------------------------------------------------------------------------------
 int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 {
@@ -687,5 +820,6 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
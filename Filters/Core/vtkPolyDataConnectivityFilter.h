@@ -43,8 +43,17 @@
  * This use of ScalarConnectivity is particularly useful for selecting cells
  * for later processing.
  *
+ * When ScalarConnectivity is off, the regions are the connected components
+ * of the cells, which are labelled in parallel with vtkConnectedComponents
+ * instead of being traversed one after the other. The regions are numbered
+ * in the same order, but the output points are numbered by region, then in
+ * the order of their first use by the cells of the region taken by
+ * increasing id. This differs from the order of the traversal, which was
+ * used before and is still used with ScalarConnectivity or
+ * SequentialProcessing.
+ *
  * @sa
- * vtkConnectivityFilter
+ * vtkConnectivityFilter vtkConnectedComponents
  */
 
 #ifndef vtkPolyDataConnectivityFilter_h
@@ -228,6 +237,19 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the regions, which
+   * are then traversed one after the other. By default, sequential
+   * processing is off. The regions and the output cells are the same either
+   * way, but the output points are numbered in the order of the traversal.
+   * This flag is typically used for benchmarking and testing purposes.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkPolyDataConnectivityFilter();
   ~vtkPolyDataConnectivityFilter() override;
@@ -253,6 +275,11 @@ protected:
 
   void TraverseAndMark();
 
+  // Mark the regions without scalar connectivity, using a parallel labelling
+  // of the connected components. If seeded, the components of the cells of
+  // the wave form region 0; otherwise every component is a region.
+  void LabelRegions(bool seeded);
+
   // used to support algorithm execution
   vtkDataArray* CellScalars;
   vtkIdList* NeighborCellPointIds;
@@ -272,6 +299,7 @@ protected:
 
   vtkTypeBool MarkVisitedPointIds;
   int OutputPointsPrecision;
+  bool SequentialProcessing;
 
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&) = delete;
@@ -23,6 +23,7 @@
 #include "vtkClosestPointStrategy.h"
 #include "vtkFindCellStrategy.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -32,6 +33,7 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
@@ -417,6 +419,11 @@ class vtkProbeFilter::ProbeEmptyPointsWorklet
   vtkCharArray* MaskArray;
   double Tol2;
   int MaxCellSize;
+  vtkImageData* SourceImage;
+  vtkRectilinearGrid* SourceRectilinear;
+
+  // Number of points located at once in structured sources.
+  static constexpr vtkIdType BatchSize = 256;
 
   struct LocalData
   {
@@ -432,6 +439,13 @@ class vtkProbeFilter::ProbeEmptyPointsWorklet
     vtkBoundingBox LastBBox;
     double LastLength2;
     vtkIdType LastCellId;
+    // Structure-of-arrays buffers used to locate batches of points
+    std::vector<vtkIdType> BatchPointIds;
+    std::vector<double> BatchCoords;
+    std::vector<vtkIdType> BatchCellIds;
+    std::vector<double> BatchPCoords;
+    std::vector<double> BatchWeights;
+    vtkSmartPointer<vtkIdList> CellPointIds;
   };
   vtkSMPThreadLocal<LocalData> TLData;
 
@@ -451,6 +465,8 @@ public:
     , MaskArray(maskArray)
     , Tol2(tol2)
     , MaxCellSize(maxCellSize)
+    , SourceImage(vtkImageData::SafeDownCast(source))
+    , SourceRectilinear(vtkRectilinearGrid::SafeDownCast(source))
   {
     // instantiate the cell map for polydata
     vtkNew<vtkGenericCell> cell;
@@ -478,10 +494,132 @@ public:
     tlData.LastCell = vtkSmartPointer<vtkGenericCell>::New();
     tlData.Weights.resize(static_cast<size_t>(this->MaxCellSize));
     tlData.LastCellId = -1;
+    if (this->SourceImage || this->SourceRectilinear)
+    {
+      tlData.BatchPointIds.resize(BatchSize);
+      tlData.BatchCoords.resize(3 * BatchSize);
+      tlData.BatchCellIds.resize(BatchSize);
+      tlData.BatchPCoords.resize(3 * BatchSize);
+      tlData.BatchWeights.resize(8 * BatchSize);
+      tlData.CellPointIds = vtkSmartPointer<vtkIdList>::New();
+    }
+  }
+
+  // Image data and rectilinear grid sources locate batches of points at
+  // once rather than calling FindCell() for each point.
+  void ProbeStructuredPoints(vtkIdType beginPointId, vtkIdType endPointId)
+  {
+    auto maskArray = this->MaskArray->GetPointer(0);
+    auto& tlData = this->TLData.Local();
+    vtkIdType* pointIds = tlData.BatchPointIds.data();
+    double* coords = tlData.BatchCoords.data();
+    vtkIdType* cellIds = tlData.BatchCellIds.data();
+    double* batchWeights = tlData.BatchWeights.data();
+    vtkIdList* cellPointIds = tlData.CellPointIds;
+    double weights[8], closestPoint[3], pt[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (vtkIdType batchBegin = beginPointId; batchBegin < endPointId; batchBegin += BatchSize)
+    {
+      if (isFirst)
+      {
+        this->ProbeFilter->CheckAbort();
+      }
+      if (this->ProbeFilter->GetAbortOutput())
+      {
+        break;
+      }
+
+      // Gather the points which have not already been probed with success.
+      const vtkIdType batchEnd = std::min(batchBegin + BatchSize, endPointId);
+      vtkIdType numPts = 0;
+      for (vtkIdType pointId = batchBegin; pointId < batchEnd; ++pointId)
+      {
+        if (maskArray[pointId] != static_cast<char>(1))
+        {
+          pointIds[numPts] = pointId;
+          this->Input->GetPoint(pointId, coords + 3 * numPts);
+          ++numPts;
+        }
+      }
+      if (numPts == 0)
+      {
+        continue;
+      }
+
+      if (this->SourceImage)
+      {
+        this->SourceImage->FindCells(
+          numPts, coords, this->Tol2, cellIds, tlData.BatchPCoords.data(), batchWeights);
+      }
+      else
+      {
+        // As when probing with FindCell(), which ignores the tolerance.
+        this->SourceRectilinear->FindCells(
+          numPts, coords, 0.0, cellIds, tlData.BatchPCoords.data(), batchWeights);
+      }
+
+      for (vtkIdType i = 0; i < numPts; ++i)
+      {
+        const vtkIdType cellId = cellIds[i];
+        if (cellId < 0 || ::IsBlankedCell(this->SourceGhostFlags, cellId))
+        {
+          continue;
+        }
+        for (int w = 0; w < 8; ++w)
+        {
+          weights[w] = batchWeights[w * numPts + i];
+        }
+        this->Source->GetCellPoints(cellId, cellPointIds);
+
+        if (this->ProbeFilter->ComputeTolerance)
+        {
+          // If ComputeTolerance is set, compute a tolerance proportional to the
+          // cell length.
+          vtkBoundingBox cellBBox;
+          closestPoint[0] = closestPoint[1] = closestPoint[2] = 0.0;
+          for (vtkIdType j = 0; j < cellPointIds->GetNumberOfIds(); ++j)
+          {
+            this->Source->GetPoint(cellPointIds->GetId(j), pt);
+            cellBBox.AddPoint(pt);
+            closestPoint[0] += weights[j] * pt[0];
+            closestPoint[1] += weights[j] * pt[1];
+            closestPoint[2] += weights[j] * pt[2];
+          }
+          const double dist2 = vtkMath::Distance2BetweenPoints(coords + 3 * i, closestPoint);
+          if (dist2 > (cellBBox.GetDiagonalLength2() * CELL_TOLERANCE_FACTOR_SQR))
+          {
+            continue;
+          }
+        }
+
+        // Interpolate the point data
+        const vtkIdType pointId = pointIds[i];
+        this->OutputPD->InterpolatePoint(*this->ProbeFilter->PointList, this->SourcePD,
+          this->SourceIdx, pointId, cellPointIds, weights);
+        for (size_t a = 0, numArrays = this->ProbeFilter->InputCellArrays.size(); a < numArrays;
+             ++a)
+        {
+          auto inputArray = this->ProbeFilter->InputCellArrays[a];
+          auto sourceArray = this->ProbeFilter->SourceCellArrays[a];
+          if (sourceArray)
+          {
+            inputArray->SetTuple(pointId, cellId, sourceArray);
+          }
+        }
+        maskArray[pointId] = static_cast<char>(1);
+      }
+    }
   }
 
   void operator()(vtkIdType beginPointId, vtkIdType endPointId)
   {
+    if (this->SourceImage || this->SourceRectilinear)
+    {
+      this->ProbeStructuredPoints(beginPointId, endPointId);
+      return;
+    }
+
     // global data
     auto maskArray = this->MaskArray->GetPointer(0);
     // thread local data
@@ -16,20 +16,31 @@
 
 #include <cstdint>
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkExecutive.h"
 #include "vtkFeatureEdges.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <array>
+#include <numeric>
 #include <unordered_set> // keep track of inserted triangles
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkQuadricClustering);
@@ -95,6 +106,7 @@ vtkQuadricClustering::vtkQuadricClustering()
 
   this->InCellCount = this->OutCellCount = 0;
   this->CopyCellData = 0;
+  this->SequentialProcessing = false;
 }
 
 //------------------------------------------------------------------------------
@@ -186,7 +198,18 @@ int vtkQuadricClustering::RequestData(vtkInformation* vtkNotUsed(request),
   this->UpdateProgress(.2);
   this->SliceSize = this->NumberOfDivisions[0] * this->NumberOfDivisions[1];
 
-  this->Append(input);
+  // The threaded path copies the cell data with ArrayList.
+  const bool threaded = !this->SequentialProcessing && input->GetNumberOfVerts() == 0 &&
+    input->GetNumberOfLines() == 0 &&
+    (!this->CopyCellData || CanUseArrayList(input->GetCellData()));
+  if (threaded)
+  {
+    this->AppendTriangles(input, output);
+  }
+  else
+  {
+    this->Append(input);
+  }
   if (this->UseFeatureEdges)
   { // Adjust bin points that contain boundary edges.
     this->AppendFeatureQuadrics(input, output);
@@ -359,6 +382,274 @@ void vtkQuadricClustering::Append(vtkPolyData* pd)
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkQuadricClustering::AppendTriangles(vtkPolyData* pd, vtkPolyData* output)
+{
+  vtkPoints* points = pd->GetPoints();
+  vtkCellArray* polys = pd->GetPolys();
+  vtkCellArray* strips = pd->GetStrips();
+  const vtkIdType numPolys = polys->GetNumberOfCells();
+  const vtkIdType numCells = numPolys + strips->GetNumberOfCells();
+
+  // Check for mis-use of the Append methods.
+  if (this->OutputTriangleArray == nullptr || this->OutputLines == nullptr)
+  {
+    vtkDebugMacro("Missing Array:  Did you call StartAppend?");
+    return;
+  }
+
+  // Triangles of each cell, fanned or stripped as in AddPolygons() and AddStrips().
+  std::vector<vtkIdType> triOffsets(numCells + 1, 0);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      const vtkIdType numPts = cellId < numPolys ? polys->GetCellSize(cellId)
+                                                 : strips->GetCellSize(cellId - numPolys);
+      triOffsets[cellId + 1] = std::max<vtkIdType>(numPts - 2, 0);
+    }
+  });
+  std::partial_sum(triOffsets.begin(), triOffsets.end(), triOffsets.begin());
+  const vtkIdType numTris = triOffsets[numCells];
+
+  // Hash the corners of the triangles and compute their quadrics. The bins of
+  // the triangles skipped by UseInternalTriangles are set to -1.
+  std::vector<vtkIdType> triBins(3 * numTris);
+  std::vector<double> triQuadrics(9 * numTris);
+  auto addTriangle = [&](vtkIdType triId, const vtkIdType binIds[3], const double* pt0,
+                       const double* pt1, const double* pt2) {
+    vtkIdType* bins = triBins.data() + 3 * triId;
+    if (this->UseInternalTriangles == 0 &&
+      (binIds[0] == binIds[1] || binIds[0] == binIds[2] || binIds[1] == binIds[2]))
+    {
+      bins[0] = bins[1] = bins[2] = -1;
+      return;
+    }
+    std::copy(binIds, binIds + 3, bins);
+    double quadric4x4[4][4];
+    vtkTriangle::ComputeQuadric(pt0, pt1, pt2, quadric4x4);
+    double* quadric = triQuadrics.data() + 9 * triId;
+    quadric[0] = quadric4x4[0][0];
+    quadric[1] = quadric4x4[0][1];
+    quadric[2] = quadric4x4[0][2];
+    quadric[3] = quadric4x4[0][3];
+    quadric[4] = quadric4x4[1][1];
+    quadric[5] = quadric4x4[1][2];
+    quadric[6] = quadric4x4[1][3];
+    quadric[7] = quadric4x4[2][2];
+    quadric[8] = quadric4x4[2][3];
+  };
+  vtkSMPThreadLocalObject<vtkIdList> cellPointIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* ptIdList = cellPointIds.Local();
+    const vtkIdType* ptIds = nullptr;
+    vtkIdType numPts = 0;
+    double pts[3][3];
+    vtkIdType binIds[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endCellId - cellId) / 10 + 1, (vtkIdType)1000);
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      vtkIdType triId = triOffsets[cellId];
+      if (triOffsets[cellId + 1] == triId)
+      {
+        continue;
+      }
+      if (cellId < numPolys)
+      {
+        polys->GetCellAtId(cellId, numPts, ptIds, ptIdList);
+        points->GetPoint(ptIds[0], pts[0]);
+        binIds[0] = this->HashPoint(pts[0]);
+        for (vtkIdType j = 0; j < numPts - 2; ++j, ++triId)
+        {
+          points->GetPoint(ptIds[j + 1], pts[1]);
+          binIds[1] = this->HashPoint(pts[1]);
+          points->GetPoint(ptIds[j + 2], pts[2]);
+          binIds[2] = this->HashPoint(pts[2]);
+          addTriangle(triId, binIds, pts[0], pts[1], pts[2]);
+        }
+      }
+      else
+      {
+        strips->GetCellAtId(cellId - numPolys, numPts, ptIds, ptIdList);
+        points->GetPoint(ptIds[0], pts[0]);
+        binIds[0] = this->HashPoint(pts[0]);
+        points->GetPoint(ptIds[1], pts[1]);
+        binIds[1] = this->HashPoint(pts[1]);
+        int odd = 0;
+        for (vtkIdType j = 2; j < numPts; ++j, ++triId)
+        {
+          points->GetPoint(ptIds[j], pts[2]);
+          binIds[2] = this->HashPoint(pts[2]);
+          addTriangle(triId, binIds, pts[0], pts[1], pts[2]);
+          std::copy(pts[2], pts[2] + 3, pts[odd]);
+          binIds[odd] = binIds[2];
+          odd = odd ? 0 : 1;
+        }
+      }
+    }
+  });
+  if (this->GetAbortOutput())
+  {
+    return;
+  }
+  this->UpdateProgress(.5);
+
+  // Sort the corners by bin. Within a bin, the corners stay in the order of
+  // Append(), which is the order of their quadric sums and point ids.
+  using Corner = std::pair<vtkIdType, vtkIdType>; // (bin, 3 * triangle + corner)
+  std::vector<Corner> corners(3 * numTris);
+  vtkSMPTools::For(0, 3 * numTris, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      corners[i] = Corner(triBins[i] < 0 ? VTK_ID_MAX : triBins[i], i);
+    }
+  });
+  vtkSMPTools::Sort(corners.begin(), corners.end());
+  std::vector<vtkIdType> binStarts;
+  vtkIdType numCorners = 0;
+  for (; numCorners < 3 * numTris && corners[numCorners].first != VTK_ID_MAX; ++numCorners)
+  {
+    if (numCorners == 0 || corners[numCorners].first != corners[numCorners - 1].first)
+    {
+      binStarts.push_back(numCorners);
+    }
+  }
+  const vtkIdType numBins = static_cast<vtkIdType>(binStarts.size());
+  binStarts.push_back(numCorners);
+
+  // Sum the quadrics of each bin. The first corner of the bins which are new
+  // gives the order of their point ids.
+  std::vector<Corner> newBins(numBins);
+  vtkSMPTools::For(0, numBins, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      const vtkIdType binId = corners[binStarts[i]].first;
+      PointQuadric& bin = this->QuadricArray[binId];
+      if (bin.Dimension > 2)
+      {
+        bin.Dimension = 2;
+        this->InitializeQuadric(bin.Quadric);
+      }
+      if (bin.Dimension == 2)
+      { // Points and segments supersede triangles.
+        for (vtkIdType c = binStarts[i]; c < binStarts[i + 1]; ++c)
+        {
+          this->AddQuadric(binId, triQuadrics.data() + 9 * (corners[c].second / 3));
+        }
+      }
+      newBins[i] = Corner(bin.VertexId == -1 ? corners[binStarts[i]].second : VTK_ID_MAX, binId);
+    }
+  });
+  vtkSMPTools::Sort(newBins.begin(), newBins.end());
+  const vtkIdType numNewBins = std::lower_bound(newBins.begin(), newBins.end(),
+                                 Corner(VTK_ID_MAX, 0)) -
+    newBins.begin();
+  vtkSMPTools::For(0, numNewBins, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      this->QuadricArray[newBins[i].second].VertexId = this->NumberOfBinsUsed + i;
+    }
+  });
+  this->NumberOfBinsUsed += numNewBins;
+  this->UpdateProgress(.7);
+
+  // Keep the triangles spanning three bins and, if duplicates are prevented,
+  // only the first one of the triangles sharing the same bins.
+  std::vector<vtkIdType> outTriOffsets(numTris + 1, 0);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType triId, vtkIdType endTriId) {
+    for (; triId < endTriId; ++triId)
+    {
+      const vtkIdType* bins = triBins.data() + 3 * triId;
+      outTriOffsets[triId + 1] =
+        (bins[0] >= 0 && bins[0] != bins[1] && bins[0] != bins[2] && bins[1] != bins[2]) ? 1 : 0;
+    }
+  });
+  if (this->PreventDuplicateCells)
+  {
+    using TriangleKey = std::pair<std::array<vtkIdType, 3>, vtkIdType>;
+    std::vector<TriangleKey> keys(numTris);
+    vtkSMPTools::For(0, numTris, [&](vtkIdType triId, vtkIdType endTriId) {
+      for (; triId < endTriId; ++triId)
+      {
+        std::array<vtkIdType, 3>& key = keys[triId].first;
+        if (outTriOffsets[triId + 1])
+        {
+          std::copy(triBins.data() + 3 * triId, triBins.data() + 3 * triId + 3, key.begin());
+          std::sort(key.begin(), key.end());
+        }
+        else
+        {
+          key.fill(VTK_ID_MAX);
+        }
+        keys[triId].second = triId;
+      }
+    });
+    vtkSMPTools::Sort(keys.begin(), keys.end());
+    vtkSMPTools::For(1, numTris, [&](vtkIdType i, vtkIdType end) {
+      for (; i < end; ++i)
+      {
+        if (keys[i].first[0] != VTK_ID_MAX && keys[i].first == keys[i - 1].first)
+        {
+          outTriOffsets[keys[i].second + 1] = 0;
+        }
+      }
+    });
+  }
+  std::partial_sum(outTriOffsets.begin(), outTriOffsets.end(), outTriOffsets.begin());
+  const vtkIdType numOutTris = outTriOffsets[numTris];
+
+  // Produce the output triangles, in the order of Append().
+  vtkNew<vtkIdTypeArray> outConn;
+  vtkIdType* outTris = outConn->WritePointer(0, 3 * numOutTris);
+  vtkNew<vtkIdTypeArray> outOffsets;
+  vtkIdType* outOffsetsPtr = outOffsets->WritePointer(0, numOutTris + 1);
+  outOffsetsPtr[numOutTris] = 3 * numOutTris;
+  ArrayList arrays;
+  if (this->CopyCellData)
+  {
+    output->GetCellData()->CopyAllocate(pd->GetCellData(), this->OutCellCount + numOutTris);
+    arrays.AddArrays(this->OutCellCount + numOutTris, pd->GetCellData(), output->GetCellData(),
+      /*nullValue*/ 0.0, /*promote*/ false);
+  }
+  vtkSMPTools::For(0, numTris, [&](vtkIdType triId, vtkIdType endTriId) {
+    for (; triId < endTriId; ++triId)
+    {
+      const vtkIdType outTriId = outTriOffsets[triId];
+      if (outTriOffsets[triId + 1] == outTriId)
+      {
+        continue;
+      }
+      outOffsetsPtr[outTriId] = 3 * outTriId;
+      for (int i = 0; i < 3; ++i)
+      {
+        outTris[3 * outTriId + i] = this->QuadricArray[triBins[3 * triId + i]].VertexId;
+      }
+      if (this->CopyCellData)
+      {
+        const vtkIdType cellId =
+          std::upper_bound(triOffsets.begin(), triOffsets.end(), triId) - triOffsets.begin() - 1;
+        arrays.Copy(this->InCellCount + cellId, this->OutCellCount + outTriId);
+      }
+    }
+  });
+  this->OutputTriangleArray->SetData(outOffsets, outConn);
+  this->InCellCount += numCells;
+  this->OutCellCount += numOutTris;
+  this->UpdateProgress(.8);
+}
+
 //------------------------------------------------------------------------------
 void vtkQuadricClustering::AddPolygons(
   vtkCellArray* polys, vtkPoints* points, int geometryFlag, vtkPolyData* input, vtkPolyData* output)
@@ -915,16 +1206,8 @@ void vtkQuadricClustering::EndAppend()
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType numBuckets;
-  bool abortExecute = false;
   vtkPoints* outputPoints;
-  double newPt[3];
   numBuckets = this->NumberOfDivisions[0] * this->NumberOfDivisions[1] * this->NumberOfDivisions[2];
-  double step = (double)numBuckets / 10.0;
-  if (step < 1000.0)
-  {
-    step = 1000.0;
-  }
-  double cstep = 0;
 
   // Check for mis use of the Append methods.
   if (this->OutputTriangleArray == nullptr || this->OutputLines == nullptr)
@@ -942,23 +1225,41 @@ void vtkQuadricClustering::EndAppend()
 
   // Compute the representative points for each bin
   outputPoints = vtkPoints::New();
-  for (vtkIdType i = 0; !abortExecute && i < numBuckets; i++)
-  {
-    if (cstep > step)
-    {
-      cstep = 0;
-      vtkDebugMacro(<< "Finding point in bin #" << i);
-      this->UpdateProgress(0.8 + 0.2 * i / numBuckets);
-      abortExecute = this->CheckAbort();
-    }
-    ++cstep;
-
-    if (this->QuadricArray[i].VertexId != -1)
+  outputPoints->SetNumberOfPoints(this->NumberOfBinsUsed);
+  auto computePoints = [&](vtkIdType i, vtkIdType end) {
+    double newPt[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - i) / 10 + 1, (vtkIdType)1000);
+    for (; i < end; i++)
     {
-      this->ComputeRepresentativePoint(this->QuadricArray[i].Quadric, i, newPt);
-      outputPoints->InsertPoint(this->QuadricArray[i].VertexId, newPt);
+      if (i % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      if (this->QuadricArray[i].VertexId != -1)
+      {
+        this->ComputeRepresentativePoint(this->QuadricArray[i].Quadric, i, newPt);
+        outputPoints->SetPoint(this->QuadricArray[i].VertexId, newPt);
+      }
     }
+  };
+  if (this->SequentialProcessing)
+  {
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1, "Sequential", false },
+      [&]() { vtkSMPTools::For(0, numBuckets, computePoints); });
+  }
+  else
+  {
+    vtkSMPTools::For(0, numBuckets, computePoints);
   }
+  this->UpdateProgress(1.0);
 
   // Set up the output data object.
   output->SetPoints(outputPoints);
@@ -1552,5 +1853,6 @@ void vtkQuadricClustering::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Copy Cell Data : " << this->CopyCellData << endl;
 
   os << indent << "Prevent Duplicate Cells : " << (this->PreventDuplicateCells ? "On\n" : "Off\n");
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
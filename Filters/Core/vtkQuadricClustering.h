@@ -79,6 +79,11 @@
  * situation, set the number of bins in the normal direction to one.
  *
  * @warning
+ * When the input has no vertices and no lines, the filter is threaded with
+ * vtkSMPTools, unless SequentialProcessing is on. The output is the same as
+ * the serial one.
+ *
+ * @warning
  * vtkBinnedDecimation produces similar results with significant speedup
  * and reduced memory consumption.
  *
@@ -265,6 +270,17 @@ public:
   vtkBooleanMacro(PreventDuplicateCells, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the binning. By
+   * default, sequential processing is off. The output is the same either
+   * way. This flag is typically used for benchmarking and testing purposes.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkQuadricClustering();
   ~vtkQuadricClustering() override;
@@ -295,6 +311,15 @@ protected:
     vtkPolyData* input, vtkPolyData* output);
   ///@}
 
+  /**
+   * Threaded equivalent of Append() for a piece made only of polygons and
+   * triangle strips, used when the filter executes in the pipeline. The
+   * quadrics of the triangles are computed concurrently, then summed per bin
+   * in the order of Append(), so that the bins, the point ids and the
+   * triangles are the same as the serial ones.
+   */
+  void AppendTriangles(vtkPolyData* piece, vtkPolyData* output);
+
   ///@{
   /**
    * Add edges to the quadric array.  If geometry flag is on then
@@ -416,6 +441,7 @@ protected:
   double FeaturePointsAngle;
 
   vtkTypeBool CopyCellData;
+  bool SequentialProcessing;
   int InCellCount;
   int OutCellCount;
 
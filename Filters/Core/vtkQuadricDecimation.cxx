@@ -49,12 +49,19 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkQuadricDecimation);
 
@@ -266,6 +273,11 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  if (this->NumberOfPartitions > 1 && this->LockedPoints.empty())
+  {
+    return this->DecimateInPartitions(input, output);
+  }
+
   polys = vtkCellArray::New();
   points = vtkPoints::New();
   outputCellList = vtkIdList::New();
@@ -378,10 +390,28 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
       vtkDebugMacro(<< "Collapsing edge#" << this->NumberOfEdgeCollapses);
       this->UpdateProgress(0.20 + 0.80 * this->NumberOfEdgeCollapses / numPts);
       abort = this->CheckAbort();
+      if (vtkQuadricDecimation* parent = this->PartitionedDecimation)
+      {
+        // Only one thread updates the abort flags of the parent.
+        if (!vtkSMPTools::IsParallelScope() || vtkSMPTools::GetSingleThread())
+        {
+          parent->CheckAbort();
+        }
+        abort = abort || parent->GetAbortOutput();
+      }
     }
 
     endPtIds[0] = this->EndPoint1List->GetId(edgeId);
     endPtIds[1] = this->EndPoint2List->GetId(edgeId);
+
+    // Locked points are never moved nor removed.
+    if (!this->LockedPoints.empty() &&
+      (this->LockedPoints[endPtIds[0]] || this->LockedPoints[endPtIds[1]]))
+    {
+      edgeId = this->EdgeCosts->Pop(0, cost);
+      continue;
+    }
+
     this->TargetPoints->GetTuple(edgeId, x);
 
     // check for a poorly placed point
@@ -467,6 +497,246 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkQuadricDecimation::DecimateInPartitions(vtkPolyData* input, vtkPolyData* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  std::vector<vtkIdType> tris;
+  tris.reserve(input->GetNumberOfPolys() * 3);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = input->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    if (npts != 3)
+    {
+      vtkErrorMacro("Can only decimate triangles");
+      return 1;
+    }
+    tris.insert(tris.end(), pts, pts + 3);
+  }
+  const vtkIdType numTris = static_cast<vtkIdType>(tris.size() / 3);
+  const int numPartitions =
+    static_cast<int>(std::min(static_cast<vtkIdType>(this->NumberOfPartitions), numTris));
+
+  // Split the triangles into slabs with the same number of triangles along
+  // the longest axis of the bounds.
+  double bounds[6];
+  input->GetPoints()->GetBounds(bounds);
+  int axis = 0;
+  for (int i = 1; i < 3; i++)
+  {
+    if (bounds[2 * i + 1] - bounds[2 * i] > bounds[2 * axis + 1] - bounds[2 * axis])
+    {
+      axis = i;
+    }
+  }
+  std::vector<std::pair<double, vtkIdType>> sorted(numTris);
+  vtkPoints* inPts = input->GetPoints();
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType t = begin; t < end; t++)
+    {
+      double center = 0.0;
+      for (int i = 0; i < 3; i++)
+      {
+        inPts->GetPoint(tris[3 * t + i], x);
+        center += x[axis];
+      }
+      sorted[t] = std::make_pair(center, t);
+    }
+  });
+  vtkSMPTools::Sort(sorted.begin(), sorted.end());
+
+  // The points used by several slabs are locked while decimating the slabs.
+  std::vector<int> owners(numPts, -1);
+  std::vector<unsigned char> shared(numPts, 0);
+  for (int p = 0; p < numPartitions; p++)
+  {
+    for (vtkIdType s = numTris * p / numPartitions; s < numTris * (p + 1) / numPartitions; s++)
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        const vtkIdType ptId = tris[3 * sorted[s].second + i];
+        if (owners[ptId] == -1)
+        {
+          owners[ptId] = p;
+        }
+        else if (owners[ptId] != p)
+        {
+          shared[ptId] = 1;
+        }
+      }
+    }
+  }
+  this->UpdateProgress(0.1);
+
+  // Decimate the slabs. The original ids of the locked points go through the
+  // decimation in a point data array, where the other points are -1. Since
+  // the locked points never take part in a collapse, their ids are never
+  // interpolated.
+  const char* originalIdsName = "vtkQuadricDecimationOriginalIds";
+  const bool mapPointData = this->AttributeErrorMetric || this->MapPointData;
+  vtkPointData* inPD = input->GetPointData();
+  auto configure = [this](vtkQuadricDecimation* decimate) {
+    decimate->SetAttributeErrorMetric(this->AttributeErrorMetric);
+    decimate->SetVolumePreservation(this->VolumePreservation);
+    decimate->SetRegularize(this->Regularize);
+    decimate->SetRegularization(this->Regularization);
+    decimate->SetWeighBoundaryConstraintsByLength(this->WeighBoundaryConstraintsByLength);
+    decimate->SetBoundaryWeightFactor(this->BoundaryWeightFactor);
+    decimate->SetScalarsAttribute(this->ScalarsAttribute);
+    decimate->SetVectorsAttribute(this->VectorsAttribute);
+    decimate->SetNormalsAttribute(this->NormalsAttribute);
+    decimate->SetTCoordsAttribute(this->TCoordsAttribute);
+    decimate->SetTensorsAttribute(this->TensorsAttribute);
+    decimate->SetScalarsWeight(this->ScalarsWeight);
+    decimate->SetVectorsWeight(this->VectorsWeight);
+    decimate->SetNormalsWeight(this->NormalsWeight);
+    decimate->SetTCoordsWeight(this->TCoordsWeight);
+    decimate->SetTensorsWeight(this->TensorsWeight);
+    decimate->SetTargetReduction(this->TargetReduction);
+  };
+  std::vector<vtkSmartPointer<vtkPolyData>> slabs(numPartitions);
+  std::vector<int> slabCollapses(numPartitions, 0);
+  std::vector<vtkIdType> localIds(numPts, -1);
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType p = begin; p < end && !this->GetAbortOutput(); p++)
+    {
+      // The local ids of the points only used by this slab are in localIds,
+      // and the ones of the shared points in sharedIds.
+      std::unordered_map<vtkIdType, vtkIdType> sharedIds;
+      vtkNew<vtkPoints> slabPts;
+      slabPts->SetDataType(inPts->GetDataType());
+      vtkNew<vtkCellArray> slabPolys;
+      vtkNew<vtkPolyData> slab;
+      vtkPointData* slabPD = slab->GetPointData();
+      if (mapPointData)
+      {
+        slabPD->CopyAllocate(inPD);
+      }
+      vtkNew<vtkDoubleArray> originalIds;
+      originalIds->SetName(originalIdsName);
+      std::vector<unsigned char> locked;
+      auto localId = [&](vtkIdType ptId) {
+        vtkIdType* id = &localIds[ptId];
+        if (shared[ptId])
+        {
+          id = &sharedIds.emplace(ptId, -1).first->second;
+        }
+        if (*id == -1)
+        {
+          double x[3];
+          inPts->GetPoint(ptId, x);
+          *id = slabPts->InsertNextPoint(x);
+          if (mapPointData)
+          {
+            slabPD->CopyData(inPD, ptId, *id);
+          }
+          originalIds->InsertNextValue(shared[ptId] ? ptId : -1);
+          locked.push_back(shared[ptId]);
+        }
+        return *id;
+      };
+      for (vtkIdType s = numTris * p / numPartitions; s < numTris * (p + 1) / numPartitions; s++)
+      {
+        const vtkIdType* tri = &tris[3 * sorted[s].second];
+        const vtkIdType slabTri[3] = { localId(tri[0]), localId(tri[1]), localId(tri[2]) };
+        slabPolys->InsertNextCell(3, slabTri);
+      }
+      slab->SetPoints(slabPts);
+      slab->SetPolys(slabPolys);
+      slabPD->AddArray(originalIds);
+
+      vtkNew<vtkQuadricDecimation> decimate;
+      configure(decimate);
+      decimate->SetMapPointData(true);
+      decimate->LockedPoints = std::move(locked);
+      decimate->PartitionedDecimation = this;
+      decimate->SetInputData(slab);
+      decimate->Update();
+      slabs[p] = decimate->GetOutput();
+      slabCollapses[p] = decimate->NumberOfEdgeCollapses;
+    }
+  });
+  this->UpdateProgress(0.7);
+  if (this->CheckAbort() || this->GetAbortOutput())
+  {
+    return 1;
+  }
+
+  // Merge the slabs, then decimate the seams.
+  vtkNew<vtkPolyData> merged;
+  vtkNew<vtkPoints> mergedPts;
+  mergedPts->SetDataType(inPts->GetDataType());
+  vtkNew<vtkCellArray> mergedPolys;
+  vtkPointData* mergedPD = merged->GetPointData();
+  std::vector<vtkIdType> mergedIds(numPts, -1);
+  this->NumberOfEdgeCollapses = 0;
+  for (int p = 0; p < numPartitions; p++)
+  {
+    vtkPolyData* slab = slabs[p];
+    vtkSmartPointer<vtkDataArray> originalIds = slab->GetPointData()->GetArray(originalIdsName);
+    slab->GetPointData()->RemoveArray(originalIdsName);
+    if (p == 0 && mapPointData)
+    {
+      mergedPD->CopyAllocate(slab->GetPointData());
+    }
+    std::vector<vtkIdType> slabIds(slab->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < slab->GetNumberOfPoints(); i++)
+    {
+      const double originalId = originalIds->GetComponent(i, 0);
+      vtkIdType* id = originalId >= 0 ? &mergedIds[static_cast<vtkIdType>(originalId)] : nullptr;
+      if (!id || *id == -1)
+      {
+        slabIds[i] = mergedPts->InsertNextPoint(slab->GetPoint(i));
+        if (mapPointData)
+        {
+          mergedPD->CopyData(slab->GetPointData(), i, slabIds[i]);
+        }
+        if (id)
+        {
+          *id = slabIds[i];
+        }
+      }
+      else
+      {
+        slabIds[i] = *id;
+      }
+    }
+    vtkCellArray* slabPolys = slab->GetPolys();
+    for (slabPolys->InitTraversal(); slabPolys->GetNextCell(npts, pts);)
+    {
+      const vtkIdType mergedTri[3] = { slabIds[pts[0]], slabIds[pts[1]], slabIds[pts[2]] };
+      mergedPolys->InsertNextCell(3, mergedTri);
+    }
+    this->NumberOfEdgeCollapses += slabCollapses[p];
+  }
+  merged->SetPoints(mergedPts);
+  merged->SetPolys(mergedPolys);
+  merged->GetFieldData()->PassData(input->GetFieldData());
+
+  const double targetTris = numTris * (1.0 - this->TargetReduction);
+  const vtkIdType numMergedTris = mergedPolys->GetNumberOfCells();
+  vtkNew<vtkQuadricDecimation> decimate;
+  configure(decimate);
+  decimate->SetMapPointData(this->MapPointData);
+  decimate->SetTargetReduction(
+    numMergedTris > targetTris ? 1.0 - targetTris / numMergedTris : 0.0);
+  decimate->PartitionedDecimation = this;
+  decimate->SetInputData(merged);
+  decimate->Update();
+  if (this->GetAbortOutput())
+  {
+    return 1;
+  }
+  output->ShallowCopy(decimate->GetOutput());
+  this->NumberOfEdgeCollapses += decimate->NumberOfEdgeCollapses;
+  this->ActualReduction =
+    numTris > 0 ? 1.0 - static_cast<double>(output->GetNumberOfPolys()) / numTris : 0.0;
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
 {
@@ -1559,5 +1829,6 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
 }
 VTK_ABI_NAMESPACE_END
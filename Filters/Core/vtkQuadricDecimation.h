@@ -48,6 +48,13 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * The decimation can be made parallel by setting NumberOfPartitions. The
+ * triangles are then split into slabs along the longest axis of the input
+ * bounds, each slab is decimated by its own thread while the points it shares
+ * with the other slabs are locked, and the merged slabs are decimated once
+ * more to reach the target reduction, which also decimates the seams. The
+ * result has a quality close to the serial decimation, but is not identical.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -60,6 +67,8 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+#include <vector> // For LockedPoints
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkEdgeTable;
 class vtkIdList;
@@ -198,6 +207,18 @@ public:
   vtkGetMacro(TensorsWeight, double);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get the number of spatial partitions decimated concurrently. When
+   * greater than 1, the triangles are split into this number of slabs
+   * decimated in parallel with vtkSMPTools, before decimating the seams
+   * between the slabs serially. Default is 1, which decimates the whole mesh
+   * serially.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  ///@}
+
   ///@{
   /**
    * Get the actual reduction. This value is only valid after the
@@ -285,6 +306,12 @@ protected:
    */
   void GetAttributeComponents();
 
+  /**
+   * Decimate the input in NumberOfPartitions slabs concurrently, then the
+   * merged slabs serially.
+   */
+  int DecimateInPartitions(vtkPolyData* input, vtkPolyData* output);
+
   double TargetReduction;
   double ActualReduction;
   vtkTypeBool AttributeErrorMetric;
@@ -329,6 +356,18 @@ protected:
   vtkTypeBool WeighBoundaryConstraintsByLength = false;
   double BoundaryWeightFactor = 1.0;
 
+  // Controlling the parallel decimation
+  int NumberOfPartitions = 1;
+
+  // Points which are never moved nor removed, one flag per point. Used by
+  // the slabs of the parallel decimation for the points shared with other
+  // slabs.
+  std::vector<unsigned char> LockedPoints;
+
+  // The filter decimating in partitions, whose abort is forwarded to the
+  // decimations of its slabs and seams.
+  vtkQuadricDecimation* PartitionedDecimation = nullptr;
+
   // Contains 4 doubles per point. Length = nPoints * 4
   double* VolumeConstraints;
   int AttributeComponents[6];
@@ -18,6 +18,7 @@
 #include "vtkCellData.h"
 #include "vtkCellLocator.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -25,11 +26,18 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
@@ -131,6 +139,7 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->GenerateErrorVectors = 0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->SequentialProcessing = true;
 
   this->SmoothPoints = nullptr;
 
@@ -162,6 +171,9 @@ vtkPolyData* vtkSmoothPolyDataFilter::GetSource()
 #define VTK_FEATURE_EDGE_VERTEX 2
 #define VTK_BOUNDARY_EDGE_VERTEX 3
 
+// Type of a polygon edge already classified through a neighbor polygon.
+#define VTK_VISITED_EDGE -1
+
 namespace
 {
 
@@ -286,6 +298,255 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
   vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
 }
 
+// Classify the edges of the polygons of the mesh in parallel, the same way as
+// the vertices they make: an edge is simple, on a feature or on the boundary.
+// An edge shared by several polygons is classified once, through the polygon
+// of smallest id; its other uses are marked visited. The type of the edge
+// from the i-th point of a cell to the next one is edgeTypes[cellOffsets[cellId] + i].
+void ClassifyEdges(vtkSmoothPolyDataFilter* self, vtkPolyData* mesh, vtkPoints* inPts,
+  const vtkIdType* cellOffsets, double cosFeatureAngle, signed char* edgeTypes)
+{
+  const vtkIdType numCells = mesh->GetNumberOfPolys();
+  const bool featureEdgeSmoothing = self->GetFeatureEdgeSmoothing() != 0;
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPThreadLocalObject<vtkIdList> tlNeiPts;
+  vtkSMPThreadLocalObject<vtkIdList> tlNeighbors;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    vtkIdList* neiPts = tlNeiPts.Local();
+    vtkIdList* neighbors = tlNeighbors.Local();
+    vtkIdType npts, numNeiPts;
+    const vtkIdType *pts, *neiPtIds;
+    double normal[3], neiNormal[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endCellId - cellId) / 10 + 1, (vtkIdType)1000);
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          self->CheckAbort();
+        }
+        if (self->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      mesh->GetCellPoints(cellId, npts, pts, cellPts);
+      signed char* types = edgeTypes + cellOffsets[cellId];
+      bool haveNormal = false;
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        mesh->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % npts], neighbors);
+        const vtkIdType numNei = neighbors->GetNumberOfIds();
+        if (numNei == 0)
+        {
+          types[i] = VTK_BOUNDARY_EDGE_VERTEX;
+        }
+        else if (numNei >= 2)
+        {
+          // non-manifold edges are feature edges
+          types[i] = std::all_of(neighbors->begin(), neighbors->end(),
+                       [cellId](vtkIdType nei) { return nei > cellId; })
+            ? VTK_FEATURE_EDGE_VERTEX
+            : VTK_VISITED_EDGE;
+        }
+        else if (neighbors->GetId(0) > cellId)
+        {
+          types[i] = VTK_SIMPLE_VERTEX;
+          if (featureEdgeSmoothing)
+          {
+            if (!haveNormal)
+            {
+              vtkPolygon::ComputeNormal(inPts, npts, pts, normal);
+              haveNormal = true;
+            }
+            mesh->GetCellPoints(neighbors->GetId(0), numNeiPts, neiPtIds, neiPts);
+            vtkPolygon::ComputeNormal(inPts, numNeiPts, neiPtIds, neiNormal);
+            if (vtkMath::Dot(normal, neiNormal) <= cosFeatureAngle)
+            {
+              types[i] = VTK_FEATURE_EDGE_VERTEX;
+            }
+          }
+        }
+        else
+        {
+          types[i] = VTK_VISITED_EDGE;
+        }
+      }
+    }
+  });
+}
+
+// Call func(neighborId, edgeType) for each classified polygon edge using a
+// point, in the order of the cells using it.
+template <typename TFunc>
+void ForEachPolygonEdge(vtkPolyData* mesh, const vtkIdType* cellOffsets,
+  const signed char* edgeTypes, vtkIdType ptId, vtkIdList* cellPts, TFunc&& func)
+{
+  vtkIdType ncells, npts;
+  vtkIdType* cells;
+  const vtkIdType* pts;
+  mesh->GetPointCells(ptId, ncells, cells);
+  for (vtkIdType c = 0; c < ncells; ++c)
+  {
+    // a cell using the point several times is listed once per use
+    if (c > 0 && cells[c] == cells[c - 1])
+    {
+      continue;
+    }
+    mesh->GetCellPoints(cells[c], npts, pts, cellPts);
+    const signed char* types = edgeTypes + cellOffsets[cells[c]];
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      if (pts[i] == ptId)
+      {
+        const vtkIdType prev = (i + npts - 1) % npts;
+        if (types[i] != VTK_VISITED_EDGE)
+        {
+          func(pts[(i + 1) % npts], types[i]);
+        }
+        if (types[prev] != VTK_VISITED_EDGE)
+        {
+          func(pts[prev], types[prev]);
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+struct vtkSPDF_ThreadedParams
+{
+  vtkSmoothPolyDataFilter* spdf;
+  int numberOfIterations;
+  vtkPoints* newPts;
+  T factor;
+  T conv;
+  vtkIdType numPts;
+  const char* types;
+  const vtkIdType* offsets;   // neighbors of point i are in [offsets[i], offsets[i+1])
+  const vtkIdType* neighbors; // connected point ids
+  vtkPolyData* source;
+  vtkSmoothPoints* SmoothPoints;
+  vtkAbstractCellLocator* cellLocator;
+};
+
+// Move the points toward the mean position of their neighbors. Each iteration
+// reads the positions of the previous one and writes into a second buffer, so
+// the points are moved in parallel and the result does not depend on the
+// number of threads.
+template <typename T>
+void vtkSPDF_MovePointsThreaded(vtkSPDF_ThreadedParams<T>& params)
+{
+  const vtkIdType numPts = params.numPts;
+  T* outCoords = static_cast<T*>(params.newPts->GetData()->GetVoidPointer(0));
+  std::vector<T> buffer(3 * numPts);
+  T* oldCoords = outCoords;
+  T* newCoords = buffer.data();
+
+  const int maxCellSize = params.source ? params.source->GetMaxCellSize() : 0;
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocal<std::vector<double>> tlWeights;
+  vtkSMPThreadLocal<T> tlMaxDist(0);
+
+  int iterationNumber = 0;
+  for (T maxDist = std::numeric_limits<T>::max();
+       maxDist > params.conv && iterationNumber < params.numberOfIterations; ++iterationNumber)
+  {
+    if (iterationNumber && !(iterationNumber % 5))
+    {
+      params.spdf->UpdateProgress(0.5 + 0.5 * iterationNumber / params.numberOfIterations);
+      if (params.spdf->CheckAbort())
+      {
+        break;
+      }
+    }
+
+    // For each non-fixed vertex of the mesh, move the point toward the mean
+    // position of its connected neighbors using the relaxation factor.
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      T& localMaxDist = tlMaxDist.Local();
+      vtkGenericCell* cell = tlCell.Local();
+      std::vector<double>& w = tlWeights.Local();
+      w.resize(maxCellSize);
+      double xNew[3], closestPt[3], dist2;
+      for (; ptId < endPtId; ++ptId)
+      {
+        const T* x = oldCoords + 3 * ptId;
+        T* y = newCoords + 3 * ptId;
+        const vtkIdType* nei = params.neighbors + params.offsets[ptId];
+        const vtkIdType npts = params.offsets[ptId + 1] - params.offsets[ptId];
+        if (params.types[ptId] == VTK_FIXED_VERTEX || npts == 0)
+        {
+          std::copy(x, x + 3, y);
+          continue;
+        }
+
+        // Compute the mean (cumulated) direction vector
+        T deltaX[3] = { 0, 0, 0 };
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          const T* xNei = oldCoords + 3 * nei[j];
+          deltaX[0] += xNei[0];
+          deltaX[1] += xNei[1];
+          deltaX[2] += xNei[2];
+        }
+
+        // Move the point
+        for (int k = 0; k < 3; ++k)
+        {
+          y[k] = x[k] + params.factor * (deltaX[k] / npts - x[k]);
+        }
+
+        // Constrain point to surface
+        if (params.source)
+        {
+          vtkSmoothPoint* sPtr = params.SmoothPoints->GetSmoothPoint(ptId);
+          xNew[0] = y[0];
+          xNew[1] = y[1];
+          xNew[2] = y[2];
+          if (sPtr->cellId >= 0)
+          {
+            params.source->GetCell(sPtr->cellId, cell);
+          }
+          if (sPtr->cellId < 0 ||
+            cell->EvaluatePosition(xNew, closestPt, sPtr->subId, sPtr->p, dist2, w.data()) == 0)
+          { // not in cell anymore
+            params.cellLocator->FindClosestPoint(
+              xNew, closestPt, cell, sPtr->cellId, sPtr->subId, dist2);
+          }
+          y[0] = static_cast<T>(closestPt[0]);
+          y[1] = static_cast<T>(closestPt[1]);
+          y[2] = static_cast<T>(closestPt[2]);
+        }
+
+        const T dist = std::sqrt(vtkMath::Distance2BetweenPoints(x, y));
+        if (dist > localMaxDist)
+        {
+          localMaxDist = dist;
+        }
+      } // for all points
+    });
+
+    maxDist = 0;
+    for (T& dist : tlMaxDist)
+    {
+      maxDist = std::max(maxDist, dist);
+      dist = 0;
+    }
+    std::swap(oldCoords, newCoords);
+  } // for not converged or within iteration count
+
+  if (oldCoords != outCoords)
+  {
+    std::copy(oldCoords, oldCoords + 3 * numPts, outCoords);
+  }
+
+  vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
+}
+
 } // namespace
 
 //------------------------------------------------------------------------------
@@ -306,20 +567,10 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   }
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts, numCells, i, numPolys, numStrips;
-  int j, k;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-  vtkIdType p1, p2;
-  double conv;
-  double x1[3], x2[3], x3[3], l1[3], l2[3];
-  double CosFeatureAngle; // Cosine of angle between adjacent polys
-  double CosEdgeAngle;    // Cosine of angle between adjacent edges
-  double closestPt[3], dist2;
-  vtkIdType numSimple = 0, numBEdges = 0, numFixed = 0, numFEdges = 0;
-  vtkPolyData* Mesh;
-  vtkPoints* inPts;
-  vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
+  vtkIdType numPts, numCells, i;
+  int j;
+  double x1[3], x2[3], x3[3];
+  vtkPoints* inPts = input->GetPoints();
 
   // Check input
   //
@@ -331,9 +582,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  CosFeatureAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
-  CosEdgeAngle = cos(vtkMath::RadiansFromDegrees(this->EdgeAngle));
-
   vtkDebugMacro(<< "Smoothing " << numPts << " vertices, " << numCells << " cells with:\n"
                 << "\tConvergence= " << this->Convergence << "\n"
                 << "\tIterations= " << this->NumberOfIterations << "\n"
@@ -352,6 +600,101 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  vtkNew<vtkPoints> newPts;
+
+  // Set the desired precision for the points in the output.
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+
+  if (this->SequentialProcessing)
+  {
+    this->SequentialSmooth(input, source, newPts);
+  }
+  else
+  {
+    this->ThreadedSmooth(input, source, newPts);
+  }
+
+  // Update output. Only point coordinates have changed.
+  //
+  output->GetPointData()->PassData(input->GetPointData());
+  output->GetCellData()->PassData(input->GetCellData());
+
+  if (this->GenerateErrorScalars)
+  {
+    vtkNew<vtkFloatArray> newScalars;
+    newScalars->SetNumberOfTuples(numPts);
+    for (i = 0; i < numPts; i++)
+    {
+      inPts->GetPoint(i, x1);
+      newPts->GetPoint(i, x2);
+      newScalars->SetComponent(i, 0, sqrt(vtkMath::Distance2BetweenPoints(x1, x2)));
+    }
+    int idx = output->GetPointData()->AddArray(newScalars);
+    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+  }
+
+  if (this->GenerateErrorVectors)
+  {
+    vtkNew<vtkFloatArray> newVectors;
+    newVectors->SetNumberOfComponents(3);
+    newVectors->SetNumberOfTuples(numPts);
+    for (i = 0; i < numPts; i++)
+    {
+      inPts->GetPoint(i, x1);
+      newPts->GetPoint(i, x2);
+      for (j = 0; j < 3; j++)
+      {
+        x3[j] = x2[j] - x1[j];
+      }
+      newVectors->SetTuple(i, x3);
+    }
+    output->GetPointData()->SetVectors(newVectors);
+  }
+
+  output->SetPoints(newPts);
+
+  output->SetVerts(input->GetVerts());
+  output->SetLines(input->GetLines());
+  output->SetPolys(input->GetPolys());
+  output->SetStrips(input->GetStrips());
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkSmoothPolyDataFilter::SequentialSmooth(
+  vtkPolyData* input, vtkPolyData* source, vtkPoints* newPts)
+{
+  vtkIdType numPts, i, numPolys, numStrips;
+  int j, k;
+  vtkIdType npts = 0;
+  const vtkIdType* pts = nullptr;
+  vtkIdType p1, p2;
+  double conv;
+  double x1[3], x2[3], x3[3], l1[3], l2[3];
+  double CosFeatureAngle; // Cosine of angle between adjacent polys
+  double CosEdgeAngle;    // Cosine of angle between adjacent edges
+  double closestPt[3], dist2;
+  vtkIdType numSimple = 0, numBEdges = 0, numFixed = 0, numFEdges = 0;
+  vtkPolyData* Mesh;
+  vtkPoints* inPts;
+  vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
+
+  numPts = input->GetNumberOfPoints();
+  CosFeatureAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
+  CosEdgeAngle = cos(vtkMath::RadiansFromDegrees(this->EdgeAngle));
+
   // Perform topological analysis. What we're gonna do is build a connectivity
   // array of connected vertices. The outcome will be one of three
   // classifications for a vertex: VTK_SIMPLE_VERTEX, VTK_FIXED_VERTEX. or
@@ -645,22 +988,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   // We've setup the topology...now perform Laplacian smoothing
   //
-  vtkNew<vtkPoints> newPts;
-
-  // Set the desired precision for the points in the output.
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-  {
-    newPts->SetDataType(inPts->GetDataType());
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_DOUBLE);
-  }
-
   newPts->SetNumberOfPoints(numPts);
 
   // If a Source is defined, we do constrained smoothing (that is, points are
@@ -713,61 +1040,341 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   // Release memory if it's been allocated
   this->SmoothPoints.reset(nullptr);
 
-  // Update output. Only point coordinates have changed.
+  // free up connectivity storage
+  for (i = 0; i < numPts; i++)
+  {
+    if (Verts[i].edges)
+    {
+      Verts[i].edges->Delete();
+      Verts[i].edges = nullptr;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkSmoothPolyDataFilter::ThreadedSmooth(
+  vtkPolyData* input, vtkPolyData* source, vtkPoints* newPts)
+{
+  vtkIdType numPts, i, numPolys, numStrips;
+  int j;
+  vtkIdType npts = 0;
+  const vtkIdType* pts = nullptr;
+  double conv;
+  double CosFeatureAngle; // Cosine of angle between adjacent polys
+  double CosEdgeAngle;    // Cosine of angle between adjacent edges
+  vtkPolyData* Mesh = nullptr;
+  vtkPoints* inPts;
+  vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
+
+  numPts = input->GetNumberOfPoints();
+  CosFeatureAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
+  CosEdgeAngle = cos(vtkMath::RadiansFromDegrees(this->EdgeAngle));
+
+  // Perform topological analysis. What we're gonna do is build a connectivity
+  // array of connected vertices. The outcome will be one of three
+  // classifications for a vertex: VTK_SIMPLE_VERTEX, VTK_FIXED_VERTEX. or
+  // VTK_EDGE_VERTEX. Simple vertices are smoothed using all connected
+  // vertices. FIXED vertices are never smoothed. Edge vertices are smoothed
+  // using a subset of the attached vertices. The connected vertices are
+  // stored in compressed sparse row layout, and are gathered in parallel.
   //
-  output->GetPointData()->PassData(input->GetPointData());
-  output->GetCellData()->PassData(input->GetCellData());
+  vtkDebugMacro(<< "Analyzing topology...");
 
-  if (this->GenerateErrorScalars)
+  std::vector<char> types(numPts, VTK_SIMPLE_VERTEX);
+  // the two neighbors of the vertices inside a line, -1 for the others
+  std::vector<vtkIdType> lineNeighbors;
+
+  inPts = input->GetPoints();
+  conv = this->Convergence * input->GetLength();
+
+  // check vertices first. Vertices are never smoothed_--------------
+  for (inVerts = input->GetVerts(), inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts);)
   {
-    vtkNew<vtkFloatArray> newScalars;
-    newScalars->SetNumberOfTuples(numPts);
-    for (i = 0; i < numPts; i++)
+    for (j = 0; j < npts; j++)
     {
-      inPts->GetPoint(i, x1);
-      newPts->GetPoint(i, x2);
-      newScalars->SetComponent(i, 0, sqrt(vtkMath::Distance2BetweenPoints(x1, x2)));
+      types[pts[j]] = VTK_FIXED_VERTEX;
     }
-    int idx = output->GetPointData()->AddArray(newScalars);
-    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
   }
+  this->UpdateProgress(0.10);
+  vtkIdType checkAbortInterval = std::min(input->GetNumberOfLines() / 10 + 1, (vtkIdType)1000);
+  vtkIdType progressCounter = 0;
 
-  if (this->GenerateErrorVectors)
+  // now check lines. Only manifold lines can be smoothed------------
+  inLines = input->GetLines();
+  if (inLines->GetNumberOfCells() > 0)
   {
-    vtkNew<vtkFloatArray> newVectors;
-    newVectors->SetNumberOfComponents(3);
-    newVectors->SetNumberOfTuples(numPts);
-    for (i = 0; i < numPts; i++)
+    lineNeighbors.resize(2 * numPts, -1);
+  }
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts);)
+  {
+    if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
     {
-      inPts->GetPoint(i, x1);
-      newPts->GetPoint(i, x2);
-      for (j = 0; j < 3; j++)
+      break;
+    }
+    progressCounter++;
+    for (j = 0; j < npts; j++)
+    {
+      if (types[pts[j]] == VTK_SIMPLE_VERTEX)
       {
-        x3[j] = x2[j] - x1[j];
+        if (j == (npts - 1) || j == 0) // end-of-line marked FIXED
+        {
+          types[pts[j]] = VTK_FIXED_VERTEX;
+        }
+        else // is edge vertex (unless already edge vertex!)
+        {
+          types[pts[j]] = VTK_FEATURE_EDGE_VERTEX;
+          lineNeighbors[2 * pts[j]] = pts[j - 1];
+          lineNeighbors[2 * pts[j] + 1] = pts[j + 1];
+        }
+      } // if simple vertex
+
+      else if (types[pts[j]] == VTK_FEATURE_EDGE_VERTEX)
+      { // multiply connected, becomes fixed!
+        types[pts[j]] = VTK_FIXED_VERTEX;
+        lineNeighbors[2 * pts[j]] = lineNeighbors[2 * pts[j] + 1] = -1;
       }
-      newVectors->SetTuple(i, x3);
+
+    } // for all points in this line
+  }   // for all lines
+  this->UpdateProgress(0.25);
+
+  // now polygons and triangle strips-------------------------------
+  inPolys = input->GetPolys();
+  numPolys = inPolys->GetNumberOfCells();
+  inStrips = input->GetStrips();
+  numStrips = inStrips->GetNumberOfCells();
+
+  vtkNew<vtkPolyData> inMesh;
+  vtkSmartPointer<vtkTriangleFilter> toTris;
+  std::vector<vtkIdType> cellOffsets;
+  std::vector<signed char> edgeTypes;
+  if (numPolys > 0 || numStrips > 0)
+  { // build cell structure
+    inMesh->SetPoints(inPts);
+    inMesh->SetPolys(inPolys);
+    Mesh = inMesh;
+
+    if (numStrips > 0)
+    { // convert data to triangles
+      inMesh->SetStrips(inStrips);
+      toTris.TakeReference(vtkTriangleFilter::New());
+      toTris->SetInputData(inMesh);
+      toTris->Update();
+      Mesh = toTris->GetOutput();
     }
-    output->GetPointData()->SetVectors(newVectors);
-  }
 
-  output->SetPoints(newPts);
+    Mesh->BuildLinks(); // to do neighborhood searching
+    vtkCellArray* polys = Mesh->GetPolys();
+    numPolys = polys->GetNumberOfCells();
+    this->UpdateProgress(0.375);
 
-  output->SetVerts(input->GetVerts());
-  output->SetLines(input->GetLines());
-  output->SetPolys(input->GetPolys());
-  output->SetStrips(input->GetStrips());
+    cellOffsets.resize(numPolys + 1);
+    cellOffsets[0] = 0;
+    for (i = 0; i < numPolys; i++)
+    {
+      cellOffsets[i + 1] = cellOffsets[i] + polys->GetCellSize(i);
+    }
+    edgeTypes.resize(cellOffsets[numPolys]);
+    ClassifyEdges(this, Mesh, inPts, cellOffsets.data(), CosFeatureAngle, edgeTypes.data());
+  } // if strips or polys
 
-  // free up connectivity storage
+  // Count the connected vertices of each vertex, and find its type from the
+  // types of the edges using it: edge vertices are only connected through
+  // their feature or boundary edges, and through the line they belong to.
+  std::vector<vtkIdType> offsets(numPts + 1);
+  offsets[0] = 0;
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType count = 0;
+      if (types[ptId] != VTK_FIXED_VERTEX)
+      {
+        vtkIdType numEdges = 0, numSimpleEdges = 0;
+        bool boundary = false;
+        if (Mesh)
+        {
+          ForEachPolygonEdge(Mesh, cellOffsets.data(), edgeTypes.data(), ptId, cellPts,
+            [&](vtkIdType, signed char edge) {
+              if (edge == VTK_SIMPLE_VERTEX)
+              {
+                ++numSimpleEdges;
+              }
+              else
+              {
+                ++numEdges;
+                boundary |= edge == VTK_BOUNDARY_EDGE_VERTEX;
+              }
+            });
+        }
+        if (types[ptId] == VTK_FEATURE_EDGE_VERTEX)
+        {
+          count = 2 + numEdges;
+        }
+        else
+        {
+          count = numEdges > 0 ? numEdges : numSimpleEdges;
+        }
+        if (numEdges > 0)
+        {
+          types[ptId] = boundary ? VTK_BOUNDARY_EDGE_VERTEX : VTK_FEATURE_EDGE_VERTEX;
+        }
+      }
+      offsets[ptId + 1] = count;
+    }
+  });
   for (i = 0; i < numPts; i++)
   {
-    if (Verts[i].edges)
+    offsets[i + 1] += offsets[i];
+  }
+  this->UpdateProgress(0.45);
+
+  // Gather the connected vertices, and post-process edge vertices to make
+  // sure we can smooth them.
+  std::vector<vtkIdType> neighbors(offsets[numPts]);
+  const bool boundarySmoothing = this->BoundarySmoothing != 0;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    double y1[3], y2[3], y3[3], l1[3], l2[3];
+    for (; ptId < endPtId; ++ptId)
     {
-      Verts[i].edges->Delete();
-      Verts[i].edges = nullptr;
+      char& type = types[ptId];
+      if (type == VTK_FIXED_VERTEX)
+      {
+        continue;
+      }
+      vtkIdType* nei = neighbors.data() + offsets[ptId];
+      vtkIdType count = 0;
+      if (!lineNeighbors.empty() && lineNeighbors[2 * ptId] >= 0)
+      {
+        nei[count++] = lineNeighbors[2 * ptId];
+        nei[count++] = lineNeighbors[2 * ptId + 1];
+      }
+      if (Mesh)
+      {
+        const bool edgeVertex = type != VTK_SIMPLE_VERTEX;
+        ForEachPolygonEdge(Mesh, cellOffsets.data(), edgeTypes.data(), ptId, cellPts,
+          [&](vtkIdType neiId, signed char edge) {
+            if ((edge != VTK_SIMPLE_VERTEX) == edgeVertex)
+            {
+              nei[count++] = neiId;
+            }
+          });
+      }
+
+      if (type == VTK_FEATURE_EDGE_VERTEX || type == VTK_BOUNDARY_EDGE_VERTEX)
+      { // see how many edges; if two, what the angle is
+        if (!boundarySmoothing && type == VTK_BOUNDARY_EDGE_VERTEX)
+        {
+          type = VTK_FIXED_VERTEX;
+        }
+        else if (count != 2)
+        {
+          type = VTK_FIXED_VERTEX;
+        }
+        else // check angle between edges
+        {
+          inPts->GetPoint(nei[0], y1);
+          inPts->GetPoint(ptId, y2);
+          inPts->GetPoint(nei[1], y3);
+          for (int k = 0; k < 3; k++)
+          {
+            l1[k] = y2[k] - y1[k];
+            l2[k] = y3[k] - y2[k];
+          }
+          if (vtkMath::Normalize(l1) >= 0.0 && vtkMath::Normalize(l2) >= 0.0 &&
+            vtkMath::Dot(l1, l2) < CosEdgeAngle)
+          {
+            type = VTK_FIXED_VERTEX;
+          }
+        }
+      } // if edge vertex
+    }   // for all points
+  });
+  this->UpdateProgress(0.50);
+
+  vtkDebugMacro(<< "Found\n\t" << std::count(types.begin(), types.end(), VTK_SIMPLE_VERTEX)
+                << " simple vertices\n\t"
+                << std::count(types.begin(), types.end(), VTK_FEATURE_EDGE_VERTEX)
+                << " feature edge vertices\n\t"
+                << std::count(types.begin(), types.end(), VTK_BOUNDARY_EDGE_VERTEX)
+                << " boundary edge vertices\n\t"
+                << std::count(types.begin(), types.end(), VTK_FIXED_VERTEX)
+                << " fixed vertices\n\t");
+
+  vtkDebugMacro(<< "Beginning smoothing iterations...");
+
+  // We've setup the topology...now perform Laplacian smoothing
+  //
+  // the smoothing works on float or double coordinates
+  if (newPts->GetDataType() != VTK_DOUBLE)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+
+  newPts->SetNumberOfPoints(numPts);
+
+  // If a Source is defined, we do constrained smoothing (that is, points are
+  // constrained to the surface of the mesh object). The static cell locator
+  // and the generic cells make the projections thread-safe.
+  vtkSmartPointer<vtkStaticCellLocator> cellLocator;
+  if (source)
+  {
+    this->SmoothPoints = std::unique_ptr<vtkSmoothPoints>(new vtkSmoothPoints);
+    this->SmoothPoints->InsertSmoothPoint(numPts - 1);
+    cellLocator.TakeReference(vtkStaticCellLocator::New());
+    cellLocator->SetDataSet(source);
+    cellLocator->BuildLocator();
+    if (source->NeedToBuildCells())
+    {
+      source->BuildCells();
     }
+
+    vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      vtkGenericCell* cell = tlCell.Local();
+      double x[3], closestPt[3], dist2;
+      for (; ptId < endPtId; ++ptId)
+      {
+        vtkSmoothPoint* sPtr = this->SmoothPoints->GetSmoothPoint(ptId);
+        inPts->GetPoint(ptId, x);
+        cellLocator->FindClosestPoint(x, closestPt, cell, sPtr->cellId, sPtr->subId, dist2);
+        newPts->SetPoint(ptId, closestPt);
+      }
+    });
+  }
+  else // smooth normally
+  {
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x[3];
+      for (; ptId < endPtId; ++ptId) // initialize to old coordinates
+      {
+        inPts->GetPoint(ptId, x);
+        newPts->SetPoint(ptId, x);
+      }
+    });
   }
 
-  return 1;
+  if (newPts->GetDataType() == VTK_DOUBLE)
+  {
+    vtkSPDF_ThreadedParams<double> params = { this, this->NumberOfIterations, newPts,
+      this->RelaxationFactor, conv, numPts, types.data(), offsets.data(), neighbors.data(), source,
+      this->SmoothPoints.get(), cellLocator };
+
+    vtkSPDF_MovePointsThreaded(params);
+  }
+  else
+  {
+    vtkSPDF_ThreadedParams<float> params = { this, this->NumberOfIterations, newPts,
+      static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, types.data(),
+      offsets.data(), neighbors.data(), source, this->SmoothPoints.get(), cellLocator };
+
+    vtkSPDF_MovePointsThreaded(params);
+  }
+
+  // Release memory if it's been allocated
+  this->SmoothPoints.reset(nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -809,5 +1416,6 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -79,6 +79,15 @@
  *
  *
  * @warning
+ * By default, the points are moved in place, one after the other, so each
+ * point is moved toward the positions its neighbors already reached during
+ * the same iteration. When SequentialProcessing is off, the smoothing is
+ * threaded with vtkSMPTools: each iteration moves the points from their
+ * positions at the end of the previous iteration, so the result does not
+ * depend on the number of threads, or on the order of the points, but
+ * differs slightly from the in-place smoothing.
+ *
+ * @warning
  * The Laplacian operation reduces high frequency information in the geometry
  * of the mesh. With excessive smoothing important details may be lost, and
  * the surface may shrink towards the centroid. Enabling FeatureEdgeSmoothing
@@ -100,6 +109,7 @@
 #include <memory> // For std::unique_ptr<>
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkPoints;
 class vtkSmoothPoints;
 
 class VTKFILTERSCORE_EXPORT vtkSmoothPolyDataFilter : public vtkPolyDataAlgorithm
@@ -225,6 +235,19 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the smoothing, which
+   * then moves the points in place. By default, sequential processing is on,
+   * so that the output matches the one of previous versions. Turn it off to
+   * smooth with threads; the smoothed points then differ slightly, as
+   * explained in the class documentation.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkSmoothPolyDataFilter();
   ~vtkSmoothPolyDataFilter() override;
@@ -232,6 +255,17 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int port, vtkInformation* info) override;
 
+  ///@{
+  /**
+   * Smooth the points of the input into newPts, whose data type is set by
+   * the caller. SequentialSmooth() moves the points in place, one after the
+   * other, and ThreadedSmooth() moves them with vtkSMPTools from their
+   * positions at the previous iteration.
+   */
+  void SequentialSmooth(vtkPolyData* input, vtkPolyData* source, vtkPoints* newPts);
+  void ThreadedSmooth(vtkPolyData* input, vtkPolyData* source, vtkPoints* newPts);
+  ///@}
+
   double Convergence;
   int NumberOfIterations;
   double RelaxationFactor;
@@ -242,6 +276,7 @@ protected:
   vtkTypeBool GenerateErrorScalars;
   vtkTypeBool GenerateErrorVectors;
   int OutputPointsPrecision;
+  bool SequentialProcessing;
 
   std::unique_ptr<vtkSmoothPoints> SmoothPoints;
 
@@ -0,0 +1,404 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurveReorder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpaceFillingCurveReorder.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// Fill an ordering with the identity permutation.
+void IdentityOrdering(vtkIdType num, vtkIdTypeArray* order)
+{
+  order->SetNumberOfTuples(num);
+  vtkIdType* ids = order->GetPointer(0);
+  vtkSMPTools::For(0, num, [&](vtkIdType begin, vtkIdType end) {
+    std::iota(ids + begin, ids + end, begin);
+  });
+}
+
+//------------------------------------------------------------------------------
+// Gather the tuples of an array along an ordering: out[i] = in[order[i]].
+struct PermuteTuplesWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* inArray, OutArrayT* outArray, const vtkIdType* order)
+  {
+    const auto inTuples = vtk::DataArrayTupleRange(inArray);
+    auto outTuples = vtk::DataArrayTupleRange(outArray);
+    vtkSMPTools::For(0, outTuples.size(), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        outTuples[i] = inTuples[order[i]];
+      }
+    });
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPoints> PermutePoints(vtkPoints* inPts, const vtkIdType* order)
+{
+  auto outPts = vtkSmartPointer<vtkPoints>::New();
+  outPts->SetDataType(inPts->GetDataType());
+  outPts->SetNumberOfPoints(inPts->GetNumberOfPoints());
+
+  using Dispatcher = vtkArrayDispatch::Dispatch2SameValueType;
+  PermuteTuplesWorker worker;
+  if (!Dispatcher::Execute(inPts->GetData(), outPts->GetData(), worker, order))
+  {
+    worker(inPts->GetData(), outPts->GetData(), order);
+  }
+  return outPts;
+}
+
+//------------------------------------------------------------------------------
+// Gather all the attributes along an ordering. The data arrays are gathered
+// in parallel; the other arrays (strings, variants, bits), which ArrayList
+// does not handle or cannot write concurrently, are gathered serially.
+void PermuteAttributes(
+  vtkDataSetAttributes* inAttr, vtkDataSetAttributes* outAttr, vtkIdTypeArray* order)
+{
+  const vtkIdType num = order->GetNumberOfTuples();
+  outAttr->CopyAllOn();
+  outAttr->CopyAllocate(inAttr, num);
+
+  ArrayList arrays;
+  std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*>> serialArrays;
+  // All the arrays are copied, so the output arrays are in the input order
+  // unless arrays with the same name replaced each other.
+  const bool sameOrder = outAttr->GetNumberOfArrays() == inAttr->GetNumberOfArrays();
+  for (int i = 0; i < outAttr->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* outArray = outAttr->GetAbstractArray(i);
+    if (!vtkArrayDownCast<vtkDataArray>(outArray) || outArray->GetDataType() == VTK_BIT)
+    {
+      vtkAbstractArray* inArray = sameOrder ? inAttr->GetAbstractArray(i)
+                                            : inAttr->GetAbstractArray(outArray->GetName());
+      arrays.ExcludeArray(outArray);
+      if (inArray)
+      {
+        serialArrays.emplace_back(inArray, outArray);
+      }
+    }
+  }
+  arrays.AddArrays(num, inAttr, outAttr, /*nullValue*/ 0.0, /*promote*/ false);
+
+  const vtkIdType* ids = order->GetPointer(0);
+  vtkSMPTools::For(0, num, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      arrays.Copy(ids[i], i);
+    }
+  });
+
+  for (const auto& pair : serialArrays)
+  {
+    pair.second->SetNumberOfTuples(num);
+    for (vtkIdType i = 0; i < num; ++i)
+    {
+      pair.second->SetTuple(i, ids[i], pair.first);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Build a new cell array containing the cells of inCells in the given order,
+// with their point ids renumbered through pointMap. The ordering references
+// cell ids shifted by offset.
+vtkSmartPointer<vtkCellArray> PermuteCells(vtkCellArray* inCells, const vtkIdType* order,
+  vtkIdType offset, const vtkIdType* pointMap)
+{
+  const vtkIdType numCells = inCells->GetNumberOfCells();
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfTuples(numCells + 1);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      offsetsPtr[cellId] = inCells->GetCellSize(order[cellId] - offset);
+    }
+  });
+
+  // Prefix sum of the cell sizes.
+  vtkIdType connSize = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    const vtkIdType size = offsetsPtr[cellId];
+    offsetsPtr[cellId] = connSize;
+    connSize += size;
+  }
+  offsetsPtr[numCells] = connSize;
+
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfTuples(connSize);
+  vtkIdType* connPtr = connectivity->GetPointer(0);
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* idList = tlIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      inCells->GetCellAtId(order[cellId] - offset, npts, pts, idList);
+      vtkIdType* outPts = connPtr + offsetsPtr[cellId];
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        outPts[i] = pointMap[pts[i]];
+      }
+    }
+  });
+
+  auto outCells = vtkSmartPointer<vtkCellArray>::New();
+  outCells->SetData(offsets, connectivity);
+  return outCells;
+}
+
+//------------------------------------------------------------------------------
+void PermuteUnstructuredGridCells(vtkUnstructuredGrid* input, vtkUnstructuredGrid* output,
+  vtkIdTypeArray* cellOrder, const vtkIdType* pointMap)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType* order = cellOrder->GetPointer(0);
+
+  if (input->GetFaces())
+  {
+    // Polyhedral cells carry a face stream that is rebuilt cell by cell.
+    output->AllocateExact(numCells, input->GetCells()->GetNumberOfConnectivityIds());
+    vtkNew<vtkIdList> ptIds;
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      const vtkIdType inCellId = order[cellId];
+      const int cellType = input->GetCellType(inCellId);
+      if (cellType == VTK_POLYHEDRON)
+      {
+        input->GetFaceStream(inCellId, ptIds);
+        vtkIdType* stream = ptIds->GetPointer(0);
+        const vtkIdType nfaces = *stream++;
+        for (vtkIdType face = 0; face < nfaces; ++face)
+        {
+          const vtkIdType npts = *stream++;
+          for (vtkIdType i = 0; i < npts; ++i, ++stream)
+          {
+            *stream = pointMap[*stream];
+          }
+        }
+        output->InsertNextCell(cellType, nfaces, ptIds->GetPointer(1));
+      }
+      else
+      {
+        input->GetCellPoints(inCellId, ptIds);
+        for (vtkIdType& ptId : *ptIds)
+        {
+          ptId = pointMap[ptId];
+        }
+        output->InsertNextCell(cellType, ptIds);
+      }
+    }
+    return;
+  }
+
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfTuples(numCells);
+  vtkUnsignedCharArray* inTypes = input->GetCellTypesArray();
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      types->SetValue(cellId, inTypes->GetValue(order[cellId]));
+    }
+  });
+
+  auto cells = PermuteCells(input->GetCells(), order, 0, pointMap);
+  output->SetCells(types, cells);
+}
+
+//------------------------------------------------------------------------------
+void PermutePolyDataCells(
+  vtkPolyData* input, vtkPolyData* output, vtkIdTypeArray* cellOrder, const vtkIdType* pointMap)
+{
+  // Cells were only sorted inside of each cell array, so each of them is a
+  // contiguous slice of the ordering.
+  const vtkIdType* order = cellOrder->GetPointer(0);
+  vtkIdType offset = 0;
+
+  vtkCellArray* verts = input->GetVerts();
+  output->SetVerts(PermuteCells(verts, order + offset, offset, pointMap));
+  offset += verts->GetNumberOfCells();
+
+  vtkCellArray* lines = input->GetLines();
+  output->SetLines(PermuteCells(lines, order + offset, offset, pointMap));
+  offset += lines->GetNumberOfCells();
+
+  vtkCellArray* polys = input->GetPolys();
+  output->SetPolys(PermuteCells(polys, order + offset, offset, pointMap));
+  offset += polys->GetNumberOfCells();
+
+  vtkCellArray* strips = input->GetStrips();
+  output->SetStrips(PermuteCells(strips, order + offset, offset, pointMap));
+}
+
+//------------------------------------------------------------------------------
+void AddOriginalIds(vtkDataSetAttributes* attr, vtkIdTypeArray* order, const char* name)
+{
+  vtkNew<vtkIdTypeArray> originalIds;
+  originalIds->DeepCopy(order);
+  originalIds->SetName(name);
+  attr->AddArray(originalIds);
+}
+} // anonymous namespace
+
+vtkStandardNewMacro(vtkSpaceFillingCurveReorder);
+
+//------------------------------------------------------------------------------
+vtkSpaceFillingCurveReorder::vtkSpaceFillingCurveReorder()
+{
+  this->SetOriginalPointIdsArrayName("vtkOriginalPointIds");
+  this->SetOriginalCellIdsArrayName("vtkOriginalCellIds");
+}
+
+//------------------------------------------------------------------------------
+vtkSpaceFillingCurveReorder::~vtkSpaceFillingCurveReorder()
+{
+  this->SetOriginalPointIdsArrayName(nullptr);
+  this->SetOriginalCellIdsArrayName(nullptr);
+}
+
+//------------------------------------------------------------------------------
+int vtkSpaceFillingCurveReorder::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkSpaceFillingCurveReorder::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPointSet* input = vtkPointSet::GetData(inputVector[0]);
+  vtkPointSet* output = vtkPointSet::GetData(outputVector);
+  vtkPolyData* inputPD = vtkPolyData::SafeDownCast(input);
+  vtkUnstructuredGrid* inputUG = vtkUnstructuredGrid::SafeDownCast(input);
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  if (numPts == 0 || (!this->ReorderPoints && !this->ReorderCells))
+  {
+    output->ShallowCopy(input);
+    return 1;
+  }
+
+  // Compute the orderings: order[newId] = oldId
+  vtkNew<vtkIdTypeArray> pointOrder;
+  if (this->ReorderPoints)
+  {
+    vtkSpaceFillingCurve::SortPoints(input->GetPoints(), this->CurveType, pointOrder);
+  }
+  else
+  {
+    ::IdentityOrdering(numPts, pointOrder);
+  }
+  this->UpdateProgress(0.2);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  vtkNew<vtkIdTypeArray> cellOrder;
+  if (this->ReorderCells)
+  {
+    vtkSpaceFillingCurve::SortCells(input, this->CurveType, cellOrder);
+  }
+  else
+  {
+    ::IdentityOrdering(numCells, cellOrder);
+  }
+  this->UpdateProgress(0.4);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Geometry and point data
+  output->SetPoints(::PermutePoints(input->GetPoints(), pointOrder->GetPointer(0)));
+  ::PermuteAttributes(input->GetPointData(), output->GetPointData(), pointOrder);
+  this->UpdateProgress(0.6);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Topology and cell data
+  vtkNew<vtkIdList> pointMap;
+  vtkSpaceFillingCurve::InvertOrdering(pointOrder, pointMap);
+  if (inputPD)
+  {
+    ::PermutePolyDataCells(
+      inputPD, vtkPolyData::SafeDownCast(output), cellOrder, pointMap->GetPointer(0));
+  }
+  else if (inputUG)
+  {
+    ::PermuteUnstructuredGridCells(
+      inputUG, vtkUnstructuredGrid::SafeDownCast(output), cellOrder, pointMap->GetPointer(0));
+  }
+  ::PermuteAttributes(input->GetCellData(), output->GetCellData(), cellOrder);
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+  this->UpdateProgress(0.9);
+
+  if (this->GenerateOriginalIds)
+  {
+    ::AddOriginalIds(output->GetPointData(), pointOrder, this->OriginalPointIdsArrayName);
+    ::AddOriginalIds(output->GetCellData(), cellOrder, this->OriginalCellIdsArrayName);
+  }
+  this->UpdateProgress(1.0);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkSpaceFillingCurveReorder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CurveType: "
+     << (this->CurveType == vtkSpaceFillingCurve::HILBERT ? "Hilbert" : "Morton") << endl;
+  os << indent << "ReorderPoints: " << this->ReorderPoints << endl;
+  os << indent << "ReorderCells: " << this->ReorderCells << endl;
+  os << indent << "GenerateOriginalIds: " << this->GenerateOriginalIds << endl;
+  os << indent << "OriginalPointIdsArrayName: "
+     << (this->OriginalPointIdsArrayName ? this->OriginalPointIdsArrayName : "(null)") << endl;
+  os << indent << "OriginalCellIdsArrayName: "
+     << (this->OriginalCellIdsArrayName ? this->OriginalCellIdsArrayName : "(null)") << endl;
+}
+VTK_ABI_NAMESPACE_END
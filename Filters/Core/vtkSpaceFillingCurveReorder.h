@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurveReorder.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSpaceFillingCurveReorder
+ * @brief   renumber points and cells along a space-filling curve
+ *
+ * vtkSpaceFillingCurveReorder renumbers the points and/or the cells of a
+ * vtkPolyData or vtkUnstructuredGrid so that they are ordered along a Morton
+ * (Z-order) or Hilbert curve. The geometry is left unchanged: only the
+ * numbering of points and cells changes, and all point and cell attributes
+ * are permuted consistently. Since entities close in memory are then close in
+ * space, downstream algorithms gathering point values through the cell
+ * connectivity (vtkCellDataToPointData, contouring, rendering...) suffer far
+ * fewer cache misses on meshes that originally had an essentially random
+ * numbering.
+ *
+ * Cells of a vtkPolyData are only reordered within each of the vertex, line,
+ * polygon and strip cell arrays. Optionally, the filter generates arrays of
+ * original point and cell ids so that results computed on the reordered mesh
+ * can be mapped back to the original numbering.
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
+ * @sa
+ * vtkSpaceFillingCurve vtkRemoveUnusedPoints
+ */
+
+#ifndef vtkSpaceFillingCurveReorder_h
+#define vtkSpaceFillingCurveReorder_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkPointSetAlgorithm.h"
+#include "vtkSpaceFillingCurve.h" // For CurveType
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKFILTERSCORE_EXPORT vtkSpaceFillingCurveReorder : public vtkPointSetAlgorithm
+{
+public:
+  static vtkSpaceFillingCurveReorder* New();
+  vtkTypeMacro(vtkSpaceFillingCurveReorder, vtkPointSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Specify the curve used to order points and cells: either
+   * vtkSpaceFillingCurve::MORTON or vtkSpaceFillingCurve::HILBERT.
+   * The Hilbert curve has better locality. Default is HILBERT.
+   */
+  vtkSetClampMacro(CurveType, int, vtkSpaceFillingCurve::MORTON, vtkSpaceFillingCurve::HILBERT);
+  vtkGetMacro(CurveType, int);
+  void SetCurveTypeToMorton() { this->SetCurveType(vtkSpaceFillingCurve::MORTON); }
+  void SetCurveTypeToHilbert() { this->SetCurveType(vtkSpaceFillingCurve::HILBERT); }
+  ///@}
+
+  ///@{
+  /**
+   * Enable/disable the renumbering of points. Default is true.
+   */
+  vtkSetMacro(ReorderPoints, bool);
+  vtkGetMacro(ReorderPoints, bool);
+  vtkBooleanMacro(ReorderPoints, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Enable/disable the renumbering of cells. Default is true.
+   */
+  vtkSetMacro(ReorderCells, bool);
+  vtkGetMacro(ReorderCells, bool);
+  vtkBooleanMacro(ReorderCells, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Enable adding `vtkOriginalPointIds` and `vtkOriginalCellIds` arrays to the
+   * point and cell data, which identify the original index of each point and
+   * cell. Default is false.
+   */
+  vtkSetMacro(GenerateOriginalIds, bool);
+  vtkGetMacro(GenerateOriginalIds, bool);
+  vtkBooleanMacro(GenerateOriginalIds, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Choose the names of the original point and cell ids arrays. Defaults are
+   * `vtkOriginalPointIds` and `vtkOriginalCellIds`. These are used only when
+   * `GenerateOriginalIds` is true.
+   */
+  vtkSetStringMacro(OriginalPointIdsArrayName);
+  vtkGetStringMacro(OriginalPointIdsArrayName);
+  vtkSetStringMacro(OriginalCellIdsArrayName);
+  vtkGetStringMacro(OriginalCellIdsArrayName);
+  ///@}
+
+protected:
+  vtkSpaceFillingCurveReorder();
+  ~vtkSpaceFillingCurveReorder() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  int CurveType = vtkSpaceFillingCurve::HILBERT;
+  bool ReorderPoints = true;
+  bool ReorderCells = true;
+  bool GenerateOriginalIds = false;
+  char* OriginalPointIdsArrayName = nullptr;
+  char* OriginalCellIdsArrayName = nullptr;
+
+private:
+  vtkSpaceFillingCurveReorder(const vtkSpaceFillingCurveReorder&) = delete;
+  void operator=(const vtkSpaceFillingCurveReorder&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -14,18 +14,30 @@
 =========================================================================*/
 #include "vtkTubeFilter.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTubeFilter);
@@ -52,6 +64,7 @@ vtkTubeFilter::vtkTubeFilter()
   this->TextureLength = 1.0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(
@@ -239,68 +252,72 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
   // the line cellIds start after the last vert cellId
   inCellId = input->GetNumberOfVerts();
-  int checkAbortInterval = std::min(numLines / 10 + 1, (vtkIdType)1000);
-  int progressCounter = 0;
-  for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
+  if (!this->ThreadedGenerate(input, outPD, outCD, inScalars, range, inVectors, maxSpeed, inNormals,
+        generateNormals != 0, newPts, newNormals, newTCoords, newStrips))
   {
-    this->UpdateProgress((double)inCellId / numLines);
-    if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
+    int checkAbortInterval = std::min(numLines / 10 + 1, (vtkIdType)1000);
+    int progressCounter = 0;
+    for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
     {
-      abort = this->CheckAbort();
-      break;
-    }
-    progressCounter++;
+      this->UpdateProgress((double)inCellId / numLines);
+      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
+      {
+        abort = this->CheckAbort();
+        break;
+      }
+      progressCounter++;
 
-    // Make a copy of point indices to avoid modifying input polydata cells
-    // while removing degenerate lines.
-    if (npts < 2)
-    {
-      continue; // skip tubing this polyline
-    }
-    std::vector<vtkIdType> ptsCopy(ptsOrig, ptsOrig + npts);
-    vtkIdType* pts = ptsCopy.data();
+      // Make a copy of point indices to avoid modifying input polydata cells
+      // while removing degenerate lines.
+      if (npts < 2)
+      {
+        continue; // skip tubing this polyline
+      }
+      std::vector<vtkIdType> ptsCopy(ptsOrig, ptsOrig + npts);
+      vtkIdType* pts = ptsCopy.data();
 
-    // remove degenerate lines to avoid warnings
-    npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) - pts);
-    if (npts < 2)
-    {
-      continue; // skip tubing this polyline
-    }
+      // remove degenerate lines to avoid warnings
+      npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) - pts);
+      if (npts < 2)
+      {
+        continue; // skip tubing this polyline
+      }
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
-    }
+      // If necessary calculate normals, each polyline calculates its
+      // normals independently, avoiding conflicts at shared vertices.
+      if (generateNormals)
+      {
+        singlePolyline->Reset(); // avoid instantiation
+        singlePolyline->InsertNextCell(npts, pts);
+        vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
+      }
 
-    // Generate the points around the polyline. The tube is not stripped
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
-          range, inVectors, maxSpeed, inNormals))
-    {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip tubing this polyline
-    }
+      // Generate the points around the polyline. The tube is not stripped
+      // if the polyline is bad.
+      //
+      if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
+            range, inVectors, maxSpeed, inNormals))
+      {
+        vtkWarningMacro(<< "Could not generate points!");
+        continue; // skip tubing this polyline
+      }
 
-    // Generate the strips for this polyline (including caps)
-    //
-    this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
+      // Generate the strips for this polyline (including caps)
+      //
+      this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
 
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
-    {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
-    }
+      // Generate the texture coordinates for this polyline
+      //
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
+      // Compute the new offset for the next polyline
+      offset = this->ComputeOffset(offset, npts);
 
-  } // for all polylines
+    } // for all polylines
+  }
 
   singlePolyline->Delete();
 
@@ -783,6 +800,335 @@ vtkIdType vtkTubeFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
   return offset;
 }
 
+//------------------------------------------------------------------------------
+bool vtkTubeFilter::ThreadedGenerate(vtkPolyData* input, vtkPointData* outPD, vtkCellData* outCD,
+  vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
+  vtkDataArray* inNormals, bool generateNormals, vtkPoints* newPts, vtkFloatArray* newNormals,
+  vtkFloatArray* newTCoords, vtkCellArray* newStrips)
+{
+  if (this->SequentialProcessing)
+  {
+    return false;
+  }
+  vtkPointData* pd = input->GetPointData();
+  vtkCellData* cd = input->GetCellData();
+  if (!CanUseArrayList(pd) || !CanUseArrayList(cd))
+  {
+    return false;
+  }
+
+  vtkPoints* inPts = input->GetPoints();
+  vtkCellArray* inLines = input->GetLines();
+  const vtkIdType numLines = inLines->GetNumberOfCells();
+  // the line cellIds start after the last vert cellId
+  const vtkIdType firstLineId = input->GetNumberOfVerts();
+  const int numSides = this->SidesShareVertices ? this->NumberOfSides : 2 * this->NumberOfSides;
+  const vtkIdType numSideStrips = (this->NumberOfSides + this->OnRatio - 1) / this->OnRatio;
+
+  // The polylines without their consecutive coincident points, as in the
+  // serial path. Polylines left with less than two points are not tubed.
+  vtkSMPThreadLocalObject<vtkIdList> cellPointIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> linePointIds;
+  auto getLine = [&](vtkIdType lineId, std::vector<vtkIdType>& ids) {
+    vtkIdType npts = 0;
+    const vtkIdType* pts = nullptr;
+    inLines->GetCellAtId(lineId, npts, pts, cellPointIds.Local());
+    ids.assign(pts, pts + npts);
+    ids.erase(std::unique(ids.begin(), ids.end(), IdPointsEqual(inPts)), ids.end());
+  };
+  std::vector<vtkIdType> lineSizes(numLines);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType lineId, vtkIdType endLineId) {
+    std::vector<vtkIdType>& ids = linePointIds.Local();
+    for (; lineId < endLineId; ++lineId)
+    {
+      getLine(lineId, ids);
+      lineSizes[lineId] = ids.size() < 2 ? 0 : static_cast<vtkIdType>(ids.size());
+    }
+  });
+
+  // Prefix sums over the polylines give where the points, the strips and
+  // the strip connectivity of each tube go in the output.
+  std::vector<vtkIdType> pointStarts(numLines + 1, 0);
+  std::vector<vtkIdType> cellStarts(numLines + 1, 0);
+  std::vector<vtkIdType> connStarts(numLines + 1, 0);
+  auto layOut = [&]() {
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+    {
+      const vtkIdType npts = lineSizes[lineId];
+      vtkIdType numTubePts = 0, numTubeCells = 0, numTubeConn = 0;
+      if (npts > 0)
+      {
+        numTubePts = this->ComputeOffset(0, npts);
+        numTubeCells = numSideStrips + (this->Capping ? 2 : 0);
+        numTubeConn = 2 * npts * numSideStrips + (this->Capping ? 2 * this->NumberOfSides : 0);
+      }
+      pointStarts[lineId + 1] = pointStarts[lineId] + numTubePts;
+      cellStarts[lineId + 1] = cellStarts[lineId] + numTubeCells;
+      connStarts[lineId + 1] = connStarts[lineId] + numTubeConn;
+    }
+  };
+
+  // Each tube is generated by the helper methods in per-thread objects, then
+  // copied to its place in the output. The polyline is renumbered 0, 1, ...
+  // and its points, scalars, vectors and normals are gathered, so that the
+  // normals generated for polylines sharing points are not shared. The
+  // attributes are copied at the end, so the helpers are given attributes
+  // with no arrays to copy.
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localIds;
+  vtkSMPThreadLocal<std::vector<std::pair<vtkIdType, vtkIdType>>> sortedIds;
+  vtkSMPThreadLocalObject<vtkPoints> linePoints;
+  vtkSMPThreadLocalObject<vtkDoubleArray> lineScalars;
+  vtkSMPThreadLocalObject<vtkDoubleArray> lineVectors;
+  vtkSMPThreadLocalObject<vtkDoubleArray> lineNormals;
+  vtkSMPThreadLocalObject<vtkFloatArray> slidingNormals;
+  vtkSMPThreadLocalObject<vtkCellArray> singlePolylines;
+  vtkSMPThreadLocalObject<vtkPoints> tubePoints;
+  vtkSMPThreadLocalObject<vtkFloatArray> tubeNormals;
+  vtkSMPThreadLocalObject<vtkFloatArray> tubeTCoords;
+  vtkSMPThreadLocalObject<vtkCellArray> tubeStrips;
+  vtkNew<vtkPointData> noPointData;
+  vtkNew<vtkCellData> noCellData;
+
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> conn;
+  std::vector<vtkIdType> sourcePoints;
+  std::vector<vtkIdType> sourceCells;
+  std::vector<unsigned char> failed(numLines, 0);
+  std::atomic<bool> anyFailed(false);
+  auto generate = [&]() {
+    const vtkIdType numNewPts = pointStarts[numLines];
+    const vtkIdType numNewCells = cellStarts[numLines];
+    newPts->SetNumberOfPoints(numNewPts);
+    newNormals->SetNumberOfTuples(numNewPts);
+    if (newTCoords)
+    {
+      newTCoords->SetNumberOfTuples(numNewPts);
+    }
+    sourcePoints.resize(numNewPts);
+    sourceCells.resize(numNewCells);
+    offsets->SetNumberOfValues(numNewCells + 1);
+    offsets->SetValue(numNewCells, connStarts[numLines]);
+    conn->SetNumberOfValues(connStarts[numLines]);
+    vtkIdType* outOffsets = offsets->GetPointer(0);
+    vtkIdType* outConn = conn->GetPointer(0);
+
+    vtkSMPTools::For(0, numLines, [&](vtkIdType lineId, vtkIdType endLineId) {
+      std::vector<vtkIdType>& ids = linePointIds.Local();
+      std::vector<vtkIdType>& lineIds = localIds.Local();
+      std::vector<std::pair<vtkIdType, vtkIdType>>& sorted = sortedIds.Local();
+      vtkIdList* ptIdList = cellPointIds.Local();
+      vtkPoints* pts = linePoints.Local();
+      vtkDoubleArray* scalars = lineScalars.Local();
+      vtkDoubleArray* vectors = lineVectors.Local();
+      vtkDoubleArray* givenNormals = lineNormals.Local();
+      vtkFloatArray* sliding = slidingNormals.Local();
+      vtkCellArray* singlePolyline = singlePolylines.Local();
+      vtkPoints* tubePts = tubePoints.Local();
+      vtkFloatArray* normals = tubeNormals.Local();
+      vtkFloatArray* tcoords = tubeTCoords.Local();
+      vtkCellArray* strips = tubeStrips.Local();
+      pts->SetDataTypeToDouble();
+      tubePts->SetDataType(newPts->GetDataType());
+      givenNormals->SetNumberOfComponents(3);
+      sliding->SetNumberOfComponents(3);
+      normals->SetNumberOfComponents(3);
+      tcoords->SetNumberOfComponents(2);
+      if (inVectors)
+      {
+        vectors->SetNumberOfComponents(inVectors->GetNumberOfComponents());
+      }
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      vtkIdType checkAbortInterval = std::min((endLineId - lineId) / 10 + 1, (vtkIdType)1000);
+      double x[3];
+      for (; lineId < endLineId; ++lineId)
+      {
+        if (lineId % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        const vtkIdType npts = lineSizes[lineId];
+        if (npts == 0)
+        {
+          continue;
+        }
+
+        // Gather the renumbered polyline.
+        getLine(lineId, ids);
+        lineIds.resize(npts);
+        std::iota(lineIds.begin(), lineIds.end(), 0);
+        pts->SetNumberOfPoints(npts);
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          inPts->GetPoint(ids[j], x);
+          pts->SetPoint(j, x);
+        }
+        if (inScalars)
+        {
+          scalars->SetNumberOfValues(npts);
+          for (vtkIdType j = 0; j < npts; ++j)
+          {
+            scalars->SetValue(j, inScalars->GetComponent(ids[j], 0));
+          }
+        }
+        if (inVectors)
+        {
+          vectors->SetNumberOfTuples(npts);
+          for (vtkIdType j = 0; j < npts; ++j)
+          {
+            inVectors->GetTuple(ids[j], vectors->GetPointer(j * vectors->GetNumberOfComponents()));
+          }
+        }
+        vtkDataArray* lineNormalsArray = givenNormals;
+        if (generateNormals)
+        {
+          singlePolyline->Reset();
+          singlePolyline->InsertNextCell(npts, lineIds.data());
+          sliding->Reset();
+          vtkPolyLine::GenerateSlidingNormals(pts, singlePolyline, sliding);
+          // The serial path generates the normals at the input point ids, so
+          // a point used several times by the polyline gets the normal
+          // generated last for it.
+          sorted.resize(npts);
+          for (vtkIdType j = 0; j < npts; ++j)
+          {
+            sorted[j] = std::make_pair(ids[j], j);
+          }
+          std::sort(sorted.begin(), sorted.end());
+          float* slidingPtr = sliding->GetPointer(0);
+          for (vtkIdType j = npts - 1; j > 0; --j)
+          {
+            if (sorted[j - 1].first == sorted[j].first)
+            {
+              const vtkIdType last = sorted[j].second;
+              std::copy(slidingPtr + 3 * last, slidingPtr + 3 * last + 3,
+                slidingPtr + 3 * sorted[j - 1].second);
+              sorted[j - 1].second = last;
+            }
+          }
+          lineNormalsArray = sliding;
+        }
+        else
+        {
+          givenNormals->SetNumberOfTuples(npts);
+          for (vtkIdType j = 0; j < npts; ++j)
+          {
+            inNormals->GetTuple(ids[j], givenNormals->GetPointer(3 * j));
+          }
+        }
+
+        // Generate the tube, placing its strips after the strips of the
+        // previous polylines.
+        tubePts->Reset();
+        normals->Reset();
+        if (!this->GeneratePoints(0, npts, lineIds.data(), pts, tubePts, pd, noPointData, normals,
+              inScalars ? scalars : nullptr, range, inVectors ? vectors : nullptr, maxSpeed,
+              lineNormalsArray))
+        {
+          vtkWarningMacro(<< "Could not generate points!");
+          failed[lineId] = 1;
+          anyFailed = true;
+          continue;
+        }
+        strips->Reset();
+        this->GenerateStrips(
+          pointStarts[lineId], npts, lineIds.data(), firstLineId + lineId, cd, noCellData, strips);
+        if (newTCoords)
+        {
+          tcoords->Reset();
+          this->GenerateTextureCoords(
+            0, npts, lineIds.data(), pts, inScalars ? scalars : nullptr, tcoords);
+        }
+
+        // Copy the tube to its place. The points around each polyline point
+        // come first, then the points of the caps.
+        const vtkIdType pointStart = pointStarts[lineId];
+        const vtkIdType numTubePts = pointStarts[lineId + 1] - pointStart;
+        for (vtkIdType i = 0; i < numTubePts; ++i)
+        {
+          tubePts->GetPoint(i, x);
+          newPts->SetPoint(pointStart + i, x);
+          newNormals->SetTypedTuple(pointStart + i, normals->GetPointer(3 * i));
+          if (newTCoords)
+          {
+            newTCoords->SetTypedTuple(pointStart + i, tcoords->GetPointer(2 * i));
+          }
+        }
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          std::fill_n(sourcePoints.begin() + pointStart + j * numSides, numSides, ids[j]);
+        }
+        if (this->Capping)
+        {
+          const vtkIdType capStart = pointStart + npts * numSides;
+          std::fill_n(sourcePoints.begin() + capStart, this->NumberOfSides, ids[0]);
+          std::fill_n(sourcePoints.begin() + capStart + this->NumberOfSides, this->NumberOfSides,
+            ids[npts - 1]);
+        }
+        vtkIdType cellId = cellStarts[lineId];
+        vtkIdType connId = connStarts[lineId];
+        for (vtkIdType i = 0; i < strips->GetNumberOfCells(); ++i, ++cellId)
+        {
+          vtkIdType stripSize = 0;
+          const vtkIdType* stripPts = nullptr;
+          strips->GetCellAtId(i, stripSize, stripPts, ptIdList);
+          outOffsets[cellId] = connId;
+          std::copy(stripPts, stripPts + stripSize, outConn + connId);
+          connId += stripSize;
+          sourceCells[cellId] = firstLineId + lineId;
+        }
+      }
+    });
+  };
+
+  layOut();
+  generate();
+  if (anyFailed && !this->GetAbortOutput())
+  {
+    // Lay out the output again without the polylines that could not be
+    // tubed, which are not visited again.
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+    {
+      if (failed[lineId])
+      {
+        lineSizes[lineId] = 0;
+      }
+    }
+    layOut();
+    generate();
+  }
+  newStrips->SetData(offsets, conn);
+
+  // Copy the attributes of the input points and polylines.
+  const vtkIdType numNewPts = pointStarts[numLines];
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, pd, outPD, /*nullValue*/ 0.0, /*promote*/ false);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      pointArrays.Copy(sourcePoints[ptId], ptId);
+    }
+  });
+  const vtkIdType numNewCells = cellStarts[numLines];
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numNewCells, cd, outCD, /*nullValue*/ 0.0, /*promote*/ false);
+  vtkSMPTools::For(0, numNewCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellArrays.Copy(sourceCells[cellId], cellId);
+    }
+  });
+
+  vtkDebugMacro(<< "Generated " << numNewCells << " strips with threads.");
+  return true;
+}
+
 // Description:
 // Return the method of varying tube radius descriptive character string.
 const char* vtkTubeFilter::GetVaryRadiusAsString()
@@ -851,5 +1197,6 @@ void vtkTubeFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Generate TCoords: " << this->GetGenerateTCoordsAsString() << endl;
   os << indent << "Texture Length: " << this->TextureLength << endl;
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << endl;
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
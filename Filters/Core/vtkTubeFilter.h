@@ -31,6 +31,14 @@
  * interesting effects such as marking the tube with stripes corresponding
  * to length or time.
  *
+ * The polylines are tubed with threads (vtkSMPTools): the size of the output
+ * of each polyline is computed first, and a prefix sum over the polylines
+ * gives where its points and strips go, so the output is ordered as if the
+ * polylines were tubed one after the other. The output is the same as the
+ * serial one, which is used when SequentialProcessing is on or when the
+ * input has string or bit arrays, except that no unused points are left
+ * when a polyline cannot be tubed.
+ *
  * This filter is typically used to create thick or dramatic lines. Another
  * common use is to combine this filter with vtkStreamTracer to generate
  * streamtubes.
@@ -232,6 +240,18 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the polylines. By
+   * default, sequential processing is off. The output is the same either
+   * way, except for the unused points described above. This flag is
+   * typically used for benchmarking and testing purposes.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkTubeFilter();
   ~vtkTubeFilter() override = default;
@@ -252,6 +272,7 @@ protected:
   int GenerateTCoords; // control texture coordinate generation
   int OutputPointsPrecision;
   double TextureLength; // this length is mapped to [0,1) texture space
+  bool SequentialProcessing;
 
   // Helper methods
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
@@ -264,6 +285,16 @@ protected:
     vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
   vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
 
+  /**
+   * Generate the tubes of all the polylines with threads, laying out the
+   * output of each polyline with a prefix sum over the polylines. Return
+   * false without modifying the output when the serial path must be taken.
+   */
+  bool ThreadedGenerate(vtkPolyData* input, vtkPointData* outPD, vtkCellData* outCD,
+    vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
+    vtkDataArray* inNormals, bool generateNormals, vtkPoints* newPts, vtkFloatArray* newNormals,
+    vtkFloatArray* newTCoords, vtkCellArray* newStrips);
+
   // Helper data members
   double Theta;
 
@@ -0,0 +1,197 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMemoryLimitStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkMemoryLimitStreamer streams its input in pieces fitting the
+// memory limit, and reduces them.
+
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMemoryLimitStreamer.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTable.h"
+#include "vtkTableAlgorithm.h"
+
+#include <iostream>
+
+namespace
+{
+const vtkIdType NumberOfPoints = 100000;
+
+// Source splitting NumberOfPoints points between the requested pieces. The
+// number of points of the piece is also stored in its field data.
+class PieceSource : public vtkPolyDataAlgorithm
+{
+public:
+  static PieceSource* New();
+  vtkTypeMacro(PieceSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions = 0;
+
+protected:
+  PieceSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    outputVector->GetInformationObject(0)->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    const int numPieces =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    const vtkIdType begin = NumberOfPoints * piece / numPieces;
+    const vtkIdType end = NumberOfPoints * (piece + 1) / numPieces;
+
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(end - begin);
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      points->SetPoint(i - begin, i, 0.0, 0.0);
+    }
+    vtkNew<vtkIdTypeArray> count;
+    count->SetName("Count");
+    count->InsertNextValue(end - begin);
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->SetPoints(points);
+    output->GetFieldData()->AddArray(count);
+    return 1;
+  }
+};
+vtkStandardNewMacro(PieceSource);
+
+// Filter computing the histogram of the x coordinates of its input, with 10
+// bins between 0 and NumberOfPoints.
+class PointHistogram : public vtkTableAlgorithm
+{
+public:
+  static PointHistogram* New();
+  vtkTypeMacro(PointHistogram, vtkTableAlgorithm);
+
+protected:
+  int FillInputPortInformation(int, vtkInformation* info) override
+  {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+    vtkNew<vtkDoubleArray> extents;
+    extents->SetName("bin_extents");
+    vtkNew<vtkIdTypeArray> values;
+    values->SetName("bin_values");
+    for (int bin = 0; bin < 10; ++bin)
+    {
+      extents->InsertNextValue((bin + 0.5) * NumberOfPoints / 10);
+      values->InsertNextValue(0);
+    }
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+    {
+      const vtkIdType bin = static_cast<vtkIdType>(input->GetPoint(i)[0]) * 10 / NumberOfPoints;
+      values->SetValue(bin, values->GetValue(bin) + 1);
+    }
+    vtkTable* output = vtkTable::GetData(outputVector);
+    output->AddColumn(extents);
+    output->AddColumn(values);
+    return 1;
+  }
+};
+vtkStandardNewMacro(PointHistogram);
+}
+
+int TestMemoryLimitStreamer(int, char*[])
+{
+  vtkNew<PieceSource> source;
+  vtkNew<vtkMemoryLimitStreamer> streamer;
+  streamer->SetInputConnection(source->GetOutputPort());
+
+  // The whole input uses more than 1 MiB, so it is streamed in at least 6
+  // pieces, after the probe.
+  streamer->SetMemoryLimit(200);
+  streamer->Update();
+  vtkPolyData* appended = vtkPolyData::SafeDownCast(streamer->GetOutputDataObject(0));
+  const int numberOfPieces = streamer->GetLastNumberOfPieces();
+  if (numberOfPieces < 6 || source->NumberOfExecutions != numberOfPieces + 1)
+  {
+    std::cerr << "Wrong number of pieces: " << numberOfPieces << " streamed in "
+              << source->NumberOfExecutions << " executions" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!appended || appended->GetNumberOfPoints() != NumberOfPoints)
+  {
+    std::cerr << "Wrong appended output" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Sum the number of points of a given number of pieces.
+  source->NumberOfExecutions = 0;
+  streamer->SetNumberOfPieces(4);
+  streamer->SetReductionModeToSum();
+  streamer->Update();
+  vtkPolyData* sum = vtkPolyData::SafeDownCast(streamer->GetOutputDataObject(0));
+  vtkIdTypeArray* count =
+    sum ? vtkIdTypeArray::SafeDownCast(sum->GetFieldData()->GetArray("Count")) : nullptr;
+  if (source->NumberOfExecutions != 4 || streamer->GetLastNumberOfPieces() != 4 || !count ||
+    count->GetValue(0) != NumberOfPoints)
+  {
+    std::cerr << "Wrong sum" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Merge the histograms of the pieces.
+  vtkNew<PointHistogram> histogram;
+  histogram->SetInputConnection(source->GetOutputPort());
+  streamer->SetInputConnection(histogram->GetOutputPort());
+  streamer->SetNumberOfPieces(3);
+  streamer->SetReductionModeToHistogram();
+  streamer->Update();
+  vtkTable* merged = vtkTable::SafeDownCast(streamer->GetOutputDataObject(0));
+  vtkDataArray* extents =
+    merged ? vtkArrayDownCast<vtkDataArray>(merged->GetColumnByName("bin_extents")) : nullptr;
+  vtkDataArray* values =
+    merged ? vtkArrayDownCast<vtkDataArray>(merged->GetColumnByName("bin_values")) : nullptr;
+  if (!extents || !values || values->GetNumberOfTuples() != 10 ||
+    extents->GetComponent(9, 0) != 95000)
+  {
+    std::cerr << "Wrong histogram" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (int bin = 0; bin < 10; ++bin)
+  {
+    if (values->GetComponent(bin, 0) != NumberOfPoints / 10)
+    {
+      std::cerr << "Wrong value for bin " << bin << ": " << values->GetComponent(bin, 0)
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
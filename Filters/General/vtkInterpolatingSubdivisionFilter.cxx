@@ -86,26 +86,31 @@ int vtkInterpolatingSubdivisionFilter::RequestData(
     outputPolys = vtkCellArray::New();
     outputPolys->AllocateEstimate(4 * numCells, 3);
 
-    // Create an array to hold new location indices
-    edgeData = vtkIntArray::New();
-    edgeData->SetNumberOfComponents(3);
-    edgeData->SetNumberOfTuples(numCells);
-
-    if (this->GenerateSubdivisionPoints(inputDS, edgeData, outputPts, outputPD) == 0)
+    // Subdivide with threads when the subclass and the attributes allow it,
+    // otherwise one edge at a time
+    if (!this->ThreadedSubdivide(inputDS, true, outputPts, outputPD, outputPolys, outputCD))
     {
-      outputPts->Delete();
-      outputPD->Delete();
-      outputCD->Delete();
-      outputPolys->Delete();
-      inputDS->Delete();
+      // Create an array to hold new location indices
+      edgeData = vtkIntArray::New();
+      edgeData->SetNumberOfComponents(3);
+      edgeData->SetNumberOfTuples(numCells);
+
+      if (this->GenerateSubdivisionPoints(inputDS, edgeData, outputPts, outputPD) == 0)
+      {
+        outputPts->Delete();
+        outputPD->Delete();
+        outputCD->Delete();
+        outputPolys->Delete();
+        inputDS->Delete();
+        edgeData->Delete();
+        vtkErrorMacro("Subdivision failed.");
+        return 0;
+      }
+      this->GenerateSubdivisionCells(inputDS, edgeData, outputPolys, outputCD);
       edgeData->Delete();
-      vtkErrorMacro("Subdivision failed.");
-      return 0;
     }
-    this->GenerateSubdivisionCells(inputDS, edgeData, outputPolys, outputCD);
 
     // start the next iteration with the input set to the output we just created
-    edgeData->Delete();
     inputDS->Delete();
     inputDS = vtkPolyData::New();
     inputDS->SetPoints(outputPts);
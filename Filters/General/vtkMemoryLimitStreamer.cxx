@@ -0,0 +1,436 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryLimitStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryLimitStreamer.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTable.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <set>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// Add the memory size of the inputs of an algorithm and of all the inputs
+// upstream, counting each data object once.
+void AddUpstreamMemorySize(vtkAlgorithm* algorithm, std::set<vtkObject*>& visited, double& size)
+{
+  for (int port = 0; port < algorithm->GetNumberOfInputPorts(); ++port)
+  {
+    for (int conn = 0; conn < algorithm->GetNumberOfInputConnections(port); ++conn)
+    {
+      vtkDataObject* data = algorithm->GetInputDataObject(port, conn);
+      if (data && visited.insert(data).second)
+      {
+        size += data->GetActualMemorySize();
+      }
+      vtkAlgorithm* producer = algorithm->GetInputAlgorithm(port, conn);
+      if (producer && visited.insert(producer).second)
+      {
+        AddUpstreamMemorySize(producer, visited, size);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Add the values of an array to the ones of another array with the same size.
+void AddArray(vtkDataArray* sum, vtkDataArray* values)
+{
+  auto sumRange = vtk::DataArrayValueRange(sum);
+  auto valuesRange = vtk::DataArrayValueRange(values);
+  std::transform(sumRange.cbegin(), sumRange.cend(), valuesRange.cbegin(), sumRange.begin(),
+    std::plus<double>());
+}
+
+//------------------------------------------------------------------------------
+bool HaveSameSize(vtkDataArray* array1, vtkDataArray* array2)
+{
+  return array1->GetNumberOfTuples() == array2->GetNumberOfTuples() &&
+    array1->GetNumberOfComponents() == array2->GetNumberOfComponents();
+}
+}
+
+//------------------------------------------------------------------------------
+class vtkMemoryLimitStreamer::vtkInternals
+{
+public:
+  // Number of pieces of the current pass.
+  int NumberOfPieces = 1;
+  // Number of probe passes preceding the first streamed piece.
+  int Offset = 0;
+  bool Probing = false;
+
+  // The pieces to append, or the result of the reduction so far.
+  std::vector<vtkSmartPointer<vtkDataObject>> Pieces;
+  vtkSmartPointer<vtkDataObject> Reduced;
+};
+
+vtkStandardNewMacro(vtkMemoryLimitStreamer);
+
+//------------------------------------------------------------------------------
+vtkMemoryLimitStreamer::vtkMemoryLimitStreamer()
+  : Internals(new vtkInternals)
+{
+  this->SetNumberOfInputPorts(1);
+  this->SetNumberOfOutputPorts(1);
+
+  this->ReductionMode = APPEND;
+  // Set a default memory limit of 1 gibibyte
+  this->MemoryLimit = 1024 * 1024;
+  this->ProbeNumberOfPieces = 16;
+  this->NumberOfPieces = 0;
+  this->BinExtentsArrayName = nullptr;
+  this->BinValuesArrayName = nullptr;
+  this->SetBinExtentsArrayName("bin_extents");
+  this->SetBinValuesArrayName("bin_values");
+  this->LastNumberOfPieces = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkMemoryLimitStreamer::~vtkMemoryLimitStreamer()
+{
+  this->SetBinExtentsArrayName(nullptr);
+  this->SetBinValuesArrayName(nullptr);
+}
+
+//------------------------------------------------------------------------------
+vtkTypeBool vtkMemoryLimitStreamer::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+  {
+    return this->RequestDataObject(request, inputVector, outputVector);
+  }
+
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::RequestDataObject(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+  if (!input)
+  {
+    return 0;
+  }
+
+  vtkSmartPointer<vtkDataObject> newOutput;
+  switch (this->ReductionMode)
+  {
+    case APPEND:
+      if (vtkPolyData::SafeDownCast(input))
+      {
+        newOutput = vtkSmartPointer<vtkPolyData>::New();
+      }
+      else if (vtkDataSet::SafeDownCast(input))
+      {
+        newOutput = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      }
+      else
+      {
+        vtkErrorMacro("Cannot append pieces of type " << input->GetClassName() << ".");
+        return 0;
+      }
+      break;
+    case SUM:
+      newOutput.TakeReference(input->NewInstance());
+      break;
+    case HISTOGRAM:
+      if (!vtkTable::SafeDownCast(input))
+      {
+        vtkErrorMacro("Histograms must be vtkTable, not " << input->GetClassName() << ".");
+        return 0;
+      }
+      newOutput = vtkSmartPointer<vtkTable>::New();
+      break;
+  }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = vtkDataObject::GetData(outInfo);
+  if (!output || !output->IsA(newOutput->GetClassName()))
+  {
+    outInfo->Set(vtkDataObject::DATA_OBJECT(), newOutput);
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+
+  vtkInternals& internals = *this->Internals;
+  if (this->CurrentIndex == 0)
+  {
+    // Probe the memory used by a piece, unless the number of pieces is given.
+    internals.Probing = this->NumberOfPieces == 0;
+    internals.NumberOfPieces =
+      internals.Probing ? this->ProbeNumberOfPieces : this->NumberOfPieces;
+    internals.Offset = 0;
+    this->NumberOfPasses = internals.NumberOfPieces;
+  }
+
+  int outPiece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  int outNumPieces = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+    outPiece * internals.NumberOfPieces + static_cast<int>(this->CurrentIndex) - internals.Offset);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+    outNumPieces * internals.NumberOfPieces);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::ExecutePass(
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInternals& internals = *this->Internals;
+  if (this->CurrentIndex == 0)
+  {
+    internals.Pieces.clear();
+    internals.Reduced = nullptr;
+  }
+
+  if (internals.Probing && this->CurrentIndex == 0)
+  {
+    // Extrapolate the memory used by the whole input from the probed piece.
+    std::set<vtkObject*> visited;
+    double size = 0.0;
+    AddUpstreamMemorySize(this, visited, size);
+    int outNumPieces = vtkStreamingDemandDrivenPipeline::GetUpdateNumberOfPieces(
+      outputVector->GetInformationObject(0));
+    const double maxNumberOfPieces = VTK_INT_MAX / std::max(outNumPieces, 1) - 1;
+    const double numberOfPieces =
+      std::ceil(size * this->ProbeNumberOfPieces / static_cast<double>(this->MemoryLimit));
+    internals.NumberOfPieces =
+      static_cast<int>(std::max(1.0, std::min(numberOfPieces, maxNumberOfPieces)));
+    vtkDebugMacro("A piece out of " << this->ProbeNumberOfPieces << " uses " << size
+                                    << " KiB, streaming " << internals.NumberOfPieces
+                                    << " pieces.");
+    internals.Probing = false;
+
+    if (internals.NumberOfPieces != this->ProbeNumberOfPieces)
+    {
+      // Discard the probed piece, the input is split differently.
+      internals.Offset = 1;
+      this->NumberOfPasses = internals.NumberOfPieces + 1;
+      return 1;
+    }
+  }
+
+  this->LastNumberOfPieces = internals.NumberOfPieces;
+  return this->ReducePiece(vtkDataObject::GetData(inputVector[0], 0));
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::PostExecute(
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
+{
+  return this->FinalizeReduction(vtkDataObject::GetData(outputVector, 0));
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::ReducePiece(vtkDataObject* piece)
+{
+  if (!piece)
+  {
+    vtkErrorMacro("Missing input piece.");
+    return 0;
+  }
+
+  vtkInternals& internals = *this->Internals;
+  if (this->ReductionMode == APPEND || !internals.Reduced)
+  {
+    // The upstream outputs are overwritten by the next pass.
+    vtkSmartPointer<vtkDataObject> copy;
+    copy.TakeReference(piece->NewInstance());
+    if (this->ReductionMode == APPEND)
+    {
+      copy->ShallowCopy(piece);
+      internals.Pieces.push_back(copy);
+    }
+    else
+    {
+      copy->DeepCopy(piece);
+      internals.Reduced = copy;
+    }
+    return 1;
+  }
+
+  if (this->ReductionMode == HISTOGRAM)
+  {
+    vtkTable* reduced = vtkTable::SafeDownCast(internals.Reduced);
+    vtkTable* histogram = vtkTable::SafeDownCast(piece);
+    vtkDataArray* extents = nullptr;
+    vtkDataArray* values = nullptr;
+    if (histogram)
+    {
+      extents = vtkArrayDownCast<vtkDataArray>(
+        histogram->GetColumnByName(this->BinExtentsArrayName));
+      values =
+        vtkArrayDownCast<vtkDataArray>(histogram->GetColumnByName(this->BinValuesArrayName));
+    }
+    vtkDataArray* reducedExtents =
+      vtkArrayDownCast<vtkDataArray>(reduced->GetColumnByName(this->BinExtentsArrayName));
+    vtkDataArray* reducedValues =
+      vtkArrayDownCast<vtkDataArray>(reduced->GetColumnByName(this->BinValuesArrayName));
+    if (!extents || !values || !reducedExtents || !reducedValues)
+    {
+      vtkErrorMacro("Missing the " << this->BinExtentsArrayName << " or "
+                                   << this->BinValuesArrayName << " column of a histogram.");
+      return 0;
+    }
+    auto extentsRange = vtk::DataArrayValueRange(extents);
+    auto reducedExtentsRange = vtk::DataArrayValueRange(reducedExtents);
+    if (!HaveSameSize(extents, reducedExtents) || !HaveSameSize(values, reducedValues) ||
+      !std::equal(extentsRange.cbegin(), extentsRange.cend(), reducedExtentsRange.cbegin()))
+    {
+      vtkErrorMacro("Cannot merge histograms with different bins.");
+      return 0;
+    }
+    AddArray(reducedValues, values);
+    return 1;
+  }
+
+  // Sum the arrays of the pieces, ignoring the arrays missing from a piece.
+  for (int type = 0; type < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++type)
+  {
+    vtkFieldData* reducedData = internals.Reduced->GetAttributesAsFieldData(type);
+    vtkFieldData* pieceData = piece->GetAttributesAsFieldData(type);
+    if (!reducedData || !pieceData)
+    {
+      continue;
+    }
+    for (int i = 0; i < reducedData->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* sum = reducedData->GetArray(i);
+      const char* name = sum ? sum->GetName() : nullptr;
+      if (!name || strcmp(name, vtkDataSetAttributes::GhostArrayName()) == 0)
+      {
+        continue;
+      }
+      vtkDataArray* values = pieceData->GetArray(name);
+      if (!values)
+      {
+        continue;
+      }
+      if (!HaveSameSize(sum, values))
+      {
+        vtkErrorMacro("Cannot sum the " << name << " arrays of pieces of different sizes.");
+        return 0;
+      }
+      AddArray(sum, values);
+    }
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::FinalizeReduction(vtkDataObject* output)
+{
+  vtkInternals& internals = *this->Internals;
+  if (this->ReductionMode != APPEND)
+  {
+    if (internals.Reduced)
+    {
+      output->ShallowCopy(internals.Reduced);
+      internals.Reduced = nullptr;
+    }
+    else
+    {
+      output->Initialize();
+    }
+    return 1;
+  }
+
+  vtkSmartPointer<vtkAlgorithm> append;
+  if (vtkPolyData::SafeDownCast(output))
+  {
+    append = vtkSmartPointer<vtkAppendPolyData>::New();
+  }
+  else
+  {
+    append = vtkSmartPointer<vtkAppendFilter>::New();
+  }
+  append->SetContainerAlgorithm(this);
+  for (const auto& piece : internals.Pieces)
+  {
+    append->AddInputDataObject(piece);
+  }
+  internals.Pieces.clear();
+  if (append->GetNumberOfInputConnections(0) == 0)
+  {
+    output->Initialize();
+    return 1;
+  }
+  append->Update();
+  output->ShallowCopy(append->GetOutputDataObject(0));
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataObject");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::FillOutputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataObject");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryLimitStreamer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ReductionMode: " << this->ReductionMode << endl;
+  os << indent << "MemoryLimit (in kibibytes): " << this->MemoryLimit << endl;
+  os << indent << "ProbeNumberOfPieces: " << this->ProbeNumberOfPieces << endl;
+  os << indent << "NumberOfPieces: " << this->NumberOfPieces << endl;
+  os << indent << "BinExtentsArrayName: "
+     << (this->BinExtentsArrayName ? this->BinExtentsArrayName : "(none)") << endl;
+  os << indent << "BinValuesArrayName: "
+     << (this->BinValuesArrayName ? this->BinValuesArrayName : "(none)") << endl;
+  os << indent << "LastNumberOfPieces: " << this->LastNumberOfPieces << endl;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,184 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryLimitStreamer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkMemoryLimitStreamer
+ * @brief   Stream any pipeline in pieces fitting a memory limit and reduce them
+ *
+ * vtkMemoryLimitStreamer executes its input pipeline piece by piece, so that
+ * datasets larger than the memory can be processed by any pipeline supporting
+ * pieces (unstructured readers and the filters downstream of them), and
+ * reduces the pieces into its output.
+ *
+ * The number of pieces is computed from MemoryLimit: the first pass requests
+ * one piece out of ProbeNumberOfPieces, measures the memory used by the
+ * outputs of all the algorithms upstream, and extrapolates the memory needed
+ * by the whole dataset. The input is then streamed in as many pieces as
+ * needed to fit the limit. The probe piece is reused when the number of
+ * pieces equals ProbeNumberOfPieces. Setting NumberOfPieces skips the probe.
+ *
+ * The pieces are reduced according to ReductionMode:
+ * - APPEND: the pieces are appended into a vtkPolyData if the input is a
+ *   vtkPolyData, into a vtkUnstructuredGrid otherwise.
+ * - SUM: the numeric arrays of all the attributes of the pieces (point, cell,
+ *   field, row data...) are summed tuple by tuple. The pieces must have the
+ *   same structure, such as the output of an integration filter.
+ * - HISTOGRAM: the pieces are tables with the same bins, such as the output
+ *   of vtkExtractHistogram with custom bin ranges. Their bin values are summed.
+ *
+ * Other reductions are implemented by subclasses overriding ReducePiece(),
+ * FinalizeReduction() and, if the type of the output differs, RequestDataObject().
+ *
+ * @warning
+ * The memory limit only bounds the memory used by the pipeline for a single
+ * piece: the reduced output must fit in memory as well. The memory of the whole
+ * dataset is extrapolated from a single piece, so the limit is only respected
+ * if the pieces are balanced.
+ *
+ * @sa
+ * vtkPolyDataStreamer vtkMemoryLimitImageDataStreamer vtkStreamerBase
+ */
+
+#ifndef vtkMemoryLimitStreamer_h
+#define vtkMemoryLimitStreamer_h
+
+#include "vtkFiltersGeneralModule.h" // For export macro
+#include "vtkStreamerBase.h"
+
+#include <memory> // For unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataObject;
+
+class VTKFILTERSGENERAL_EXPORT vtkMemoryLimitStreamer : public vtkStreamerBase
+{
+public:
+  static vtkMemoryLimitStreamer* New();
+  vtkTypeMacro(vtkMemoryLimitStreamer, vtkStreamerBase);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum ReductionModes
+  {
+    APPEND = 0,
+    SUM = 1,
+    HISTOGRAM = 2
+  };
+
+  ///@{
+  /**
+   * Set/Get how the pieces are reduced. Defaults to APPEND.
+   */
+  vtkSetClampMacro(ReductionMode, int, APPEND, HISTOGRAM);
+  vtkGetMacro(ReductionMode, int);
+  void SetReductionModeToAppend() { this->SetReductionMode(APPEND); }
+  void SetReductionModeToSum() { this->SetReductionMode(SUM); }
+  void SetReductionModeToHistogram() { this->SetReductionMode(HISTOGRAM); }
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the memory limit in kibibytes (1024 bytes) of the pipeline
+   * upstream, used to compute the number of pieces. Defaults to 1 gibibyte.
+   */
+  vtkSetClampMacro(MemoryLimit, unsigned long, 1, VTK_UNSIGNED_LONG_MAX);
+  vtkGetMacro(MemoryLimit, unsigned long);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of pieces the input is split into to measure the
+   * memory used by a piece. Defaults to 16.
+   */
+  vtkSetClampMacro(ProbeNumberOfPieces, int, 1, VTK_INT_MAX);
+  vtkGetMacro(ProbeNumberOfPieces, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of pieces the input is streamed in. If 0, the default,
+   * it is computed from MemoryLimit.
+   */
+  vtkSetClampMacro(NumberOfPieces, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPieces, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the names of the columns holding the bins and the number of
+   * values in each bin, in HISTOGRAM mode. Default to "bin_extents" and
+   * "bin_values", as produced by vtkExtractHistogram.
+   */
+  vtkSetStringMacro(BinExtentsArrayName);
+  vtkGetStringMacro(BinExtentsArrayName);
+  vtkSetStringMacro(BinValuesArrayName);
+  vtkGetStringMacro(BinValuesArrayName);
+  ///@}
+
+  /**
+   * Get the number of pieces the input was streamed in by the last update.
+   */
+  vtkGetMacro(LastNumberOfPieces, int);
+
+  /**
+   * see vtkAlgorithm for details
+   */
+  vtkTypeBool ProcessRequest(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+protected:
+  vtkMemoryLimitStreamer();
+  ~vtkMemoryLimitStreamer() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int FillOutputPortInformation(int port, vtkInformation* info) override;
+
+  /**
+   * Create the output, depending on the reduction mode and the input type.
+   */
+  virtual int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+
+  int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int ExecutePass(vtkInformationVector** inputVector, vtkInformationVector* outputVector) override;
+  int PostExecute(vtkInformationVector** inputVector, vtkInformationVector* outputVector) override;
+
+  /**
+   * Reduce a piece of the input. The piece is only valid during the call.
+   * Returns 0 on failure.
+   */
+  virtual int ReducePiece(vtkDataObject* piece);
+
+  /**
+   * Produce the output from the reduced pieces, and release them.
+   * Returns 0 on failure.
+   */
+  virtual int FinalizeReduction(vtkDataObject* output);
+
+  int ReductionMode;
+  unsigned long MemoryLimit;
+  int ProbeNumberOfPieces;
+  int NumberOfPieces;
+  char* BinExtentsArrayName;
+  char* BinValuesArrayName;
+  int LastNumberOfPieces;
+
+private:
+  vtkMemoryLimitStreamer(const vtkMemoryLimitStreamer&) = delete;
+  void operator=(const vtkMemoryLimitStreamer&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -75,6 +75,11 @@ protected:
   vtkQuantizePolyDataPoints();
   ~vtkQuantizePolyDataPoints() override = default;
 
+  /**
+   * OperateOnPoint() only depends on QFactor, so it may run concurrently.
+   */
+  bool IsOperateOnPointThreadSafe() override { return true; }
+
   double QFactor;
 
 private:
@@ -20,23 +20,33 @@
 #include "vtkCellIterator.h"
 #include "vtkEdgeTable.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <sstream>
+#include <vector>
 
 // Construct object with number of subdivisions set to 1, check for
-// triangles set to 1
+// triangles set to 1, and sequential processing off
 VTK_ABI_NAMESPACE_BEGIN
 vtkSubdivisionFilter::vtkSubdivisionFilter()
 {
   this->NumberOfSubdivisions = 1;
   this->CheckForTriangles = 1;
+  this->SequentialProcessing = false;
 }
 
 int vtkSubdivisionFilter::RequestData(vtkInformation* vtkNotUsed(request),
@@ -99,11 +109,310 @@ int vtkSubdivisionFilter::RequestData(vtkInformation* vtkNotUsed(request),
   }
   return 1;
 }
+
+//------------------------------------------------------------------------------
+int vtkSubdivisionFilter::GenerateEdgeStencil(vtkIdType vtkNotUsed(p1), vtkIdType vtkNotUsed(p2),
+  vtkPolyData* vtkNotUsed(polys), vtkIdList* vtkNotUsed(stencilIds), double* vtkNotUsed(weights))
+{
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+int vtkSubdivisionFilter::GeneratePointStencil(vtkIdType vtkNotUsed(ptId),
+  vtkPolyData* vtkNotUsed(polys), vtkIdList* vtkNotUsed(stencilIds), double* vtkNotUsed(weights))
+{
+  return -1;
+}
+
+namespace
+{
+// The arrays of the attributes must be data arrays to be filled concurrently
+// once allocated; bits packed in the same byte cannot be.
+bool HasThreadSafeArrays(vtkFieldData* fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = fd->GetArray(i);
+    if (!array || array->GetDataType() == VTK_BIT)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Same as the InterpolatePosition() methods of the subclasses, into a point
+// that is already allocated.
+void InterpolatePosition(vtkPoints* inputPts, vtkPoints* outputPts, vtkIdType outputId,
+  vtkIdList* stencil, const double* weights)
+{
+  double xx[3], x[3] = { 0.0, 0.0, 0.0 };
+  for (vtkIdType i = 0; i < stencil->GetNumberOfIds(); i++)
+  {
+    inputPts->GetPoint(stencil->GetId(i), xx);
+    for (int j = 0; j < 3; j++)
+    {
+      x[j] += xx[j] * weights[i];
+    }
+  }
+  outputPts->SetPoint(outputId, x);
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkSubdivisionFilter::ThreadedSubdivide(vtkPolyData* inputDS, bool interpolating,
+  vtkPoints* outputPts, vtkPointData* outputPD, vtkCellArray* outputPolys, vtkCellData* outputCD)
+{
+  if (this->SequentialProcessing)
+  {
+    return false;
+  }
+
+  vtkCellArray* inputPolys = inputDS->GetPolys();
+  vtkPointData* inputPD = inputDS->GetPointData();
+  vtkCellData* inputCD = inputDS->GetCellData();
+  vtkPoints* inputPts = inputDS->GetPoints();
+  const vtkIdType numCells = inputPolys->GetNumberOfCells();
+  const vtkIdType numPts = inputDS->GetNumberOfPoints();
+  if (numCells == 0 || inputDS->GetNumberOfCells() != numCells ||
+    inputPolys->IsHomogeneous() != 3 || !HasThreadSafeArrays(inputPD) ||
+    !HasThreadSafeArrays(inputCD))
+  {
+    return false;
+  }
+
+  // Enumerate the edges of the triangles. The edge i of a triangle, in the
+  // slot 3 * cellId + i, goes from its point i - 1 to its point i, which is
+  // the order of the serial traversal.
+  using EdgeTupleType = EdgeTuple<vtkIdType, vtkIdType>;
+  const vtkIdType numSlots = 3 * numCells;
+  std::vector<EdgeTupleType> edges(numSlots);
+  std::atomic<bool> degenerate(false);
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      inputPolys->GetCellAtId(cellId, npts, pts, cellPts);
+      if (pts[0] == pts[1] || pts[1] == pts[2] || pts[2] == pts[0])
+      {
+        degenerate.store(true, std::memory_order_relaxed);
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        edges[3 * cellId + i] = EdgeTupleType(pts[(i + 2) % 3], pts[i], 3 * cellId + i);
+      }
+    }
+  });
+  if (degenerate)
+  {
+    return false;
+  }
+  vtkStaticEdgeLocatorTemplate<vtkIdType, vtkIdType> locator;
+  vtkIdType numEdges;
+  const vtkIdType* edgeOffsets = locator.MergeEdges(numSlots, edges.data(), numEdges);
+
+  // The edge of each slot, and the first slot of each edge: the serial
+  // traversal inserts the point of an edge when it meets its first slot.
+  std::vector<vtkIdType> slotIds(numSlots);
+  std::vector<vtkIdType> firstSlots(numEdges);
+  std::atomic<bool> nonManifold(false);
+  vtkSMPTools::For(0, numEdges, [&](vtkIdType edgeId, vtkIdType endEdgeId) {
+    for (; edgeId < endEdgeId; ++edgeId)
+    {
+      if (edgeOffsets[edgeId + 1] - edgeOffsets[edgeId] > 2)
+      {
+        nonManifold.store(true, std::memory_order_relaxed);
+      }
+      vtkIdType firstSlot = numSlots;
+      for (vtkIdType i = edgeOffsets[edgeId]; i < edgeOffsets[edgeId + 1]; ++i)
+      {
+        slotIds[edges[i].Data] = edgeId;
+        firstSlot = std::min(firstSlot, edges[i].Data);
+      }
+      firstSlots[edgeId] = firstSlot;
+    }
+  });
+  std::vector<EdgeTupleType>().swap(edges);
+  if (nonManifold)
+  {
+    // let the serial subdivision report the error
+    return false;
+  }
+
+  auto getEdgePoints = [&](vtkIdType slot, vtkIdList* cellPts, vtkIdType& p1, vtkIdType& p2) {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    inputPolys->GetCellAtId(slot / 3, npts, pts, cellPts);
+    p1 = pts[(slot % 3 + 2) % 3];
+    p2 = pts[slot % 3];
+  };
+
+  // Check that the subclass computes its stencils concurrently, and that
+  // the points can be moved, before touching the outputs.
+  vtkNew<vtkIdList> cellPts;
+  vtkNew<vtkIdList> stencil;
+  double weights[256];
+  vtkIdType p1, p2;
+  getEdgePoints(firstSlots[0], cellPts, p1, p2);
+  if (this->GenerateEdgeStencil(p1, p2, inputDS, stencil, weights) <= 0)
+  {
+    return false;
+  }
+  if (!interpolating)
+  {
+    std::atomic<bool> unusedPoint(false);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      vtkIdType ncells;
+      vtkIdType* cells;
+      for (; ptId < endPtId; ++ptId)
+      {
+        inputDS->GetPointCells(ptId, ncells, cells);
+        if (ncells < 1)
+        {
+          unusedPoint.store(true, std::memory_order_relaxed);
+          break;
+        }
+      }
+    });
+    if (unusedPoint || this->GeneratePointStencil(0, inputDS, stencil, weights) <= 0)
+    {
+      return false;
+    }
+  }
+
+  // Number the inserted points in the order of the first slots of their
+  // edges.
+  std::vector<char> firsts(numSlots, 0);
+  vtkSMPTools::For(0, numEdges, [&](vtkIdType edgeId, vtkIdType endEdgeId) {
+    for (; edgeId < endEdgeId; ++edgeId)
+    {
+      firsts[firstSlots[edgeId]] = 1;
+    }
+  });
+  std::vector<vtkIdType> edgePointIds(numEdges);
+  vtkIdType newId = numPts;
+  for (vtkIdType slot = 0; slot < numSlots; ++slot)
+  {
+    if (firsts[slot])
+    {
+      edgePointIds[slotIds[slot]] = newId++;
+    }
+  }
+  std::vector<char>().swap(firsts);
+
+  // Resize() keeps the points copied by interpolating schemes, which
+  // SetNumberOfPoints() alone would discard.
+  const vtkIdType numNewPts = numPts + numEdges;
+  outputPts->Resize(numNewPts);
+  outputPts->SetNumberOfPoints(numNewPts);
+  outputPD->SetNumberOfTuples(numNewPts);
+  vtkSMPThreadLocalObject<vtkIdList> tlStencil;
+
+  // The points of the input, moved by approximating schemes.
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    vtkIdList* ptStencil = tlStencil.Local();
+    double ptWeights[256];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      if (interpolating)
+      {
+        outputPD->CopyData(inputPD, ptId, ptId);
+      }
+      else if (this->GeneratePointStencil(ptId, inputDS, ptStencil, ptWeights) > 0)
+      {
+        InterpolatePosition(inputPts, outputPts, ptId, ptStencil, ptWeights);
+        outputPD->InterpolatePoint(inputPD, ptId, ptStencil, ptWeights);
+      }
+    }
+  });
+
+  // The points inserted on the edges.
+  vtkSMPTools::For(0, numEdges, [&](vtkIdType edgeId, vtkIdType endEdgeId) {
+    vtkIdList* edgeCellPts = tlCellPts.Local();
+    vtkIdList* edgeStencil = tlStencil.Local();
+    double edgeWeights[256];
+    vtkIdType q1, q2;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endEdgeId - edgeId) / 10 + 1, (vtkIdType)1000);
+    for (; edgeId < endEdgeId; ++edgeId)
+    {
+      if (edgeId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      getEdgePoints(firstSlots[edgeId], edgeCellPts, q1, q2);
+      if (this->GenerateEdgeStencil(q1, q2, inputDS, edgeStencil, edgeWeights) > 0)
+      {
+        InterpolatePosition(inputPts, outputPts, edgePointIds[edgeId], edgeStencil, edgeWeights);
+        outputPD->InterpolatePoint(inputPD, edgePointIds[edgeId], edgeStencil, edgeWeights);
+      }
+    }
+  });
+
+  // Four triangles per triangle, in the order of the serial subdivision, and
+  // with the cell data of their parent.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(4 * numCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(12 * numCells);
+  outputCD->SetNumberOfTuples(4 * numCells);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* triCellPts = tlCellPts.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkIdType* offset = offsets->GetPointer(4 * cellId);
+    vtkIdType* conn = connectivity->GetPointer(12 * cellId);
+    for (; cellId < endCellId; ++cellId)
+    {
+      inputPolys->GetCellAtId(cellId, npts, pts, triCellPts);
+      const vtkIdType e0 = edgePointIds[slotIds[3 * cellId]];
+      const vtkIdType e1 = edgePointIds[slotIds[3 * cellId + 1]];
+      const vtkIdType e2 = edgePointIds[slotIds[3 * cellId + 2]];
+      const vtkIdType tris[12] = { pts[0], e1, e0, e1, pts[1], e2, e2, pts[2], e0, e1, e2, e0 };
+      for (int i = 0; i < 4; ++i)
+      {
+        *offset++ = 12 * cellId + 3 * i;
+        outputCD->CopyData(inputCD, cellId, 4 * cellId + i);
+      }
+      conn = std::copy(tris, tris + 12, conn);
+    }
+  });
+  offsets->SetValue(4 * numCells, 12 * numCells);
+  outputPolys->SetData(offsets, connectivity);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
 void vtkSubdivisionFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "Number of subdivisions: " << this->GetNumberOfSubdivisions() << endl;
   os << indent << "Check for triangles: " << this->GetCheckForTriangles() << endl;
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
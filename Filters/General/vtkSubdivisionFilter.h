@@ -19,6 +19,13 @@
  * vtkSubdivisionFilter is an abstract class that defines
  * the protocol for subdivision surface filters.
  *
+ * @warning
+ * Meshes made of triangles only are subdivided with vtkSMPTools when the
+ * subclass computes its stencils with GenerateEdgeStencil() and, for
+ * approximating schemes, GeneratePointStencil(). The output is the same as
+ * the one of the serial subdivision, which is still used for other meshes,
+ * for non-manifold meshes, when SequentialProcessing is on, and when the
+ * attributes have arrays that are not data arrays or are bit arrays.
  */
 
 #ifndef vtkSubdivisionFilter_h
@@ -34,6 +41,7 @@ class vtkIdList;
 class vtkIntArray;
 class vtkPoints;
 class vtkPointData;
+class vtkPolyData;
 
 class VTKFILTERSGENERAL_EXPORT vtkSubdivisionFilter : public vtkPolyDataAlgorithm
 {
@@ -61,14 +69,61 @@ public:
   vtkBooleanMacro(CheckForTriangles, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the subdivision. By
+   * default, sequential processing is off. The output is the same either
+   * way. This flag is typically used for benchmarking and testing purposes.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkSubdivisionFilter();
   ~vtkSubdivisionFilter() override = default;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Compute the stencil of the point inserted on the edge (p1, p2) of the
+   * mesh, used by one or two triangles, into stencilIds and weights. This
+   * method is called concurrently, so it must be thread-safe. Return 1 on
+   * success, 0 on failure. The default implementation returns -1, meaning
+   * that the subclass does not support the threaded subdivision.
+   */
+  virtual int GenerateEdgeStencil(
+    vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights);
+
+  /**
+   * Compute the stencil of the point moved from the point ptId of the mesh
+   * by approximating schemes. This method is called concurrently, so it must
+   * be thread-safe. Return 1 on success, 0 on failure. The default
+   * implementation returns -1, meaning that the subclass does not support
+   * the threaded subdivision.
+   */
+  virtual int GeneratePointStencil(
+    vtkIdType ptId, vtkPolyData* polys, vtkIdList* stencilIds, double* weights);
+
+  /**
+   * Subdivide one level of inputDS, whose links must be built, with
+   * vtkSMPTools. The edges are enumerated with vtkStaticEdgeLocatorTemplate,
+   * the stencils of the points are computed in parallel, and the triangles
+   * are written directly into outputPolys. outputPts must hold a copy of the
+   * points of inputDS for interpolating schemes and be empty otherwise, and
+   * outputPD and outputCD must have been allocated from the attributes of
+   * inputDS. The points, triangles and attributes are the same as the ones
+   * of the serial subdivision. Return false, leaving the outputs untouched,
+   * when SequentialProcessing is on or the level must be subdivided
+   * serially.
+   */
+  bool ThreadedSubdivide(vtkPolyData* inputDS, bool interpolating, vtkPoints* outputPts,
+    vtkPointData* outputPD, vtkCellArray* outputPolys, vtkCellData* outputCD);
+
   int NumberOfSubdivisions;
   vtkTypeBool CheckForTriangles;
+  bool SequentialProcessing;
 
 private:
   vtkSubdivisionFilter(const vtkSubdivisionFilter&) = delete;
@@ -21,8 +21,10 @@
 #include "vtkDataArrayRange.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkGenericCell.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkImageDataToPointSet.h"
+#include "vtkIncrementalArrayCache.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMarkBoundaryFilter.h"
@@ -57,6 +59,7 @@ vtkWarpScalar::vtkWarpScalar()
   this->Normal[2] = 1.0;
   this->XYPlane = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->IncrementalCache = vtkIncrementalArrayCache::New();
 
   // by default process active point scalars
   this->SetInputArrayToProcess(
@@ -64,7 +67,10 @@ vtkWarpScalar::vtkWarpScalar()
 }
 
 //------------------------------------------------------------------------------
-vtkWarpScalar::~vtkWarpScalar() = default;
+vtkWarpScalar::~vtkWarpScalar()
+{
+  this->IncrementalCache->Delete();
+}
 
 //------------------------------------------------------------------------------
 int vtkWarpScalar::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
@@ -122,10 +128,10 @@ struct ScaleWorker
 {
   template <typename InPT, typename OutPT, typename ST>
   void operator()(InPT* inPts, OutPT* outPts, ST* scalars, vtkWarpScalar* self, double sf,
-    bool XYPlane, vtkDataArray* inNormals, double* normal)
+    bool XYPlane, vtkDataArray* inNormals, double* normal, vtkIdType begin, vtkIdType end)
 
   {
-    vtkIdType numPts = inPts->GetNumberOfTuples();
+    vtkIdType numPts = end - begin;
     const auto ipts = vtk::DataArrayTupleRange<3>(inPts);
     auto opts = vtk::DataArrayTupleRange<3>(outPts);
     const auto sRange = vtk::DataArrayTupleRange(scalars);
@@ -136,7 +142,7 @@ struct ScaleWorker
     static constexpr int VTK_SMP_THRESHOLD = 750000;
     if (numPts >= VTK_SMP_THRESHOLD)
     {
-      vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      vtkSMPTools::For(begin, end, [&](vtkIdType ptId, vtkIdType endPtId) {
         double s, *n = normal, inNormal[3];
         bool isFirst = vtkSMPTools::GetSingleThread();
         for (; ptId < endPtId; ++ptId)
@@ -178,11 +184,11 @@ struct ScaleWorker
     else // serial
     {
       double s, *n = normal, inNormal[3];
-      for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+      for (vtkIdType ptId = begin; ptId < end; ptId++)
       {
-        if (!(ptId % 10000))
+        if (!((ptId - begin) % 10000))
         {
-          self->UpdateProgress((double)ptId / numPts);
+          self->UpdateProgress((double)(ptId - begin) / numPts);
           if (self->CheckAbort())
           {
             break;
@@ -322,21 +328,6 @@ int vtkWarpScalar::RequestData(vtkInformation* vtkNotUsed(request),
 
   numPts = inPts->GetNumberOfPoints();
 
-  // Create the output points. Backward compatibility requires the
-  // output type to be float - this can be overridden.
-  vtkNew<vtkPoints> newPts;
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION ||
-    this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else
-  {
-    newPts->SetDataType(VTK_DOUBLE);
-  }
-  newPts->SetNumberOfPoints(numPts);
-  output->SetPoints(newPts);
-
   // Figure out what normal to use
   double normal[3] = { 0.0, 0.0, 0.0 };
   if (inNormals && !this->UseNormal)
@@ -358,16 +349,62 @@ int vtkWarpScalar::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "Using Normal instance variable");
   }
 
+  // Reuse the output points of the last execution if only ranges of the
+  // input arrays were modified.
+  vtkDataArray* inArrays[3] = { inPts->GetData(), inScalars, inNormals };
+  vtkNew<vtkIdTypeArray> ranges;
+  vtkDataArray* incrementalPts = this->GenerateEnclosure
+    ? nullptr
+    : this->IncrementalCache->GetCachedOutput(this, 3, inArrays, ranges);
+
+  // Create the output points. Backward compatibility requires the
+  // output type to be float - this can be overridden.
+  vtkNew<vtkPoints> newPts;
+  if (incrementalPts)
+  {
+    newPts->SetData(incrementalPts);
+  }
+  else
+  {
+    if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION ||
+      this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+    {
+      newPts->SetDataType(VTK_FLOAT);
+    }
+    else
+    {
+      newPts->SetDataType(VTK_DOUBLE);
+    }
+    newPts->SetNumberOfPoints(numPts);
+    ranges->SetNumberOfComponents(2);
+    ranges->SetNumberOfTuples(1);
+    ranges->SetTypedComponent(0, 0, 0);
+    ranges->SetTypedComponent(0, 1, numPts);
+  }
+  output->SetPoints(newPts);
+
   // Dispatch over point and scalar types
   using vtkArrayDispatch::Reals;
   using ScaleDispatch = vtkArrayDispatch::Dispatch3ByValueType<Reals, Reals, Reals>;
   ScaleWorker scaleWorker;
-  if (!ScaleDispatch::Execute(inPts->GetData(), newPts->GetData(), inScalars, scaleWorker, this,
-        this->ScaleFactor, this->XYPlane, inNormals, normal))
-  { // fallback to slowpath
-    scaleWorker(inPts->GetData(), newPts->GetData(), inScalars, this, this->ScaleFactor,
-      this->XYPlane, inNormals, normal);
+  for (vtkIdType r = 0; r < ranges->GetNumberOfTuples(); ++r)
+  {
+    const vtkIdType begin = ranges->GetTypedComponent(r, 0);
+    const vtkIdType end = ranges->GetTypedComponent(r, 1);
+    if (!ScaleDispatch::Execute(inPts->GetData(), newPts->GetData(), inScalars, scaleWorker, this,
+          this->ScaleFactor, this->XYPlane, inNormals, normal, begin, end))
+    { // fallback to slowpath
+      scaleWorker(inPts->GetData(), newPts->GetData(), inScalars, this, this->ScaleFactor,
+        this->XYPlane, inNormals, normal, begin, end);
+    }
+    if (incrementalPts)
+    {
+      // Let the filters downstream update their outputs incrementally.
+      incrementalPts->ModifiedRange(begin, end);
+    }
   }
+  this->IncrementalCache->SetCachedOutput(3, inArrays,
+    this->GenerateEnclosure || this->GetAbortOutput() ? nullptr : newPts->GetData());
 
   // Update ourselves and release memory
   //
@@ -33,6 +33,11 @@
  * Note that the filter passes both its point data and cell data to
  * its output, except for normals, since these are distorted by the
  * warping.
+ *
+ * When the input points, scalars and normals were only modified by ranges
+ * (see vtkDataArray::ModifiedRange()), only the modified points are warped
+ * again, in place, as long as the output points of the last execution are not
+ * referenced anywhere else. This is disabled when GenerateEnclosure is on.
  */
 
 #ifndef vtkWarpScalar_h
@@ -47,6 +52,7 @@ class vtkDataArray;
 class vtkDataSet;
 class vtkDataSetAttributes;
 class vtkIdTypeArray;
+class vtkIncrementalArrayCache;
 class vtkPointSet;
 class vtkUnsignedCharArray;
 
@@ -159,6 +165,8 @@ protected:
 private:
   vtkWarpScalar(const vtkWarpScalar&) = delete;
   void operator=(const vtkWarpScalar&) = delete;
+
+  vtkIncrementalArrayCache* IncrementalCache;
 };
 
 VTK_ABI_NAMESPACE_END
@@ -0,0 +1,165 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTemporalCachePrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkTemporalDataSetCache prefetches the time steps following the
+// requested ones, forward and backward.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTemporalDataSetCache.h"
+
+#include <atomic>
+#include <iostream>
+
+namespace
+{
+// Source with 10 time steps, producing time + 1 points.
+class TemporalSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TemporalSource* New();
+  vtkTypeMacro(TemporalSource, vtkPolyDataAlgorithm);
+
+  std::atomic<int> NumberOfExecutions{ 0 };
+
+protected:
+  TemporalSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double timeSteps[10];
+    for (int i = 0; i < 10; ++i)
+    {
+      timeSteps[i] = i;
+    }
+    double timeRange[2] = { 0.0, 9.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(static_cast<vtkIdType>(time) + 1);
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->SetPoints(points);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+};
+vtkStandardNewMacro(TemporalSource);
+
+// Update the cache and returns the number of executions of the source.
+int Update(vtkTemporalDataSetCache* cache, TemporalSource* source, double time)
+{
+  cache->WaitForPrefetch();
+  const int numberOfExecutions = source->NumberOfExecutions;
+  cache->UpdateTimeStep(time);
+  vtkPolyData* output = vtkPolyData::SafeDownCast(cache->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfPoints() != static_cast<vtkIdType>(time) + 1 ||
+    output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != time)
+  {
+    std::cerr << "Wrong output for time " << time << std::endl;
+    return -1;
+  }
+  return source->NumberOfExecutions - numberOfExecutions;
+}
+}
+
+int TestTemporalCachePrefetch(int, char*[])
+{
+  vtkNew<TemporalSource> source;
+  vtkNew<TemporalSource> prefetchSource;
+  vtkNew<vtkTemporalDataSetCache> cache;
+  cache->SetInputConnection(source->GetOutputPort());
+  cache->SetPrefetchSource(prefetchSource);
+  cache->PrefetchOn();
+
+  // Playing forward, time steps 2 and 3 are prefetched after 0 and 1.
+  if (Update(cache, source, 0.0) != 1 || Update(cache, source, 1.0) != 1)
+  {
+    std::cerr << "Wrong number of executions" << std::endl;
+    return EXIT_FAILURE;
+  }
+  cache->WaitForPrefetch();
+  if (prefetchSource->NumberOfExecutions != 2)
+  {
+    std::cerr << "Time steps were not prefetched" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (int time = 2; time < 6; ++time)
+  {
+    if (Update(cache, source, time) != 0)
+    {
+      std::cerr << "Time step " << time << " was not prefetched" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Playing backward with a stride. Modifying the input discards the cached
+  // and prefetched time steps.
+  source->Modified();
+  if (Update(cache, source, 9.0) != 1 || Update(cache, source, 7.0) != 1 ||
+    Update(cache, source, 5.0) != 0 || Update(cache, source, 3.0) != 0)
+  {
+    std::cerr << "Time steps were not prefetched backward" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the prefetch source discards the time steps it prefetched. The
+  // other cache has its own prefetch source, since a source updated by two
+  // caches would be updated by two threads at once.
+  cache->WaitForPrefetch();
+  vtkNew<TemporalSource> otherPrefetchSource;
+  vtkNew<vtkTemporalDataSetCache> otherCache;
+  otherCache->SetInputConnection(source->GetOutputPort());
+  otherCache->SetPrefetchSource(otherPrefetchSource);
+  otherCache->PrefetchOn();
+  if (Update(otherCache, source, 0.0) != 1 || Update(otherCache, source, 1.0) != 1)
+  {
+    std::cerr << "Wrong number of executions" << std::endl;
+    return EXIT_FAILURE;
+  }
+  otherCache->WaitForPrefetch();
+  otherPrefetchSource->Modified();
+  if (Update(otherCache, source, 2.0) != 1)
+  {
+    std::cerr << "Time steps of a modified prefetch source were used" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Without prefetching, time steps are produced by the input.
+  cache->PrefetchOff();
+  if (Update(cache, source, 0.0) != 1 || Update(cache, source, 1.0) != 1 ||
+    Update(cache, source, 2.0) != 1)
+  {
+    std::cerr << "Time steps were prefetched" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -24,8 +24,12 @@
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimeStamp.h"
 
 #include <algorithm>
+#include <chrono>
+#include <future>
+#include <utility>
 #include <vector>
 
 // A helper class to to turn on memkind, if enabled, while ensuring it always is restored
@@ -57,23 +61,42 @@ public:
   vtkTDSCMemkindRAII(vtkTDSCMemkindRAII const&) = default;
 };
 
+//------------------------------------------------------------------------------
+class vtkTemporalDataSetCache::vtkInternals
+{
+public:
+  using PrefetchedType = std::vector<std::pair<double, vtkSmartPointer<vtkDataObject>>>;
+
+  // Time steps being produced by the prefetch source.
+  std::future<PrefetchedType> Prefetched;
+  // Time at which the prefetch started.
+  vtkMTimeType PrefetchTime = 0;
+  // The last two requested time steps, the most recent last.
+  std::vector<double> History;
+};
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkTemporalDataSetCache);
 
 //------------------------------------------------------------------------------
 vtkTemporalDataSetCache::vtkTemporalDataSetCache()
+  : Internals(new vtkInternals)
 {
   this->CacheSize = 10;
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(1);
   this->CacheInMemkind = false;
   this->IsASource = false;
+  this->Prefetch = false;
+  this->NumberOfPrefetchedTimeSteps = 2;
+  this->PrefetchSource = nullptr;
   this->Ejected = nullptr;
 }
 
 //------------------------------------------------------------------------------
 vtkTemporalDataSetCache::~vtkTemporalDataSetCache()
 {
+  this->SetPrefetchSource(nullptr);
   CacheType::iterator pos = this->Cache.begin();
   for (; pos != this->Cache.end();)
   {
@@ -140,6 +163,40 @@ void vtkTemporalDataSetCache::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "Prefetch: " << this->Prefetch << endl;
+  os << indent << "NumberOfPrefetchedTimeSteps: " << this->NumberOfPrefetchedTimeSteps << endl;
+  os << indent << "PrefetchSource: " << this->PrefetchSource << endl;
+}
+
+//------------------------------------------------------------------------------
+void vtkTemporalDataSetCache::SetPrefetchSource(vtkAlgorithm* source)
+{
+  if (this->PrefetchSource == source)
+  {
+    return;
+  }
+  // Discard the time steps prefetched by the previous source.
+  this->WaitForPrefetch();
+  this->Internals->Prefetched = std::future<vtkInternals::PrefetchedType>();
+  if (this->PrefetchSource)
+  {
+    this->PrefetchSource->UnRegister(this);
+  }
+  this->PrefetchSource = source;
+  if (this->PrefetchSource)
+  {
+    this->PrefetchSource->Register(this);
+  }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkTemporalDataSetCache::WaitForPrefetch()
+{
+  if (this->Internals->Prefetched.valid())
+  {
+    this->Internals->Prefetched.wait();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -329,6 +386,7 @@ int vtkTemporalDataSetCache ::RequestUpdateExtent(vtkInformation* vtkNotUsed(req
         ++pos;
       }
     }
+    this->AddPrefetchedTimeSteps(pmt);
   }
 
   // are there any times that we are missing from the request? e.g. times
@@ -382,11 +440,153 @@ int vtkTemporalDataSetCache ::RequestUpdateExtent(vtkInformation* vtkNotUsed(req
         }
       }
     }
+
+    this->StartPrefetch(inInfo, upTime);
   }
 
   return 1;
 }
 
+//------------------------------------------------------------------------------
+void vtkTemporalDataSetCache::AddPrefetchedTimeSteps(vtkMTimeType pipelineMTime)
+{
+  std::future<vtkInternals::PrefetchedType>& prefetched = this->Internals->Prefetched;
+  if (!prefetched.valid() ||
+    prefetched.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+  {
+    return;
+  }
+  vtkInternals::PrefetchedType timeSteps = prefetched.get();
+
+  // The pipeline, the prefetch source or its own pipeline was modified since
+  // the prefetch started.
+  vtkMTimeType sourceMTime = this->PrefetchSource->GetMTime();
+  if (auto sddp = vtkDemandDrivenPipeline::SafeDownCast(this->PrefetchSource->GetExecutive()))
+  {
+    sddp->UpdatePipelineMTime();
+    sourceMTime = std::max(sourceMTime, sddp->GetPipelineMTime());
+  }
+  const vtkMTimeType prefetchTime = this->Internals->PrefetchTime;
+  if (prefetchTime < pipelineMTime || prefetchTime < sourceMTime)
+  {
+    return;
+  }
+
+  for (auto& timeStep : timeSteps)
+  {
+    if (this->Cache.find(timeStep.first) != this->Cache.end())
+    {
+      continue;
+    }
+    if (this->Cache.size() >= static_cast<unsigned long>(this->CacheSize))
+    {
+      // evict the oldest data, unless it was requested since the prefetch
+      // started
+      CacheType::iterator oldestpos = this->Cache.begin();
+      for (CacheType::iterator pos = this->Cache.begin(); pos != this->Cache.end(); ++pos)
+      {
+        if (pos->second.first < oldestpos->second.first)
+        {
+          oldestpos = pos;
+        }
+      }
+      if (oldestpos->second.first >= prefetchTime)
+      {
+        return;
+      }
+      oldestpos->second.second->UnRegister(this);
+      this->Cache.erase(oldestpos);
+    }
+    timeStep.second->Register(this);
+    this->Cache[timeStep.first] =
+      std::pair<unsigned long, vtkDataObject*>(prefetchTime, timeStep.second);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkTemporalDataSetCache::StartPrefetch(vtkInformation* inInfo, double upTime)
+{
+  std::vector<double>& history = this->Internals->History;
+  if (history.empty() || history.back() != upTime)
+  {
+    history.push_back(upTime);
+    if (history.size() > 2)
+    {
+      history.erase(history.begin());
+    }
+  }
+
+  // Only one prefetch runs at a time.
+  if (!this->Prefetch || !this->PrefetchSource || this->IsASource || history.size() < 2 ||
+    this->Internals->Prefetched.valid() ||
+    !inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    return;
+  }
+
+  // Predict the next time steps from the stride between the last two
+  // requests, in the time steps of the input.
+  const double* steps = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  const int numberOfSteps = inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  auto indexOf = [steps, numberOfSteps](double time) {
+    const double* found = std::lower_bound(steps, steps + numberOfSteps, time);
+    return (found != steps + numberOfSteps && *found == time) ? static_cast<int>(found - steps)
+                                                              : -1;
+  };
+  const int previous = indexOf(history[0]);
+  const int last = indexOf(history[1]);
+  if (previous < 0 || last < 0)
+  {
+    return;
+  }
+  const int stride = last - previous;
+  const int count = std::min(this->NumberOfPrefetchedTimeSteps, this->CacheSize - 1);
+  std::vector<double> times;
+  for (int i = 1; i <= count; ++i)
+  {
+    const int index = last + i * stride;
+    if (index < 0 || index >= numberOfSteps)
+    {
+      break;
+    }
+    if (this->Cache.find(steps[index]) == this->Cache.end())
+    {
+      times.push_back(steps[index]);
+    }
+  }
+  if (times.empty())
+  {
+    return;
+  }
+
+  vtkDebugMacro(<< "Prefetching " << times.size() << " time steps");
+  vtkTimeStamp prefetchTime;
+  prefetchTime.Modified();
+  this->Internals->PrefetchTime = prefetchTime.GetMTime();
+  vtkSmartPointer<vtkAlgorithm> source = this->PrefetchSource;
+  this->Internals->Prefetched = std::async(std::launch::async, [source, times]() {
+    vtkInternals::PrefetchedType prefetched;
+    for (double time : times)
+    {
+      vtkDataObject* output = nullptr;
+      if (source->UpdateTimeStep(time))
+      {
+        output = source->GetOutputDataObject(0);
+      }
+      if (!output)
+      {
+        break;
+      }
+      vtkSmartPointer<vtkDataObject> copy;
+      copy.TakeReference(output->NewInstance());
+      copy->DeepCopy(output);
+      copy->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+      prefetched.emplace_back(time, copy);
+    }
+    return prefetched;
+  });
+}
+
 //------------------------------------------------------------------------------
 // This method simply copies by reference the input data to the output.
 int vtkTemporalDataSetCache::RequestData(vtkInformation* vtkNotUsed(request),
@@ -26,6 +26,19 @@
  * John Biddiscombe, Berk Geveci, Ken Martin, Kenneth Moreland, David Thompson,
  * "Time Dependent Processing in a Parallel Pipeline Architecture",
  * IEEE Visualization 2007.
+ *
+ * When Prefetch is on, the time steps likely to be requested next are
+ * predicted from the last requests (playing forward, backward, or with a
+ * stride) and produced in the background by PrefetchSource, so that they are
+ * already cached when requested. PrefetchSource must produce the same data as
+ * the input of the cache, without sharing any state with the input pipeline:
+ * typically a second instance of the reader, opening the same files. It is
+ * updated on a background thread, so it must not be shared with other caches
+ * nor be updated by anything else while Prefetch is on.
+ * Prefetched time steps are stored under the same cache size rules, but never
+ * evict time steps requested since the prefetch started. They are discarded
+ * if the input pipeline, or the pipeline of PrefetchSource, was modified
+ * since the prefetch started.
  */
 
 #ifndef vtkTemporalDataSetCache_h
@@ -35,6 +48,7 @@
 
 #include "vtkAlgorithm.h"
 #include <map>    // used for the cache
+#include <memory> // for unique_ptr
 #include <vector> // used for the timestep records
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -74,6 +88,42 @@ public:
   vtkBooleanMacro(IsASource, bool);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the prefetching of the next time steps by PrefetchSource.
+   * Off by default.
+   */
+  vtkSetMacro(Prefetch, bool);
+  vtkGetMacro(Prefetch, bool);
+  vtkBooleanMacro(Prefetch, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum number of time steps prefetched after each request.
+   * It is also limited by the cache size. Defaults to 2.
+   */
+  vtkSetClampMacro(NumberOfPrefetchedTimeSteps, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPrefetchedTimeSteps, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the algorithm updated in the background to prefetch time steps.
+   * Its first output must produce the same data as the input of the cache.
+   * Each cache needs its own prefetch source, since a source shared between
+   * caches would be updated by two threads at once.
+   */
+  void SetPrefetchSource(vtkAlgorithm* source);
+  vtkGetObjectMacro(PrefetchSource, vtkAlgorithm);
+  ///@}
+
+  /**
+   * Wait for the time steps being prefetched. They are added to the cache
+   * during the next request.
+   */
+  void WaitForPrefetch();
+
 protected:
   vtkTemporalDataSetCache();
   ~vtkTemporalDataSetCache() override;
@@ -109,6 +159,16 @@ private:
   void ReplaceCacheItem(vtkDataObject* input, double inTime, vtkMTimeType outputUpdateTime);
   bool CacheInMemkind;
   bool IsASource;
+  bool Prefetch;
+  int NumberOfPrefetchedTimeSteps;
+  vtkAlgorithm* PrefetchSource;
+
+  // Prefetching helpers, called while processing REQUEST_UPDATE_EXTENT.
+  void AddPrefetchedTimeSteps(vtkMTimeType pipelineMTime);
+  void StartPrefetch(vtkInformation* inInfo, double upTime);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 
   // a helper to deal with eviction smoothly. In effect we are an N+1 cache.
   void SetEjected(vtkDataObject*);
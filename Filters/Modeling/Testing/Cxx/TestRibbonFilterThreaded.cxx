@@ -0,0 +1,333 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRibbonFilterThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks of the threaded generation of vtkRibbonFilter: the same output as
+// the sequential one for all the options, the edges at the width from the
+// polylines across the ribbon normals, and the string and bit arrays, which
+// are only copied by the sequential processing.
+
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRibbonFilter.h"
+#include "vtkStringArray.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+// Polylines of all kinds: polylines sharing points, a closed polyline, a
+// polyline with coincident points, which cannot be ribboned, polylines too
+// short to be ribboned, a straight polyline along the z axis, which cannot be
+// ribboned with the default normal, and many random walks.
+static void MakeInput(vtkPolyData* input)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkIdList> ptIds;
+
+  // A helix, and a polyline going back along a part of it.
+  for (int i = 0; i < 200; ++i)
+  {
+    points->InsertNextPoint(std::cos(0.2 * i), std::sin(0.2 * i), 0.05 * i);
+    ptIds->InsertNextId(i);
+  }
+  lines->InsertNextCell(ptIds);
+  ptIds->Reset();
+  for (vtkIdType i = 120; i >= 50; --i)
+  {
+    ptIds->InsertNextId(i);
+  }
+  lines->InsertNextCell(ptIds);
+
+  // A closed polyline, using its first point twice.
+  ptIds->Reset();
+  for (int i = 0; i < 40; ++i)
+  {
+    ptIds->InsertNextId(points->InsertNextPoint(3.0 + std::cos(0.1 * i), std::sin(0.1 * i), 1.0));
+  }
+  ptIds->InsertNextId(ptIds->GetId(0));
+  lines->InsertNextCell(ptIds);
+
+  // Coincident points, with the same or different ids.
+  ptIds->Reset();
+  for (int i = 0; i < 10; ++i)
+  {
+    const vtkIdType id = points->InsertNextPoint(0.3 * i, -2.0, 0.1 * i * i);
+    ptIds->InsertNextId(id);
+    if (i % 3 == 0)
+    {
+      ptIds->InsertNextId(points->InsertNextPoint(0.3 * i, -2.0, 0.1 * i * i));
+    }
+    if (i % 4 == 1)
+    {
+      ptIds->InsertNextId(id);
+    }
+  }
+  lines->InsertNextCell(ptIds);
+
+  // Polylines with less than two points.
+  const vtkIdType single[1] = { 5 };
+  lines->InsertNextCell(1, single);
+  lines->InsertNextCell(0, single);
+
+  // A straight polyline along the z axis.
+  ptIds->Reset();
+  for (int i = 0; i < 5; ++i)
+  {
+    ptIds->InsertNextId(points->InsertNextPoint(5.0, 5.0, i));
+  }
+  lines->InsertNextCell(ptIds);
+
+  // Random walks.
+  for (int line = 0; line < 300; ++line)
+  {
+    ptIds->Reset();
+    double x[3] = { random->GetNextRangeValue(-5, 5), random->GetNextRangeValue(-5, 5),
+      random->GetNextRangeValue(-5, 5) };
+    const int npts = static_cast<int>(random->GetNextRangeValue(2, 30));
+    for (int i = 0; i < npts; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        x[j] += random->GetNextRangeValue(-0.5, 0.5);
+      }
+      ptIds->InsertNextId(points->InsertNextPoint(x));
+    }
+    lines->InsertNextCell(ptIds);
+  }
+  input->SetPoints(points);
+  input->SetLines(lines);
+
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    scalars->InsertNextValue(random->GetNextRangeValue(0.5, 2.0));
+    vectors->InsertNextTuple3(random->GetNextRangeValue(0.5, 1.0),
+      random->GetNextRangeValue(-1.0, 1.0), random->GetNextRangeValue(-1.0, 1.0));
+    normals->InsertNextTuple3(0.0, 0.0, 1.0);
+    pointIds->InsertNextValue(i);
+  }
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->AddArray(normals);
+  input->GetPointData()->AddArray(pointIds);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  input->GetCellData()->AddArray(cellIds);
+}
+
+// Both arrays are missing, or have the same type, size and values.
+static bool SameArrays(vtkDataArray* threaded, vtkDataArray* serial)
+{
+  if (!threaded || !serial)
+  {
+    return !threaded && !serial;
+  }
+  if (threaded->GetDataType() != serial->GetDataType() ||
+    threaded->GetNumberOfTuples() != serial->GetNumberOfTuples() ||
+    threaded->GetNumberOfComponents() != serial->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < threaded->GetNumberOfTuples(); ++i)
+  {
+    for (int j = 0; j < threaded->GetNumberOfComponents(); ++j)
+    {
+      if (threaded->GetComponent(i, j) != serial->GetComponent(i, j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool SameStrips(vtkPolyData* threaded, vtkPolyData* serial)
+{
+  vtkCellArray* threadedStrips = threaded->GetStrips();
+  vtkCellArray* serialStrips = serial->GetStrips();
+  return threadedStrips->GetNumberOfCells() != 0 &&
+    SameArrays(threadedStrips->GetOffsetsArray(), serialStrips->GetOffsetsArray()) &&
+    SameArrays(threadedStrips->GetConnectivityArray(), serialStrips->GetConnectivityArray());
+}
+
+// String and bit arrays, which are only copied by the sequential
+// processing, are passed to the output.
+static bool CopiesStringAndBitArrays(vtkPolyDataAlgorithm* filter, vtkPolyData* input)
+{
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  vtkNew<vtkBitArray> bits;
+  bits->SetName("Bits");
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    names->InsertNextValue(std::to_string(i));
+    bits->InsertNextValue(i % 2);
+  }
+  vtkNew<vtkPolyData> namesInput;
+  namesInput->ShallowCopy(input);
+  namesInput->GetPointData()->AddArray(names);
+  namesInput->GetPointData()->AddArray(bits);
+  filter->SetInputData(namesInput);
+  filter->Update();
+  vtkPolyData* output = filter->GetOutput();
+  vtkPointData* outPD = output->GetPointData();
+  vtkStringArray* outNames = vtkArrayDownCast<vtkStringArray>(outPD->GetAbstractArray("Names"));
+  vtkDataArray* outBits = outPD->GetArray("Bits");
+  vtkDataArray* outIds = outPD->GetArray("PointIds");
+  if (!outNames || !outBits || !outIds || output->GetNumberOfPoints() == 0 ||
+    outNames->GetNumberOfValues() != output->GetNumberOfPoints() ||
+    outBits->GetNumberOfTuples() != output->GetNumberOfPoints())
+  {
+    std::cerr << "Missing string or bit array" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < outNames->GetNumberOfValues(); ++i)
+  {
+    const vtkIdType id = static_cast<vtkIdType>(outIds->GetComponent(i, 0));
+    if (outNames->GetValue(i) != std::to_string(id) || outBits->GetComponent(i, 0) != id % 2)
+    {
+      std::cerr << "Different string or bit value " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The threaded ribbons are the sequential ones, with and without varying
+// width, texture coordinates, input normals, default normal and angle.
+static bool TestRibbonFilterThreaded_SameAsSequential(
+  vtkPolyData* input, vtkPolyData* normalsInput)
+{
+  vtkNew<vtkRibbonFilter> threaded;
+  vtkNew<vtkRibbonFilter> serial;
+  serial->SequentialProcessingOn();
+  for (int option = 0; option < 24; ++option)
+  {
+    const int normalsMode = option % 3;
+    for (vtkRibbonFilter* filter : { threaded.Get(), serial.Get() })
+    {
+      filter->SetVaryWidth((option / 3) % 2);
+      filter->SetGenerateTCoords((option / 6) % 4);
+      filter->SetInputData(normalsMode == 2 ? normalsInput : input);
+      filter->SetUseDefaultNormal(normalsMode == 1);
+      filter->SetWidth(0.1);
+      filter->SetAngle(option % 4 == 0 ? 30.0 : 0.0);
+      filter->Update();
+    }
+    vtkPolyData* threadedOutput = threaded->GetOutput();
+    vtkPolyData* serialOutput = serial->GetOutput();
+    vtkPointData* threadedPD = threadedOutput->GetPointData();
+    vtkPointData* serialPD = serialOutput->GetPointData();
+    bool same = threadedOutput->GetNumberOfPoints() != 0 &&
+      SameArrays(threadedOutput->GetPoints()->GetData(), serialOutput->GetPoints()->GetData()) &&
+      SameStrips(threadedOutput, serialOutput) &&
+      SameArrays(threadedPD->GetNormals(), serialPD->GetNormals()) &&
+      SameArrays(threadedPD->GetTCoords(), serialPD->GetTCoords()) &&
+      SameArrays(threadedOutput->GetCellData()->GetArray("CellIds"),
+        serialOutput->GetCellData()->GetArray("CellIds"));
+    for (const char* name : { "Scalars", "Vectors", "PointIds" })
+    {
+      same = same && SameArrays(threadedPD->GetArray(name), serialPD->GetArray(name));
+    }
+    if (!same)
+    {
+      std::cerr << "Different outputs for option " << option << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Without varying width, each point of the edges is at the width from its
+// input point, across the unit normal of the ribbon.
+static bool TestRibbonFilterThreaded_Width(vtkPolyData* input)
+{
+  const double width = 0.1;
+  for (bool sequential : { false, true })
+  {
+    vtkNew<vtkRibbonFilter> ribbonFilter;
+    ribbonFilter->SetSequentialProcessing(sequential);
+    ribbonFilter->SetInputData(input);
+    ribbonFilter->SetWidth(width);
+    ribbonFilter->Update();
+    vtkPolyData* output = ribbonFilter->GetOutput();
+    vtkDataArray* normals = output->GetPointData()->GetNormals();
+    vtkDataArray* pointIds = output->GetPointData()->GetArray("PointIds");
+    if (output->GetNumberOfPoints() == 0 || !normals || !pointIds)
+    {
+      std::cerr << "No ribbon normals or point ids" << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+      double x[3], p[3], n[3];
+      output->GetPoint(i, x);
+      input->GetPoint(static_cast<vtkIdType>(pointIds->GetComponent(i, 0)), p);
+      normals->GetTuple(i, n);
+      const double offset[3] = { x[0] - p[0], x[1] - p[1], x[2] - p[2] };
+      if (std::abs(vtkMath::Norm(offset) - width) > 1e-5 ||
+        std::abs(vtkMath::Dot(offset, n)) > 1e-5 || std::abs(vtkMath::Norm(n) - 1.0) > 1e-5)
+      {
+        std::cerr << "Point " << i << " is not at the width across its normal" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int TestRibbonFilterThreaded(int, char*[])
+{
+  // Some polylines cannot be ribboned.
+  vtkObject::GlobalWarningDisplayOff();
+
+  vtkNew<vtkPolyData> input;
+  MakeInput(input);
+  vtkNew<vtkPolyData> normalsInput;
+  normalsInput->ShallowCopy(input);
+  normalsInput->GetPointData()->SetNormals(normalsInput->GetPointData()->GetArray("Normals"));
+
+  vtkNew<vtkRibbonFilter> ribbonFilter;
+  bool success = TestRibbonFilterThreaded_SameAsSequential(input, normalsInput) &&
+    TestRibbonFilterThreaded_Width(input) && CopiesStringAndBitArrays(ribbonFilter, input);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
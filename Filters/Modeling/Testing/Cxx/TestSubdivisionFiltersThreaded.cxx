@@ -0,0 +1,264 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSubdivisionFiltersThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks of the threaded subdivision of the linear, loop and butterfly
+// filters: the same output as the sequential one, four triangles per
+// triangle and level, the input points kept by the interpolating filters,
+// and the string and bit arrays, which make the filters subdivide serially.
+
+#include "vtkBitArray.h"
+#include "vtkButterflySubdivisionFilter.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLinearSubdivisionFilter.h"
+#include "vtkLoopSubdivisionFilter.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStringArray.h"
+
+#include <iostream>
+#include <string>
+
+// An open sphere, whose poles and boundary points have valences other than
+// six, with jittered points and attributes.
+static void MakeInput(vtkPolyData* input)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(14);
+  sphere->SetPhiResolution(9);
+  sphere->SetEndTheta(300.0);
+  sphere->Update();
+  input->CopyStructure(sphere->GetOutput());
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    input->GetPoint(i, x);
+    points->InsertNextPoint(x[0] + random->GetNextRangeValue(-0.02, 0.02),
+      x[1] + random->GetNextRangeValue(-0.02, 0.02), x[2]);
+    scalars->InsertNextValue(random->GetNextRangeValue(0.0, 1.0));
+    vectors->InsertNextTuple3(x[0], random->GetNextRangeValue(-1.0, 1.0), i);
+  }
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  input->GetCellData()->AddArray(cellIds);
+}
+
+// Both arrays have the same type, size and values.
+static bool SameArrays(vtkDataArray* threaded, vtkDataArray* serial)
+{
+  if (!threaded || !serial || threaded->GetDataType() != serial->GetDataType() ||
+    threaded->GetNumberOfTuples() != serial->GetNumberOfTuples() ||
+    threaded->GetNumberOfComponents() != serial->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < threaded->GetNumberOfTuples(); ++i)
+  {
+    for (int j = 0; j < threaded->GetNumberOfComponents(); ++j)
+    {
+      if (threaded->GetComponent(i, j) != serial->GetComponent(i, j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static vtkSmartPointer<vtkPolyData> Subdivide(
+  vtkSubdivisionFilter* filter, vtkPolyData* input, int level, bool sequential)
+{
+  filter->SetSequentialProcessing(sequential);
+  filter->SetInputData(input);
+  filter->SetNumberOfSubdivisions(level);
+  filter->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(filter->GetOutputDataObject(0));
+  return output;
+}
+
+// The threaded subdivision gives the points, triangles and attributes of the
+// sequential one, for one to three levels.
+static bool TestSubdivisionFiltersThreaded_SameAsSequential(
+  vtkSubdivisionFilter* filter, vtkPolyData* input)
+{
+  for (int level = 1; level <= 3; ++level)
+  {
+    vtkSmartPointer<vtkPolyData> threaded = Subdivide(filter, input, level, false);
+    vtkSmartPointer<vtkPolyData> serial = Subdivide(filter, input, level, true);
+    if (!SameArrays(threaded->GetPoints()->GetData(), serial->GetPoints()->GetData()) ||
+      !SameArrays(threaded->GetPolys()->GetOffsetsArray(), serial->GetPolys()->GetOffsetsArray()) ||
+      !SameArrays(
+        threaded->GetPolys()->GetConnectivityArray(), serial->GetPolys()->GetConnectivityArray()))
+    {
+      std::cerr << "Different geometry of " << filter->GetClassName() << " for " << level
+                << " levels" << std::endl;
+      return false;
+    }
+    for (const char* name : { "Scalars", "Vectors" })
+    {
+      if (!SameArrays(
+            threaded->GetPointData()->GetArray(name), serial->GetPointData()->GetArray(name)))
+      {
+        std::cerr << "Different " << name << " of " << filter->GetClassName() << " for "
+                  << level << " levels" << std::endl;
+        return false;
+      }
+    }
+    if (!SameArrays(
+          threaded->GetCellData()->GetArray("CellIds"), serial->GetCellData()->GetArray("CellIds")))
+    {
+      std::cerr << "Different CellIds of " << filter->GetClassName() << " for " << level
+                << " levels" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Each level splits each triangle in four, whose cell data is the one of the
+// input triangle. The input points are numbered first, and the interpolating
+// filters keep them in place (as float, the type of the output points).
+static bool TestSubdivisionFiltersThreaded_Topology(
+  vtkSubdivisionFilter* filter, vtkPolyData* input, bool interpolating)
+{
+  vtkSmartPointer<vtkPolyData> output = Subdivide(filter, input, 2, false);
+  const vtkIdType numCells = input->GetNumberOfPolys();
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("CellIds");
+  if (output->GetNumberOfPolys() != 16 * numCells || !cellIds)
+  {
+    std::cerr << "Expected " << 16 * numCells << " triangles from " << filter->GetClassName()
+              << ", got " << output->GetNumberOfPolys() << std::endl;
+    return false;
+  }
+  vtkNew<vtkIdTypeArray> count;
+  count->SetNumberOfValues(numCells);
+  count->Fill(0);
+  for (vtkIdType i = 0; i < cellIds->GetNumberOfTuples(); ++i)
+  {
+    const vtkIdType id = static_cast<vtkIdType>(cellIds->GetComponent(i, 0));
+    count->SetValue(id, count->GetValue(id) + 1);
+  }
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    if (count->GetValue(i) != 16)
+    {
+      std::cerr << "Input triangle " << i << " of " << filter->GetClassName() << " gives "
+                << count->GetValue(i) << " triangles" << std::endl;
+      return false;
+    }
+  }
+  if (interpolating)
+  {
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+    {
+      double x[3], y[3];
+      input->GetPoint(i, x);
+      output->GetPoint(i, y);
+      if (static_cast<float>(x[0]) != y[0] || static_cast<float>(x[1]) != y[1] ||
+        static_cast<float>(x[2]) != y[2])
+      {
+        std::cerr << "Input point " << i << " moved by " << filter->GetClassName() << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// String and bit arrays are interpolated by the serial subdivision, which
+// keeps the values of the input points, numbered first in the output.
+static bool TestSubdivisionFiltersThreaded_StringAndBitArrays(vtkPolyData* input)
+{
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  vtkNew<vtkBitArray> bits;
+  bits->SetName("Bits");
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    names->InsertNextValue(std::to_string(i));
+    bits->InsertNextValue(i % 2);
+  }
+  vtkNew<vtkPolyData> namedInput;
+  namedInput->ShallowCopy(input);
+  namedInput->GetPointData()->AddArray(names);
+  namedInput->GetPointData()->AddArray(bits);
+  vtkNew<vtkLinearSubdivisionFilter> linear;
+  vtkSmartPointer<vtkPolyData> output = Subdivide(linear, namedInput, 1, false);
+  vtkPointData* outputPD = output->GetPointData();
+  vtkStringArray* outputNames = vtkStringArray::SafeDownCast(outputPD->GetAbstractArray("Names"));
+  vtkBitArray* outputBits = vtkBitArray::SafeDownCast(outputPD->GetAbstractArray("Bits"));
+  if (!outputNames || !outputBits ||
+    outputNames->GetNumberOfValues() != output->GetNumberOfPoints() ||
+    outputBits->GetNumberOfValues() != output->GetNumberOfPoints())
+  {
+    std::cerr << "Missing string or bit arrays" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    if (outputNames->GetValue(i) != names->GetValue(i) ||
+      outputBits->GetValue(i) != bits->GetValue(i))
+    {
+      std::cerr << "Different string or bit value of point " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int TestSubdivisionFiltersThreaded(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  MakeInput(input);
+
+  vtkNew<vtkLinearSubdivisionFilter> linear;
+  vtkNew<vtkLoopSubdivisionFilter> loop;
+  vtkNew<vtkButterflySubdivisionFilter> butterfly;
+  bool success = TestSubdivisionFiltersThreaded_SameAsSequential(linear, input) &&
+    TestSubdivisionFiltersThreaded_SameAsSequential(loop, input) &&
+    TestSubdivisionFiltersThreaded_SameAsSequential(butterfly, input) &&
+    TestSubdivisionFiltersThreaded_Topology(linear, input, true) &&
+    TestSubdivisionFiltersThreaded_Topology(loop, input, false) &&
+    TestSubdivisionFiltersThreaded_Topology(butterfly, input, true) &&
+    TestSubdivisionFiltersThreaded_StringAndBitArrays(input);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
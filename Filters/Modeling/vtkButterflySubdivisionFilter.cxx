@@ -38,25 +38,18 @@ int vtkButterflySubdivisionFilter::GenerateSubdivisionPoints(
   vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts, vtkPointData* outputPD)
 {
   const vtkIdType* pts = nullptr;
-  vtkIdType cellId, newId, i, j;
+  vtkIdType cellId, newId;
   int edgeId;
   vtkIdType npts = 0;
   vtkIdType p1, p2;
-  int valence1, valence2;
   vtkCellArray* inputPolys = inputDS->GetPolys();
   vtkSmartPointer<vtkEdgeTable> edgeTable = vtkSmartPointer<vtkEdgeTable>::New();
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
-  vtkSmartPointer<vtkIdList> p1CellIds = vtkSmartPointer<vtkIdList>::New();
-  vtkSmartPointer<vtkIdList> p2CellIds = vtkSmartPointer<vtkIdList>::New();
   vtkSmartPointer<vtkIdList> stencil = vtkSmartPointer<vtkIdList>::New();
-  vtkSmartPointer<vtkIdList> stencil1 = vtkSmartPointer<vtkIdList>::New();
-  vtkSmartPointer<vtkIdList> stencil2 = vtkSmartPointer<vtkIdList>::New();
   vtkPoints* inputPts = inputDS->GetPoints();
   vtkPointData* inputPD = inputDS->GetPointData();
 
   double weights[256];
-  double weights1[256];
-  double weights2[256];
 
   // Create an edge table to keep track of which edges we've processed
   edgeTable->InitEdgeInsertion(inputDS->GetNumberOfPoints());
@@ -84,59 +77,12 @@ int vtkButterflySubdivisionFilter::GenerateSubdivisionPoints(
         edgeTable->InsertEdge(p1, p2);
 
         inputDS->GetCellEdgeNeighbors(-1, p1, p2, cellIds);
-        // If this is a boundary edge. we need to use a special subdivision rule
-        if (cellIds->GetNumberOfIds() == 1)
-        {
-          // Compute new Position and PointData using the same subdivision scheme
-          this->GenerateBoundaryStencil(p1, p2, inputDS, stencil, weights);
-        } // boundary edge
-        else if (cellIds->GetNumberOfIds() == 2)
-        {
-          // find the valence of the two points
-          inputDS->GetPointCells(p1, p1CellIds);
-          valence1 = p1CellIds->GetNumberOfIds();
-          inputDS->GetPointCells(p2, p2CellIds);
-          valence2 = p2CellIds->GetNumberOfIds();
-
-          if (valence1 == 6 && valence2 == 6)
-          {
-            this->GenerateButterflyStencil(p1, p2, inputDS, stencil, weights);
-          }
-          else if (valence1 == 6 && valence2 != 6)
-          {
-            this->GenerateLoopStencil(p2, p1, inputDS, stencil, weights);
-          }
-          else if (valence1 != 6 && valence2 == 6)
-          {
-            this->GenerateLoopStencil(p1, p2, inputDS, stencil, weights);
-          }
-          else
-          {
-            // Edge connects two extraordinary vertices
-            this->GenerateLoopStencil(p2, p1, inputDS, stencil1, weights1);
-            this->GenerateLoopStencil(p1, p2, inputDS, stencil2, weights2);
-            // combine the two stencils and halve the weights
-            vtkIdType total = stencil1->GetNumberOfIds() + stencil2->GetNumberOfIds();
-            stencil->SetNumberOfIds(total);
-
-            j = 0;
-            for (i = 0; i < stencil1->GetNumberOfIds(); i++)
-            {
-              stencil->InsertId(j, stencil1->GetId(i));
-              weights[j++] = weights1[i] * .5;
-            }
-            for (i = 0; i < stencil2->GetNumberOfIds(); i++)
-            {
-              stencil->InsertId(j, stencil2->GetId(i));
-              weights[j++] = weights2[i] * .5;
-            }
-          }
-        }
-        else
+        if (cellIds->GetNumberOfIds() > 2)
         {
           vtkErrorMacro("Dataset is non-manifold and cannot be subdivided.");
           return 0;
         }
+        this->GenerateEdgeStencil(p1, p2, inputDS, stencil, weights);
         newId = this->InterpolatePosition(inputPts, outputPts, stencil, weights);
         outputPD->InterpolatePoint(inputPD, newId, stencil, weights);
       }
@@ -156,12 +102,85 @@ int vtkButterflySubdivisionFilter::GenerateSubdivisionPoints(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkButterflySubdivisionFilter::GenerateEdgeStencil(
+  vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
+{
+  vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> p1CellIds = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> p2CellIds = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> stencil1 = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> stencil2 = vtkSmartPointer<vtkIdList>::New();
+  double weights1[256];
+  double weights2[256];
+  vtkIdType i, j;
+  int valence1, valence2;
+
+  polys->GetCellEdgeNeighbors(-1, p1, p2, cellIds);
+  // If this is a boundary edge. we need to use a special subdivision rule
+  if (cellIds->GetNumberOfIds() == 1)
+  {
+    // Compute new Position and PointData using the same subdivision scheme
+    this->GenerateBoundaryStencil(p1, p2, polys, stencilIds, weights);
+  } // boundary edge
+  else if (cellIds->GetNumberOfIds() == 2)
+  {
+    // find the valence of the two points
+    polys->GetPointCells(p1, p1CellIds);
+    valence1 = p1CellIds->GetNumberOfIds();
+    polys->GetPointCells(p2, p2CellIds);
+    valence2 = p2CellIds->GetNumberOfIds();
+
+    if (valence1 == 6 && valence2 == 6)
+    {
+      this->GenerateButterflyStencil(p1, p2, polys, stencilIds, weights);
+    }
+    else if (valence1 == 6 && valence2 != 6)
+    {
+      this->GenerateLoopStencil(p2, p1, polys, stencilIds, weights);
+    }
+    else if (valence1 != 6 && valence2 == 6)
+    {
+      this->GenerateLoopStencil(p1, p2, polys, stencilIds, weights);
+    }
+    else
+    {
+      // Edge connects two extraordinary vertices
+      this->GenerateLoopStencil(p2, p1, polys, stencil1, weights1);
+      this->GenerateLoopStencil(p1, p2, polys, stencil2, weights2);
+      // combine the two stencils and halve the weights
+      vtkIdType total = stencil1->GetNumberOfIds() + stencil2->GetNumberOfIds();
+      stencilIds->SetNumberOfIds(total);
+
+      j = 0;
+      for (i = 0; i < stencil1->GetNumberOfIds(); i++)
+      {
+        stencilIds->InsertId(j, stencil1->GetId(i));
+        weights[j++] = weights1[i] * .5;
+      }
+      for (i = 0; i < stencil2->GetNumberOfIds(); i++)
+      {
+        stencilIds->InsertId(j, stencil2->GetId(i));
+        weights[j++] = weights2[i] * .5;
+      }
+    }
+  }
+  else
+  {
+    stencilIds->Reset();
+    return 0;
+  }
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkButterflySubdivisionFilter::GenerateLoopStencil(
   vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
 {
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
-  vtkCell* cell;
+  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
+  vtkIdType npts;
+  const vtkIdType* cellPts;
   vtkIdType startCell, nextCell, tp2, p;
   int shift[255];
   int processed = 0;
@@ -180,11 +199,11 @@ void vtkButterflySubdivisionFilter::GenerateLoopStencil(
   tp2 = p2;
   while (nextCell != startCell)
   {
-    cell = polys->GetCell(nextCell);
+    polys->GetCellPoints(nextCell, npts, cellPts, ptIds);
     p = -1;
     for (int i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != tp2)
+      if ((p = cellPts[i]) != p1 && cellPts[i] != tp2)
       {
         break;
       }
@@ -237,11 +256,11 @@ void vtkButterflySubdivisionFilter::GenerateLoopStencil(
   }
   else
   { // K == 2. p1 must be on a boundary edge,
-    cell = polys->GetCell(startCell);
+    polys->GetCellPoints(startCell, npts, cellPts, ptIds);
     p = -1;
     for (int i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+      if ((p = cellPts[i]) != p1 && cellPts[i] != p2)
       {
         break;
       }
@@ -266,6 +285,7 @@ void vtkButterflySubdivisionFilter::GenerateBoundaryStencil(
   vtkIdType ncells;
   const vtkIdType* pts;
   vtkIdType npts;
+  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
   int i, j;
   vtkIdType p0, p3;
 
@@ -274,7 +294,7 @@ void vtkButterflySubdivisionFilter::GenerateBoundaryStencil(
   p0 = -1;
   for (i = 0; i < ncells && p0 == -1; i++)
   {
-    polys->GetCellPoints(cells[i], npts, pts);
+    polys->GetCellPoints(cells[i], npts, pts, ptIds);
     for (j = 0; j < npts; j++)
     {
       if (pts[j] == p1 || pts[j] == p2)
@@ -294,7 +314,7 @@ void vtkButterflySubdivisionFilter::GenerateBoundaryStencil(
   p3 = -1;
   for (i = 0; i < ncells && p3 == -1; i++)
   {
-    polys->GetCellPoints(cells[i], npts, pts);
+    polys->GetCellPoints(cells[i], npts, pts, ptIds);
     for (j = 0; j < npts; j++)
     {
       if (pts[j] == p1 || pts[j] == p2 || pts[j] == p0)
@@ -333,7 +353,9 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
 {
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
-  vtkCell* cell;
+  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
+  vtkIdType npts;
+  const vtkIdType* cellPts;
   int i;
   vtkIdType cell0, cell1;
   vtkIdType p, p3, p4, p5, p6, p7, p8;
@@ -342,21 +364,21 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   cell0 = cellIds->GetId(0);
   cell1 = cellIds->GetId(1);
 
-  cell = polys->GetCell(cell0);
+  polys->GetCellPoints(cell0, npts, cellPts, ptIds);
   p3 = -1;
   for (i = 0; i < 3; i++)
   {
-    if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+    if ((p = cellPts[i]) != p1 && cellPts[i] != p2)
     {
       p3 = p;
       break;
     }
   }
-  cell = polys->GetCell(cell1);
+  polys->GetCellPoints(cell1, npts, cellPts, ptIds);
   p4 = -1;
   for (i = 0; i < 3; i++)
   {
-    if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+    if ((p = cellPts[i]) != p1 && cellPts[i] != p2)
     {
       p4 = p;
       break;
@@ -367,10 +389,10 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   p5 = -1;
   if (cellIds->GetNumberOfIds() > 0)
   {
-    cell = polys->GetCell(cellIds->GetId(0));
+    polys->GetCellPoints(cellIds->GetId(0), npts, cellPts, ptIds);
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p3)
+      if ((p = cellPts[i]) != p1 && cellPts[i] != p3)
       {
         p5 = p;
         break;
@@ -382,10 +404,10 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   p6 = -1;
   if (cellIds->GetNumberOfIds() > 0)
   {
-    cell = polys->GetCell(cellIds->GetId(0));
+    polys->GetCellPoints(cellIds->GetId(0), npts, cellPts, ptIds);
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p2 && cell->GetPointId(i) != p3)
+      if ((p = cellPts[i]) != p2 && cellPts[i] != p3)
       {
         p6 = p;
         break;
@@ -397,10 +419,10 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   p7 = -1;
   if (cellIds->GetNumberOfIds() > 0)
   {
-    cell = polys->GetCell(cellIds->GetId(0));
+    polys->GetCellPoints(cellIds->GetId(0), npts, cellPts, ptIds);
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p4)
+      if ((p = cellPts[i]) != p1 && cellPts[i] != p4)
       {
         p7 = p;
         break;
@@ -412,10 +434,10 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   polys->GetCellEdgeNeighbors(cell1, p2, p4, cellIds);
   if (cellIds->GetNumberOfIds() > 0)
   {
-    cell = polys->GetCell(cellIds->GetId(0));
+    polys->GetCellPoints(cellIds->GetId(0), npts, cellPts, ptIds);
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p2 && cell->GetPointId(i) != p4)
+      if ((p = cellPts[i]) != p2 && cellPts[i] != p4)
       {
         p8 = p;
         break;
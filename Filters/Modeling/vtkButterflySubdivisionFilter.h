@@ -73,6 +73,8 @@ protected:
 private:
   int GenerateSubdivisionPoints(vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts,
     vtkPointData* outputPD) override;
+  int GenerateEdgeStencil(vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds,
+    double* weights) override;
   void GenerateButterflyStencil(
     vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights);
   void GenerateLoopStencil(
@@ -42,13 +42,11 @@ int vtkLinearSubdivisionFilter::GenerateSubdivisionPoints(
   vtkSmartPointer<vtkEdgeTable> edgeTable = vtkSmartPointer<vtkEdgeTable>::New();
   vtkPoints* inputPts = inputDS->GetPoints();
   vtkPointData* inputPD = inputDS->GetPointData();
-  static double weights[2] = { .5, .5 };
+  double weights[2];
 
   // Create an edge table to keep track of which edges we've processed
   edgeTable->InitEdgeInsertion(inputDS->GetNumberOfPoints());
 
-  pointIds->SetNumberOfIds(2);
-
   double total = inputPolys->GetNumberOfCells();
   double curr = 0;
   bool abort = false;
@@ -82,8 +80,7 @@ int vtkLinearSubdivisionFilter::GenerateSubdivisionPoints(
           return 0;
         }
         // Compute Position andnew PointData using the same subdivision scheme
-        pointIds->SetId(0, p1);
-        pointIds->SetId(1, p2);
+        this->GenerateEdgeStencil(p1, p2, inputDS, pointIds, weights);
         newId = this->InterpolatePosition(inputPts, outputPts, pointIds, weights);
         outputPD->InterpolatePoint(inputPD, newId, pointIds, weights);
       }
@@ -104,4 +101,15 @@ int vtkLinearSubdivisionFilter::GenerateSubdivisionPoints(
 
   return 1;
 }
+
+int vtkLinearSubdivisionFilter::GenerateEdgeStencil(vtkIdType p1, vtkIdType p2,
+  vtkPolyData* vtkNotUsed(polys), vtkIdList* stencilIds, double* weights)
+{
+  stencilIds->SetNumberOfIds(2);
+  stencilIds->SetId(0, p1);
+  stencilIds->SetId(1, p2);
+  weights[0] = .5;
+  weights[1] = .5;
+  return 1;
+}
 VTK_ABI_NAMESPACE_END
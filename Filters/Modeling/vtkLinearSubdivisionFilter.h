@@ -35,6 +35,7 @@
 #include "vtkInterpolatingSubdivisionFilter.h"
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkIdList;
 class vtkIntArray;
 class vtkPointData;
 class vtkPoints;
@@ -59,6 +60,8 @@ protected:
 
   int GenerateSubdivisionPoints(vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts,
     vtkPointData* outputPD) override;
+  int GenerateEdgeStencil(vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds,
+    double* weights) override;
 
 private:
   vtkLinearSubdivisionFilter(const vtkLinearSubdivisionFilter&) = delete;
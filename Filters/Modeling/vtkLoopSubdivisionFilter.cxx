@@ -14,7 +14,6 @@
 =========================================================================*/
 #include "vtkLoopSubdivisionFilter.h"
 
-#include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellIterator.h"
 #include "vtkEdgeTable.h"
@@ -100,25 +99,14 @@ int vtkLoopSubdivisionFilter::GenerateSubdivisionPoints(
       {
         edgeTable->InsertEdge(p1, p2);
         inputDS->GetCellEdgeNeighbors(-1, p1, p2, cellIds);
-        if (cellIds->GetNumberOfIds() == 1)
-        {
-          // Compute new Position and PointData using the same subdivision scheme
-          stencil->SetNumberOfIds(2);
-          stencil->SetId(0, p1);
-          stencil->SetId(1, p2);
-          weights[0] = .5;
-          weights[1] = .5;
-        } // boundary edge
-        else if (cellIds->GetNumberOfIds() == 2)
-        {
-          this->GenerateOddStencil(p1, p2, inputDS, stencil, weights);
-        }
-        else
+        if (cellIds->GetNumberOfIds() > 2)
         {
           vtkErrorMacro("Dataset is non-manifold and cannot be subdivided. Edge shared by "
             << cellIds->GetNumberOfIds() << " cells");
           return 0;
         }
+        // Compute new Position and PointData using the same subdivision scheme
+        this->GenerateEdgeStencil(p1, p2, inputDS, stencil, weights);
         newId = this->InterpolatePosition(inputPts, outputPts, stencil, weights);
         outputPD->InterpolatePoint(inputPD, newId, stencil, weights);
       }
@@ -138,13 +126,48 @@ int vtkLoopSubdivisionFilter::GenerateSubdivisionPoints(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkLoopSubdivisionFilter::GenerateEdgeStencil(
+  vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
+{
+  vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
+  polys->GetCellEdgeNeighbors(-1, p1, p2, cellIds);
+  if (cellIds->GetNumberOfIds() == 1)
+  {
+    // boundary edge
+    stencilIds->SetNumberOfIds(2);
+    stencilIds->SetId(0, p1);
+    stencilIds->SetId(1, p2);
+    weights[0] = .5;
+    weights[1] = .5;
+  }
+  else if (cellIds->GetNumberOfIds() == 2)
+  {
+    this->GenerateOddStencil(p1, p2, polys, stencilIds, weights);
+  }
+  else
+  {
+    stencilIds->Reset();
+    return 0;
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkLoopSubdivisionFilter::GeneratePointStencil(
+  vtkIdType ptId, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
+{
+  return this->GenerateEvenStencil(ptId, polys, stencilIds, weights);
+}
+
 //------------------------------------------------------------------------------
 int vtkLoopSubdivisionFilter::GenerateEvenStencil(
   vtkIdType p1, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
 {
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
   vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
-  vtkCell* cell;
+  vtkIdType npts;
+  const vtkIdType* cellPts;
 
   int i;
   vtkIdType j;
@@ -191,11 +214,11 @@ int vtkLoopSubdivisionFilter::GenerateEvenStencil(
   // walk around the loop counter-clockwise and get cells
   for (j = 0; j < numCellsInLoop; j++)
   {
-    cell = polys->GetCell(nextCell);
+    polys->GetCellPoints(nextCell, npts, cellPts, ptIds);
     p = -1;
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+      if ((p = cellPts[i]) != p1 && cellPts[i] != p2)
       {
         break;
       }
@@ -218,11 +241,11 @@ int vtkLoopSubdivisionFilter::GenerateEvenStencil(
   p2 = bp1;
   for (; j < numCellsInLoop && startCell != -1; j++)
   {
-    cell = polys->GetCell(nextCell);
+    polys->GetCellPoints(nextCell, npts, cellPts, ptIds);
     p = -1;
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+      if ((p = cellPts[i]) != p1 && cellPts[i] != p2)
       {
         break;
       }
@@ -279,7 +302,9 @@ void vtkLoopSubdivisionFilter::GenerateOddStencil(
   vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
 {
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
-  vtkCell* cell;
+  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
+  vtkIdType npts;
+  const vtkIdType* cellPts;
   int i;
   vtkIdType cell0, cell1;
   vtkIdType p3 = 0, p4 = 0;
@@ -288,18 +313,18 @@ void vtkLoopSubdivisionFilter::GenerateOddStencil(
   cell0 = cellIds->GetId(0);
   cell1 = cellIds->GetId(1);
 
-  cell = polys->GetCell(cell0);
+  polys->GetCellPoints(cell0, npts, cellPts, ptIds);
   for (i = 0; i < 3; i++)
   {
-    if ((p3 = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+    if ((p3 = cellPts[i]) != p1 && cellPts[i] != p2)
     {
       break;
     }
   }
-  cell = polys->GetCell(cell1);
+  polys->GetCellPoints(cell1, npts, cellPts, ptIds);
   for (i = 0; i < 3; i++)
   {
-    if ((p4 = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+    if ((p4 = cellPts[i]) != p1 && cellPts[i] != p2)
     {
       break;
     }
@@ -73,6 +73,10 @@ protected:
 
   int GenerateSubdivisionPoints(vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts,
     vtkPointData* outputPD) override;
+  int GenerateEdgeStencil(vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds,
+    double* weights) override;
+  int GeneratePointStencil(
+    vtkIdType ptId, vtkPolyData* polys, vtkIdList* stencilIds, double* weights) override;
   int GenerateEvenStencil(vtkIdType p1, vtkPolyData* polys, vtkIdList* stencilIds, double* weights);
   void GenerateOddStencil(
     vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights);
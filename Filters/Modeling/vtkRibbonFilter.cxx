@@ -14,17 +14,31 @@
 =========================================================================*/
 #include "vtkRibbonFilter.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkRibbonFilter);
@@ -45,6 +59,7 @@ vtkRibbonFilter::vtkRibbonFilter()
 
   this->GenerateTCoords = 0;
   this->TextureLength = 1.0;
+  this->SequentialProcessing = false;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(
@@ -175,56 +190,60 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //
   this->Theta = vtkMath::RadiansFromDegrees(this->Angle);
   vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
-       inCellId++)
+  if (!this->ThreadedGenerate(input, outPD, outCD, inScalars, range, inNormals,
+        generateNormals != 0, newPts, newNormals, newTCoords, newStrips))
   {
-    this->UpdateProgress((double)inCellId / numLines);
-    abort = this->CheckAbort();
-
-    if (npts < 2)
+    for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
+         inCellId++)
     {
-      vtkWarningMacro(<< "Less than two points in line!");
-      continue; // skip tubing this polyline
-    }
+      this->UpdateProgress((double)inCellId / numLines);
+      abort = this->CheckAbort();
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      if (!vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals))
+      if (npts < 2)
       {
-        vtkWarningMacro(<< "No normals for line!");
+        vtkWarningMacro(<< "Less than two points in line!");
         continue; // skip tubing this polyline
       }
-    }
 
-    // Generate the points around the polyline. The strip is not created
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(
-          offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
-    {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip ribboning this polyline
-    }
+      // If necessary calculate normals, each polyline calculates its
+      // normals independently, avoiding conflicts at shared vertices.
+      if (generateNormals)
+      {
+        singlePolyline->Reset(); // avoid instantiation
+        singlePolyline->InsertNextCell(npts, pts);
+        if (!vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals))
+        {
+          vtkWarningMacro(<< "No normals for line!");
+          continue; // skip tubing this polyline
+        }
+      }
 
-    // Generate the strip for this polyline
-    //
-    this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
+      // Generate the points around the polyline. The strip is not created
+      // if the polyline is bad.
+      //
+      if (!this->GeneratePoints(
+            offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
+      {
+        vtkWarningMacro(<< "Could not generate points!");
+        continue; // skip ribboning this polyline
+      }
 
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
-    {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
-    }
+      // Generate the strip for this polyline
+      //
+      this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
+
+      // Generate the texture coordinates for this polyline
+      //
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
+      // Compute the new offset for the next polyline
+      offset = this->ComputeOffset(offset, npts);
 
-  } // for all polylines
+    } // for all polylines
+  }
 
   singlePolyline->Delete();
 
@@ -485,6 +504,279 @@ vtkIdType vtkRibbonFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
   return offset;
 }
 
+//------------------------------------------------------------------------------
+bool vtkRibbonFilter::ThreadedGenerate(vtkPolyData* input, vtkPointData* outPD,
+  vtkCellData* outCD, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals,
+  bool generateNormals, vtkPoints* newPts, vtkFloatArray* newNormals, vtkFloatArray* newTCoords,
+  vtkCellArray* newStrips)
+{
+  if (this->SequentialProcessing)
+  {
+    return false;
+  }
+  vtkPointData* pd = input->GetPointData();
+  vtkCellData* cd = input->GetCellData();
+  if (!CanUseArrayList(pd) || !CanUseArrayList(cd))
+  {
+    return false;
+  }
+
+  vtkPoints* inPts = input->GetPoints();
+  vtkCellArray* inLines = input->GetLines();
+  const vtkIdType numLines = inLines->GetNumberOfCells();
+  std::vector<vtkIdType> lineSizes(numLines);
+  for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+  {
+    lineSizes[lineId] = inLines->GetCellSize(lineId);
+    if (lineSizes[lineId] < 2)
+    {
+      vtkWarningMacro(<< "Less than two points in line!");
+      lineSizes[lineId] = 0;
+    }
+  }
+
+  // A prefix sum over the polylines gives where the points and the strip
+  // of each ribbon go in the output.
+  std::vector<vtkIdType> pointStarts(numLines + 1, 0);
+  std::vector<vtkIdType> cellStarts(numLines + 1, 0);
+  auto layOut = [&]() {
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+    {
+      const vtkIdType npts = lineSizes[lineId];
+      pointStarts[lineId + 1] = pointStarts[lineId] + (npts > 0 ? this->ComputeOffset(0, npts) : 0);
+      cellStarts[lineId + 1] = cellStarts[lineId] + (npts > 0 ? 1 : 0);
+    }
+  };
+
+  // Each ribbon is generated by the helper methods in per-thread objects,
+  // then copied to its place in the output. The polyline is renumbered 0,
+  // 1, ... and its points, scalars and normals are gathered, so that the
+  // normals generated for polylines sharing points are not shared. The
+  // attributes are copied at the end, so the helpers are given attributes
+  // with no arrays to copy.
+  vtkSMPThreadLocalObject<vtkIdList> cellPointIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localIds;
+  vtkSMPThreadLocal<std::vector<std::pair<vtkIdType, vtkIdType>>> sortedIds;
+  vtkSMPThreadLocalObject<vtkPoints> linePoints;
+  vtkSMPThreadLocalObject<vtkDoubleArray> lineScalars;
+  vtkSMPThreadLocalObject<vtkDoubleArray> lineNormals;
+  vtkSMPThreadLocalObject<vtkFloatArray> slidingNormals;
+  vtkSMPThreadLocalObject<vtkCellArray> singlePolylines;
+  vtkSMPThreadLocalObject<vtkPoints> ribbonPoints;
+  vtkSMPThreadLocalObject<vtkFloatArray> ribbonNormals;
+  vtkSMPThreadLocalObject<vtkFloatArray> ribbonTCoords;
+  vtkNew<vtkPointData> noPointData;
+  vtkNew<vtkCellData> noCellData;
+
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> conn;
+  std::vector<vtkIdType> sourcePoints;
+  std::vector<vtkIdType> sourceCells;
+  std::vector<unsigned char> failed(numLines, 0);
+  std::atomic<bool> anyFailed(false);
+  auto generate = [&]() {
+    const vtkIdType numNewPts = pointStarts[numLines];
+    const vtkIdType numNewCells = cellStarts[numLines];
+    newPts->SetNumberOfPoints(numNewPts);
+    newNormals->SetNumberOfTuples(numNewPts);
+    if (newTCoords)
+    {
+      newTCoords->SetNumberOfTuples(numNewPts);
+    }
+    sourcePoints.resize(numNewPts);
+    sourceCells.resize(numNewCells);
+    // Each strip alternates the two points made for each polyline point.
+    offsets->SetNumberOfValues(numNewCells + 1);
+    conn->SetNumberOfValues(numNewPts);
+    vtkIdType* outOffsets = offsets->GetPointer(0);
+    vtkIdType* outConn = conn->GetPointer(0);
+    outOffsets[numNewCells] = numNewPts;
+
+    vtkSMPTools::For(0, numLines, [&](vtkIdType lineId, vtkIdType endLineId) {
+      vtkIdList* ptIdList = cellPointIds.Local();
+      std::vector<vtkIdType>& lineIds = localIds.Local();
+      std::vector<std::pair<vtkIdType, vtkIdType>>& sorted = sortedIds.Local();
+      vtkPoints* pts = linePoints.Local();
+      vtkDoubleArray* scalars = lineScalars.Local();
+      vtkDoubleArray* givenNormals = lineNormals.Local();
+      vtkFloatArray* sliding = slidingNormals.Local();
+      vtkCellArray* singlePolyline = singlePolylines.Local();
+      vtkPoints* ribbonPts = ribbonPoints.Local();
+      vtkFloatArray* normals = ribbonNormals.Local();
+      vtkFloatArray* tcoords = ribbonTCoords.Local();
+      pts->SetDataTypeToDouble();
+      ribbonPts->SetDataType(newPts->GetDataType());
+      givenNormals->SetNumberOfComponents(inNormals->GetNumberOfComponents());
+      sliding->SetNumberOfComponents(3);
+      normals->SetNumberOfComponents(3);
+      tcoords->SetNumberOfComponents(2);
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      vtkIdType checkAbortInterval = std::min((endLineId - lineId) / 10 + 1, (vtkIdType)1000);
+      double x[3];
+      for (; lineId < endLineId; ++lineId)
+      {
+        if (lineId % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        if (lineSizes[lineId] == 0)
+        {
+          continue;
+        }
+
+        // Gather the renumbered polyline.
+        vtkIdType npts = 0;
+        const vtkIdType* ids = nullptr;
+        inLines->GetCellAtId(lineId, npts, ids, ptIdList);
+        lineIds.resize(npts);
+        std::iota(lineIds.begin(), lineIds.end(), 0);
+        pts->SetNumberOfPoints(npts);
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          inPts->GetPoint(ids[j], x);
+          pts->SetPoint(j, x);
+        }
+        if (inScalars)
+        {
+          scalars->SetNumberOfValues(npts);
+          for (vtkIdType j = 0; j < npts; ++j)
+          {
+            scalars->SetValue(j, inScalars->GetComponent(ids[j], 0));
+          }
+        }
+        vtkDataArray* lineNormalsArray = givenNormals;
+        if (generateNormals)
+        {
+          singlePolyline->Reset();
+          singlePolyline->InsertNextCell(npts, lineIds.data());
+          sliding->Reset();
+          if (!vtkPolyLine::GenerateSlidingNormals(pts, singlePolyline, sliding))
+          {
+            vtkWarningMacro(<< "No normals for line!");
+            failed[lineId] = 1;
+            anyFailed = true;
+            continue;
+          }
+          // The serial path generates the normals at the input point ids, so
+          // a point used several times by the polyline gets the normal
+          // generated last for it.
+          sorted.resize(npts);
+          for (vtkIdType j = 0; j < npts; ++j)
+          {
+            sorted[j] = std::make_pair(ids[j], j);
+          }
+          std::sort(sorted.begin(), sorted.end());
+          float* slidingPtr = sliding->GetPointer(0);
+          for (vtkIdType j = npts - 1; j > 0; --j)
+          {
+            if (sorted[j - 1].first == sorted[j].first)
+            {
+              const vtkIdType last = sorted[j].second;
+              std::copy(slidingPtr + 3 * last, slidingPtr + 3 * last + 3,
+                slidingPtr + 3 * sorted[j - 1].second);
+              sorted[j - 1].second = last;
+            }
+          }
+          lineNormalsArray = sliding;
+        }
+        else
+        {
+          givenNormals->SetNumberOfTuples(npts);
+          for (vtkIdType j = 0; j < npts; ++j)
+          {
+            inNormals->GetTuple(
+              ids[j], givenNormals->GetPointer(j * givenNormals->GetNumberOfComponents()));
+          }
+        }
+
+        // Generate the ribbon.
+        ribbonPts->Reset();
+        normals->Reset();
+        if (!this->GeneratePoints(0, npts, lineIds.data(), pts, ribbonPts, pd, noPointData,
+              normals, inScalars ? scalars : nullptr, range, lineNormalsArray))
+        {
+          vtkWarningMacro(<< "Could not generate points!");
+          failed[lineId] = 1;
+          anyFailed = true;
+          continue;
+        }
+        if (newTCoords)
+        {
+          tcoords->Reset();
+          this->GenerateTextureCoords(
+            0, npts, lineIds.data(), pts, inScalars ? scalars : nullptr, tcoords);
+        }
+
+        // Copy the ribbon to its place, with its strip, as GenerateStrip()
+        // does.
+        const vtkIdType pointStart = pointStarts[lineId];
+        for (vtkIdType i = 0; i < 2 * npts; ++i)
+        {
+          ribbonPts->GetPoint(i, x);
+          newPts->SetPoint(pointStart + i, x);
+          newNormals->SetTypedTuple(pointStart + i, normals->GetPointer(3 * i));
+          if (newTCoords)
+          {
+            newTCoords->SetTypedTuple(pointStart + i, tcoords->GetPointer(2 * i));
+          }
+          sourcePoints[pointStart + i] = ids[i / 2];
+          outConn[pointStart + i] = pointStart + i;
+        }
+        outOffsets[cellStarts[lineId]] = pointStart;
+        sourceCells[cellStarts[lineId]] = lineId;
+      }
+    });
+  };
+
+  layOut();
+  generate();
+  if (anyFailed && !this->GetAbortOutput())
+  {
+    // Lay out the output again without the polylines that could not be
+    // ribboned, which are not visited again.
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+    {
+      if (failed[lineId])
+      {
+        lineSizes[lineId] = 0;
+      }
+    }
+    layOut();
+    generate();
+  }
+  newStrips->SetData(offsets, conn);
+
+  // Copy the attributes of the input points and polylines.
+  const vtkIdType numNewPts = pointStarts[numLines];
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, pd, outPD, /*nullValue*/ 0.0, /*promote*/ false);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      pointArrays.Copy(sourcePoints[ptId], ptId);
+    }
+  });
+  const vtkIdType numNewCells = cellStarts[numLines];
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numNewCells, cd, outCD, /*nullValue*/ 0.0, /*promote*/ false);
+  vtkSMPTools::For(0, numNewCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellArrays.Copy(sourceCells[cellId], cellId);
+    }
+  });
+
+  vtkDebugMacro(<< "Generated " << numNewCells << " ribbons with threads.");
+  return true;
+}
+
 // Description:
 // Return the method of generating the texture coordinates.
 const char* vtkRibbonFilter::GetGenerateTCoordsAsString()
@@ -522,5 +814,6 @@ void vtkRibbonFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Generate TCoords: " << this->GetGenerateTCoordsAsString() << endl;
   os << indent << "Texture Length: " << this->TextureLength << endl;
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
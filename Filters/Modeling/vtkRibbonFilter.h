@@ -23,6 +23,14 @@
  * the local line segment. An offset angle can be specified to rotate the
  * ribbon with respect to the normal.
  *
+ * The polylines are ribboned with threads (vtkSMPTools): a prefix sum over
+ * the polylines gives where the points and the strip of each polyline go,
+ * so the output is ordered as if the polylines were ribboned one after the
+ * other. The output is the same as the serial one, which is used when
+ * SequentialProcessing is on or when the input has string or bit arrays,
+ * except that no unused points are left when a polyline cannot be
+ * ribboned.
+ *
  * @warning
  * The input line must not have duplicate points, or normals at points that
  * are parallel to the incoming/outgoing line segments. (Duplicate points
@@ -148,6 +156,18 @@ public:
   vtkGetMacro(TextureLength, double);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the polylines. By
+   * default, sequential processing is off. The output is the same either
+   * way, except for the unused points described above. This flag is
+   * typically used for benchmarking and testing purposes.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkRibbonFilter();
   ~vtkRibbonFilter() override;
@@ -161,6 +181,7 @@ protected:
   vtkTypeBool UseDefaultNormal;
   int GenerateTCoords;  // control texture coordinate generation
   double TextureLength; // this length is mapped to [0,1) texture space
+  bool SequentialProcessing;
 
   // Helper methods
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
@@ -172,6 +193,16 @@ protected:
     vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
   vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
 
+  /**
+   * Generate the ribbons of all the polylines with threads, laying out the
+   * output of each polyline with a prefix sum over the polylines. Return
+   * false without modifying the output when the serial path must be taken.
+   */
+  bool ThreadedGenerate(vtkPolyData* input, vtkPointData* outPD, vtkCellData* outCD,
+    vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals, bool generateNormals,
+    vtkPoints* newPts, vtkFloatArray* newNormals, vtkFloatArray* newTCoords,
+    vtkCellArray* newStrips);
+
   // Helper data members
   double Theta;
 
@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEuclideanClusterExtractionParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel labelling of vtkEuclideanClusterExtraction, used
+// with a vtkStaticPointLocator, extracts the same clusters as the serial
+// traversal, used with other locators.
+
+#include "vtkDoubleArray.h"
+#include "vtkEuclideanClusterExtraction.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <iostream>
+#include <map>
+#include <set>
+
+namespace
+{
+// The cluster id of each extracted input point. When extracting specified
+// clusters or the largest one, the output points of the other clusters are
+// left uninitialized, so only the given cluster ids are considered.
+std::map<vtkIdType, vtkIdType> GetClusters(vtkPolyData* output, const std::set<vtkIdType>& ids)
+{
+  std::map<vtkIdType, vtkIdType> clusters;
+  vtkDataArray* pointIds = output->GetPointData()->GetArray("PointIds");
+  vtkDataArray* clusterIds = output->GetPointData()->GetArray("ClusterId");
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    const vtkIdType clusterId = static_cast<vtkIdType>(clusterIds->GetComponent(i, 0));
+    if (ids.empty() || ids.count(clusterId))
+    {
+      clusters[static_cast<vtkIdType>(pointIds->GetComponent(i, 0))] = clusterId;
+    }
+  }
+  return clusters;
+}
+}
+
+int TestEuclideanClusterExtractionParallel(int, char*[])
+{
+  // Random points, with random scalars.
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointIds;
+  pointIds->SetName("PointIds");
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (vtkIdType i = 0; i < 5000; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetNextRangeValue(0.0, 1.0);
+    }
+    points->InsertNextPoint(x);
+    pointIds->InsertNextValue(i);
+    scalars->InsertNextValue(random->GetNextRangeValue(0.0, 1.0));
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(pointIds);
+  input->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkEuclideanClusterExtraction> parallel;
+  vtkNew<vtkEuclideanClusterExtraction> serial;
+  vtkNew<vtkPointLocator> locator;
+  serial->SetLocator(locator);
+  for (vtkEuclideanClusterExtraction* filter : { parallel.Get(), serial.Get() })
+  {
+    filter->SetInputData(input);
+    filter->SetRadius(0.04);
+    filter->ColorClustersOn();
+    filter->SetScalarRange(0.0, 0.8);
+    filter->AddSeed(0);
+    filter->AddSeed(10);
+    filter->AddSpecifiedCluster(0);
+    filter->AddSpecifiedCluster(3);
+    filter->SetClosestPoint(0.5, 0.5, 0.5);
+  }
+
+  // The largest cluster is found from the sizes of all the clusters.
+  const int modes[] = { VTK_EXTRACT_ALL_CLUSTERS, VTK_EXTRACT_POINT_SEEDED_CLUSTERS,
+    VTK_EXTRACT_SPECIFIED_CLUSTERS, VTK_EXTRACT_LARGEST_CLUSTER,
+    VTK_EXTRACT_CLOSEST_POINT_CLUSTER };
+  for (bool scalarConnectivity : { false, true })
+  {
+    vtkIdType largestClusterId = 0;
+    for (int mode : modes)
+    {
+      for (vtkEuclideanClusterExtraction* filter : { parallel.Get(), serial.Get() })
+      {
+        filter->SetScalarConnectivity(scalarConnectivity);
+        filter->SetExtractionMode(mode);
+        filter->Update();
+      }
+      std::cout << "Mode " << mode << ", scalar connectivity " << scalarConnectivity << ": "
+                << parallel->GetNumberOfExtractedClusters() << " clusters, "
+                << parallel->GetOutput()->GetNumberOfPoints() << " points" << std::endl;
+      std::set<vtkIdType> ids;
+      if (mode == VTK_EXTRACT_SPECIFIED_CLUSTERS)
+      {
+        ids = { 0, 3 };
+      }
+      else if (mode == VTK_EXTRACT_LARGEST_CLUSTER)
+      {
+        ids = { largestClusterId };
+      }
+      const std::map<vtkIdType, vtkIdType> clusters = GetClusters(parallel->GetOutput(), ids);
+      if (parallel->GetNumberOfExtractedClusters() != serial->GetNumberOfExtractedClusters() ||
+        parallel->GetOutput()->GetNumberOfPoints() != serial->GetOutput()->GetNumberOfPoints() ||
+        clusters.empty() || clusters != GetClusters(serial->GetOutput(), ids))
+      {
+        std::cerr << "Different clusters" << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (mode == VTK_EXTRACT_ALL_CLUSTERS)
+      {
+        std::map<vtkIdType, vtkIdType> sizes;
+        for (const auto& cluster : clusters)
+        {
+          if (++sizes[cluster.second] > sizes[largestClusterId])
+          {
+            largestClusterId = cluster.second;
+          }
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
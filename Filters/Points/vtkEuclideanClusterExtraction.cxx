@@ -15,6 +15,7 @@
 #include "vtkEuclideanClusterExtraction.h"
 
 #include "vtkAbstractPointLocator.h"
+#include "vtkConnectedComponents.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -25,8 +26,13 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStaticPointLocator.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkEuclideanClusterExtraction);
 vtkCxxSetObjectMacro(vtkEuclideanClusterExtraction, Locator, vtkAbstractPointLocator);
@@ -156,34 +162,54 @@ int vtkEuclideanClusterExtraction::RequestData(vtkInformation* vtkNotUsed(reques
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
+  // The static point locator is thread-safe, so the clusters can be labelled
+  // in parallel.
+  const bool parallel = vtkStaticPointLocator::SafeDownCast(this->Locator) != nullptr;
+
   if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_CLUSTERS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_CLUSTER)
   { // visit all points assigning cluster number
-    for (ptId = 0; ptId < numPts; ptId++)
+    if (parallel)
     {
-      if (ptId && !(ptId % 10000))
+      this->LabelClusters(inPts, false);
+      for (i = 0; i < this->ClusterNumber; i++)
       {
-        this->UpdateProgress(0.1 + 0.8 * ptId / numPts);
+        if (this->ClusterSizes->GetValue(i) > maxPointsInCluster)
+        {
+          maxPointsInCluster = this->ClusterSizes->GetValue(i);
+          largestClusterId = i;
+        }
       }
-
-      if (!this->Visited[ptId])
+      this->UpdateProgress(0.9);
+    }
+    else
+    {
+      for (ptId = 0; ptId < numPts; ptId++)
       {
-        this->NumPointsInCluster = 0;
-        this->InsertIntoWave(this->Wave, ptId);
-        this->TraverseAndMark(inPts);
-
-        if (this->NumPointsInCluster > maxPointsInCluster)
+        if (ptId && !(ptId % 10000))
         {
-          maxPointsInCluster = this->NumPointsInCluster;
-          largestClusterId = this->ClusterNumber;
+          this->UpdateProgress(0.1 + 0.8 * ptId / numPts);
         }
 
-        if (this->NumPointsInCluster > 0)
+        if (!this->Visited[ptId])
         {
-          this->ClusterSizes->InsertValue(this->ClusterNumber++, this->NumPointsInCluster);
+          this->NumPointsInCluster = 0;
+          this->InsertIntoWave(this->Wave, ptId);
+          this->TraverseAndMark(inPts);
+
+          if (this->NumPointsInCluster > maxPointsInCluster)
+          {
+            maxPointsInCluster = this->NumPointsInCluster;
+            largestClusterId = this->ClusterNumber;
+          }
+
+          if (this->NumPointsInCluster > 0)
+          {
+            this->ClusterSizes->InsertValue(this->ClusterNumber++, this->NumPointsInCluster);
+          }
+          this->Wave->Reset();
+          this->Wave2->Reset();
         }
-        this->Wave->Reset();
-        this->Wave2->Reset();
       }
     }
   }
@@ -211,8 +237,15 @@ int vtkEuclideanClusterExtraction::RequestData(vtkInformation* vtkNotUsed(reques
     this->UpdateProgress(0.5);
 
     // mark all seeded clusters
-    this->TraverseAndMark(inPts);
-    this->ClusterSizes->InsertValue(this->ClusterNumber, this->NumPointsInCluster);
+    if (parallel)
+    {
+      this->LabelClusters(inPts, true);
+    }
+    else
+    {
+      this->TraverseAndMark(inPts);
+      this->ClusterSizes->InsertValue(this->ClusterNumber, this->NumPointsInCluster);
+    }
     this->UpdateProgress(0.9);
   }
 
@@ -370,6 +403,101 @@ void vtkEuclideanClusterExtraction::TraverseAndMark(vtkPoints* inPts)
   } // while wave is not empty
 }
 
+//------------------------------------------------------------------------------
+// Label the clusters as the connected components of the points within the
+// radius of each other, possibly limited by scalar connectivity. The points
+// are numbered by cluster, then by point id.
+void vtkEuclideanClusterExtraction::LabelClusters(vtkPoints* inPts, bool seeded)
+{
+  const vtkIdType numPts = inPts->GetNumberOfPoints();
+  vtkConnectedComponents clusters;
+  clusters.Initialize(numPts);
+  std::vector<char> inRange(numPts, 1);
+  if (this->InScalars)
+  {
+    for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+      double s = this->InScalars->GetTuple1(ptId);
+      if (s < this->ScalarRange[0] || s > this->ScalarRange[1])
+      {
+        inRange[ptId] = 0;
+        clusters.Exclude(ptId);
+      }
+    }
+  }
+
+  vtkSMPThreadLocalObject<vtkIdList> localNeighbors;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    vtkIdList* neighbors = localNeighbors.Local();
+    double x[3];
+    for (; ptId < endPtId; ptId++)
+    {
+      if (inRange[ptId])
+      {
+        inPts->GetPoint(ptId, x);
+        this->Locator->FindPointsWithinRadius(this->Radius, x, neighbors);
+        for (vtkIdType neighborId : *neighbors)
+        {
+          if (neighborId > ptId && inRange[neighborId])
+          {
+            clusters.Union(ptId, neighborId);
+          }
+        }
+      }
+    }
+  });
+
+  std::vector<vtkIdType> labels(numPts);
+  vtkIdType numClusters = clusters.Label(labels.data());
+  if (seeded)
+  {
+    std::vector<vtkIdType> seededClusters(numClusters, -1);
+    for (vtkIdType i = 0; i < this->Wave->GetNumberOfIds(); i++)
+    {
+      seededClusters[labels[this->Wave->GetId(i)]] = 0;
+    }
+    this->Wave->Reset();
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ptId++)
+      {
+        if (labels[ptId] >= 0)
+        {
+          labels[ptId] = seededClusters[labels[ptId]];
+        }
+      }
+    });
+    numClusters = 1;
+  }
+  else
+  {
+    this->ClusterNumber = numClusters;
+  }
+
+  std::vector<vtkIdType> offsets(numClusters + 1, 0);
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+  {
+    if (labels[ptId] >= 0)
+    {
+      offsets[labels[ptId] + 1]++;
+    }
+  }
+  this->ClusterSizes->SetNumberOfValues(numClusters);
+  for (vtkIdType clusterId = 0; clusterId < numClusters; clusterId++)
+  {
+    this->ClusterSizes->SetValue(clusterId, offsets[clusterId + 1]);
+    offsets[clusterId + 1] += offsets[clusterId];
+  }
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+  {
+    if (labels[ptId] >= 0)
+    {
+      this->PointMap[ptId] = offsets[labels[ptId]]++;
+      this->NewScalars->SetValue(this->PointMap[ptId], labels[ptId]);
+    }
+  }
+  this->PointNumber = offsets[numClusters];
+}
+
 //------------------------------------------------------------------------------
 // Obtain the number of connected clusters.
 int vtkEuclideanClusterExtraction::GetNumberOfExtractedClusters()
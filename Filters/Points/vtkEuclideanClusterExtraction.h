@@ -44,8 +44,14 @@
  * example, by using a seed point in a known cluster, clustering will pull
  * out all points "representing" the local structure.
  *
+ * When the locator is a vtkStaticPointLocator, which can be queried from
+ * several threads, the clusters are labelled in parallel with
+ * vtkConnectedComponents instead of being traversed one after the other.
+ * The clusters are numbered in the same order, and the output points are
+ * ordered by cluster, then by input point id.
+ *
  * @sa
- * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter vtkConnectedComponents
  */
 
 #ifndef vtkEuclideanClusterExtraction_h
@@ -219,6 +225,10 @@ protected:
   void InsertIntoWave(vtkIdList* wave, vtkIdType ptId);
   void TraverseAndMark(vtkPoints* pts);
 
+  // Internal method labelling the clusters in parallel. If seeded, the
+  // clusters of the points of the wave form cluster 0.
+  void LabelClusters(vtkPoints* pts, bool seeded);
+
 private:
   vtkEuclideanClusterExtraction(const vtkEuclideanClusterExtraction&) = delete;
   void operator=(const vtkEuclideanClusterExtraction&) = delete;
@@ -72,6 +72,7 @@ vtkXMLHyperTreeGridReader::~vtkXMLHyperTreeGridReader() = default;
 void vtkXMLHyperTreeGridReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "PackTrees: " << this->PackTrees << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -429,6 +430,13 @@ void vtkXMLHyperTreeGridReader::ReadXMLData()
   }
   this->IdsSelected.clear();
   this->FixedHTs = false;
+
+  if (this->PackTrees)
+  {
+    // Pack the trees that could not be packed while being read
+    output->SetModeSqueeze("Packed");
+    output->Squeeze();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -987,6 +995,7 @@ void vtkXMLHyperTreeGridReader::ReadTrees_2(vtkXMLDataElement* element)
   vtkIdType descriptorOffset = 0;
   vtkIdType inputOffset = 0;
   vtkIdType outputOffset = 0;
+  vtkHyperTree* packedSibling = nullptr;
   numberOfVerticesPerDepthIterator = numberOfVerticesPerDepthRange.cbegin();
 
   for (vtkIdType treeId = 0; treeId < treeIdsSize; ++treeId)
@@ -1053,6 +1062,18 @@ void vtkXMLHyperTreeGridReader::ReadTrees_2(vtkXMLDataElement* element)
     }
 
     tree->BuildFromBreadthFirstOrderDescriptor(descriptor, readableDescriptorSize, 0);
+    if (this->PackTrees)
+    {
+      // Move the tree to the packed storage shared by the previous ones, so
+      // that no more than one tree is stored unpacked at any time
+      vtkHyperTree* packedTree = tree->FreezePacked(packedSibling);
+      if (packedTree != tree)
+      {
+        output->SetTree(treeIds->GetValue(treeId), packedTree);
+        packedTree->Delete();
+        packedSibling = packedTree;
+      }
+    }
     descriptorOffset += descriptorSize;
     outputOffset += readableTreeSize;
     inputOffset += treeSize;
@@ -78,6 +78,19 @@ public:
   vtkGetMacro(FixedLevel, unsigned int);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get whether the trees are moved to a single packed storage (see
+   * vtkHyperTreeGrid::SetModeSqueeze) as they are read, which reduces the
+   * memory footprint of grids made of many trees. The trees of the output
+   * are then unmodifiable.
+   * Default is false.
+   */
+  vtkSetMacro(PackTrees, bool);
+  vtkGetMacro(PackTrees, bool);
+  vtkBooleanMacro(PackTrees, bool);
+  ///@}
+
   ///@{
   /**
    * Set/Get the selected HyperTrees (HTs) to read :
@@ -187,6 +200,9 @@ protected:
   // Fixed the load maximum level
   unsigned int FixedLevel;
 
+  // Pack the trees as they are read
+  bool PackTrees = false;
+
   bool Verbose = false;
 
   bool FixedHTs = false;
@@ -43,6 +43,9 @@ vtkImageMapToColors::vtkImageMapToColors()
 
   // Make sure the Scalars are used as default ArrayToProcess
   this->SetInputArrayToProcess(0, 0, 0, vtkDataObject::POINT, vtkDataSetAttributes::SCALARS);
+
+  // Each output point only depends on the same input point.
+  this->PointLocal = true;
 }
 
 //------------------------------------------------------------------------------
@@ -31,6 +31,9 @@ vtkImageShiftScale::vtkImageShiftScale()
   this->Scale = 1.0;
   this->OutputScalarType = -1;
   this->ClampOverflow = 0;
+
+  // Each output point only depends on the same input point.
+  this->PointLocal = true;
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageConnectivityFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel labelling of vtkImageConnectivityFilter numbers
+// the regions in the order of a scan of the image, with the right sizes and
+// extents.
+
+#include "vtkIdTypeArray.h"
+#include "vtkImageConnectivityFilter.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+int TestImageConnectivityFilterParallel(int, char*[])
+{
+  // A random binary image with many regions.
+  const int dims[3] = { 40, 30, 20 };
+  const vtkIdType numVoxels = dims[0] * dims[1] * dims[2];
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(dims[0], dims[1], dims[2]);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  unsigned char* inPtr = static_cast<unsigned char*>(image->GetScalarPointer());
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  for (vtkIdType i = 0; i < numVoxels; ++i)
+  {
+    inPtr[i] = random->GetNextRangeValue(0.0, 1.0) < 0.3 ? 1 : 0;
+  }
+
+  // The expected labels, from a flood fill of each region in scan order.
+  std::vector<int> expected(numVoxels, 0);
+  std::vector<vtkIdType> sizes(1, 0);
+  std::vector<int> extents(6, 0);
+  for (vtkIdType i = 0; i < numVoxels; ++i)
+  {
+    if (!inPtr[i] || expected[i])
+    {
+      continue;
+    }
+    const int label = static_cast<int>(sizes.size());
+    sizes.push_back(0);
+    int extent[6] = { dims[0], -1, dims[1], -1, dims[2], -1 };
+    std::vector<vtkIdType> stack(1, i);
+    expected[i] = label;
+    while (!stack.empty())
+    {
+      const vtkIdType id = stack.back();
+      stack.pop_back();
+      sizes[label]++;
+      const int pos[3] = { static_cast<int>(id % dims[0]),
+        static_cast<int>((id / dims[0]) % dims[1]), static_cast<int>(id / (dims[0] * dims[1])) };
+      vtkIdType inc = 1;
+      for (int j = 0; j < 3; ++j)
+      {
+        extent[2 * j] = std::min(extent[2 * j], pos[j]);
+        extent[2 * j + 1] = std::max(extent[2 * j + 1], pos[j]);
+        for (int step : { -1, 1 })
+        {
+          const int neighborPos = pos[j] + step;
+          const vtkIdType neighbor = id + step * inc;
+          if (neighborPos >= 0 && neighborPos < dims[j] && inPtr[neighbor] && !expected[neighbor])
+          {
+            expected[neighbor] = label;
+            stack.push_back(neighbor);
+          }
+        }
+        inc *= dims[j];
+      }
+    }
+    extents.insert(extents.end(), extent, extent + 6);
+  }
+  const vtkIdType numRegions = static_cast<vtkIdType>(sizes.size()) - 1;
+  std::cout << numRegions << " regions" << std::endl;
+
+  vtkNew<vtkImageConnectivityFilter> connectivity;
+  connectivity->SetInputData(image);
+  connectivity->SetScalarRange(1, 1);
+  connectivity->SetLabelScalarTypeToInt();
+  connectivity->GenerateRegionExtentsOn();
+  connectivity->Update();
+  const int* outPtr = static_cast<int*>(connectivity->GetOutput()->GetScalarPointer());
+  if (connectivity->GetNumberOfExtractedRegions() != numRegions ||
+    !std::equal(expected.begin(), expected.end(), outPtr))
+  {
+    std::cerr << "Wrong labels: " << connectivity->GetNumberOfExtractedRegions() << " regions"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkIdTypeArray* labels = connectivity->GetExtractedRegionLabels();
+  vtkIdTypeArray* regionSizes = connectivity->GetExtractedRegionSizes();
+  vtkIntArray* regionExtents = connectivity->GetExtractedRegionExtents();
+  for (vtkIdType i = 0; i < numRegions; ++i)
+  {
+    const vtkIdType label = labels->GetValue(i);
+    if (regionSizes->GetValue(i) != sizes[label] ||
+      !std::equal(extents.begin() + 6 * label, extents.begin() + 6 * label + 6,
+        regionExtents->GetPointer(6 * i)))
+    {
+      std::cerr << "Wrong size or extent for region " << label << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Only a part of the output.
+  int updateExtent[6] = { 5, 30, 3, 25, 2, 15 };
+  connectivity->UpdateExtent(updateExtent);
+  for (int k = updateExtent[4]; k <= updateExtent[5]; ++k)
+  {
+    for (int j = updateExtent[2]; j <= updateExtent[3]; ++j)
+    {
+      for (int i = updateExtent[0]; i <= updateExtent[1]; ++i)
+      {
+        const int* label =
+          static_cast<int*>(connectivity->GetOutput()->GetScalarPointer(i, j, k));
+        if (*label != expected[(k * dims[1] + j) * dims[0] + i])
+        {
+          std::cerr << "Wrong label in the update extent" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // More regions than labels, so that the smallest ones are discarded.
+  connectivity->SetLabelScalarTypeToUnsignedChar();
+  connectivity->Update();
+  if (connectivity->GetNumberOfExtractedRegions() < 1 ||
+    connectivity->GetNumberOfExtractedRegions() > 255)
+  {
+    std::cerr << "Wrong number of regions with unsigned char labels: "
+              << connectivity->GetNumberOfExtractedRegions() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -46,6 +46,7 @@
 
 #include "vtkImageConnectivityFilter.h"
 
+#include "vtkConnectedComponents.h"
 #include "vtkDataSet.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
@@ -59,6 +60,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTemplateAliasMacro.h"
@@ -323,6 +325,15 @@ protected:
     vtkDataSet* seedData, vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr,
     int extent[6], vtkICF::RegionVector& regionInfo);
 
+  // Label the regions of the uncolored voxels in parallel, and add them in
+  // the same order as SeedlessExecute(). Nothing is done, and false is
+  // returned, if the labels would run out and require some regions to be
+  // pruned.
+  template <class OT>
+  static bool ParallelSeedlessExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
+    vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr, int extent[6],
+    vtkICF::RegionVector& regionInfo);
+
   // Execute method for when no seeds are provided.
   template <class OT>
   static void SeedlessExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
@@ -1238,12 +1249,161 @@ void vtkICF::SeededExecute(vtkImageConnectivityFilter* self, vtkImageData* outDa
   }
 }
 
+//------------------------------------------------------------------------------
+template <class OT>
+bool vtkICF::ParallelSeedlessExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
+  vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr, int extent[6],
+  vtkICF::RegionVector& regionInfo)
+{
+  vtkIdType outInc[3];
+  outData->GetIncrements(outInc);
+
+  int outExt[6];
+  outData->GetExtent(outExt);
+
+  int maxIdx[3];
+  int* outLimits = vtkICF::ZeroBaseExtent(extent, outExt, maxIdx);
+
+  const vtkIdType rowSize = maxIdx[0] + 1;
+  const vtkIdType numRows = static_cast<vtkIdType>(maxIdx[1] + 1) * (maxIdx[2] + 1);
+  const vtkIdType numVoxels = rowSize * numRows;
+
+  // the voxels that are colored or not in the bitmask are excluded, and the
+  // others are connected to their uncolored neighbors
+  vtkConnectedComponents components;
+  components.Initialize(numVoxels);
+  vtkSMPTools::For(0, numVoxels, [&](vtkIdType idx, vtkIdType endIdx) {
+    for (; idx < endIdx; idx++)
+    {
+      if ((maskPtr[idx >> 3] & (1 << (idx & 0x7))) != 0)
+      {
+        components.Exclude(idx);
+      }
+    }
+  });
+  const vtkIdType inc[3] = { 1, rowSize, rowSize * (maxIdx[1] + 1) };
+  vtkSMPTools::For(0, numRows, [&](vtkIdType row, vtkIdType endRow) {
+    for (; row < endRow; row++)
+    {
+      const int yIdx = static_cast<int>(row % (maxIdx[1] + 1));
+      const int zIdx = static_cast<int>(row / (maxIdx[1] + 1));
+      const vtkIdType rowIdx = row * rowSize;
+      for (int xIdx = 0; xIdx <= maxIdx[0]; xIdx++)
+      {
+        const vtkIdType idx = rowIdx + xIdx;
+        if ((maskPtr[idx >> 3] & (1 << (idx & 0x7))) != 0)
+        {
+          continue;
+        }
+        const int pos[3] = { xIdx, yIdx, zIdx };
+        for (int i = 0; i < 3; i++)
+        {
+          const vtkIdType neighborIdx = idx + inc[i];
+          if (pos[i] < maxIdx[i] && (maskPtr[neighborIdx >> 3] & (1 << (neighborIdx & 0x7))) == 0)
+          {
+            components.Union(idx, neighborIdx);
+          }
+        }
+      }
+    }
+  });
+
+  // the regions are numbered in the order of their first voxel in the
+  // raster, like the flood fill does, so if no region must be pruned the
+  // result is the same
+  std::vector<vtkIdType> labels(numVoxels);
+  const vtkIdType numRegions = components.Label(labels.data());
+  const vtkIdType firstLabel = static_cast<vtkIdType>(regionInfo.size());
+  if (firstLabel + numRegions > static_cast<vtkIdType>(vtkTypeTraits<OT>::Max()))
+  {
+    return false;
+  }
+
+  // the region extent is the position of its first voxel, unless the
+  // extents were requested
+  const bool generateExtents = (self->GetGenerateRegionExtents() != 0);
+  std::vector<vtkIdType> sizes(numRegions, 0);
+  std::vector<int> regionExtents(6 * numRegions);
+  for (vtkIdType row = 0; row < numRows; row++)
+  {
+    const int yIdx = static_cast<int>(row % (maxIdx[1] + 1));
+    const int zIdx = static_cast<int>(row / (maxIdx[1] + 1));
+    const vtkIdType* rowLabels = labels.data() + row * rowSize;
+    for (int xIdx = 0; xIdx <= maxIdx[0]; xIdx++)
+    {
+      const vtkIdType label = rowLabels[xIdx];
+      if (label < 0)
+      {
+        continue;
+      }
+      int* regionExtent = &regionExtents[6 * label];
+      if (sizes[label]++ == 0)
+      {
+        regionExtent[0] = regionExtent[1] = xIdx;
+        regionExtent[2] = regionExtent[3] = yIdx;
+        regionExtent[4] = regionExtent[5] = zIdx;
+      }
+      else if (generateExtents)
+      {
+        regionExtent[0] = std::min(regionExtent[0], xIdx);
+        regionExtent[1] = std::max(regionExtent[1], xIdx);
+        regionExtent[2] = std::min(regionExtent[2], yIdx);
+        regionExtent[3] = std::max(regionExtent[3], yIdx);
+        regionExtent[5] = zIdx;
+      }
+    }
+  }
+
+  // write the labels of the voxels within the output extent
+  int limits[6] = { 0, maxIdx[0], 0, maxIdx[1], 0, maxIdx[2] };
+  if (outLimits)
+  {
+    std::copy(outLimits, outLimits + 6, limits);
+  }
+  vtkSMPTools::For(0, numRows, [&](vtkIdType row, vtkIdType endRow) {
+    for (; row < endRow; row++)
+    {
+      const int yIdx = static_cast<int>(row % (maxIdx[1] + 1));
+      const int zIdx = static_cast<int>(row / (maxIdx[1] + 1));
+      if (yIdx < limits[2] || yIdx > limits[3] || zIdx < limits[4] || zIdx > limits[5])
+      {
+        continue;
+      }
+      const vtkIdType* rowLabels = labels.data() + row * rowSize;
+      OT* outRowPtr = outPtr + (yIdx - limits[2]) * outInc[1] + (zIdx - limits[4]) * outInc[2];
+      for (int xIdx = limits[0]; xIdx <= limits[1]; xIdx++)
+      {
+        if (rowLabels[xIdx] >= 0)
+        {
+          outRowPtr[(xIdx - limits[0]) * outInc[0]] = static_cast<OT>(firstLabel + rowLabels[xIdx]);
+        }
+      }
+    }
+  });
+
+  int extractionMode = self->GetExtractionMode();
+  vtkIdType sizeRange[2];
+  self->GetSizeRange(sizeRange);
+  for (vtkIdType label = 0; label < numRegions; label++)
+  {
+    vtkICF::AddRegion(outData, outPtr, stencil, extent, sizeRange, regionInfo, sizes[label], -1,
+      &regionExtents[6 * label], extractionMode);
+  }
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 template <class OT>
 void vtkICF::SeedlessExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
   vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr, int extent[6],
   vtkICF::RegionVector& regionInfo)
 {
+  if (vtkICF::ParallelSeedlessExecute(self, outData, stencil, outPtr, maskPtr, extent, regionInfo))
+  {
+    return;
+  }
+
   // Get execution parameters
   int extractionMode = self->GetExtractionMode();
   vtkIdType sizeRange[2];
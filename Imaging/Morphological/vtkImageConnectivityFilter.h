@@ -86,8 +86,15 @@
  * is called.  These extents can be useful for cropping the output
  * of the filter.
  *
+ * The regions that are not connected to seeds are labelled in parallel
+ * with vtkConnectedComponents, and numbered in the order in which they
+ * are found by a scan of the image.  If there are more regions than the
+ * label scalar type can hold, they are instead grown one at a time so
+ * that the smallest ones can be discarded as they are found.
+ *
  * @sa
- * vtkConnectivityFilter, vtkPolyDataConnectivityFilter, vtkmImageConnectivity
+ * vtkConnectivityFilter, vtkPolyDataConnectivityFilter, vtkmImageConnectivity,
+ * vtkConnectedComponents
  */
 
 #ifndef vtkImageConnectivityFilter_h
@@ -0,0 +1,187 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAsynchronousUpdater.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkAsynchronousUpdater updates a pipeline on a worker thread,
+// double buffers its outputs, delivers its events and can be canceled.
+
+#include "vtkAsynchronousUpdater.h"
+#include "vtkCommand.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+// Source producing a given number of points. It executes until it is
+// released or aborted.
+class BlockingSource : public vtkPolyDataAlgorithm
+{
+public:
+  static BlockingSource* New();
+  vtkTypeMacro(BlockingSource, vtkPolyDataAlgorithm);
+
+  vtkIdType NumberOfPoints = 1;
+  std::atomic<bool> Released{ true };
+  std::atomic<bool> Running{ false };
+
+protected:
+  BlockingSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    this->Running = true;
+    this->UpdateProgress(0.5);
+    const auto start = std::chrono::steady_clock::now();
+    while (!this->Released && !this->CheckAbort() &&
+      std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(this->NumberOfPoints);
+    vtkPolyData::GetData(outputVector)->SetPoints(points);
+    this->Running = false;
+    return 1;
+  }
+};
+vtkStandardNewMacro(BlockingSource);
+
+// Filter passing its input.
+class PassPoints : public vtkPolyDataAlgorithm
+{
+public:
+  static PassPoints* New();
+  vtkTypeMacro(PassPoints, vtkPolyDataAlgorithm);
+
+protected:
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkPolyData::GetData(outputVector)->ShallowCopy(vtkPolyData::GetData(inputVector[0]));
+    return 1;
+  }
+};
+vtkStandardNewMacro(PassPoints);
+
+struct EventCounter
+{
+  int Progress = 0;
+  int End = 0;
+  std::thread::id ThreadId;
+  bool WrongThread = false;
+
+  void OnEvent(vtkObject*, unsigned long event, void*)
+  {
+    if (std::this_thread::get_id() != this->ThreadId)
+    {
+      this->WrongThread = true;
+    }
+    ++(event == vtkCommand::ProgressEvent ? this->Progress : this->End);
+  }
+};
+
+vtkIdType GetNumberOfPoints(vtkAsynchronousUpdater* updater)
+{
+  vtkPolyData* output = vtkPolyData::SafeDownCast(updater->GetOutputDataObject(0));
+  return output ? output->GetNumberOfPoints() : -1;
+}
+}
+
+int TestAsynchronousUpdater(int, char*[])
+{
+  vtkNew<BlockingSource> source;
+  source->NumberOfPoints = 10;
+  vtkNew<PassPoints> pass;
+  pass->SetInputConnection(source->GetOutputPort());
+
+  vtkNew<vtkAsynchronousUpdater> updater;
+  updater->SetAlgorithm(pass);
+  EventCounter counter;
+  counter.ThreadId = std::this_thread::get_id();
+  updater->AddObserver(vtkCommand::ProgressEvent, &counter, &EventCounter::OnEvent);
+  updater->AddObserver(vtkCommand::EndEvent, &counter, &EventCounter::OnEvent);
+
+  auto future = updater->UpdateAsync();
+  if (future->Get() != 1 || !updater->ProcessEvents() || GetNumberOfPoints(updater) != 10 ||
+    counter.End != 1 || counter.Progress == 0 || counter.WrongThread)
+  {
+    std::cerr << "Wrong result of the first update" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The previous outputs stay available while the next update executes.
+  source->Released = false;
+  source->NumberOfPoints = 20;
+  source->Modified();
+  future = updater->UpdateTimeStepAsync(0.0);
+  while (!source->Running)
+  {
+    std::this_thread::yield();
+  }
+  if (!updater->IsUpdating() || updater->ProcessEvents() || GetNumberOfPoints(updater) != 10)
+  {
+    std::cerr << "The outputs were not double buffered" << std::endl;
+    return EXIT_FAILURE;
+  }
+  source->Released = true;
+  if (future->Get() != 1 || !updater->ProcessEvents() || GetNumberOfPoints(updater) != 20 ||
+    counter.End != 2 || updater->IsUpdating())
+  {
+    std::cerr << "Wrong result of the second update" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Canceling aborts the algorithms upstream, and discards the pending
+  // updates.
+  source->Released = false;
+  source->NumberOfPoints = 30;
+  source->Modified();
+  future = updater->UpdateAsync();
+  auto pending = updater->UpdateAsync();
+  while (!source->Running)
+  {
+    std::this_thread::yield();
+  }
+  const auto start = std::chrono::steady_clock::now();
+  updater->Cancel();
+  if (future->Get() != 0 || pending->Get() != 0 ||
+    std::chrono::steady_clock::now() - start > std::chrono::seconds(5) ||
+    updater->ProcessEvents() || GetNumberOfPoints(updater) != 20)
+  {
+    std::cerr << "The update was not canceled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The aborted algorithms execute again during the next update.
+  source->Released = true;
+  future = updater->UpdateAsync();
+  if (future->Get() != 1 || !updater->ProcessEvents() || GetNumberOfPoints(updater) != 30 ||
+    source->GetAbortExecute() || pass->GetAbortExecute() || counter.WrongThread)
+  {
+    std::cerr << "Wrong result after canceling" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
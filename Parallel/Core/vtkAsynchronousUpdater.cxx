@@ -0,0 +1,307 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousUpdater.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAsynchronousUpdater.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCommand.h"
+#include "vtkDataObject.h"
+#include "vtkExecutive.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+void CollectUpstream(vtkAlgorithm* algorithm, std::set<vtkAlgorithm*>& algorithms)
+{
+  if (!algorithm || !algorithms.insert(algorithm).second)
+  {
+    return;
+  }
+  for (int i = 0; i < algorithm->GetNumberOfInputPorts(); ++i)
+  {
+    for (int j = 0; j < algorithm->GetNumberOfInputConnections(i); ++j)
+    {
+      CollectUpstream(algorithm->GetInputAlgorithm(i, j), algorithms);
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+class vtkAsynchronousUpdater::vtkInternals
+{
+public:
+  using OutputsType = std::vector<vtkSmartPointer<vtkDataObject>>;
+
+  vtkSmartPointer<vtkThreadedCallbackQueue> Queue =
+    vtkSmartPointer<vtkThreadedCallbackQueue>::New();
+
+  // Updates are numbered in the order they are requested. Those numbered up
+  // to CanceledRequest are skipped.
+  std::atomic<int> LastRequest{ 0 };
+  std::atomic<int> CanceledRequest{ 0 };
+  std::atomic<int> NumberOfPendingUpdates{ 0 };
+
+  // Guards the AbortExecute flags of the pipeline, and the algorithm being
+  // updated.
+  std::mutex AbortMutex;
+  vtkAlgorithm* Running = nullptr;
+
+  std::atomic<double> Progress{ 0.0 };
+  std::atomic<bool> ProgressModified{ false };
+  unsigned long ProgressObserver = 0;
+
+  std::mutex OutputsMutex;
+  OutputsType BackOutputs;
+  bool BackOutputsReady = false;
+  OutputsType Outputs;
+
+  FuturePointer Push(vtkAlgorithm* algorithm, std::function<int(vtkAlgorithm*)> update)
+  {
+    const int request = ++this->LastRequest;
+    ++this->NumberOfPendingUpdates;
+    vtkSmartPointer<vtkAlgorithm> pipeline = algorithm;
+    return this->Queue->Push([this, request, pipeline, update]() {
+      int result = 0;
+      if (this->Start(request, pipeline))
+      {
+        result = update(pipeline);
+        this->Finish(pipeline);
+        if (result && request > this->CanceledRequest)
+        {
+          this->StoreOutputs(pipeline);
+        }
+        else
+        {
+          result = 0;
+        }
+      }
+      --this->NumberOfPendingUpdates;
+      return result;
+    });
+  }
+
+  bool Start(int request, vtkAlgorithm* algorithm)
+  {
+    std::lock_guard<std::mutex> lock(this->AbortMutex);
+    if (request <= this->CanceledRequest)
+    {
+      return false;
+    }
+    this->Running = algorithm;
+    return true;
+  }
+
+  // Clear the flags set by Cancel(). The aborted algorithms are modified, so
+  // that they execute again during the next update. The shared LastAbortTime
+  // of vtkAlgorithm is updated once, now that the pipeline does not execute
+  // anymore.
+  void Finish(vtkAlgorithm* algorithm)
+  {
+    std::lock_guard<std::mutex> lock(this->AbortMutex);
+    this->Running = nullptr;
+    std::set<vtkAlgorithm*> algorithms;
+    CollectUpstream(algorithm, algorithms);
+    bool aborted = false;
+    for (vtkAlgorithm* upstream : algorithms)
+    {
+      if (upstream->GetAbortExecute())
+      {
+        if (!aborted)
+        {
+          upstream->SetAbortExecuteAndUpdateTime();
+          aborted = true;
+        }
+        upstream->SetAbortExecute(0);
+      }
+    }
+  }
+
+  void Cancel()
+  {
+    std::lock_guard<std::mutex> lock(this->AbortMutex);
+    this->CanceledRequest = this->LastRequest.load();
+    std::set<vtkAlgorithm*> algorithms;
+    CollectUpstream(this->Running, algorithms);
+    // Only set the flags: the algorithms must not be modified while the
+    // worker thread executes them.
+    for (vtkAlgorithm* upstream : algorithms)
+    {
+      upstream->RequestAbortExecute();
+    }
+  }
+
+  void StoreOutputs(vtkAlgorithm* algorithm)
+  {
+    OutputsType outputs;
+    for (int i = 0; i < algorithm->GetNumberOfOutputPorts(); ++i)
+    {
+      vtkSmartPointer<vtkDataObject> copy;
+      if (vtkDataObject* output = algorithm->GetOutputDataObject(i))
+      {
+        copy.TakeReference(output->NewInstance());
+        copy->ShallowCopy(output);
+      }
+      outputs.push_back(copy);
+    }
+    std::lock_guard<std::mutex> lock(this->OutputsMutex);
+    this->BackOutputs.swap(outputs);
+    this->BackOutputsReady = true;
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkStandardNewMacro(vtkAsynchronousUpdater);
+
+//------------------------------------------------------------------------------
+vtkAsynchronousUpdater::vtkAsynchronousUpdater()
+  : Algorithm(nullptr)
+  , Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkAsynchronousUpdater::~vtkAsynchronousUpdater()
+{
+  this->Cancel();
+  // Wait for the running update.
+  this->Internals->Queue = nullptr;
+  this->SetAlgorithm(nullptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousUpdater::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Algorithm: " << this->Algorithm << endl;
+  os << indent << "NumberOfPendingUpdates: " << this->Internals->NumberOfPendingUpdates << endl;
+  os << indent << "NumberOfOutputs: " << this->Internals->Outputs.size() << endl;
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousUpdater::SetAlgorithm(vtkAlgorithm* algorithm)
+{
+  if (this->Algorithm == algorithm)
+  {
+    return;
+  }
+  this->Cancel();
+  if (this->Algorithm)
+  {
+    this->Algorithm->RemoveObserver(this->Internals->ProgressObserver);
+    this->Algorithm->UnRegister(this);
+  }
+  this->Algorithm = algorithm;
+  if (this->Algorithm)
+  {
+    this->Algorithm->Register(this);
+    this->Internals->ProgressObserver = this->Algorithm->AddObserver(
+      vtkCommand::ProgressEvent, this, &vtkAsynchronousUpdater::OnProgress);
+  }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkAsynchronousUpdater::FuturePointer vtkAsynchronousUpdater::UpdateAsync()
+{
+  if (!this->Algorithm)
+  {
+    vtkErrorMacro("No algorithm to update.");
+    return nullptr;
+  }
+  return this->Internals->Push(this->Algorithm, [](vtkAlgorithm* algorithm) {
+    const int port = algorithm->GetNumberOfOutputPorts() ? 0 : -1;
+    return static_cast<int>(algorithm->GetExecutive()->Update(port));
+  });
+}
+
+//------------------------------------------------------------------------------
+vtkAsynchronousUpdater::FuturePointer vtkAsynchronousUpdater::UpdateTimeStepAsync(
+  double time, int piece, int numPieces, int ghostLevels)
+{
+  if (!this->Algorithm)
+  {
+    vtkErrorMacro("No algorithm to update.");
+    return nullptr;
+  }
+  return this->Internals->Push(
+    this->Algorithm, [time, piece, numPieces, ghostLevels](vtkAlgorithm* algorithm) {
+      return algorithm->UpdateTimeStep(time, piece, numPieces, ghostLevels);
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousUpdater::Cancel()
+{
+  this->Internals->Cancel();
+}
+
+//------------------------------------------------------------------------------
+bool vtkAsynchronousUpdater::IsUpdating()
+{
+  return this->Internals->NumberOfPendingUpdates > 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkAsynchronousUpdater::ProcessEvents()
+{
+  bool newOutputs = false;
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->OutputsMutex);
+    if (this->Internals->BackOutputsReady)
+    {
+      this->Internals->Outputs.swap(this->Internals->BackOutputs);
+      this->Internals->BackOutputs.clear();
+      this->Internals->BackOutputsReady = false;
+      newOutputs = true;
+    }
+  }
+
+  if (this->Internals->ProgressModified.exchange(false))
+  {
+    double progress = this->Internals->Progress;
+    this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+  }
+  if (newOutputs)
+  {
+    this->InvokeEvent(vtkCommand::EndEvent);
+  }
+  return newOutputs;
+}
+
+//------------------------------------------------------------------------------
+vtkDataObject* vtkAsynchronousUpdater::GetOutputDataObject(int port)
+{
+  if (port < 0 || port >= static_cast<int>(this->Internals->Outputs.size()))
+  {
+    return nullptr;
+  }
+  return this->Internals->Outputs[port];
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousUpdater::OnProgress(vtkObject*, unsigned long, void* callData)
+{
+  this->Internals->Progress = *static_cast<double*>(callData);
+  this->Internals->ProgressModified = true;
+}
+VTK_ABI_NAMESPACE_END
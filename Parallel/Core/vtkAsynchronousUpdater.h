@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousUpdater.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkAsynchronousUpdater
+ * @brief update a pipeline without blocking the calling thread
+ *
+ * vtkAsynchronousUpdater updates the pipeline of an algorithm on a worker thread of a
+ * vtkThreadedCallbackQueue, so that an application, a GUI for instance, stays responsive while
+ * a long pipeline executes. `UpdateAsync()` and `UpdateTimeStepAsync()` return immediately a
+ * shared future, which can be waited on, and whose value is the result of the update. Updates
+ * are executed one after the other, in the order they were requested.
+ *
+ * The outputs are double buffered: `GetOutputDataObject()` returns a shallow copy of the outputs
+ * of the last completed update, which stays valid, for rendering for instance, while the next
+ * update executes. Connect the consumers to these copies with `SetInputData()` rather than to
+ * the output ports of the algorithm, which are modified by the worker thread.
+ *
+ * The application must call `ProcessEvents()` regularly from its own thread, from a timer of its
+ * event loop for instance. It invokes on this thread:
+ * - `vtkCommand::ProgressEvent`, with the last progress of the algorithm as call data, when the
+ *   progress changed since the previous call.
+ * - `vtkCommand::EndEvent` when a new update completed. The outputs returned by
+ *   `GetOutputDataObject()` are replaced just before this event is invoked.
+ *
+ * `Cancel()` cancels the pending updates and aborts the running one, by setting the
+ * AbortExecute flag of the algorithm and of all the algorithms upstream. Algorithms calling
+ * `vtkAlgorithm::CheckAbort()` then stop as soon as possible. The outputs of a canceled update
+ * are discarded.
+ *
+ * @warning The pipeline must not be modified nor updated by another thread while an update is
+ * running.
+ *
+ * @sa
+ * vtkThreadedCallbackQueue
+ */
+
+#ifndef vtkAsynchronousUpdater_h
+#define vtkAsynchronousUpdater_h
+
+#include "vtkObject.h"
+#include "vtkParallelCoreModule.h"    // For export macro
+#include "vtkThreadedCallbackQueue.h" // For SharedFuturePointer
+
+#include <memory> // For unique_ptr
+
+#if !defined(__WRAP__)
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkDataObject;
+
+class VTKPARALLELCORE_EXPORT vtkAsynchronousUpdater : public vtkObject
+{
+public:
+  static vtkAsynchronousUpdater* New();
+  vtkTypeMacro(vtkAsynchronousUpdater, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  using FuturePointer = vtkThreadedCallbackQueue::SharedFuturePointer<int>;
+
+  ///@{
+  /**
+   * Set/Get the algorithm to update. Changing the algorithm cancels the pending updates.
+   */
+  void SetAlgorithm(vtkAlgorithm* algorithm);
+  vtkGetObjectMacro(Algorithm, vtkAlgorithm);
+  ///@}
+
+  /**
+   * Asynchronous version of `vtkAlgorithm::Update()`. The value of the returned future is 1 if
+   * the update succeeded, 0 if it failed or was canceled.
+   */
+  FuturePointer UpdateAsync();
+
+  /**
+   * Asynchronous version of `vtkAlgorithm::UpdateTimeStep()`. The value of the returned future
+   * is 1 if the update succeeded, 0 if it failed or was canceled.
+   */
+  FuturePointer UpdateTimeStepAsync(
+    double time, int piece = -1, int numPieces = 1, int ghostLevels = 0);
+
+  /**
+   * Cancel the pending updates and abort the running one.
+   */
+  void Cancel();
+
+  /**
+   * Returns true while an update is pending or running.
+   */
+  bool IsUpdating();
+
+  /**
+   * Invoke the progress and completion events on the calling thread, and make the outputs of
+   * the last completed update available. Returns true if new outputs are available.
+   */
+  bool ProcessEvents();
+
+  /**
+   * Get the outputs of the last completed update, as of the last call to `ProcessEvents()`.
+   * Returns nullptr if no update completed yet.
+   */
+  vtkDataObject* GetOutputDataObject(int port);
+
+protected:
+  vtkAsynchronousUpdater();
+  ~vtkAsynchronousUpdater() override;
+
+  void OnProgress(vtkObject* caller, unsigned long event, void* callData);
+
+  vtkAlgorithm* Algorithm;
+
+private:
+  vtkAsynchronousUpdater(const vtkAsynchronousUpdater&) = delete;
+  void operator=(const vtkAsynchronousUpdater&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+#endif
+// VTK-HeaderTest-Exclude: vtkAsynchronousUpdater.h